@@ -0,0 +1,30 @@
+# Checks that running the Programmable Filter script once per block gives
+# the same result as running it once on the whole composite input.
+import sys
+from paraview.simple import *
+from paraview import servermanager
+from paraview.vtk.numpy_interface import dataset_adapter as dsa
+import numpy
+
+blocks = [Wavelet(WholeExtent=[-10 - i, 10, -10, 10 + i, -10, 10]) for i in range(6)]
+group = GroupDatasets(Input=blocks)
+
+script = """
+output.ShallowCopy(inputs[0].VTKObject)
+output.PointData.append(sqrt(abs(inputs[0].PointData['RTData'])) * 2, 'result')
+"""
+
+results = []
+for perBlock in [0, 1]:
+    programmable = ProgrammableFilter(Input=group, Script=script,
+                                      ExecutePerBlock=perBlock, NumberOfThreads=3)
+    programmable.UpdatePipeline()
+    output = dsa.WrapDataObject(servermanager.Fetch(programmable))
+    results.append([numpy.asarray(array) for array in output.PointData['result'].Arrays])
+    Delete(programmable)
+
+if len(results[0]) != len(blocks) or len(results[1]) != len(blocks) or \
+        any(not numpy.array_equal(a, b) for a, b in zip(results[0], results[1])):
+    print("ERROR: per block execution differs")
+    sys.exit(1)
+print("success")
@@ -0,0 +1,100 @@
+# Checks the numexpr path of the streaming evaluation of the Python
+# Calculator: which expressions are handed to numexpr, that its results match
+# the evaluation on whole arrays, and that failures in numexpr fall back to
+# numpy. A stand-in module is installed as `numexpr` so that the test does not
+# depend on numexpr being available; the real one is also tested when found.
+import sys
+import types
+from paraview.simple import *
+from paraview import servermanager
+from paraview.vtk.numpy_interface import dataset_adapter as dsa
+import numpy
+
+try:
+    import numexpr as real_numexpr
+except ImportError:
+    real_numexpr = None
+
+wavelet = Wavelet(WholeExtent=[-20, 20, -20, 20, -20, 20])
+gradient = Gradient(Input=wavelet, ScalarArray=['POINTS', 'RTData'])
+
+# expression, whether numexpr evaluates it
+expressions = [
+    ("RTData * RTData + 2 * RTData - 1", True),
+    ("sqrt(abs(RTData)) + exp(-RTData / 100)", True),
+    ("where(RTData > 150, RTData, 0)", True),
+    ("-RTData ** 2 + 3 * RTData / (1 + RTData)", True),
+    # numpy attributes and calls are not numexpr's
+    ("RTData * numpy.pi", False),
+    ("numpy.sqrt(abs(RTData))", False),
+    # components are extracted with numpy
+    ("Gradient[:, 0] + RTData", False),
+    # not element-wise, evaluated on whole arrays
+    ("RTData - mean(RTData)", False),
+]
+
+
+def make_numexpr(fail):
+    """A numexpr stand-in evaluating with numpy, or raising if `fail`."""
+    module = types.ModuleType("numexpr")
+    module.calls = []
+
+    def evaluate(expression, local_dict=None):
+        module.calls.append(expression)
+        if fail:
+            raise TypeError("unsupported by this numexpr")
+        namespace = {name: getattr(numpy, name) for name in
+                     ["abs", "exp", "sqrt", "where"]}
+        return eval(expression, namespace, dict(local_dict))
+
+    module.evaluate = evaluate
+    return module
+
+
+def evaluate(expression, streaming):
+    calculator = PythonCalculator(Input=gradient, Expression=expression,
+                                  UseStreamingEvaluation=streaming,
+                                  StreamingChunkSize=1000)
+    calculator.UpdatePipeline()
+    output = dsa.WrapDataObject(servermanager.Fetch(calculator))
+    result = numpy.asarray(output.PointData['result'])
+    Delete(calculator)
+    return result
+
+
+def check(expression, expected, module_name):
+    result = evaluate(expression, 1)
+    # numexpr may use a different evaluation order and precision.
+    if result.shape != expected.shape or not numpy.allclose(result, expected):
+        print("ERROR: %s evaluation differs for '%s'" % (module_name, expression))
+        sys.exit(1)
+
+
+saved = sys.modules.get("numexpr")
+try:
+    for expression, uses_numexpr in expressions:
+        expected = evaluate(expression, 0)
+
+        sys.modules["numexpr"] = stand_in = make_numexpr(fail=False)
+        check(expression, expected, "numexpr stand-in")
+        if bool(stand_in.calls) != uses_numexpr:
+            print("ERROR: numexpr %s called for '%s'" %
+                  ("not" if uses_numexpr else "unexpectedly", expression))
+            sys.exit(1)
+
+        sys.modules["numexpr"] = failing = make_numexpr(fail=True)
+        check(expression, expected, "numpy fallback")
+        if bool(failing.calls) != uses_numexpr:
+            print("ERROR: numexpr %s called for '%s'" %
+                  ("not" if uses_numexpr else "unexpectedly", expression))
+            sys.exit(1)
+
+        if real_numexpr is not None:
+            sys.modules["numexpr"] = real_numexpr
+            check(expression, expected, "numexpr")
+finally:
+    if saved is None:
+        sys.modules.pop("numexpr", None)
+    else:
+        sys.modules["numexpr"] = saved
+print("success")
@@ -0,0 +1,34 @@
+# Checks that the streaming evaluation of the Python Calculator gives the
+# same results as the evaluation on whole arrays.
+import sys
+from paraview.simple import *
+from paraview import servermanager
+from paraview.vtk.numpy_interface import dataset_adapter as dsa
+import numpy
+
+wavelet = Wavelet(WholeExtent=[-40, 40, -40, 40, -40, 40])
+gradient = Gradient(Input=wavelet, ScalarArray=['POINTS', 'RTData'])
+
+expressions = [
+    "RTData * RTData + 2 * Gradient[:, 0] - 1",
+    "sqrt(abs(RTData)) + numpy.exp(-Gradient[:, 1] / 100)",
+    "numpy.where(RTData > 150, RTData, 0)",
+    "Gradient * 2",
+    # not element-wise, evaluated on whole arrays
+    "RTData - mean(RTData)",
+]
+
+for expression in expressions:
+    results = []
+    for streaming in [0, 1]:
+        calculator = PythonCalculator(Input=gradient, Expression=expression,
+                                      UseStreamingEvaluation=streaming,
+                                      StreamingChunkSize=1000)
+        calculator.UpdatePipeline()
+        output = dsa.WrapDataObject(servermanager.Fetch(calculator))
+        results.append(numpy.asarray(output.PointData['result']))
+        Delete(calculator)
+    if results[0].shape != results[1].shape or not numpy.array_equal(results[0], results[1]):
+        print("ERROR: streaming evaluation differs for '%s'" % expression)
+        sys.exit(1)
+print("success")
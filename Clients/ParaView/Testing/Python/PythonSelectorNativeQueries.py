@@ -0,0 +1,109 @@
+# Checks that the queries evaluated natively by vtkPythonSelector select the
+# same elements as their evaluation by `paraview.detail.python_selector`, and
+# that the queries it does not understand still fall back to Python.
+import sys
+import numpy
+from paraview.modules.vtkPVVTKExtensionsExtractionPython import vtkPythonSelector
+from paraview.detail import python_selector
+from vtkmodules.vtkCommonDataModel import vtkImageData, vtkMultiBlockDataSet, vtkSelectionNode
+from vtkmodules.numpy_interface import dataset_adapter as dsa
+
+INSIDEDNESS = "vtkInsidedness"
+
+
+def make_block(seed, with_ints=True):
+    image = vtkImageData()
+    image.SetDimensions(8, 8, 8)
+    n = image.GetNumberOfPoints()
+    random = numpy.random.RandomState(seed)
+    data = dsa.WrapDataObject(image)
+    data.PointData.append(random.uniform(0, 255, n).astype(numpy.float32), "RTData")
+    data.PointData.append(random.uniform(-1, 1, (n, 3)), "Vec")
+    pressure = random.uniform(0, 1, n).astype(numpy.float32)
+    pressure[::17] = numpy.nan
+    data.PointData.append(pressure, "Pressure")
+    if with_ints:
+        data.PointData.append(random.randint(0, 6, n).astype(numpy.int32), "Ints")
+    return image
+
+
+def make_input():
+    blocks = vtkMultiBlockDataSet()
+    blocks.SetBlock(0, make_block(0))
+    blocks.SetBlock(1, make_block(1))
+    # queries on `Ints` do not select anything in this block.
+    blocks.SetBlock(2, make_block(2, with_ints=False))
+    return blocks
+
+
+def make_output(blocks):
+    output = vtkMultiBlockDataSet()
+    output.CopyStructure(blocks)
+    for cc in range(blocks.GetNumberOfBlocks()):
+        block = blocks.GetBlock(cc).NewInstance()
+        block.ShallowCopy(blocks.GetBlock(cc))
+        output.SetBlock(cc, block)
+    return output
+
+
+def masks(output):
+    """Selected elements of each block, None when the block has no mask."""
+    result = []
+    for cc in range(output.GetNumberOfBlocks()):
+        array = output.GetBlock(cc).GetPointData().GetArray(INSIDEDNESS)
+        result.append(None if array is None else dsa.vtkDataArrayToVTKArray(array) != 0)
+    return result
+
+
+def select(blocks, query, native):
+    node = vtkSelectionNode()
+    node.SetContentType(vtkSelectionNode.QUERY)
+    node.SetFieldType(vtkSelectionNode.POINT)
+    node.SetQueryString(query)
+    output = make_output(blocks)
+    if native:
+        selector = vtkPythonSelector()
+        selector.SetInsidednessArrayName(INSIDEDNESS)
+        selector.Initialize(node)
+        selector.Execute(blocks, output)
+    else:
+        python_selector.execute(blocks, node, INSIDEDNESS, output)
+    return masks(output)
+
+
+queries = [
+    # evaluated natively
+    "RTData > 150",
+    "RTData<=100.5",
+    "(RTData >= 100) & (RTData < 200)",
+    "((RTData > 50)) & ((Vec[:,1] < 0.5) & (Ints == 3))",
+    "(mag(Vec) >= 0.8) & (id < 300)",
+    "in1d(Ints, [1, 3, 5])",
+    "in1d(RTData, [0, 1, ])",
+    "isnan(Pressure)",
+    "(Pressure > 0.5) & (Vec[:,2] > 0)",
+    "Ints == max(Ints)",
+    "mag(Vec) == min(mag(Vec))",
+    "(id >= 10) & (id <= 40)",
+    # evaluated by Python, `&` binding tighter than comparisons in the first one
+    "RTData > 100 & 255",
+    "abs(Vec[:,0]) > 0.5",
+    "RTData * 2 > 300",
+    "(RTData > 100) & (abs(Vec[:,0]) < 0.5)",
+]
+
+blocks = make_input()
+for query in queries:
+    expected = select(blocks, query, native=False)
+    result = select(blocks, query, native=True)
+    if all(e is None for e in expected):
+        print("ERROR: Python could not evaluate '%s'" % query)
+        sys.exit(1)
+    for block, (e, r) in enumerate(zip(expected, result)):
+        # a block without mask has nothing selected.
+        e = numpy.zeros(0, dtype=bool) if e is None else numpy.asarray(e)
+        r = numpy.zeros(0, dtype=bool) if r is None else numpy.asarray(r)
+        if e.any() != r.any() or (e.size and r.size and not numpy.array_equal(e, r)):
+            print("ERROR: '%s' selects different elements in block %d" % (query, block))
+            sys.exit(1)
+print("success")
@@ -0,0 +1,61 @@
+# This test verifies that compositing translucent geometry in depth layers,
+# without redistributing the data, matches the ordered compositing of the
+# redistributed data.
+
+from paraview.simple import *
+from paraview import smtesting
+
+pm = servermanager.vtkProcessModule.GetProcessModule()
+if pm.GetNumberOfLocalPartitions() < 2:
+    raise smtesting.TestError("Test must be run on several ranks!")
+
+# the pieces of the sphere are wedges around the z axis: looking along the x
+# axis, the front and the back of the sphere are on different ranks.
+sphere = Sphere(ThetaResolution=64, PhiResolution=64)
+view = CreateRenderView()
+view.ViewSize = [300, 300]
+view.OrientationAxesVisibility = 0
+view.RemoteRenderThreshold = 0
+display = Show(sphere, view)
+display.Opacity = 0.5
+ColorBy(display, ("POINTS", "Normals", "X"))
+view.CameraPosition = [3, 0.2, 0.1]
+view.CameraFocalPoint = [0, 0, 0]
+view.CameraViewUp = [0, 0, 1]
+view.ResetCamera()
+
+
+def capture(layers):
+    view.NumberOfCompositingLayers = layers
+    Render(view)
+    image = view.CaptureWindow(1)
+    scalars = image.GetPointData().GetScalars()
+    values = [scalars.GetValue(cc) for cc in range(scalars.GetNumberOfValues())]
+    components = scalars.GetNumberOfComponents()
+    image.UnRegister(None)
+    return values, components
+
+
+def differing_pixels(first, second):
+    values1, components = first
+    values2 = second[0]
+    if len(values1) != len(values2):
+        raise smtesting.TestError("Images of different sizes!")
+    count = 0
+    for cc in range(0, len(values1), components):
+        if any(abs(values1[cc + comp] - values2[cc + comp]) > 8 for comp in range(components)):
+            count += 1
+    return count
+
+
+numPixels = view.ViewSize[0] * view.ViewSize[1]
+redistributed = capture(0)
+differing = differing_pixels(redistributed, capture(4))
+print("pixels differing from the redistributed data: %d of %d" % (differing, numPixels))
+# the cuts of the redistribution slightly change the geometry along them.
+if differing > numPixels // 100:
+    raise smtesting.TestError("Depth layers differ from the redistributed data!")
+
+# a single layer only keeps the front of the sphere.
+if differing_pixels(redistributed, capture(1)) <= numPixels // 100:
+    raise smtesting.TestError("A single depth layer should miss the back of the sphere!")
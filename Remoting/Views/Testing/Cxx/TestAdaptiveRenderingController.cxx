@@ -0,0 +1,65 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkNew.h"
+#include "vtkPVAdaptiveRenderingController.h"
+
+#define expect(x, msg)                                                                             \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << __LINE__ << ": " msg << endl;                                                          \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+namespace
+{
+// Feeds frames whose image stages cost `imageTime` seconds at full resolution.
+void Interact(vtkPVAdaptiveRenderingController* controller, double renderTime,
+  double lodRenderTime, double imageTime, int numFrames)
+{
+  for (int cc = 0; cc < numFrames; ++cc)
+  {
+    const int factor = controller->GetImageReductionFactor();
+    const bool lod = controller->GetUseLOD();
+    controller->AddInteractiveFrame(
+      lod ? lodRenderTime : renderTime, 0.0, 0.0, imageTime / (factor * factor), lod);
+  }
+}
+}
+
+int TestAdaptiveRenderingController(int, char*[])
+{
+  vtkNew<vtkPVAdaptiveRenderingController> controller;
+  controller->SetTargetFrameRate(10);
+
+  // Image bound: the resolution is reduced until the target is met.
+  Interact(controller, 0.02, 0.01, 0.8, 10);
+  expect(controller->GetImageReductionFactor() == 4, "Wrong image reduction factor.");
+  expect(!controller->GetUseLOD(), "LOD should not be used.");
+  expect(controller->PredictFrameTime(4, false) <= 0.1, "Target frame rate not met.");
+
+  // The full resolution frame is slow, so it is refined in two steps.
+  expect(controller->EndInteraction() == 2, "Wrong refinement factor.");
+  expect(controller->EndInteraction() == 0, "Refinement should be done once.");
+
+  // Geometry bound: LOD is used and the resolution is kept.
+  controller->Reset();
+  Interact(controller, 0.2, 0.01, 0.01, 10);
+  expect(controller->GetUseLOD(), "LOD should be used.");
+  expect(controller->GetImageReductionFactor() == 1, "Resolution should not be reduced.");
+  expect(controller->EndInteraction() == 0, "No refinement expected.");
+
+  // Transfer bound even at the maximum reduction: the compression is degraded.
+  controller->Reset();
+  controller->SetMaximumImageReductionFactor(2);
+  Interact(controller, 0.02, 0.01, 2.0, 10);
+  expect(controller->GetImageReductionFactor() == 2, "Wrong image reduction factor.");
+  expect(controller->GetCompressionLossLevel() == controller->GetMaximumCompressionLossLevel(),
+    "Compression loss level should be maximal.");
+
+  // Fast frames restore full quality.
+  Interact(controller, 0.001, 0.001, 0.001, 20);
+  expect(controller->GetImageReductionFactor() == 1 && controller->GetCompressionLossLevel() == 0,
+    "Full quality should be restored.");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,251 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Checks that vtkBrickedImageVolumeRepresentation streams the bricks of a
+// streaming capable image source one update extent at a time, that they are
+// taken from the cache after a camera move or an array change but loaded
+// again after the source or the brick size changed, and that the cache is
+// bounded by CacheSize.
+
+#include "vtkBrickedImageVolumeRepresentation.h"
+#include "vtkCamera.h"
+#include "vtkDataObject.h"
+#include "vtkDoubleArray.h"
+#include "vtkImageAlgorithm.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVView.h"
+#include "vtkPointData.h"
+#include "vtkResampledBrickImageSource.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#include <array>
+#include <vector>
+
+namespace
+{
+constexpr int WholeExtent[6] = { 0, 63, 0, 63, 0, 63 };
+constexpr int NumberOfBricks = 64;
+}
+
+// An image source that produces any requested extent, with two point arrays,
+// and records the extents it produced.
+class vtkTestBrickSource : public vtkImageAlgorithm
+{
+public:
+  static vtkTestBrickSource* New();
+  vtkTypeMacro(vtkTestBrickSource, vtkImageAlgorithm);
+
+  std::vector<std::array<int, 6>> Extents;
+
+protected:
+  vtkTestBrickSource() { this->SetNumberOfInputPorts(0); }
+
+  int RequestInformation(vtkInformation*, vtkInformationVector**,
+    vtkInformationVector* outputVector) override
+  {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), WholeExtent, 6);
+    outInfo->Set(vtkDataObject::ORIGIN(), 0.0, 0.0, 0.0);
+    outInfo->Set(vtkDataObject::SPACING(), 1.0, 1.0, 1.0);
+    outInfo->Set(CAN_PRODUCE_SUB_EXTENT(), 1);
+    return 1;
+  }
+
+  int RequestData(vtkInformation*, vtkInformationVector**,
+    vtkInformationVector* outputVector) override
+  {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    vtkImageData* output = vtkImageData::GetData(outInfo);
+    std::array<int, 6> extent;
+    outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), extent.data());
+    this->Extents.push_back(extent);
+
+    output->SetExtent(extent.data());
+    output->SetOrigin(0, 0, 0);
+    output->SetSpacing(1, 1, 1);
+    const vtkIdType numPoints = output->GetNumberOfPoints();
+    for (const char* name : { "a", "b" })
+    {
+      vtkNew<vtkDoubleArray> array;
+      array->SetName(name);
+      array->SetNumberOfTuples(numPoints);
+      for (vtkIdType cc = 0; cc < numPoints; ++cc)
+      {
+        double x[3];
+        output->GetPoint(cc, x);
+        array->SetValue(cc, *name == 'a' ? x[0] + x[1] + x[2] : x[0] * x[1] - x[2]);
+      }
+      output->GetPointData()->AddArray(array);
+    }
+    return 1;
+  }
+
+private:
+  vtkTestBrickSource(const vtkTestBrickSource&) = delete;
+  void operator=(const vtkTestBrickSource&) = delete;
+};
+vtkStandardNewMacro(vtkTestBrickSource);
+
+// Streams the bricks as vtkPVRenderView does, without rendering them.
+class vtkTestBrickedRepresentation : public vtkBrickedImageVolumeRepresentation
+{
+public:
+  static vtkTestBrickedRepresentation* New();
+  vtkTypeMacro(vtkTestBrickedRepresentation, vtkBrickedImageVolumeRepresentation);
+
+  // Streams all the bricks visible from `camera`, the resampled volume
+  // covering `bounds` as it follows the camera, and returns their number.
+  int StreamAll(vtkCamera* camera, const double bounds[6])
+  {
+    double planes[24];
+    camera->GetFrustumPlanes(1.0, planes);
+    this->Resampler->SetSpatialBounds(bounds);
+    int count = 0;
+    while (this->StreamingUpdate(nullptr, planes))
+    {
+      ++count;
+    }
+    return count;
+  }
+
+protected:
+  vtkTestBrickedRepresentation() = default;
+
+private:
+  vtkTestBrickedRepresentation(const vtkTestBrickedRepresentation&) = delete;
+  void operator=(const vtkTestBrickedRepresentation&) = delete;
+};
+vtkStandardNewMacro(vtkTestBrickedRepresentation);
+
+namespace
+{
+bool CheckPass(vtkTestBrickedRepresentation* repr, int count, int expectedCount, int expectedHits,
+  const char* what)
+{
+  const int hits = repr->GetNumberOfCacheHits();
+  const int loads = repr->GetNumberOfLoadedBricks();
+  if ((expectedCount >= 0 && count != expectedCount) || count <= 0 ||
+    (expectedHits >= 0 && hits != expectedHits) || hits + loads != count)
+  {
+    vtkLogF(ERROR, "%s: %d bricks streamed, %d cache hits and %d loaded.", what, count, hits,
+      loads);
+    return false;
+  }
+  return true;
+}
+}
+
+int TestBrickedImageVolumeRepresentation(int, char*[])
+{
+  vtkPVView::SetEnableStreaming(true);
+
+  vtkNew<vtkTestBrickSource> source;
+  vtkNew<vtkTestBrickedRepresentation> repr;
+  repr->SetInputConnection(source->GetOutputPort());
+  repr->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "a");
+  repr->SetBrickSize(16);
+  repr->Update();
+
+  vtkNew<vtkCamera> camera;
+  camera->SetFocalPoint(31.5, 31.5, 31.5);
+  camera->SetPosition(31.5, 31.5, 400);
+  camera->SetClippingRange(1, 1000);
+  const double dataBounds[6] = { 0, 63, 0, 63, 0, 63 };
+  const double zoomedBounds[6] = { 20, 43, 20, 43, 20, 43 };
+
+  bool success = true;
+  source->Extents.clear();
+  int count = repr->StreamAll(camera, dataBounds);
+  success = CheckPass(repr, count, NumberOfBricks, 0, "First pass") && success;
+  if (static_cast<int>(source->Extents.size()) != count)
+  {
+    vtkLogF(ERROR, "Each brick should be a single update of the source.");
+    success = false;
+  }
+  for (const auto& extent : source->Extents)
+  {
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      if (extent[2 * axis] < 0 || extent[2 * axis + 1] > 63 ||
+        extent[2 * axis + 1] - extent[2 * axis] > 16)
+      {
+        vtkLogF(ERROR, "Requested extent [%d, %d] along %d is not a brick.", extent[2 * axis],
+          extent[2 * axis + 1], axis);
+        success = false;
+      }
+    }
+  }
+
+  // zooming in regenerates the resampled volume: the visible bricks are
+  // streamed again from the cache, the others are not requested.
+  camera->Dolly(10);
+  camera->SetClippingRange(1, 1000);
+  source->Extents.clear();
+  count = repr->StreamAll(camera, zoomedBounds);
+  success = CheckPass(repr, count, -1, count, "Camera move") && success;
+  if (count >= NumberOfBricks || !source->Extents.empty())
+  {
+    vtkLogF(ERROR, "Camera move: %d bricks streamed and %d loaded from the source.", count,
+      static_cast<int>(source->Extents.size()));
+    success = false;
+  }
+
+  // selecting another array modifies the representation only.
+  camera->SetPosition(31.5, 31.5, 400);
+  repr->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "b");
+  repr->MarkModified();
+  repr->Update();
+  count = repr->StreamAll(camera, dataBounds);
+  success = CheckPass(repr, count, NumberOfBricks, NumberOfBricks, "Array change") && success;
+
+  source->Modified();
+  repr->MarkModified();
+  repr->Update();
+  count = repr->StreamAll(camera, dataBounds);
+  success = CheckPass(repr, count, NumberOfBricks, 0, "Source change") && success;
+
+  repr->SetBrickSize(32);
+  repr->Update();
+  count = repr->StreamAll(camera, dataBounds);
+  success = CheckPass(repr, count, 8, 0, "Brick size change") && success;
+
+  // the cache only keeps the most recently used bricks that fit in 1 MiB.
+  const vtkTypeInt64 maxCacheSize = 1024 * 1024;
+  repr->SetBrickSize(16);
+  repr->SetCacheSize(1);
+  repr->Update();
+  count = repr->StreamAll(camera, dataBounds);
+  success = CheckPass(repr, count, NumberOfBricks, 0, "Bounded cache") && success;
+  if (repr->GetNumberOfLoadedBytes() <= maxCacheSize || repr->GetCacheMemorySize() <= 0 ||
+    repr->GetCacheMemorySize() > maxCacheSize)
+  {
+    vtkLogF(ERROR, "Bounded cache: %lld bytes cached out of %lld bytes loaded.",
+      static_cast<long long>(repr->GetCacheMemorySize()),
+      static_cast<long long>(repr->GetNumberOfLoadedBytes()));
+    success = false;
+  }
+  camera->Dolly(10);
+  camera->SetClippingRange(1, 1000);
+  count = repr->StreamAll(camera, zoomedBounds);
+  success = CheckPass(repr, count, -1, -1, "Bounded cache after a camera move") && success;
+  if (repr->GetNumberOfLoadedBricks() == 0 || repr->GetCacheMemorySize() > maxCacheSize)
+  {
+    vtkLogF(ERROR, "Evicted bricks should be loaded again, within the cache size.");
+    success = false;
+  }
+
+  repr->SetCacheSize(0);
+  if (repr->GetCacheMemorySize() != 0)
+  {
+    vtkLogF(ERROR, "Disabling the cache should release all the bricks.");
+    success = false;
+  }
+
+  repr->SetInputConnection(nullptr);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
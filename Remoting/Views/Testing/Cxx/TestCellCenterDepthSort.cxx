@@ -0,0 +1,121 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkCamera.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPVCellCenterDepthSort.h"
+
+#include <vector>
+
+#define expect(x, msg)                                                                             \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << __LINE__ << ": " msg << endl;                                                          \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+namespace
+{
+// Traverses all the cells and checks that they are ordered by depth along
+// `dop`, decreasing for back to front.
+bool CheckOrder(vtkPVCellCenterDepthSort* sort, vtkImageData* image, const double dop[3])
+{
+  const vtkIdType numCells = image->GetNumberOfCells();
+  const double sign = sort->GetDirection() == vtkVisibilitySort::BACK_TO_FRONT ? -1.0 : 1.0;
+  std::vector<bool> seen(numCells, false);
+  vtkIdType count = 0;
+  double previous = VTK_DOUBLE_MIN;
+  sort->InitTraversal();
+  while (vtkIdTypeArray* cells = sort->GetNextCells())
+  {
+    for (vtkIdType cc = 0; cc < cells->GetNumberOfTuples(); ++cc)
+    {
+      const vtkIdType cellId = cells->GetValue(cc);
+      if (cellId < 0 || cellId >= numCells || seen[cellId])
+      {
+        return false;
+      }
+      seen[cellId] = true;
+      ++count;
+
+      double bounds[6];
+      image->GetCellBounds(cellId, bounds);
+      const double center[3] = { (bounds[0] + bounds[1]) / 2, (bounds[2] + bounds[3]) / 2,
+        (bounds[4] + bounds[5]) / 2 };
+      const double depth = sign * vtkMath::Dot(center, dop);
+      if (depth < previous - 1e-3)
+      {
+        return false;
+      }
+      previous = depth;
+    }
+  }
+  return count == numCells;
+}
+}
+
+int TestCellCenterDepthSort(int, char*[])
+{
+  // enough cells for several chunks.
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(42, 42, 42);
+  image->SetOrigin(-20.5, -20.5, -20.5);
+
+  vtkNew<vtkCamera> camera;
+  camera->ParallelProjectionOn();
+  camera->SetPosition(47.3, 101.9, 152.1);
+  camera->SetFocalPoint(0, 0, 0);
+
+  vtkNew<vtkPVCellCenterDepthSort> sort;
+  sort->SetInput(image);
+  sort->SetCamera(camera);
+  sort->SetMaxCellsReturned(1000);
+  sort->SetDirectionToBackToFront();
+
+  double dop[3];
+  camera->GetDirectionOfProjection(dop);
+  expect(CheckOrder(sort, image, dop), "Cells are not sorted back to front.");
+  expect(sort->GetLastSortType() == vtkPVCellCenterDepthSort::FULL_SORT, "Expected a full sort.");
+
+  // small camera moves reuse the order.
+  camera->Azimuth(0.1);
+  expect(CheckOrder(sort, image, dop), "Order should be reused.");
+  expect(sort->GetLastSortType() == vtkPVCellCenterDepthSort::REUSED_ORDER,
+    "Expected the order to be reused.");
+
+  // otherwise the previous order is sorted again, which is fast for small moves.
+  sort->SetReuseAngle(0.0);
+  camera->Azimuth(-0.1);
+  camera->Azimuth(0.0005);
+  camera->GetDirectionOfProjection(dop);
+  expect(CheckOrder(sort, image, dop), "Cells are not sorted after a small move.");
+  expect(sort->GetLastSortType() == vtkPVCellCenterDepthSort::INCREMENTAL_SORT,
+    "Expected an incremental sort.");
+
+  // large ones sort from scratch.
+  camera->Azimuth(60);
+  camera->GetDirectionOfProjection(dop);
+  expect(CheckOrder(sort, image, dop), "Cells are not sorted after a large move.");
+  expect(sort->GetLastSortType() == vtkPVCellCenterDepthSort::FULL_SORT, "Expected a full sort.");
+
+  // interactive renders reuse the order when sorting exceeds the budget.
+  sort->SetInteractive(true);
+  sort->SetInteractiveTimeBudget(1e-9);
+  camera->Elevation(30);
+  sort->InitTraversal();
+  expect(sort->GetLastSortType() == vtkPVCellCenterDepthSort::REUSED_ORDER,
+    "Expected the order to be reused while interacting.");
+  sort->SetInteractive(false);
+  camera->GetDirectionOfProjection(dop);
+  expect(CheckOrder(sort, image, dop), "Cells are not sorted after interaction.");
+  expect(sort->GetLastSortType() != vtkPVCellCenterDepthSort::REUSED_ORDER,
+    "Still renders should sort.");
+
+  sort->SetDirectionToFrontToBack();
+  expect(CheckOrder(sort, image, dop), "Cells are not sorted front to back.");
+  expect(sort->GetLastSortType() == vtkPVCellCenterDepthSort::FULL_SORT, "Expected a full sort.");
+  return EXIT_SUCCESS;
+}
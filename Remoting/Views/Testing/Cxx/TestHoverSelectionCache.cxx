@@ -0,0 +1,149 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Checks that hover selections are answered from the cached selection buffers
+// without rendering, including after the preselection highlight changed, and
+// that the buffers are captured again after a camera or a data change.
+
+#include "vtkCamera.h"
+#include "vtkCollection.h"
+#include "vtkCommand.h"
+#include "vtkInitializationHelper.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPVRenderView.h"
+#include "vtkPVRenderViewSettings.h"
+#include "vtkProcessModule.h"
+#include "vtkRenderWindow.h"
+#include "vtkSMParaViewPipelineControllerWithRendering.h"
+#include "vtkSMPropertyHelper.h"
+#include "vtkSMRenderViewProxy.h"
+#include "vtkSMSession.h"
+#include "vtkSMSessionProxyManager.h"
+#include "vtkSMSourceProxy.h"
+#include "vtkSmartPointer.h"
+
+#include <vector>
+
+namespace
+{
+struct RenderCounter
+{
+  int Renders = 0;
+  void Count() { ++this->Renders; }
+};
+
+// Selects the cell under (x, y) as a hover query does and returns the number
+// of renders it took, or -1 if nothing was selected.
+int Hover(vtkSMRenderViewProxy* view, RenderCounter& counter, int x, int y,
+  vtkSmartPointer<vtkSMSourceProxy>* selectionSource = nullptr)
+{
+  vtkNew<vtkCollection> representations;
+  vtkNew<vtkCollection> sources;
+  const int region[4] = { x, y, x, y };
+  counter.Renders = 0;
+  if (!view->SelectSurfaceCells(region, representations, sources) ||
+    sources->GetNumberOfItems() == 0)
+  {
+    return -1;
+  }
+  if (selectionSource)
+  {
+    *selectionSource = vtkSMSourceProxy::SafeDownCast(sources->GetItemAsObject(0));
+  }
+  return counter.Renders;
+}
+}
+
+int TestHoverSelectionCache(int, char* argv[])
+{
+  vtkInitializationHelper::SetApplicationName("TestHoverSelectionCache");
+  vtkInitializationHelper::SetOrganizationName("Humanity");
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+  vtkPVRenderViewSettings::GetInstance()->SetEnableHoverSelectionCache(true);
+  vtkPVRenderViewSettings::GetInstance()->SetEnableFastPreselection(true);
+
+  vtkNew<vtkSMParaViewPipelineControllerWithRendering> controller;
+  vtkNew<vtkSMSession> session;
+  vtkProcessModule::GetProcessModule()->RegisterSession(session);
+  controller->InitializeSession(session);
+  vtkSMSessionProxyManager* pxm = session->GetSessionProxyManager();
+
+  vtkSmartPointer<vtkSMRenderViewProxy> view;
+  view.TakeReference(vtkSMRenderViewProxy::SafeDownCast(pxm->NewProxy("views", "RenderView")));
+  controller->InitializeProxy(view);
+  vtkSMPropertyHelper(view, "ViewSize").Set(std::vector<int>({ 300, 300 }).data(), 2);
+  view->UpdateVTKObjects();
+  controller->RegisterViewProxy(view);
+
+  vtkSmartPointer<vtkSMSourceProxy> sphere;
+  sphere.TakeReference(vtkSMSourceProxy::SafeDownCast(pxm->NewProxy("sources", "SphereSource")));
+  controller->InitializeProxy(sphere);
+  sphere->UpdateVTKObjects();
+  controller->RegisterPipelineProxy(sphere);
+  vtkSMProxy* representation = controller->Show(sphere, 0, view);
+  view->ResetCamera();
+  view->StillRender();
+
+  vtkSMPropertyHelper(view, "InteractionMode").Set(vtkPVRenderView::INTERACTION_MODE_SELECTION);
+  view->UpdateVTKObjects();
+
+  RenderCounter counter;
+  view->GetRenderWindow()->AddObserver(vtkCommand::StartEvent, &counter, &RenderCounter::Count);
+
+  bool success = true;
+  // the first hover captures the buffers.
+  vtkSmartPointer<vtkSMSourceProxy> selection;
+  if (Hover(view, counter, 150, 150, &selection) <= 0)
+  {
+    vtkLogF(ERROR, "The first hover should render the selection buffers.");
+    success = false;
+  }
+
+  // highlight the hovered cell as the fast preselection does, then hover
+  // again: the highlight must not invalidate the buffers.
+  if (selection)
+  {
+    vtkSMPropertyHelper(representation, "Selection").Set(selection);
+    representation->UpdateVTKObjects();
+    view->StillRender();
+  }
+  const int hoverRenders = Hover(view, counter, 152, 149);
+  if (hoverRenders != 0)
+  {
+    vtkLogF(ERROR, "A repeated hover should be a cache hit, got %d renders.", hoverRenders);
+    success = false;
+  }
+
+  // the camera is changed on the client only, as the proxy would not notice.
+  view->GetActiveCamera()->Azimuth(30);
+  if (Hover(view, counter, 150, 150) <= 0)
+  {
+    vtkLogF(ERROR, "The buffers should be captured again after a camera change.");
+    success = false;
+  }
+  if (Hover(view, counter, 151, 150) != 0)
+  {
+    vtkLogF(ERROR, "A hover after the new capture should be a cache hit.");
+    success = false;
+  }
+
+  vtkSMPropertyHelper(sphere, "ThetaResolution").Set(16);
+  sphere->UpdateVTKObjects();
+  view->StillRender();
+  if (Hover(view, counter, 150, 150) <= 0)
+  {
+    vtkLogF(ERROR, "The buffers should be captured again after a data change.");
+    success = false;
+  }
+
+  view->GetRenderWindow()->RemoveObservers(vtkCommand::StartEvent);
+  controller->UnRegisterProxy(sphere);
+  controller->UnRegisterProxy(view);
+  selection = nullptr;
+  sphere = nullptr;
+  view = nullptr;
+  vtkProcessModule::GetProcessModule()->UnRegisterSession(session);
+  vtkInitializationHelper::Finalize();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,214 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Checks the compositing of small spheres, one per rank, covering a corner of
+// the screen with an image reduction factor of 2: IceT only reads back the
+// region of each rank and the composited depths are only pushed back to the
+// screen over the region covered by the spheres.
+
+#include "vtkActor.h"
+#include "vtkCamera.h"
+#include "vtkCameraPass.h"
+#include "vtkCullerCollection.h"
+#include "vtkFloatArray.h"
+#include "vtkIceTCompositePass.h"
+#include "vtkLightsPass.h"
+#include "vtkLogger.h"
+#include "vtkMPIController.h"
+#include "vtkNew.h"
+#include "vtkOpaquePass.h"
+#include "vtkPolyDataMapper.h"
+#include "vtkRenderPassCollection.h"
+#include "vtkRenderWindow.h"
+#include "vtkRenderer.h"
+#include "vtkSequencePass.h"
+#include "vtkSphereSource.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+constexpr int ReductionFactor = 2;
+// the reduced image is 151x150 pixels, which are not an integer number of
+// screen pixels apart.
+constexpr int ScreenWidth = 302;
+constexpr int ScreenHeight = 300;
+constexpr int Width = ScreenWidth / ReductionFactor;
+constexpr int Height = ScreenHeight / ReductionFactor;
+
+// Adds the sphere of `rank`. The spheres overlap their neighbors.
+void AddSphere(vtkRenderer* renderer, int rank)
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetCenter(-0.8 + 0.2 * rank, -0.6 + 0.1 * rank, 0.2 * rank);
+  sphere->SetRadius(0.15);
+  sphere->SetThetaResolution(32);
+  sphere->SetPhiResolution(32);
+  vtkNew<vtkPolyDataMapper> mapper;
+  mapper->SetInputConnection(sphere->GetOutputPort());
+  vtkNew<vtkActor> actor;
+  actor->SetMapper(mapper);
+  renderer->AddActor(actor);
+}
+
+// The same camera on all ranks, not reset to the local bounds.
+void SetupCamera(vtkRenderer* renderer)
+{
+  vtkCamera* camera = renderer->GetActiveCamera();
+  camera->SetPosition(0, 0, 5);
+  camera->SetFocalPoint(0, 0, 0);
+  camera->SetViewUp(0, 1, 0);
+  camera->SetClippingRange(3, 7);
+}
+
+// Checks that the composited depths are the ones of all the spheres rendered
+// at the reduced size, but for a few pixels along their silhouettes.
+bool CheckCompositedDepths(vtkFloatArray* depths, vtkFloatArray* expected)
+{
+  vtkIdType covered = 0;
+  vtkIdType differing = 0;
+  for (vtkIdType cc = 0; cc < expected->GetNumberOfTuples(); ++cc)
+  {
+    covered += expected->GetValue(cc) < 1.0f ? 1 : 0;
+    differing += std::abs(depths->GetValue(cc) - expected->GetValue(cc)) > 1e-4f ? 1 : 0;
+  }
+  const vtkIdType numPixels = expected->GetNumberOfTuples();
+  if (covered == 0 || covered > numPixels / 10)
+  {
+    vtkLogF(ERROR, "The spheres cover %lld of %lld pixels instead of a small part.",
+      static_cast<long long>(covered), static_cast<long long>(numPixels));
+    return false;
+  }
+  if (differing > numPixels / 500)
+  {
+    vtkLogF(ERROR, "%lld of %lld composited depths differ from the rendered ones.",
+      static_cast<long long>(differing), static_cast<long long>(numPixels));
+    return false;
+  }
+  return true;
+}
+
+// Checks that the depths on the screen are the composited ones drawn as
+// vtkTextureObject::CopyToFrameBuffer draws a whole image, with the centers of
+// its end pixels on the borders of the screen. Screen pixels sampling close to
+// the border of two composited pixels may get either.
+bool CheckScreenDepths(vtkFloatArray* depths, vtkFloatArray* screen)
+{
+  auto sample = [](int pixel, int size, int screenSize, double offset) {
+    const double source = 0.5 + (pixel + 0.5) * (size - 1) / screenSize + offset;
+    return std::max(0, std::min(size - 1, static_cast<int>(std::floor(source))));
+  };
+  for (int y = 0; y < ScreenHeight; ++y)
+  {
+    for (int x = 0; x < ScreenWidth; ++x)
+    {
+      const float depth = screen->GetValue(static_cast<vtkIdType>(y) * ScreenWidth + x);
+      bool found = false;
+      for (double dy : { -1e-3, 1e-3 })
+      {
+        for (double dx : { -1e-3, 1e-3 })
+        {
+          const vtkIdType row = sample(y, Height, ScreenHeight, dy);
+          const vtkIdType index = row * Width + sample(x, Width, ScreenWidth, dx);
+          found = found || std::abs(depth - depths->GetValue(index)) <= 1e-4f;
+        }
+      }
+      if (!found)
+      {
+        vtkLogF(ERROR, "Screen depth %g at (%d, %d) is not a composited depth.", depth, x, y);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Renders the spheres of all ranks and checks the depths on rank 0. The IceT
+// context must be released before MPI is finalized.
+bool Render(vtkMultiProcessController* controller)
+{
+  const int rank = controller->GetLocalProcessId();
+  const int numProcs = controller->GetNumberOfProcesses();
+
+  vtkNew<vtkRenderWindow> window;
+  window->SetOffScreenRendering(true);
+  window->SetMultiSamples(0);
+  window->SetSize(ScreenWidth, ScreenHeight);
+  vtkNew<vtkRenderer> renderer;
+  window->AddRenderer(renderer);
+  AddSphere(renderer, rank);
+  SetupCamera(renderer);
+  // as vtkIceTSynchronizedRenderers, IceT culls the props itself.
+  renderer->GetCullers()->RemoveAllItems();
+
+  vtkNew<vtkLightsPass> lights;
+  vtkNew<vtkOpaquePass> opaque;
+  vtkNew<vtkRenderPassCollection> passes;
+  passes->AddItem(lights);
+  passes->AddItem(opaque);
+  vtkNew<vtkSequencePass> sequence;
+  sequence->SetPasses(passes);
+
+  vtkNew<vtkIceTCompositePass> iceTPass;
+  iceTPass->SetController(controller);
+  iceTPass->SetRenderPass(sequence);
+  iceTPass->SetImageReductionFactor(ReductionFactor);
+  iceTPass->SetDisplayDepthResults(true);
+  vtkNew<vtkCameraPass> cameraPass;
+  cameraPass->SetDelegatePass(iceTPass);
+  renderer->SetPass(cameraPass);
+
+  // all ranks render together.
+  window->Render();
+
+  bool success = true;
+  if (rank == 0)
+  {
+    vtkFloatArray* depths = iceTPass->GetLastRenderedDepths();
+    if (!depths || depths->GetNumberOfTuples() != Width * Height)
+    {
+      vtkLogF(ERROR, "Missing or unexpected composited depths.");
+      success = false;
+    }
+    else
+    {
+      vtkNew<vtkFloatArray> screen;
+      window->GetZbufferData(0, 0, ScreenWidth - 1, ScreenHeight - 1, screen);
+      success = CheckScreenDepths(depths, screen);
+
+      // all the spheres, rendered without IceT at the reduced size.
+      vtkNew<vtkRenderWindow> expectedWindow;
+      expectedWindow->SetOffScreenRendering(true);
+      expectedWindow->SetMultiSamples(0);
+      expectedWindow->SetSize(Width, Height);
+      vtkNew<vtkRenderer> expectedRenderer;
+      expectedWindow->AddRenderer(expectedRenderer);
+      for (int cc = 0; cc < numProcs; ++cc)
+      {
+        AddSphere(expectedRenderer, cc);
+      }
+      SetupCamera(expectedRenderer);
+      expectedWindow->Render();
+      vtkNew<vtkFloatArray> expected;
+      expectedWindow->GetZbufferData(0, 0, Width - 1, Height - 1, expected);
+      success = CheckCompositedDepths(depths, expected) && success;
+    }
+  }
+  return success;
+}
+}
+
+int TestIceTCompositePassSparseRegions(int argc, char* argv[])
+{
+  vtkNew<vtkMPIController> controller;
+  controller->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(controller);
+
+  int allSuccess = 0;
+  int localSuccess = Render(controller) ? 1 : 0;
+  controller->AllReduce(&localSuccess, &allSuccess, 1, vtkCommunicator::LOGICAL_AND_OP);
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  controller->Finalize();
+  return allSuccess ? EXIT_SUCCESS : EXIT_FAILURE;
+}
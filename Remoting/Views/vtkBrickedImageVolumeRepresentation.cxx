@@ -0,0 +1,722 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkBrickedImageVolumeRepresentation.h"
+
+#include "vtkAMRVolumeMapper.h"
+#include "vtkCellData.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMath.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVLODVolume.h"
+#include "vtkPVLogger.h"
+#include "vtkPVRenderView.h"
+#include "vtkPVStreamingMacros.h"
+#include "vtkPointData.h"
+#include "vtkRenderWindow.h"
+#include "vtkRenderer.h"
+#include "vtkResampledBrickImageSource.h"
+#include "vtkSmartVolumeMapper.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkStreamingPriorityQueue.h"
+#include "vtkVolumeProperty.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <list>
+#include <map>
+
+//*****************************************************************************
+class vtkBrickedImageVolumeRepresentation::vtkInternals
+{
+public:
+  vtkStreamingPriorityQueue<> PriorityQueue;
+  int NumberOfBricks[3] = { 0, 0, 0 };
+
+  // bricks in the cache, least recently used first.
+  std::list<unsigned int> LRU;
+  struct CacheItem
+  {
+    vtkSmartPointer<vtkImageData> Brick;
+    vtkTypeInt64 Size;
+    std::list<unsigned int>::iterator Position;
+  };
+  std::map<unsigned int, CacheItem> Cache;
+  vtkTypeInt64 CacheMemorySize = 0;
+
+  // input and brick size the cached bricks were loaded for.
+  vtkMTimeType InputPipelineMTime = 0;
+  bool HasInputTime = false;
+  double InputTime = 0.0;
+  int CachedBrickSize = 0;
+
+  // resampler parameters the bricks were last streamed for.
+  int MaxDimensions[3] = { 0, 0, 0 };
+  double SpatialBounds[6] = { 0, 0, 0, 0, 0, 0 };
+
+  // The resampler is also modified when initialized on the rendering nodes,
+  // so its parameters are compared rather than its MTime.
+  bool ResamplerChanged(vtkResampledBrickImageSource* resampler) const
+  {
+    return !std::equal(this->MaxDimensions, this->MaxDimensions + 3,
+             resampler->GetMaxDimensions()) ||
+      !std::equal(this->SpatialBounds, this->SpatialBounds + 6, resampler->GetSpatialBounds());
+  }
+
+  void GetBrickExtent(unsigned int id, const int wholeExtent[6], int brickSize, int extent[6]) const
+  {
+    const int ijk[3] = { static_cast<int>(id % this->NumberOfBricks[0]),
+      static_cast<int>((id / this->NumberOfBricks[0]) % this->NumberOfBricks[1]),
+      static_cast<int>(id / (this->NumberOfBricks[0] * this->NumberOfBricks[1])) };
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      // neighboring bricks share their boundary points.
+      extent[2 * axis] = wholeExtent[2 * axis] + ijk[axis] * brickSize;
+      extent[2 * axis + 1] = std::min(extent[2 * axis] + brickSize, wholeExtent[2 * axis + 1]);
+    }
+  }
+
+  vtkImageData* FindBrick(unsigned int id)
+  {
+    auto iter = this->Cache.find(id);
+    if (iter == this->Cache.end())
+    {
+      return nullptr;
+    }
+    this->LRU.splice(this->LRU.end(), this->LRU, iter->second.Position);
+    return iter->second.Brick;
+  }
+
+  void AddBrick(unsigned int id, vtkImageData* brick, vtkTypeInt64 size, vtkTypeInt64 maxSize)
+  {
+    this->RemoveBrick(id);
+    if (size > maxSize)
+    {
+      return;
+    }
+    this->LRU.push_back(id);
+    this->Cache[id] = CacheItem{ brick, size, std::prev(this->LRU.end()) };
+    this->CacheMemorySize += size;
+    this->Trim(maxSize);
+  }
+
+  void RemoveBrick(unsigned int id)
+  {
+    auto iter = this->Cache.find(id);
+    if (iter != this->Cache.end())
+    {
+      this->CacheMemorySize -= iter->second.Size;
+      this->LRU.erase(iter->second.Position);
+      this->Cache.erase(iter);
+    }
+  }
+
+  void Trim(vtkTypeInt64 maxSize)
+  {
+    while (this->CacheMemorySize > maxSize && !this->LRU.empty())
+    {
+      auto iter = this->Cache.find(this->LRU.front());
+      this->CacheMemorySize -= iter->second.Size;
+      this->Cache.erase(iter);
+      this->LRU.pop_front();
+    }
+  }
+
+  void ClearCache()
+  {
+    this->LRU.clear();
+    this->Cache.clear();
+    this->CacheMemorySize = 0;
+  }
+
+  // Records the input and brick size the bricks are loaded for, returning
+  // true if they changed since the cache was filled.
+  bool InputChanged(vtkMTimeType pipelineMTime, bool hasTime, double time, int brickSize)
+  {
+    const bool changed = pipelineMTime == 0 || pipelineMTime != this->InputPipelineMTime ||
+      hasTime != this->HasInputTime || (hasTime && time != this->InputTime) ||
+      brickSize != this->CachedBrickSize;
+    this->InputPipelineMTime = pipelineMTime;
+    this->HasInputTime = hasTime;
+    this->InputTime = time;
+    this->CachedBrickSize = brickSize;
+    return changed;
+  }
+};
+
+vtkStandardNewMacro(vtkBrickedImageVolumeRepresentation);
+//----------------------------------------------------------------------------
+vtkBrickedImageVolumeRepresentation::vtkBrickedImageVolumeRepresentation()
+  : Internals(new vtkBrickedImageVolumeRepresentation::vtkInternals())
+{
+  this->Resampler = vtkSmartPointer<vtkResampledBrickImageSource>::New();
+
+  this->VolumeMapper = vtkSmartPointer<vtkSmartVolumeMapper>::New();
+  this->VolumeMapper->SetInputConnection(this->Resampler->GetOutputPort());
+
+  this->Property = vtkSmartPointer<vtkVolumeProperty>::New();
+  this->Actor = vtkSmartPointer<vtkPVLODVolume>::New();
+  this->Actor->SetProperty(this->Property);
+  this->Actor->SetMapper(this->VolumeMapper);
+}
+
+//----------------------------------------------------------------------------
+vtkBrickedImageVolumeRepresentation::~vtkBrickedImageVolumeRepresentation() = default;
+
+//----------------------------------------------------------------------------
+void vtkBrickedImageVolumeRepresentation::SetResamplingMode(int val)
+{
+  if (val != this->ResamplingMode && val >= RESAMPLE_OVER_DATA_BOUNDS &&
+    val <= RESAMPLE_USING_VIEW_FRUSTUM)
+  {
+    this->ResamplingMode = val;
+    // the resampled volume is regenerated, reusing the cached bricks.
+    this->Resampler->Reset();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkBrickedImageVolumeRepresentation::SetBrickSize(int val)
+{
+  val = std::max(val, 1);
+  if (val != this->BrickSize)
+  {
+    this->BrickSize = val;
+    // the cached bricks no longer match, restart the streaming.
+    this->MarkModified();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkBrickedImageVolumeRepresentation::SetCacheSize(int val)
+{
+  this->CacheSize = std::max(val, 0);
+  this->Internals->Trim(static_cast<vtkTypeInt64>(this->CacheSize) * 1024 * 1024);
+}
+
+//----------------------------------------------------------------------------
+vtkTypeInt64 vtkBrickedImageVolumeRepresentation::GetCacheMemorySize() const
+{
+  return this->Internals->CacheMemorySize;
+}
+
+//----------------------------------------------------------------------------
+int vtkBrickedImageVolumeRepresentation::FillInputPortInformation(
+  int vtkNotUsed(port), vtkInformation* info)
+{
+  info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkImageData");
+  info->Set(vtkAlgorithm::INPUT_IS_OPTIONAL(), 1);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkBrickedImageVolumeRepresentation::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "ResamplingMode: ";
+  switch (this->ResamplingMode)
+  {
+    case RESAMPLE_OVER_DATA_BOUNDS:
+      os << "RESAMPLE_OVER_DATA_BOUNDS" << endl;
+      break;
+
+    case RESAMPLE_USING_VIEW_FRUSTUM:
+      os << "RESAMPLE_USING_VIEW_FRUSTUM" << endl;
+      break;
+
+    default:
+      os << "(invalid)" << endl;
+  }
+  os << indent << "BrickSize: " << this->BrickSize << endl;
+  os << indent << "CacheSize: " << this->CacheSize << endl;
+  os << indent << "NumberOfCacheHits: " << this->NumberOfCacheHits << endl;
+  os << indent << "NumberOfLoadedBricks: " << this->NumberOfLoadedBricks << endl;
+  os << indent << "NumberOfLoadedBytes: " << this->NumberOfLoadedBytes << endl;
+}
+
+//----------------------------------------------------------------------------
+int vtkBrickedImageVolumeRepresentation::ProcessViewRequest(
+  vtkInformationRequestKey* request_type, vtkInformation* inInfo, vtkInformation* outInfo)
+{
+  if (!this->Superclass::ProcessViewRequest(request_type, inInfo, outInfo))
+  {
+    return 0;
+  }
+
+  if (request_type == vtkPVView::REQUEST_UPDATE())
+  {
+    vtkPVRenderView::SetPiece(inInfo, this, this->ProcessedData);
+
+    double bounds[6];
+    this->DataBounds.GetBounds(bounds);
+    vtkPVRenderView::SetGeometryBounds(inInfo, this, bounds);
+
+    vtkPVRenderView::SetStreamable(inInfo, this, this->StreamingCapablePipeline);
+
+    // FIXME: like vtkAMRStreamingVolumeRepresentation, parallel volume
+    // rendering is not supported.
+  }
+  else if (request_type == vtkPVRenderView::REQUEST_STREAMING_UPDATE())
+  {
+    if (this->StreamingCapablePipeline)
+    {
+      double view_planes[24];
+      inInfo->Get(vtkPVRenderView::VIEW_PLANES(), view_planes);
+      vtkPVRenderView* view = vtkPVRenderView::SafeDownCast(inInfo->Get(vtkPVRenderView::VIEW()));
+      if (this->StreamingUpdate(view, view_planes))
+      {
+        vtkPVRenderView::SetNextStreamedPiece(inInfo, this, this->ProcessedPiece);
+      }
+    }
+  }
+  else if (request_type == vtkPVView::REQUEST_RENDER() ||
+    request_type == vtkPVRenderView::REQUEST_PROCESS_STREAMED_PIECE())
+  {
+    if (this->Resampler->NeedsInitialization())
+    {
+      // the delivered piece has the whole extent, origin and spacing of the
+      // image. Unless the pipeline is not streaming capable, it has no arrays.
+      vtkImageData* image = vtkImageData::SafeDownCast(vtkPVView::GetDeliveredPiece(inInfo, this));
+      if (image)
+      {
+        int extent[6];
+        image->GetExtent(extent);
+        if (this->Resampler->Initialize(extent, image->GetOrigin(), image->GetSpacing()) &&
+          (image->GetPointData()->GetNumberOfArrays() > 0 ||
+            image->GetCellData()->GetNumberOfArrays() > 0))
+        {
+          this->Resampler->AddBrick(image);
+        }
+      }
+    }
+
+    if (request_type == vtkPVRenderView::REQUEST_PROCESS_STREAMED_PIECE())
+    {
+      vtkImageData* brick =
+        vtkImageData::SafeDownCast(vtkPVRenderView::GetCurrentStreamedPiece(inInfo, this));
+      if (brick)
+      {
+        this->Resampler->AddBrick(brick);
+      }
+    }
+  }
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkBrickedImageVolumeRepresentation::RequestInformation(
+  vtkInformation* rqst, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  // A pipeline is streaming capable if it tells us the whole extent, origin
+  // and spacing of the image in the RequestInformation() pass, which lets us
+  // request arbitrary bricks as update extents.
+  this->StreamingCapablePipeline = false;
+  if (inputVector[0]->GetNumberOfInformationObjects() == 1)
+  {
+    vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+    if (inInfo->Has(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT()) &&
+      inInfo->Has(vtkDataObject::ORIGIN()) && inInfo->Has(vtkDataObject::SPACING()) &&
+      vtkPVView::GetEnableStreaming())
+    {
+      inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), this->WholeExtent);
+      inInfo->Get(vtkDataObject::ORIGIN(), this->DataOrigin);
+      inInfo->Get(vtkDataObject::SPACING(), this->DataSpacing);
+      this->StreamingCapablePipeline = true;
+    }
+  }
+
+  vtkStreamingStatusMacro(<< this << ": streaming capable input pipeline? "
+                          << (this->StreamingCapablePipeline ? "yes" : "no"));
+  return this->Superclass::RequestInformation(rqst, inputVector, outputVector);
+}
+
+//----------------------------------------------------------------------------
+int vtkBrickedImageVolumeRepresentation::RequestUpdateExtent(
+  vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  if (!this->Superclass::RequestUpdateExtent(request, inputVector, outputVector))
+  {
+    return 0;
+  }
+
+  if (!this->StreamingCapablePipeline)
+  {
+    return 1;
+  }
+
+  for (int cc = 0; cc < this->GetNumberOfInputPorts(); cc++)
+  {
+    for (int kk = 0; kk < inputVector[cc]->GetNumberOfInformationObjects(); kk++)
+    {
+      vtkInformation* info = inputVector[cc]->GetInformationObject(kk);
+      if (this->InStreamingUpdate)
+      {
+        info->Set(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), this->RequestedExtent, 6);
+      }
+      else
+      {
+        // the bricks are streamed afterwards, only read a single point.
+        const int* wext = this->WholeExtent;
+        const int extent[6] = { wext[0], wext[0], wext[2], wext[2], wext[4], wext[4] };
+        info->Set(vtkStreamingDemandDrivenPipeline::UPDATE_EXTENT(), extent, 6);
+      }
+      info->Set(vtkStreamingDemandDrivenPipeline::EXACT_EXTENT(), 1);
+    }
+  }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkBrickedImageVolumeRepresentation::RequestData(
+  vtkInformation* rqst, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  this->ProcessedPiece = nullptr;
+  vtkMTimeType inputPipelineMTime = 0;
+  bool hasInputTime = false;
+  double inputTime = 0.0;
+  if (inputVector[0]->GetNumberOfInformationObjects() == 1)
+  {
+    // To keep things simple here, we don't bother about the "flip-book" caching
+    // support used for animation playback.
+    vtkImageData* input = vtkImageData::GetData(inputVector[0], 0);
+    auto executive =
+      vtkStreamingDemandDrivenPipeline::SafeDownCast(this->GetInputAlgorithm(0, 0)->GetExecutive());
+    inputPipelineMTime = executive ? executive->GetPipelineMTime() : 0;
+    hasInputTime = input && input->GetInformation()->Has(vtkDataObject::DATA_TIME_STEP());
+    inputTime = hasInputTime ? input->GetInformation()->Get(vtkDataObject::DATA_TIME_STEP()) : 0.0;
+    if (this->InStreamingUpdate)
+    {
+      auto brick = vtkSmartPointer<vtkImageData>::New();
+      brick->ShallowCopy(input);
+      this->ProcessedPiece = brick;
+    }
+    else
+    {
+      auto image = vtkSmartPointer<vtkImageData>::New();
+      if (this->StreamingCapablePipeline)
+      {
+        image->SetExtent(this->WholeExtent);
+        image->SetOrigin(this->DataOrigin);
+        image->SetSpacing(this->DataSpacing);
+      }
+      else
+      {
+        image->ShallowCopy(input);
+      }
+      this->ProcessedData = image;
+
+      double bounds[6];
+      image->GetBounds(bounds);
+      this->DataBounds.SetBounds(bounds);
+    }
+  }
+  else
+  {
+    // create an empty dataset. This is needed so that view knows what dataset
+    // to expect from the other processes on this node.
+    this->ProcessedData = vtkSmartPointer<vtkImageData>::New();
+    this->DataBounds.Reset();
+  }
+
+  if (!this->InStreamingUpdate)
+  {
+    // the cached bricks are stale when the input or the brick size changed,
+    // not when only the representation was modified, e.g. to select another
+    // array.
+    if (this->Internals->InputChanged(
+          inputPipelineMTime, hasInputTime, inputTime, this->BrickSize))
+    {
+      this->Internals->ClearCache();
+    }
+    this->Resampler->Reset();
+    this->InitializeBricks();
+  }
+
+  return this->Superclass::RequestData(rqst, inputVector, outputVector);
+}
+
+//----------------------------------------------------------------------------
+void vtkBrickedImageVolumeRepresentation::InitializeBricks()
+{
+  auto& internals = *this->Internals;
+  internals.PriorityQueue = vtkStreamingPriorityQueue<>();
+  std::copy_n(this->Resampler->GetMaxDimensions(), 3, internals.MaxDimensions);
+  std::copy_n(this->Resampler->GetSpatialBounds(), 6, internals.SpatialBounds);
+  this->NumberOfCacheHits = 0;
+  this->NumberOfLoadedBricks = 0;
+  this->NumberOfLoadedBytes = 0;
+  if (!this->StreamingCapablePipeline)
+  {
+    return;
+  }
+
+  unsigned int numberOfBricks = 1;
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    const int cells = this->WholeExtent[2 * axis + 1] - this->WholeExtent[2 * axis];
+    if (cells < 0)
+    {
+      return;
+    }
+    internals.NumberOfBricks[axis] = std::max(1, (cells + this->BrickSize - 1) / this->BrickSize);
+    numberOfBricks *= internals.NumberOfBricks[axis];
+  }
+
+  for (unsigned int id = 0; id < numberOfBricks; ++id)
+  {
+    int extent[6];
+    internals.GetBrickExtent(id, this->WholeExtent, this->BrickSize, extent);
+
+    double bounds[6];
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      const double lo = this->DataOrigin[axis] + extent[2 * axis] * this->DataSpacing[axis];
+      const double hi = this->DataOrigin[axis] + extent[2 * axis + 1] * this->DataSpacing[axis];
+      bounds[2 * axis] = std::min(lo, hi);
+      bounds[2 * axis + 1] = std::max(lo, hi);
+    }
+
+    vtkStreamingPriorityQueueItem item;
+    item.Identifier = id;
+    item.Bounds.SetBounds(bounds);
+    internals.PriorityQueue.push(item);
+  }
+  vtkStreamingStatusMacro(<< this << ": initialized " << numberOfBricks << " bricks.");
+}
+
+//----------------------------------------------------------------------------
+bool vtkBrickedImageVolumeRepresentation::StreamingUpdate(
+  vtkPVRenderView* view, const double view_planes[24])
+{
+  assert(this->InStreamingUpdate == false);
+  auto& internals = *this->Internals;
+
+  if (this->ResamplingMode == RESAMPLE_USING_VIEW_FRUSTUM && view &&
+    view->GetRenderWindow()->GetDesiredUpdateRate() < 1)
+  {
+    double data_bounds[6];
+    this->DataBounds.GetBounds(data_bounds);
+
+    double bounds[6];
+    if (vtkAMRVolumeMapper::ComputeResamplerBoundsFrustumMethod(
+          view->GetActiveCamera(), view->GetRenderer(), data_bounds, bounds))
+    {
+      this->Resampler->SetSpatialBounds(bounds);
+    }
+  }
+
+  // if the resampled volume is to be regenerated, all the bricks it covers
+  // are streamed again, hopefully from the cache.
+  if (internals.ResamplerChanged(this->Resampler))
+  {
+    vtkStreamingStatusMacro(<< this << ": reinitializing priority queue.");
+    this->InitializeBricks();
+  }
+
+  // bricks outside of the view frustum get a null priority. We don't clamp
+  // to the resampler bounds since the frustum is tighter anyway.
+  double clamp_bounds[6];
+  vtkMath::UninitializeBounds(clamp_bounds);
+  internals.PriorityQueue.UpdatePriorities(view_planes, clamp_bounds);
+  if (internals.PriorityQueue.empty() || internals.PriorityQueue.top().Priority <= 0)
+  {
+    return false;
+  }
+
+  const unsigned int id = internals.PriorityQueue.top().Identifier;
+  internals.PriorityQueue.pop();
+
+  this->InStreamingUpdate = true;
+  const vtkTypeInt64 maxCacheSize = static_cast<vtkTypeInt64>(this->CacheSize) * 1024 * 1024;
+  bool cacheHit = false;
+  vtkImageData* cached = internals.FindBrick(id);
+  const char* arrayName = this->VolumeMapper->GetArrayName();
+  if (cached && arrayName && *arrayName && !cached->GetPointData()->GetAbstractArray(arrayName) &&
+    !cached->GetCellData()->GetAbstractArray(arrayName))
+  {
+    // the brick was loaded before the array was requested, e.g. a component
+    // computed upstream on demand.
+    cached = nullptr;
+  }
+  if (cached)
+  {
+    this->ProcessedPiece = cached;
+    this->NumberOfCacheHits++;
+    cacheHit = true;
+  }
+  else
+  {
+    internals.GetBrickExtent(id, this->WholeExtent, this->BrickSize, this->RequestedExtent);
+    this->MarkModified();
+    this->Update();
+
+    if (vtkImageData* brick = vtkImageData::SafeDownCast(this->ProcessedPiece))
+    {
+      const vtkTypeInt64 size = static_cast<vtkTypeInt64>(brick->GetActualMemorySize()) * 1024;
+      this->NumberOfLoadedBricks++;
+      this->NumberOfLoadedBytes += size;
+      internals.AddBrick(id, brick, size, maxCacheSize);
+    }
+  }
+  this->InStreamingUpdate = false;
+
+  vtkVLogF(PARAVIEW_LOG_RENDERING_VERBOSITY(),
+    "%s: brick %u %s (%d cache hits, %d bricks loaded, %lld bytes loaded, %lld bytes cached)",
+    this->GetLogName().c_str(), id, cacheHit ? "from cache" : "loaded", this->NumberOfCacheHits,
+    this->NumberOfLoadedBricks, static_cast<long long>(this->NumberOfLoadedBytes),
+    static_cast<long long>(internals.CacheMemorySize));
+  return this->ProcessedPiece != nullptr;
+}
+
+//----------------------------------------------------------------------------
+bool vtkBrickedImageVolumeRepresentation::AddToView(vtkView* view)
+{
+  vtkPVRenderView* rview = vtkPVRenderView::SafeDownCast(view);
+  if (rview)
+  {
+    rview->GetRenderer()->AddActor(this->Actor);
+    return this->Superclass::AddToView(rview);
+  }
+  return false;
+}
+
+//----------------------------------------------------------------------------
+bool vtkBrickedImageVolumeRepresentation::RemoveFromView(vtkView* view)
+{
+  vtkPVRenderView* rview = vtkPVRenderView::SafeDownCast(view);
+  if (rview)
+  {
+    rview->GetRenderer()->RemoveActor(this->Actor);
+    return this->Superclass::RemoveFromView(rview);
+  }
+  return false;
+}
+
+//***************************************************************************
+// Forwarded to Actor.
+
+//----------------------------------------------------------------------------
+void vtkBrickedImageVolumeRepresentation::SetOrientation(double x, double y, double z)
+{
+  this->Actor->SetOrientation(x, y, z);
+}
+
+//----------------------------------------------------------------------------
+void vtkBrickedImageVolumeRepresentation::SetOrigin(double x, double y, double z)
+{
+  this->Actor->SetOrigin(x, y, z);
+}
+
+//----------------------------------------------------------------------------
+void vtkBrickedImageVolumeRepresentation::SetPickable(int val)
+{
+  this->Actor->SetPickable(val);
+}
+
+//----------------------------------------------------------------------------
+void vtkBrickedImageVolumeRepresentation::SetPosition(double x, double y, double z)
+{
+  this->Actor->SetPosition(x, y, z);
+}
+
+//----------------------------------------------------------------------------
+void vtkBrickedImageVolumeRepresentation::SetScale(double x, double y, double z)
+{
+  this->Actor->SetScale(x, y, z);
+}
+
+//----------------------------------------------------------------------------
+void vtkBrickedImageVolumeRepresentation::SetVisibility(bool val)
+{
+  this->Actor->SetVisibility(val ? 1 : 0);
+  this->Superclass::SetVisibility(val);
+}
+
+//***************************************************************************
+// Forwarded to vtkVolumeProperty.
+//----------------------------------------------------------------------------
+void vtkBrickedImageVolumeRepresentation::SetInterpolationType(int val)
+{
+  this->Property->SetInterpolationType(val);
+}
+
+//----------------------------------------------------------------------------
+void vtkBrickedImageVolumeRepresentation::SetColor(vtkColorTransferFunction* lut)
+{
+  this->Property->SetColor(lut);
+}
+
+//----------------------------------------------------------------------------
+void vtkBrickedImageVolumeRepresentation::SetScalarOpacity(vtkPiecewiseFunction* pwf)
+{
+  this->Property->SetScalarOpacity(pwf);
+}
+
+//----------------------------------------------------------------------------
+void vtkBrickedImageVolumeRepresentation::SetScalarOpacityUnitDistance(double val)
+{
+  this->Property->SetScalarOpacityUnitDistance(val);
+}
+
+//----------------------------------------------------------------------------
+void vtkBrickedImageVolumeRepresentation::SetAmbient(double val)
+{
+  this->Property->SetAmbient(val);
+}
+
+//----------------------------------------------------------------------------
+void vtkBrickedImageVolumeRepresentation::SetDiffuse(double val)
+{
+  this->Property->SetDiffuse(val);
+}
+
+//----------------------------------------------------------------------------
+void vtkBrickedImageVolumeRepresentation::SetSpecular(double val)
+{
+  this->Property->SetSpecular(val);
+}
+
+//----------------------------------------------------------------------------
+void vtkBrickedImageVolumeRepresentation::SetSpecularPower(double val)
+{
+  this->Property->SetSpecularPower(val);
+}
+
+//----------------------------------------------------------------------------
+void vtkBrickedImageVolumeRepresentation::SetShade(bool val)
+{
+  this->Property->SetShade(val);
+}
+
+//----------------------------------------------------------------------------
+void vtkBrickedImageVolumeRepresentation::SetInputArrayToProcess(
+  int idx, int port, int connection, int fieldAssociation, const char* name)
+{
+  this->Superclass::SetInputArrayToProcess(idx, port, connection, fieldAssociation, name);
+  this->VolumeMapper->SelectScalarArray(name);
+
+  // cell data of the bricks becomes point data on the resampled volume.
+  this->VolumeMapper->SetScalarMode(VTK_SCALAR_MODE_USE_POINT_FIELD_DATA);
+}
+
+//***************************************************************************
+// Forwarded to vtkSmartVolumeMapper.
+//----------------------------------------------------------------------------
+void vtkBrickedImageVolumeRepresentation::SetRequestedRenderMode(int mode)
+{
+  this->VolumeMapper->SetRequestedRenderMode(mode);
+}
+
+//----------------------------------------------------------------------------
+void vtkBrickedImageVolumeRepresentation::SetNumberOfSamples(int x, int y, int z)
+{
+  if (x >= 10 && y >= 10 && z >= 10)
+  {
+    // the resampled volume is regenerated from the cached bricks, without
+    // updating the input pipeline.
+    this->Resampler->SetMaxDimensions(x, y, z);
+  }
+}
@@ -0,0 +1,275 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkBrickedImageVolumeRepresentation
+ * @brief   representation used for volume rendering large image data by
+ * streaming bricks.
+ *
+ * vtkBrickedImageVolumeRepresentation is a representation for volume
+ * rendering vtkImageData too large to be resident on the rendering process.
+ * When streaming is enabled and the input pipeline provides the whole extent,
+ * origin and spacing of the image, the whole extent is split into bricks of
+ * BrickSize cells along each axis. The bricks are requested one at a time from
+ * the input pipeline, as update extents, using the same streaming update path
+ * as vtkAMRStreamingVolumeRepresentation. They are ordered by their coverage of
+ * the view frustum, and bricks outside of it are not requested.
+ *
+ * The bricks are resampled, using vtkResampledBrickImageSource, into a volume
+ * of at most NumberOfSamples points covering either the data bounds or, with
+ * RESAMPLE_USING_VIEW_FRUSTUM, the part of it visible in the view, so that the
+ * resolution follows the zoom level.
+ *
+ * Loaded bricks are kept in a least recently used cache bounded by
+ * CacheSize. When the resampled volume must be regenerated, e.g. after the
+ * camera moved or the number of samples changed, cached bricks are reused
+ * without updating the input pipeline. The cache is cleared when the input
+ * pipeline, its time or BrickSize changes. The number of cache hits, of loaded
+ * bricks and of loaded bytes since the resampled volume was last regenerated
+ * are available, and logged for each brick with
+ * `PARAVIEW_LOG_RENDERING_VERBOSITY()`.
+ *
+ * When the input pipeline is not streaming capable, the whole image is
+ * resampled at once.
+ *
+ * @warning Like vtkAMRStreamingVolumeRepresentation, parallel volume rendering
+ * is not supported. The cell data of the bricks is resampled as point data.
+ */
+
+#ifndef vtkBrickedImageVolumeRepresentation_h
+#define vtkBrickedImageVolumeRepresentation_h
+
+#include "vtkBoundingBox.h" // needed for vtkBoundingBox.
+#include "vtkPVDataRepresentation.h"
+#include "vtkRemotingViewsModule.h" // for export macros
+#include "vtkSmartPointer.h"        // needed for vtkSmartPointer.
+
+#include <memory> // for std::unique_ptr
+
+class vtkColorTransferFunction;
+class vtkPiecewiseFunction;
+class vtkPVLODVolume;
+class vtkPVRenderView;
+class vtkResampledBrickImageSource;
+class vtkSmartVolumeMapper;
+class vtkVolumeProperty;
+
+class VTKREMOTINGVIEWS_EXPORT vtkBrickedImageVolumeRepresentation : public vtkPVDataRepresentation
+{
+public:
+  static vtkBrickedImageVolumeRepresentation* New();
+  vtkTypeMacro(vtkBrickedImageVolumeRepresentation, vtkPVDataRepresentation);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  enum ResamplingModes
+  {
+    RESAMPLE_OVER_DATA_BOUNDS = 0,
+    RESAMPLE_USING_VIEW_FRUSTUM = 1
+  };
+
+  ///@{
+  /**
+   * This control the logic used to determine how to place the resampled
+   * volume within the data bounds.
+   * \li RESAMPLE_OVER_DATA_BOUNDS implies that the volume is set to the data
+   * bounds and is not updated as the user interacts.
+   * \li RESAMPLE_USING_VIEW_FRUSTUM indicates that the volume must be
+   * repositioned when the camera changes using the current view frustum.
+   * Default is RESAMPLE_USING_VIEW_FRUSTUM.
+   */
+  void SetResamplingMode(int val);
+  vtkGetMacro(ResamplingMode, int);
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set the number of cells of the bricks along each axis. Default is 256.
+   */
+  void SetBrickSize(int val);
+  vtkGetMacro(BrickSize, int);
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set the maximum size of the brick cache, in MiB. 0 disables the
+   * cache. Default is 1024.
+   */
+  void SetCacheSize(int val);
+  vtkGetMacro(CacheSize, int);
+  ///@}
+
+  /**
+   * Set the maximum number of samples of the resampled volume along each axis.
+   */
+  void SetNumberOfSamples(int x, int y, int z);
+
+  ///@{
+  /**
+   * Statistics since the resampled volume was last regenerated: the number of
+   * bricks taken from the cache, the number of bricks loaded from the input
+   * pipeline and their size in bytes. Valid on the data-server nodes.
+   */
+  vtkGetMacro(NumberOfCacheHits, int);
+  vtkGetMacro(NumberOfLoadedBricks, int);
+  vtkGetMacro(NumberOfLoadedBytes, vtkTypeInt64);
+  ///@}
+
+  /**
+   * Returns the size, in bytes, of the bricks currently in the cache.
+   */
+  vtkTypeInt64 GetCacheMemorySize() const;
+
+  /**
+   * vtkAlgorithm::ProcessRequest() equivalent for rendering passes. This is
+   * typically called by the vtkView to request meta-data from the
+   * representations or ask them to perform certain tasks e.g.
+   * PrepareForRendering.
+   */
+  int ProcessViewRequest(vtkInformationRequestKey* request_type, vtkInformation* inInfo,
+    vtkInformation* outInfo) override;
+
+  /**
+   * Get/Set the visibility for this representation. When the visibility of
+   * representation of false, all view passes are ignored.
+   */
+  void SetVisibility(bool val) override;
+
+  ///@{
+  /**
+   * Set the input data arrays that this algorithm will process.
+   */
+  void SetInputArrayToProcess(
+    int idx, int port, int connection, int fieldAssociation, const char* name) override;
+  void SetInputArrayToProcess(
+    int idx, int port, int connection, int fieldAssociation, int fieldAttributeType) override
+  {
+    this->Superclass::SetInputArrayToProcess(
+      idx, port, connection, fieldAssociation, fieldAttributeType);
+  }
+  void SetInputArrayToProcess(int idx, vtkInformation* info) override
+  {
+    this->Superclass::SetInputArrayToProcess(idx, info);
+  }
+  void SetInputArrayToProcess(int idx, int port, int connection, const char* fieldAssociation,
+    const char* attributeTypeorName) override
+  {
+    this->Superclass::SetInputArrayToProcess(
+      idx, port, connection, fieldAssociation, attributeTypeorName);
+  }
+  ///@}
+
+  //***************************************************************************
+  // Forwarded to Actor.
+  void SetOrientation(double, double, double);
+  void SetOrigin(double, double, double);
+  void SetPickable(int val);
+  void SetPosition(double, double, double);
+  void SetScale(double, double, double);
+
+  //***************************************************************************
+  // Forwarded to vtkVolumeProperty.
+  void SetInterpolationType(int val);
+  void SetColor(vtkColorTransferFunction* lut);
+  void SetScalarOpacity(vtkPiecewiseFunction* pwf);
+  void SetScalarOpacityUnitDistance(double val);
+  void SetAmbient(double);
+  void SetDiffuse(double);
+  void SetSpecular(double);
+  void SetSpecularPower(double);
+  void SetShade(bool);
+
+  //***************************************************************************
+  // Forwarded to vtkSmartVolumeMapper.
+  void SetRequestedRenderMode(int);
+
+protected:
+  vtkBrickedImageVolumeRepresentation();
+  ~vtkBrickedImageVolumeRepresentation() override;
+
+  bool AddToView(vtkView* view) override;
+  bool RemoveFromView(vtkView* view) override;
+
+  int FillInputPortInformation(int port, vtkInformation* info) override;
+
+  /**
+   * Overridden to check if the input pipeline is streaming capable, i.e. if
+   * streaming is enabled and the input pipeline provides the whole extent,
+   * origin and spacing of the image.
+   */
+  int RequestInformation(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override;
+
+  /**
+   * During StreamingUpdate, this requests the extent of the next brick. Outside
+   * of it, only a single point is requested from a streaming capable pipeline.
+   */
+  int RequestUpdateExtent(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override;
+
+  /**
+   * When not in StreamingUpdate, this initializes the bricks. The cache is
+   * cleared if the input pipeline, its time or BrickSize changed.
+   */
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+
+  /**
+   * Returns true if this representation has a next brick to stream, taken
+   * from the cache or loaded from the input pipeline.
+   */
+  bool StreamingUpdate(vtkPVRenderView* view, const double view_planes[24]);
+
+  /**
+   * Fills the priority queue with all the bricks and resets the statistics.
+   */
+  void InitializeBricks();
+
+  /**
+   * This is the data object generated processed by the most recent call to
+   * RequestData() while not streaming. When the pipeline is streaming capable,
+   * this is an image with the whole extent and no arrays.
+   */
+  vtkSmartPointer<vtkDataObject> ProcessedData;
+
+  /**
+   * This is the brick streamed by the most recent call to StreamingUpdate().
+   */
+  vtkSmartPointer<vtkDataObject> ProcessedPiece;
+
+  vtkSmartPointer<vtkResampledBrickImageSource> Resampler;
+
+  ///@{
+  /**
+   * Rendering components.
+   */
+  vtkSmartPointer<vtkSmartVolumeMapper> VolumeMapper;
+  vtkSmartPointer<vtkVolumeProperty> Property;
+  vtkSmartPointer<vtkPVLODVolume> Actor;
+  ///@}
+
+  vtkBoundingBox DataBounds;
+
+  int ResamplingMode = RESAMPLE_USING_VIEW_FRUSTUM;
+  int BrickSize = 256;
+  int CacheSize = 1024;
+
+  int NumberOfCacheHits = 0;
+  int NumberOfLoadedBricks = 0;
+  vtkTypeInt64 NumberOfLoadedBytes = 0;
+
+private:
+  vtkBrickedImageVolumeRepresentation(const vtkBrickedImageVolumeRepresentation&) = delete;
+  void operator=(const vtkBrickedImageVolumeRepresentation&) = delete;
+
+  class vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
+
+  // Set in RequestInformation(); valid only on the data-server nodes.
+  bool StreamingCapablePipeline = false;
+  int WholeExtent[6] = { 0, -1, 0, -1, 0, -1 };
+  double DataOrigin[3] = { 0, 0, 0 };
+  double DataSpacing[3] = { 1, 1, 1 };
+
+  bool InStreamingUpdate = false;
+  int RequestedExtent[6] = { 0, -1, 0, -1, 0, -1 };
+};
+
+#endif
@@ -2,12 +2,14 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkIceTCompositePass.h"
 
+#include "vtkActor.h"
 #include "vtkBoundingBox.h"
 #include "vtkCameraPass.h"
 #include "vtkFloatArray.h"
 #include "vtkFrameBufferObjectBase.h"
 #include "vtkHardwareSelector.h"
 #include "vtkIceTContext.h"
+#include "vtkMath.h"
 #include "vtkMatrix4x4.h"
 #include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
@@ -26,12 +28,16 @@
 #include "vtkTextureObject.h"
 #include "vtkTilesHelper.h"
 #include "vtkTimerLog.h"
+#include "vtkUnsignedCharArray.h"
 #include "vtkVector.h"
 #include "vtkVectorOperators.h"
 
 #include <IceT.h>
 #include <IceTGL.h>
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <vector>
 
 #include "vtkCompositeZPassFS.h"
 #include "vtkOpenGLHelper.h"
@@ -71,33 +77,132 @@ void IceTDrawCallback(const IceTDouble* projection_matrix, const IceTDouble* mod
   }
 }
 
-void MergeCubeAxesBounds(double bounds[6], const vtkRenderState* rState)
+// Collects the corners of the bounds of the props rendered on this rank. IceT
+// projects them to find the screen-space region of this rank, which is tighter
+// than the projection of a single box enclosing all props, e.g. when the props
+// are far apart. Past a few props, their enclosing box is used instead.
+void ComputeBoundingVertices(const vtkRenderState* rState, std::vector<double>& vertices)
 {
-  vtkBoundingBox bbox(bounds);
-
-  // Hande CubeAxes specifically has it wrongly implement the GetBounds()
+  const size_t maxNumberOfBoxes = 32;
+  std::vector<vtkBoundingBox> boxes;
   for (int cc = 0; cc < rState->GetPropArrayCount(); cc++)
   {
     vtkProp* prop = rState->GetPropArray()[cc];
-    if (prop->GetVisibility() && prop->GetUseBounds())
+    const double* bounds =
+      prop->GetVisibility() && prop->GetUseBounds() ? prop->GetBounds() : nullptr;
+    if (!bounds || !vtkMath::AreBoundsInitialized(bounds) ||
+      !std::all_of(bounds, bounds + 6, [](double v) { return std::abs(v) < VTK_FLOAT_MAX; }))
     {
-      if (prop->IsA("vtkGridAxes3DActor") || prop->IsA("vtkCubeAxesActor") ||
-        prop->IsA("vtkPolarAxesActor"))
-      {
-        vtkProp3D* prop3D = static_cast<vtkProp3D*>(prop);
-        vtkBoundingBox box(prop3D->GetBounds());
-        // This is the same trick used by vtkCubeAxesActor::GetRenderedBounds():
-        if (box.IsValid())
-        {
-          box.Inflate(box.GetMaxLength());
-          box.GetBounds(bounds);
-          bbox.AddBounds(bounds);
-        }
-      }
+      continue;
+    }
+    vtkBoundingBox box(bounds);
+    if (!box.IsValid())
+    {
+      continue;
     }
+    // The cube axes actors override GetBounds() to return their inner bounds
+    // rather than the prop bounds (BUG #13469). This is the same trick used by
+    // vtkCubeAxesActor::GetRenderedBounds() to include the outer bounds.
+    if (prop->IsA("vtkGridAxes3DActor") || prop->IsA("vtkCubeAxesActor") ||
+      prop->IsA("vtkPolarAxesActor"))
+    {
+      box.Inflate(box.GetMaxLength());
+    }
+    boxes.push_back(box);
   }
+  if (boxes.size() > maxNumberOfBoxes)
+  {
+    vtkBoundingBox all;
+    for (const auto& box : boxes)
+    {
+      all.AddBox(box);
+    }
+    boxes.assign(1, all);
+  }
+
+  vertices.clear();
+  vertices.reserve(boxes.size() * 8 * 3);
+  for (const auto& box : boxes)
+  {
+    for (int corner = 0; corner < 8; ++corner)
+    {
+      double point[3];
+      box.GetCorner(corner, point);
+      vertices.insert(vertices.end(), point, point + 3);
+    }
+  }
+}
+
+// Reads the `region` (x, y, width, height) of the framebuffer in the same
+// region of `dest`, an image of `width` pixels per row.
+void ReadPixels(const int region[4], int width, GLenum format, GLenum type, void* dest)
+{
+  glPixelStorei(GL_PACK_ROW_LENGTH, width);
+  glPixelStorei(GL_PACK_SKIP_PIXELS, region[0]);
+  glPixelStorei(GL_PACK_SKIP_ROWS, region[1]);
+  glReadPixels(region[0], region[1], region[2], region[3], format, type, dest);
+  glPixelStorei(GL_PACK_ROW_LENGTH, 0);
+  glPixelStorei(GL_PACK_SKIP_PIXELS, 0);
+  glPixelStorei(GL_PACK_SKIP_ROWS, 0);
+}
+
+// Maps the pixels `first` to `last` of a row (or column) of `size` depths to
+// the `targetSize` pixels of the screen, as vtkTextureObject::CopyToFrameBuffer
+// draws the whole row, i.e. with the centers of its end pixels on the borders
+// of the screen. Sets `dest` to the range of screen pixels sampling these
+// depths, and `tcoords` to the texture coordinates of its borders in a texture
+// holding only these depths.
+void MapDepthRange(int first, int last, int size, int targetSize, int dest[2], float tcoords[2])
+{
+  dest[0] = 0;
+  dest[1] = targetSize;
+  if (size > 1)
+  {
+    const double scale = static_cast<double>(targetSize) / (size - 1);
+    dest[0] = std::max(0, static_cast<int>(std::floor(first * scale)));
+    dest[1] = std::min(targetSize, static_cast<int>(std::ceil(last * scale)));
+  }
+  for (int cc = 0; cc < 2; ++cc)
+  {
+    const double source =
+      size > 1 ? 0.5 + static_cast<double>(dest[cc]) * (size - 1) / targetSize : 0.5;
+    tcoords[cc] = static_cast<float>((source - first) / (last - first + 1));
+  }
+}
+
+// Translucent geometry does not write depths. Renders the depth of the
+// front-most fragment of the visible actors, translucent or not.
+void RenderFrontDepths(const vtkRenderState* rState, vtkOpenGLState* ostate)
+{
+  vtkOpenGLState::ScopedglColorMask cmsaver(ostate);
+  vtkOpenGLState::ScopedglDepthMask dmsaver(ostate);
+  vtkOpenGLState::ScopedglEnableDisable dtsaver(ostate, GL_DEPTH_TEST);
+  ostate->vtkglColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+  ostate->vtkglDepthMask(GL_TRUE);
+  ostate->vtkglEnable(GL_DEPTH_TEST);
+  ostate->vtkglClearDepth(static_cast<GLclampf>(1.0));
+  ostate->vtkglClear(GL_DEPTH_BUFFER_BIT);
 
-  bbox.GetBounds(bounds);
+  vtkRenderer* renderer = rState->GetRenderer();
+  for (int cc = 0; cc < rState->GetPropArrayCount(); cc++)
+  {
+    vtkActor* actor = vtkActor::SafeDownCast(rState->GetPropArray()[cc]);
+    if (!actor || !actor->GetVisibility())
+    {
+      continue;
+    }
+    if (actor->HasTranslucentPolygonalGeometry())
+    {
+      const bool forceOpaque = actor->GetForceOpaque();
+      actor->ForceOpaqueOn();
+      actor->RenderOpaqueGeometry(renderer);
+      actor->SetForceOpaque(forceOpaque);
+    }
+    else
+    {
+      actor->RenderOpaqueGeometry(renderer);
+    }
+  }
 }
 
 } // end of namespace
@@ -121,6 +226,7 @@ vtkIceTCompositePass::vtkIceTCompositePass()
 
   this->DataReplicatedOnAllProcesses = false;
   this->ImageReductionFactor = 1;
+  this->LastCompositeTime = 0.0;
 
   this->RenderEmptyImages = false;
   this->UseOrderedCompositing = false;
@@ -133,6 +239,11 @@ vtkIceTCompositePass::vtkIceTCompositePass()
 
   this->DisplayRGBAResults = false;
   this->DisplayDepthResults = false;
+
+  this->NumberOfCompositingLayers = 0;
+  this->ActiveCompositingLayers = 0;
+  this->LayerColors->SetNumberOfComponents(4);
+  this->PeelWidth = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -242,7 +353,16 @@ void vtkIceTCompositePass::SetupContext(const vtkRenderState* render_state)
     icetCompositeMode(ICET_COMPOSITE_MODE_Z_BUFFER);
   }
 
-  icetEnable(ICET_FLOATING_VIEWPORT);
+  if (this->ActiveCompositingLayers > 0)
+  {
+    // the image rendered for the first layer is reused by the next ones, hence
+    // the viewport must not change between them.
+    icetDisable(ICET_FLOATING_VIEWPORT);
+  }
+  else
+  {
+    icetEnable(ICET_FLOATING_VIEWPORT);
+  }
   if (use_ordered_compositing) // if ordered compositing is enabled
   {
     // Setup IceT context for correct sorting.
@@ -269,13 +389,14 @@ void vtkIceTCompositePass::SetupContext(const vtkRenderState* render_state)
   }
 
   // Let IceT know the data bounds. This allows IceT to make smarter compositing
-  // decisions.
-  double allBounds[6];
-  render_state->GetRenderer()->ComputeVisiblePropBounds(allBounds);
+  // decisions: it only reads back and sends the screen-space region covered by
+  // the bounds of each rank, and skips the ranks with empty bounds.
+  std::vector<double> vertices;
+  ::ComputeBoundingVertices(render_state, vertices);
 
   // Try to detect when bounds are empty and try to let IceT know that
   // nothing is in bounds.
-  if (allBounds[0] > allBounds[1])
+  if (vertices.empty())
   {
     vtkDebugMacro("nothing visible" << endl);
     IceTFloat tmp = VTK_FLOAT_MAX;
@@ -283,16 +404,8 @@ void vtkIceTCompositePass::SetupContext(const vtkRenderState* render_state)
   }
   else
   {
-    // ComputeVisiblePropBounds() includes bounds from all props, however it
-    // cannot include the "real" bounds from vtkCubeAxesActor. Thanks to
-    // vtkCubeAxesActor overriding the 'GetBounds' method to return the inner
-    // bounds rather that the prop  bounds for the actor. That results in BUG#
-    // 13469. Hence, to overcome that issue, we iterate over the props to locate
-    // vtkCubeAxesActor and include the outer bounds.
-    MergeCubeAxesBounds(allBounds, render_state);
-
-    icetBoundingBoxd(
-      allBounds[0], allBounds[1], allBounds[2], allBounds[3], allBounds[4], allBounds[5]);
+    icetBoundingVertices(3, ICET_DOUBLE, 0, static_cast<IceTSizeType>(vertices.size() / 3),
+      vertices.data());
   }
 
   if (this->DataReplicatedOnAllProcesses)
@@ -353,6 +466,18 @@ void vtkIceTCompositePass::Render(const vtkRenderState* render_state)
   vtkOpenGLState* ostate = context->GetState();
 
   this->IceTContext->MakeCurrent();
+
+  // composite depth layers if requested and supported by the current mode.
+  const int numRanks = this->Controller->GetNumberOfProcesses();
+  const bool layersSupported = !(this->OrderedCompositingHelper && this->UseOrderedCompositing) &&
+    this->TileDimensions[0] == 1 && this->TileDimensions[1] == 1 && !this->EnableFloatValuePass &&
+    !this->DataReplicatedOnAllProcesses && render_state->GetRenderer()->GetSelector() == nullptr;
+  this->ActiveCompositingLayers =
+    layersSupported ? std::min(this->NumberOfCompositingLayers, numRanks) : 0;
+  this->LayerColors->SetNumberOfTuples(0);
+  this->LayerDepths->SetNumberOfTuples(0);
+  this->PeelDepths->SetNumberOfTuples(0);
+
   this->SetupContext(render_state);
 
   vtkOpenGLState::ScopedglViewport vsaver(ostate);
@@ -385,9 +510,6 @@ void vtkIceTCompositePass::Render(const vtkRenderState* render_state)
     icetDrawFrame(this->Projection->Element[0], this->ModelView->Element[0], background);
   vtkOpenGLRenderUtilities::MarkDebugEvent("vtkIceTCompositePass: icetDrawFrame End");
 
-  IceTDrawCallbackHandle = nullptr;
-  IceTDrawCallbackState = nullptr;
-
   // isolate vtk from IceT OpenGL errors
   vtkOpenGLClearErrorMacro();
 
@@ -443,11 +565,79 @@ void vtkIceTCompositePass::Render(const vtkRenderState* render_state)
     this->LastRenderedDepths->SetNumberOfTuples(0);
   }
 
+  if (this->ActiveCompositingLayers > 1)
+  {
+    vtkOpenGLRenderUtilities::MarkDebugEvent("vtkIceTCompositePass: Layers Start");
+    IceTInt displayRank = 0;
+    icetGetIntegerv(ICET_DISPLAY_NODES, &displayRank);
+    const bool isDisplayRank = this->Controller->GetLocalProcessId() == displayRank;
+    IceTInt tileViewport[4];
+    icetGetIntegerv(ICET_TILE_VIEWPORTS, tileViewport);
+    const vtkIdType numTilePixels = static_cast<vtkIdType>(tileViewport[2]) * tileViewport[3];
+    this->PeelWidth = tileViewport[2];
+
+    int layer = 1;
+    for (; layer < this->ActiveCompositingLayers && numTilePixels > 0; ++layer)
+    {
+      // all ranks peel their image behind the last composited layer.
+      this->PeelDepths->SetNumberOfTuples(numTilePixels);
+      float* peelDepths = this->PeelDepths->GetPointer(0);
+      if (isDisplayRank)
+      {
+        if (icetImageGetNumPixels(renderedImage) == numTilePixels &&
+          icetImageGetDepthFormat(renderedImage) != ICET_IMAGE_DEPTH_NONE)
+        {
+          icetImageCopyDepthf(renderedImage, peelDepths, ICET_IMAGE_DEPTH_FLOAT);
+        }
+        else
+        {
+          std::fill_n(peelDepths, numTilePixels, 1.0f);
+        }
+      }
+      this->Controller->Broadcast(peelDepths, numTilePixels, displayRank);
+      if (std::all_of(peelDepths, peelDepths + numTilePixels, [](float d) { return d >= 1.0f; }))
+      {
+        // no fragment left behind the last layer.
+        break;
+      }
+
+      renderedImage =
+        icetDrawFrame(this->Projection->Element[0], this->ModelView->Element[0], background);
+      vtkOpenGLClearErrorMacro();
+
+      // blend the layer under the layers composited so far.
+      if (isDisplayRank && this->LastRenderedRGBAColors->IsValid() &&
+        icetImageGetColorFormat(renderedImage) == ICET_IMAGE_COLOR_RGBA_UBYTE &&
+        icetImageGetNumPixels(renderedImage) ==
+          this->LastRenderedRGBAColors->GetRawPtr()->GetNumberOfTuples())
+      {
+        const IceTUByte* src = icetImageGetColorcub(renderedImage);
+        unsigned char* dst = this->LastRenderedRGBAColors->GetRawPtr()->GetPointer(0);
+        for (vtkIdType cc = 0, max = 4 * icetImageGetNumPixels(renderedImage); cc < max; cc += 4)
+        {
+          const unsigned int remaining = 255u - dst[cc + 3];
+          for (int comp = 0; comp < 4; ++comp)
+          {
+            dst[cc + comp] = static_cast<unsigned char>(
+              std::min(255u, dst[cc + comp] + (remaining * src[cc + comp] + 127u) / 255u));
+          }
+        }
+      }
+    }
+    this->PeelDepths->SetNumberOfTuples(0);
+    vtkVLogF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "composited %d depth layers", layer);
+    vtkOpenGLRenderUtilities::MarkDebugEvent("vtkIceTCompositePass: Layers End");
+  }
+
+  IceTDrawCallbackHandle = nullptr;
+  IceTDrawCallbackState = nullptr;
+
   this->DisplayResultsIfNeeded(render_state);
   this->CleanupContext(render_state);
 
   double val = 0.;
   icetGetDoublev(ICET_COMPOSITE_TIME, &val);
+  this->LastCompositeTime = val;
   vtkTimerLog::InsertTimedEvent("ICET_COMPOSITE_TIME", val, 0);
   vtkVLogF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "ICET_COMPOSITE_TIME: %lf", val);
   icetGetDoublev(ICET_BLEND_TIME, &val);
@@ -504,6 +694,39 @@ void vtkIceTCompositePass::Draw(
 {
   vtkOpenGLClearErrorMacro();
 
+  if (this->PeelDepths->GetNumberOfTuples() > 0)
+  {
+    // layers after the first one reuse the image of this rank: a pixel
+    // contributes only if it is strictly behind the last composited layer.
+    // The rank that provided that layer cannot be told apart from other ranks
+    // at the same depth, so pixels tied with it are treated as the same
+    // surface, e.g. at the seams of the partitions, and composited once:
+    // including them would blend the front-most one again in every layer.
+    const vtkIdType width = icetImageGetWidth(params.Result);
+    const vtkIdType height = icetImageGetHeight(params.Result);
+    const vtkIdType peelWidth = std::max(this->PeelWidth, 1);
+    const vtkIdType peelHeight = this->PeelDepths->GetNumberOfTuples() / peelWidth;
+    const bool valid = this->LayerDepths->GetNumberOfTuples() == width * height &&
+      this->LayerColors->GetNumberOfTuples() == width * height;
+    IceTUByte* colors = icetImageGetColorub(params.Result);
+    IceTFloat* depths = icetImageGetDepthf(params.Result);
+    for (vtkIdType y = 0; y < height; ++y)
+    {
+      for (vtkIdType x = 0; x < width; ++x)
+      {
+        const vtkIdType index = y * width + x;
+        const bool behind = valid && x < peelWidth && y < peelHeight &&
+          this->LayerDepths->GetValue(index) > this->PeelDepths->GetValue(y * peelWidth + x);
+        for (int comp = 0; comp < 4; ++comp)
+        {
+          colors[4 * index + comp] = behind ? this->LayerColors->GetValue(4 * index + comp) : 0;
+        }
+        depths[index] = behind ? this->LayerDepths->GetValue(index) : 1.0f;
+      }
+    }
+    return;
+  }
+
   vtkRenderer* ren = render_state->GetRenderer();
   vtkOpenGLRenderWindow* context = static_cast<vtkOpenGLRenderWindow*>(ren->GetRenderWindow());
   vtkOpenGLState* ostate = context->GetState();
@@ -552,6 +775,11 @@ void vtkIceTCompositePass::Draw(
     ren->GetViewport(viewport);
     ren->SetViewport(0, 0, 1, 1);
     this->RenderPass->Render(render_state);
+    if (this->ActiveCompositingLayers > 0)
+    {
+      // depths are the sort key of the image of this rank.
+      ::RenderFrontDepths(render_state, ostate);
+    }
 
     // reset viewport
     ren->SetViewport(viewport);
@@ -563,13 +791,30 @@ void vtkIceTCompositePass::Draw(
     // copy the results
     if (!this->EnableFloatValuePass)
     {
+      // IceT ignores the pixels outside of the readback viewport, which only
+      // covers the screen-space bounds of this rank, so only that region is
+      // read. The whole image is needed when it is reused for the next layers
+      // and for selections.
+      const int width = icetImageGetWidth(params.Result);
+      const int height = icetImageGetHeight(params.Result);
+      int region[4] = { 0, 0, width, height };
+      if (params.ReadbackViewport && this->ActiveCompositingLayers <= 1 && !ren->GetSelector())
+      {
+        region[0] = std::max(0, std::min(params.ReadbackViewport[0], width));
+        region[1] = std::max(0, std::min(params.ReadbackViewport[1], height));
+        region[2] = std::max(0, std::min(params.ReadbackViewport[2], width - region[0]));
+        region[3] = std::max(0, std::min(params.ReadbackViewport[3], height - region[1]));
+        vtkVLogF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "readback region: %dx%d of %dx%d", region[2],
+          region[3], width, height);
+      }
+      const bool readback = region[2] > 0 && region[3] > 0;
+
       // Copy image from default buffer.
-      if (icetImageGetColorFormat(params.Result) != ICET_IMAGE_COLOR_NONE)
+      if (readback && icetImageGetColorFormat(params.Result) != ICET_IMAGE_COLOR_NONE)
       {
         // read in the pixels
         unsigned char* destdata = icetImageGetColorub(params.Result);
-        glReadPixels(0, 0, icetImageGetWidth(params.Result), icetImageGetHeight(params.Result),
-          GL_RGBA, GL_UNSIGNED_BYTE, destdata);
+        ::ReadPixels(region, width, GL_RGBA, GL_UNSIGNED_BYTE, destdata);
 
         // for selections we need the adjusted buffer
         // so we overwrite the RGB with the selection buffer
@@ -597,10 +842,24 @@ void vtkIceTCompositePass::Draw(
         }
       }
 
-      if (icetImageGetDepthFormat(params.Result) != ICET_IMAGE_DEPTH_NONE)
+      if (readback && icetImageGetDepthFormat(params.Result) != ICET_IMAGE_DEPTH_NONE)
+      {
+        ::ReadPixels(
+          region, width, GL_DEPTH_COMPONENT, GL_FLOAT, icetImageGetDepthf(params.Result));
+      }
+
+      if (this->ActiveCompositingLayers > 1 &&
+        icetImageGetColorFormat(params.Result) == ICET_IMAGE_COLOR_RGBA_UBYTE &&
+        icetImageGetDepthFormat(params.Result) == ICET_IMAGE_DEPTH_FLOAT)
       {
-        glReadPixels(0, 0, icetImageGetWidth(params.Result), icetImageGetHeight(params.Result),
-          GL_DEPTH_COMPONENT, GL_FLOAT, icetImageGetDepthf(params.Result));
+        // keep the image of this rank for the next layers.
+        const vtkIdType numPixels = icetImageGetNumPixels(params.Result);
+        this->LayerColors->SetNumberOfTuples(numPixels);
+        std::copy_n(icetImageGetColorcub(params.Result), 4 * numPixels,
+          this->LayerColors->GetPointer(0));
+        this->LayerDepths->SetNumberOfTuples(numPixels);
+        std::copy_n(
+          icetImageGetDepthcf(params.Result), numPixels, this->LayerDepths->GetPointer(0));
       }
     }
     else
@@ -762,39 +1021,30 @@ void vtkIceTCompositePass::PushIceTDepthBufferToScreen(const vtkRenderState* ren
     return;
   }
 
-  float* depthBuffer = this->LastRenderedDepths->GetPointer(0);
-
-  // pbo arguments.
-  unsigned int dims[2];
-  vtkIdType continuousInc[3];
-
-  dims[0] = static_cast<unsigned int>(w);
-  dims[1] = static_cast<unsigned int>(h);
-  continuousInc[0] = 0;
-  continuousInc[1] = 0;
-  continuousInc[2] = 0;
+  // only the region covered by geometry, i.e. closer than the far plane, and a
+  // border of far depths are uploaded; the rest of the target viewport is
+  // cleared.
+  const float* depthBuffer = this->LastRenderedDepths->GetPointer(0);
+  int active[4] = { w, h, -1, -1 };
+  for (IceTInt y = 0; y < h; ++y)
+  {
+    const float* row = depthBuffer + static_cast<vtkIdType>(y) * w;
+    for (IceTInt x = 0; x < w; ++x)
+    {
+      if (row[x] < 1.0f)
+      {
+        active[0] = std::min(active[0], static_cast<int>(x));
+        active[1] = std::min(active[1], static_cast<int>(y));
+        active[2] = std::max(active[2], static_cast<int>(x));
+        active[3] = std::max(active[3], static_cast<int>(y));
+      }
+    }
+  }
 
   vtkOpenGLRenderWindow* context =
     vtkOpenGLRenderWindow::SafeDownCast(render_state->GetRenderer()->GetRenderWindow());
   vtkOpenGLState* ostate = context->GetState();
 
-  if (this->PBO == nullptr)
-  {
-    this->PBO = vtkPixelBufferObject::New();
-    this->PBO->SetContext(context);
-  }
-  if (this->ZTexture == nullptr)
-  {
-    this->ZTexture = vtkTextureObject::New();
-    this->ZTexture->SetContext(context);
-  }
-
-  // client to PBO
-  this->PBO->Upload2D(VTK_FLOAT, depthBuffer, dims, 1, continuousInc);
-
-  // PBO to TO
-  this->ZTexture->CreateDepth(dims[0], dims[1], vtkTextureObject::Native, this->PBO);
-
   // TO to FB: apply TO on quad with special zcomposite fragment shader.
   GLboolean prevColorMask[4];
   ostate->vtkglGetBooleanv(GL_COLOR_WRITEMASK, prevColorMask);
@@ -811,18 +1061,88 @@ void vtkIceTCompositePass::PushIceTDepthBufferToScreen(const vtkRenderState* ren
   ostate->vtkglGetIntegerv(GL_DEPTH_FUNC, &prevDepthFunc);
   ostate->vtkglDepthFunc(GL_ALWAYS);
 
-  this->ReadyProgram(context);
-
   int target_size[2], target_origin[2];
   render_state->GetRenderer()->GetTiledSizeAndOrigin(
     &target_size[0], &target_size[1], &target_origin[0], &target_origin[1]);
 
-  this->ZTexture->Activate();
-  this->Program->Program->SetUniformi("depth", this->ZTexture->GetTextureUnit());
-  this->ZTexture->CopyToFrameBuffer(0, 0, w - 1, h - 1, target_origin[0], target_origin[1],
-    target_origin[0] + target_size[0] - 1, target_origin[1] + target_size[1] - 1, target_size[0],
-    target_size[1], this->Program->Program, this->Program->VAO);
-  this->ZTexture->Deactivate();
+  {
+    vtkOpenGLState::ScopedglScissor ssaver(ostate);
+    vtkOpenGLState::ScopedglEnableDisable stsaver(ostate, GL_SCISSOR_TEST);
+    ostate->vtkglScissor(target_origin[0], target_origin[1], target_size[0], target_size[1]);
+    ostate->vtkglEnable(GL_SCISSOR_TEST);
+    ostate->vtkglClearDepth(static_cast<GLclampf>(1.0));
+    ostate->vtkglClear(GL_DEPTH_BUFFER_BIT);
+  }
+
+  if (active[0] <= active[2])
+  {
+    // the screen pixels added by rounding the region outwards sample the border.
+    active[0] = std::max(0, active[0] - 1);
+    active[1] = std::max(0, active[1] - 1);
+    active[2] = std::min(static_cast<int>(w) - 1, active[2] + 1);
+    active[3] = std::min(static_cast<int>(h) - 1, active[3] + 1);
+    const int active_w = active[2] - active[0] + 1;
+    const int active_h = active[3] - active[1] + 1;
+    vtkVLogF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "pushing depth region: %dx%d of %dx%d", active_w,
+      active_h, w, h);
+    std::vector<float> activeDepths(static_cast<size_t>(active_w) * active_h);
+    for (int y = 0; y < active_h; ++y)
+    {
+      std::copy_n(depthBuffer + static_cast<vtkIdType>(active[1] + y) * w + active[0], active_w,
+        activeDepths.data() + static_cast<size_t>(y) * active_w);
+    }
+
+    // pbo arguments.
+    unsigned int dims[2];
+    vtkIdType continuousInc[3];
+
+    dims[0] = static_cast<unsigned int>(active_w);
+    dims[1] = static_cast<unsigned int>(active_h);
+    continuousInc[0] = 0;
+    continuousInc[1] = 0;
+    continuousInc[2] = 0;
+
+    if (this->PBO == nullptr)
+    {
+      this->PBO = vtkPixelBufferObject::New();
+      this->PBO->SetContext(context);
+    }
+    if (this->ZTexture == nullptr)
+    {
+      this->ZTexture = vtkTextureObject::New();
+      this->ZTexture->SetContext(context);
+      this->ZTexture->SetWrapS(vtkTextureObject::ClampToEdge);
+      this->ZTexture->SetWrapT(vtkTextureObject::ClampToEdge);
+    }
+
+    // client to PBO
+    this->PBO->Upload2D(VTK_FLOAT, activeDepths.data(), dims, 1, continuousInc);
+
+    // PBO to TO
+    this->ZTexture->CreateDepth(dims[0], dims[1], vtkTextureObject::Native, this->PBO);
+
+    this->ReadyProgram(context);
+
+    // the depth image may have been rendered with a reduced resolution: the
+    // region is drawn with the texture coordinates the whole image would have,
+    // so that it is not shifted by the rounding of its screen bounds.
+    int dest_x[2], dest_y[2];
+    float tc_x[2], tc_y[2];
+    ::MapDepthRange(active[0], active[2], w, target_size[0], dest_x, tc_x);
+    ::MapDepthRange(active[1], active[3], h, target_size[1], dest_y, tc_y);
+    if (dest_x[0] < dest_x[1] && dest_y[0] < dest_y[1])
+    {
+      float tcoords[] = { tc_x[0], tc_y[0], tc_x[1], tc_y[0], tc_x[1], tc_y[1], tc_x[0], tc_y[1] };
+      float verts[] = { -1.f, -1.f, 0.f, 1.f, -1.f, 0.f, 1.f, 1.f, 0.f, -1.f, 1.f, 0.f };
+      vtkOpenGLState::ScopedglViewport vsaver(ostate);
+      ostate->vtkglViewport(target_origin[0] + dest_x[0], target_origin[1] + dest_y[0],
+        dest_x[1] - dest_x[0], dest_y[1] - dest_y[0]);
+      this->ZTexture->Activate();
+      this->Program->Program->SetUniformi("depth", this->ZTexture->GetTextureUnit());
+      this->ZTexture->CopyToFrameBuffer(tcoords, verts, this->Program->Program, this->Program->VAO);
+      this->ZTexture->Deactivate();
+    }
+  }
 
   if (prevDepthTest)
   {
@@ -876,6 +1196,7 @@ void vtkIceTCompositePass::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "ImageReductionFactor: " << this->ImageReductionFactor << endl;
   os << indent << "OrderedCompositingHelper: " << this->OrderedCompositingHelper << endl;
   os << indent << "UseOrderedCompositing: " << this->UseOrderedCompositing << endl;
+  os << indent << "NumberOfCompositingLayers: " << this->NumberOfCompositingLayers << endl;
   os << indent << "DisplayRGBAResults: " << this->DisplayRGBAResults << endl;
   os << indent << "DisplayDepthResults: " << this->DisplayDepthResults << endl;
 }
@@ -160,6 +160,32 @@ public:
   vtkBooleanMacro(UseOrderedCompositing, bool);
   ///@}
 
+  ///@{
+  /**
+   * Set the number of depth layers to composite in order to blend translucent
+   * geometry in order without redistributing the data, i.e. when
+   * UseOrderedCompositing is false. Each rank renders its image once, along with the
+   * depth of its front-most fragment, translucent or not, at each pixel. The
+   * images of the ranks are then depth-peeled across ranks: each layer is
+   * composited with IceT in Z-buffer mode from the pixels that are behind the
+   * layers composited so far, and blended under them. Pixels are thus
+   * composited in the order of the ranks' front-most fragments, which is
+   * exact unless the fragments of several ranks interleave at that pixel.
+   * Pixels of several ranks at the same depth are composited once, as a
+   * single surface, since a layer only keeps the pixels strictly behind the
+   * previous one. This is not supported in tile display mode and with float value
+   * rendering. The number of layers is limited to the number of ranks.
+   * Initial value is 0, i.e. disabled.
+   */
+  vtkSetClampMacro(NumberOfCompositingLayers, int, 0, 64);
+  vtkGetMacro(NumberOfCompositingLayers, int);
+  ///@}
+
+  /**
+   * Returns the time, in seconds, IceT spent compositing the last frame.
+   */
+  vtkGetMacro(LastCompositeTime, double);
+
   /**
    * Returns the last rendered tile from this process, if any.
    * Image is invalid if tile is not available on the current process.
@@ -271,6 +297,23 @@ protected:
   bool DisplayRGBAResults;
   bool DisplayDepthResults;
 
+  int NumberOfCompositingLayers;
+
+  // Number of layers composited by the current render, 0 when layers are not
+  // used.
+  int ActiveCompositingLayers;
+
+  // Image of this rank, rendered for the first layer and peeled for the next
+  // ones.
+  vtkNew<vtkUnsignedCharArray> LayerColors;
+  vtkNew<vtkFloatArray> LayerDepths;
+
+  // Depths of the last composited layer, empty when rendering the first one.
+  vtkNew<vtkFloatArray> PeelDepths;
+  int PeelWidth;
+
+  double LastCompositeTime;
+
   vtkNew<vtkFloatArray> LastRenderedDepths;
 
   vtkNew<vtkFloatArray> LastRenderedRGBA32F;
@@ -83,6 +83,16 @@ public:
     this->IceTCompositePass->SetUseOrderedCompositing(uoc);
   }
 
+  /**
+   * Set the number of depth layers to composite translucent geometry without
+   * ordered compositing. 0 disables it.
+   * @sa vtkIceTCompositePass::SetNumberOfCompositingLayers
+   */
+  void SetNumberOfCompositingLayers(int val)
+  {
+    this->IceTCompositePass->SetNumberOfCompositingLayers(val);
+  }
+
   /**
    * Set the image reduction factor. Overrides superclass implementation.
    */
@@ -0,0 +1,147 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkPVAdaptiveRenderingController.h"
+
+#include "vtkObjectFactory.h"
+
+#include <algorithm>
+
+namespace
+{
+// Weight of the last frame in the running estimates.
+constexpr double vtkSmoothingFactor = 0.5;
+
+double vtkBlend(double estimate, double value)
+{
+  return estimate < 0.0 ? value : estimate + vtkSmoothingFactor * (value - estimate);
+}
+}
+
+vtkStandardNewMacro(vtkPVAdaptiveRenderingController);
+//----------------------------------------------------------------------------
+vtkPVAdaptiveRenderingController::vtkPVAdaptiveRenderingController() = default;
+
+//----------------------------------------------------------------------------
+vtkPVAdaptiveRenderingController::~vtkPVAdaptiveRenderingController() = default;
+
+//----------------------------------------------------------------------------
+void vtkPVAdaptiveRenderingController::AddInteractiveFrame(double renderTime, double compositeTime,
+  double compressTime, double transferTime, bool usedLOD)
+{
+  this->Interacting = true;
+  if (usedLOD)
+  {
+    this->LODRenderTime = vtkBlend(this->LODRenderTime, std::max(renderTime, 0.0));
+  }
+  else
+  {
+    this->RenderTime = vtkBlend(this->RenderTime, std::max(renderTime, 0.0));
+  }
+  const double imageTime = std::max(compositeTime + compressTime + transferTime, 0.0);
+  this->ImageTime = vtkBlend(
+    this->ImageTime, imageTime * this->ImageReductionFactor * this->ImageReductionFactor);
+
+  const double budget = 1.0 / this->TargetFrameRate;
+
+  // LOD is requested when the full resolution geometry alone takes more than
+  // half of the budget, and released when it takes less than a quarter.
+  if (this->RenderTime >= 0.0)
+  {
+    if (this->RenderTime > 0.5 * budget)
+    {
+      this->UseLOD = true;
+    }
+    else if (this->RenderTime < 0.25 * budget)
+    {
+      this->UseLOD = false;
+    }
+  }
+
+  const double geometryTime = this->UseLOD ? this->LODRenderTime : this->RenderTime;
+  if (geometryTime < 0.0)
+  {
+    // LOD was just requested and has not been measured yet, keep the other
+    // parameters until it is.
+    return;
+  }
+  const double available = 0.9 * (budget - geometryTime);
+
+  int factor = this->MaximumImageReductionFactor;
+  for (int cc = 1; available > 0.0 && cc < this->MaximumImageReductionFactor; ++cc)
+  {
+    if (this->ImageTime / (cc * cc) <= available)
+    {
+      factor = cc;
+      break;
+    }
+  }
+  // a single slow frame must not drop the resolution all at once.
+  this->ImageReductionFactor = std::min(factor, 2 * this->ImageReductionFactor);
+
+  const int maxFactor2 = this->MaximumImageReductionFactor * this->MaximumImageReductionFactor;
+  if (this->ImageTime / maxFactor2 > available)
+  {
+    this->CompressionLossLevel =
+      std::min(this->CompressionLossLevel + 1, this->MaximumCompressionLossLevel);
+  }
+  else if (this->ImageTime / (factor * factor) < 0.5 * available)
+  {
+    this->CompressionLossLevel = std::max(this->CompressionLossLevel - 1, 0);
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkPVAdaptiveRenderingController::EndInteraction()
+{
+  if (!this->Interacting)
+  {
+    return 0;
+  }
+  this->Interacting = false;
+
+  const double budget = 1.0 / this->TargetFrameRate;
+  const double fullTime = this->PredictFrameTime(1, false);
+  const int factor = this->ImageReductionFactor / 2;
+  if (fullTime <= 2.0 * budget || factor < 2)
+  {
+    return 0;
+  }
+  // only worth it if the intermediate frame is much faster than the full one.
+  return this->PredictFrameTime(factor, false) < 0.5 * fullTime ? factor : 0;
+}
+
+//----------------------------------------------------------------------------
+double vtkPVAdaptiveRenderingController::PredictFrameTime(
+  int imageReductionFactor, bool useLOD) const
+{
+  const double geometryTime = useLOD ? this->LODRenderTime : this->RenderTime;
+  if (geometryTime < 0.0 || this->ImageTime < 0.0 || imageReductionFactor < 1)
+  {
+    return -1.0;
+  }
+  return geometryTime + this->ImageTime / (imageReductionFactor * imageReductionFactor);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVAdaptiveRenderingController::Reset()
+{
+  this->ImageReductionFactor = 1;
+  this->UseLOD = false;
+  this->CompressionLossLevel = 0;
+  this->RenderTime = -1.0;
+  this->LODRenderTime = -1.0;
+  this->ImageTime = -1.0;
+  this->Interacting = false;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVAdaptiveRenderingController::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "TargetFrameRate: " << this->TargetFrameRate << endl;
+  os << indent << "MaximumImageReductionFactor: " << this->MaximumImageReductionFactor << endl;
+  os << indent << "MaximumCompressionLossLevel: " << this->MaximumCompressionLossLevel << endl;
+  os << indent << "ImageReductionFactor: " << this->ImageReductionFactor << endl;
+  os << indent << "UseLOD: " << this->UseLOD << endl;
+  os << indent << "CompressionLossLevel: " << this->CompressionLossLevel << endl;
+}
@@ -0,0 +1,131 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class vtkPVAdaptiveRenderingController
+ * @brief picks interactive render parameters from measured frame times
+ *
+ * vtkPVAdaptiveRenderingController is a closed-loop controller used by
+ * vtkPVRenderView to meet a target interactive frame rate. After each
+ * interactive frame, the view reports the time spent rendering geometry,
+ * compositing, compressing and transferring the image. The controller keeps a
+ * running estimate of the geometry cost, with and without LOD, and of the
+ * per-pixel cost of the other stages, and picks for the next frame:
+ *
+ * @li whether LOD geometry should be used, when rendering the full resolution
+ *     geometry alone takes more than half of the frame budget;
+ * @li the smallest image reduction factor for which the image stages fit in
+ *     what remains of the budget;
+ * @li a compression loss level, increased when the image stages do not fit in
+ *     the budget even at MaximumImageReductionFactor.
+ *
+ * When interaction stops, EndInteraction() returns the image reduction factor
+ * of an intermediate frame to render before the full resolution one when the
+ * latter is expected to be much slower than the target, so that the image is
+ * refined progressively.
+ *
+ * The controller only makes decisions; it is up to the caller to apply them
+ * consistently on all processes.
+ */
+
+#ifndef vtkPVAdaptiveRenderingController_h
+#define vtkPVAdaptiveRenderingController_h
+
+#include "vtkObject.h"
+#include "vtkRemotingViewsModule.h" //needed for exports
+
+class VTKREMOTINGVIEWS_EXPORT vtkPVAdaptiveRenderingController : public vtkObject
+{
+public:
+  static vtkPVAdaptiveRenderingController* New();
+  vtkTypeMacro(vtkPVAdaptiveRenderingController, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * Get/Set the target interactive frame rate, in frames per second.
+   * Default is 10.
+   */
+  vtkSetClampMacro(TargetFrameRate, double, 1.0, 100.0);
+  vtkGetMacro(TargetFrameRate, double);
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set the largest image reduction factor the controller may pick.
+   * Default is 8.
+   */
+  vtkSetClampMacro(MaximumImageReductionFactor, int, 1, 20);
+  vtkGetMacro(MaximumImageReductionFactor, int);
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set the largest compression loss level the controller may pick.
+   * Default is 3.
+   */
+  vtkSetClampMacro(MaximumCompressionLossLevel, int, 0, 5);
+  vtkGetMacro(MaximumCompressionLossLevel, int);
+  ///@}
+
+  /**
+   * Records the stage times, in seconds, of an interactive frame rendered with
+   * the current parameters, and updates the parameters for the next frame.
+   * `usedLOD` tells whether LOD geometry was rendered, which may be the case
+   * even if GetUseLOD() is false.
+   */
+  void AddInteractiveFrame(double renderTime, double compositeTime, double compressTime,
+    double transferTime, bool usedLOD);
+
+  /**
+   * Must be called when interaction stops. Returns the image reduction factor
+   * of an intermediate frame to render before the full resolution one, or 0
+   * if none is needed.
+   */
+  int EndInteraction();
+
+  /**
+   * Forgets all estimates and resets the parameters, e.g. when the rendered
+   * geometry changes.
+   */
+  void Reset();
+
+  ///@{
+  /**
+   * Parameters picked for the next interactive frame.
+   */
+  vtkGetMacro(ImageReductionFactor, int);
+  vtkGetMacro(UseLOD, bool);
+  vtkGetMacro(CompressionLossLevel, int);
+  ///@}
+
+  /**
+   * Returns the predicted time, in seconds, of a frame rendered with the given
+   * parameters, or a negative value if it is not known yet.
+   */
+  double PredictFrameTime(int imageReductionFactor, bool useLOD) const;
+
+protected:
+  vtkPVAdaptiveRenderingController();
+  ~vtkPVAdaptiveRenderingController() override;
+
+  double TargetFrameRate = 10.0;
+  int MaximumImageReductionFactor = 8;
+  int MaximumCompressionLossLevel = 3;
+
+  int ImageReductionFactor = 1;
+  bool UseLOD = false;
+  int CompressionLossLevel = 0;
+
+  // Running estimates, negative when unknown. The image stages cost is the
+  // cost at full resolution, i.e. scaled by the square of the reduction factor.
+  double RenderTime = -1.0;
+  double LODRenderTime = -1.0;
+  double ImageTime = -1.0;
+  bool Interacting = false;
+
+private:
+  vtkPVAdaptiveRenderingController(const vtkPVAdaptiveRenderingController&) = delete;
+  void operator=(const vtkPVAdaptiveRenderingController&) = delete;
+};
+
+#endif
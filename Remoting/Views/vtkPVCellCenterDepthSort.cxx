@@ -0,0 +1,397 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkPVCellCenterDepthSort.h"
+
+#include "vtkCamera.h"
+#include "vtkDataSet.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMath.h"
+#include "vtkMatrix4x4.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVLogger.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkTimerLog.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// number of cells of the chunks insertion sorted in parallel, and of the
+// blocks of the radix sort.
+constexpr vtkIdType ChunkSize = 1 << 16;
+
+// moves allowed per cell before the insertion sort gives up.
+constexpr vtkIdType MaxMovesPerCell = 16;
+
+// Maps a depth to a key that sorts the same way as unsigned integers.
+vtkTypeUInt32 DepthKey(float depth)
+{
+  vtkTypeUInt32 bits;
+  std::memcpy(&bits, &depth, sizeof(bits));
+  return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+
+// Moves the cell at `cc` down to its place in [lo, cc]. Returns false when
+// `budget` is exhausted.
+bool Insert(vtkTypeUInt32* keys, vtkIdType* ids, vtkIdType lo, vtkIdType cc, vtkIdType& budget)
+{
+  for (vtkIdType pos = cc; pos > lo && keys[pos - 1] > keys[pos]; --pos)
+  {
+    std::swap(keys[pos - 1], keys[pos]);
+    std::swap(ids[pos - 1], ids[pos]);
+    if (--budget < 0)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+//*****************************************************************************
+class vtkPVCellCenterDepthSort::vtkInternals
+{
+public:
+  // cell centers of Input, computed at CentersTime.
+  vtkDataSet* Input = nullptr;
+  vtkTimeStamp CentersTime;
+  std::vector<float> Centers;
+
+  // cells in the last sorted order, with their keys.
+  std::vector<vtkIdType> Order;
+  std::vector<vtkTypeUInt32> Keys;
+
+  // view the order was computed for, in model coordinates.
+  double DirectionOfProjection[3] = { 0.0, 0.0, 0.0 };
+  double Position[3] = { 0.0, 0.0, 0.0 };
+  bool ParallelProjection = false;
+  int SortDirection = vtkVisibilitySort::BACK_TO_FRONT;
+  double SortDuration = 0.0;
+
+  vtkNew<vtkIdTypeArray> Cells;
+  vtkIdType Cursor = 0;
+
+  void ComputeCellCenters(vtkDataSet* input)
+  {
+    const vtkIdType numCells = input->GetNumberOfCells();
+    this->Centers.resize(3 * numCells);
+    this->Input = input;
+    this->CentersTime.Modified();
+    if (numCells == 0)
+    {
+      return;
+    }
+
+    // GetCellPoints() is thread safe once called from a single thread.
+    vtkNew<vtkIdList> ptIds;
+    input->GetCellPoints(0, ptIds);
+
+    vtkSMPThreadLocalObject<vtkIdList> localPtIds;
+    vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+      vtkIdList* cellPtIds = localPtIds.Local();
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        input->GetCellPoints(cellId, cellPtIds);
+        const vtkIdType numPts = cellPtIds->GetNumberOfIds();
+        double center[3] = { 0.0, 0.0, 0.0 };
+        for (vtkIdType cc = 0; cc < numPts; ++cc)
+        {
+          double x[3];
+          input->GetPoint(cellPtIds->GetId(cc), x);
+          vtkMath::Add(center, x, center);
+        }
+        if (numPts > 0)
+        {
+          vtkMath::MultiplyScalar(center, 1.0 / numPts);
+        }
+        for (int axis = 0; axis < 3; ++axis)
+        {
+          this->Centers[3 * cellId + axis] = static_cast<float>(center[axis]);
+        }
+      }
+    });
+  }
+
+  // Computes the keys of the cells in Order. Cells are sorted by increasing
+  // keys, so for back to front the depths are negated.
+  void ComputeKeys(const double dop[3], const double position[3], bool parallel, bool backToFront)
+  {
+    const vtkIdType numCells = static_cast<vtkIdType>(this->Order.size());
+    this->Keys.resize(numCells);
+    const double sign = backToFront ? -1.0 : 1.0;
+    vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType cc = begin; cc < end; ++cc)
+      {
+        const float* c = &this->Centers[3 * this->Order[cc]];
+        const double center[3] = { c[0], c[1], c[2] };
+        // along the direction of projection, or from the camera position for
+        // perspective projections.
+        const double depth = parallel ? vtkMath::Dot(center, dop)
+                                      : vtkMath::Distance2BetweenPoints(center, position);
+        this->Keys[cc] = DepthKey(static_cast<float>(sign * depth));
+      }
+    });
+  }
+
+  // Sorts an almost sorted Order: chunks are insertion sorted in parallel,
+  // then the cells out of order at the chunk boundaries are moved down.
+  // Returns false if it takes more than MaxMovesPerCell moves per cell, in
+  // which case Order is only partially sorted.
+  bool IncrementalSort()
+  {
+    const vtkIdType numCells = static_cast<vtkIdType>(this->Order.size());
+    const vtkIdType numChunks = (numCells + ChunkSize - 1) / ChunkSize;
+    vtkTypeUInt32* keys = this->Keys.data();
+    vtkIdType* ids = this->Order.data();
+
+    std::atomic<bool> sorted(true);
+    vtkSMPTools::For(0, numChunks, [&](vtkIdType first, vtkIdType last) {
+      for (vtkIdType chunk = first; chunk < last && sorted; ++chunk)
+      {
+        const vtkIdType lo = chunk * ChunkSize;
+        const vtkIdType hi = std::min(lo + ChunkSize, numCells);
+        vtkIdType budget = MaxMovesPerCell * (hi - lo);
+        for (vtkIdType cc = lo + 1; cc < hi; ++cc)
+        {
+          if (!Insert(keys, ids, lo, cc, budget))
+          {
+            sorted = false;
+            return;
+          }
+        }
+      }
+    });
+    if (!sorted)
+    {
+      return false;
+    }
+
+    // each chunk is sorted, so once a cell is in place the rest of its chunk is.
+    vtkIdType budget = MaxMovesPerCell * numCells;
+    for (vtkIdType chunk = 1; chunk < numChunks; ++chunk)
+    {
+      for (vtkIdType cc = chunk * ChunkSize; cc < numCells && keys[cc] < keys[cc - 1]; ++cc)
+      {
+        if (!Insert(keys, ids, 0, cc, budget))
+        {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  // Least significant digit radix sort of Order by Keys, 8 bits at a time.
+  // Each pass counts the digits of blocks of cells in parallel, then scatters
+  // the blocks in parallel at offsets given by the counts.
+  void RadixSort()
+  {
+    const vtkIdType numCells = static_cast<vtkIdType>(this->Order.size());
+    const vtkIdType numBlocks =
+      std::max<vtkIdType>(1, std::min<vtkIdType>((numCells + ChunkSize - 1) / ChunkSize, 1024));
+    const vtkIdType blockSize = (numCells + numBlocks - 1) / numBlocks;
+
+    std::vector<vtkTypeUInt32> tmpKeys(numCells);
+    std::vector<vtkIdType> tmpOrder(numCells);
+    std::vector<vtkIdType> offsets(256 * numBlocks);
+    for (int shift = 0; shift < 32; shift += 8)
+    {
+      const vtkTypeUInt32* keys = this->Keys.data();
+      vtkSMPTools::For(0, numBlocks, [&](vtkIdType first, vtkIdType last) {
+        for (vtkIdType block = first; block < last; ++block)
+        {
+          vtkIdType* counts = &offsets[256 * block];
+          std::fill(counts, counts + 256, 0);
+          const vtkIdType end = std::min(numCells, (block + 1) * blockSize);
+          for (vtkIdType cc = block * blockSize; cc < end; ++cc)
+          {
+            ++counts[(keys[cc] >> shift) & 0xff];
+          }
+        }
+      });
+
+      // offsets of each digit of each block, digits first to keep it stable.
+      vtkIdType offset = 0;
+      bool skip = false;
+      for (int digit = 0; digit < 256; ++digit)
+      {
+        for (vtkIdType block = 0; block < numBlocks; ++block)
+        {
+          const vtkIdType count = offsets[256 * block + digit];
+          skip |= (count == numCells);
+          offsets[256 * block + digit] = offset;
+          offset += count;
+        }
+      }
+      if (skip)
+      {
+        // all the cells have the same digit.
+        continue;
+      }
+
+      vtkSMPTools::For(0, numBlocks, [&](vtkIdType first, vtkIdType last) {
+        for (vtkIdType block = first; block < last; ++block)
+        {
+          vtkIdType* blockOffsets = &offsets[256 * block];
+          const vtkIdType end = std::min(numCells, (block + 1) * blockSize);
+          for (vtkIdType cc = block * blockSize; cc < end; ++cc)
+          {
+            const vtkIdType pos = blockOffsets[(keys[cc] >> shift) & 0xff]++;
+            tmpKeys[pos] = keys[cc];
+            tmpOrder[pos] = this->Order[cc];
+          }
+        }
+      });
+      std::swap(this->Keys, tmpKeys);
+      std::swap(this->Order, tmpOrder);
+    }
+  }
+};
+
+vtkStandardNewMacro(vtkPVCellCenterDepthSort);
+//----------------------------------------------------------------------------
+vtkPVCellCenterDepthSort::vtkPVCellCenterDepthSort()
+  : Internals(new vtkPVCellCenterDepthSort::vtkInternals())
+{
+}
+
+//----------------------------------------------------------------------------
+vtkPVCellCenterDepthSort::~vtkPVCellCenterDepthSort() = default;
+
+//----------------------------------------------------------------------------
+void vtkPVCellCenterDepthSort::InitTraversal()
+{
+  const double startTime = vtkTimerLog::GetUniversalTime();
+  auto& internals = *this->Internals;
+  internals.Cursor = 0;
+
+  vtkDataSet* input = this->Input;
+  if (input == nullptr || this->Camera == nullptr)
+  {
+    internals.Input = nullptr;
+    internals.Order.clear();
+    return;
+  }
+
+  const vtkIdType numCells = input->GetNumberOfCells();
+  if (input != internals.Input || input->GetMTime() > internals.CentersTime)
+  {
+    internals.ComputeCellCenters(input);
+    internals.Order.clear();
+  }
+
+  // the view in model coordinates.
+  double dop[4] = { 0.0, 0.0, 0.0, 0.0 };
+  this->Camera->GetDirectionOfProjection(dop);
+  this->GetInverseModelTransform()->MultiplyPoint(dop, dop);
+  vtkMath::Normalize(dop);
+  double position[4] = { 0.0, 0.0, 0.0, 1.0 };
+  this->Camera->GetPosition(position);
+  this->GetInverseModelTransform()->MultiplyPoint(position, position);
+  if (position[3] != 0.0 && position[3] != 1.0)
+  {
+    vtkMath::MultiplyScalar(position, 1.0 / position[3]);
+  }
+  const bool parallel = this->Camera->GetParallelProjection() != 0;
+
+  const bool hasOrder = static_cast<vtkIdType>(internals.Order.size()) == numCells &&
+    numCells > 0 && parallel == internals.ParallelProjection &&
+    this->Direction == internals.SortDirection;
+  bool reuse = false;
+  if (hasOrder)
+  {
+    const double angle = vtkMath::RadiansFromDegrees(this->ReuseAngle);
+    reuse = vtkMath::Dot(dop, internals.DirectionOfProjection) >= std::cos(angle);
+    if (reuse && !parallel)
+    {
+      double center[3];
+      input->GetCenter(center);
+      const double distance2 = vtkMath::Distance2BetweenPoints(internals.Position, center);
+      const double move2 = vtkMath::Distance2BetweenPoints(position, internals.Position);
+      reuse = std::sqrt(move2) <= std::sqrt(distance2) * std::tan(angle);
+    }
+    // the order is outdated but sorting again would be too slow.
+    reuse |= this->Interactive && this->InteractiveTimeBudget > 0.0 &&
+      internals.SortDuration > this->InteractiveTimeBudget;
+  }
+
+  if (reuse)
+  {
+    this->LastSortType = REUSED_ORDER;
+  }
+  else
+  {
+    if (!hasOrder)
+    {
+      internals.Order.resize(numCells);
+      vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType cc = begin; cc < end; ++cc)
+        {
+          internals.Order[cc] = cc;
+        }
+      });
+    }
+
+    internals.ComputeKeys(dop, position, parallel, this->Direction == BACK_TO_FRONT);
+    if (hasOrder && internals.IncrementalSort())
+    {
+      this->LastSortType = INCREMENTAL_SORT;
+    }
+    else
+    {
+      internals.RadixSort();
+      this->LastSortType = FULL_SORT;
+    }
+
+    std::copy(dop, dop + 3, internals.DirectionOfProjection);
+    std::copy(position, position + 3, internals.Position);
+    internals.ParallelProjection = parallel;
+    internals.SortDirection = this->Direction;
+  }
+
+  this->LastSortDuration = vtkTimerLog::GetUniversalTime() - startTime;
+  if (this->LastSortType != REUSED_ORDER)
+  {
+    internals.SortDuration = this->LastSortDuration;
+  }
+
+  static const char* sortTypes[] = { "reused order of", "incrementally sorted", "sorted" };
+  vtkVLogF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "%s %lld cells in %f s",
+    sortTypes[this->LastSortType], static_cast<long long>(numCells), this->LastSortDuration);
+}
+
+//----------------------------------------------------------------------------
+vtkIdTypeArray* vtkPVCellCenterDepthSort::GetNextCells()
+{
+  auto& internals = *this->Internals;
+  const vtkIdType numCells = static_cast<vtkIdType>(internals.Order.size());
+  if (internals.Cursor >= numCells)
+  {
+    return nullptr;
+  }
+
+  // the cells are passed without copy.
+  const vtkIdType count = std::min<vtkIdType>(this->MaxCellsReturned, numCells - internals.Cursor);
+  internals.Cells->SetArray(internals.Order.data() + internals.Cursor, count, 1);
+  internals.Cursor += count;
+  return internals.Cells;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVCellCenterDepthSort::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "ReuseAngle: " << this->ReuseAngle << endl;
+  os << indent << "InteractiveTimeBudget: " << this->InteractiveTimeBudget << endl;
+  os << indent << "Interactive: " << this->Interactive << endl;
+  os << indent << "LastSortType: " << this->LastSortType << endl;
+  os << indent << "LastSortDuration: " << this->LastSortDuration << endl;
+}
@@ -0,0 +1,110 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkPVCellCenterDepthSort
+ * @brief   parallel, view-dependent sort of cells by the depth of their centers
+ *
+ * vtkPVCellCenterDepthSort is a vtkVisibilitySort used by
+ * vtkUnstructuredGridVolumeRepresentation for vtkProjectedTetrahedraMapper.
+ * Like vtkCellCenterDepthSort, cells are ordered by the depth of their
+ * centers: along the direction of projection for parallel projections, or by
+ * their distance to the camera for perspective projections. Unlike it:
+ *
+ * \li the cell centers are computed once per input, and the depths and the
+ * sort are computed with vtkSMPTools, using a least significant digit radix
+ * sort of the depths converted to 32 bits keys.
+ * \li the order is kept from one traversal to the next. When the camera moved
+ * by less than ReuseAngle, it is reused as is. Otherwise, the depths are
+ * recomputed in that order which, after a small camera move, is almost
+ * sorted: chunks of it are insertion sorted in parallel and merged. When that
+ * takes too many moves, the radix sort is used instead.
+ * \li when Interactive is set and the last sort took longer than
+ * InteractiveTimeBudget, the previous order is reused regardless of the
+ * camera move, trading accuracy for frame rate until the next still render.
+ *
+ * The type and the duration of the last sort are available, and logged with
+ * `PARAVIEW_LOG_RENDERING_VERBOSITY()`.
+ */
+
+#ifndef vtkPVCellCenterDepthSort_h
+#define vtkPVCellCenterDepthSort_h
+
+#include "vtkRemotingViewsModule.h" // for export macros
+#include "vtkVisibilitySort.h"
+
+#include <memory> // for std::unique_ptr
+
+class VTKREMOTINGVIEWS_EXPORT vtkPVCellCenterDepthSort : public vtkVisibilitySort
+{
+public:
+  static vtkPVCellCenterDepthSort* New();
+  vtkTypeMacro(vtkPVCellCenterDepthSort, vtkVisibilitySort);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  void InitTraversal() override;
+  vtkIdTypeArray* GetNextCells() override;
+
+  ///@{
+  /**
+   * Get/Set the camera rotation, in degrees, under which the previous order
+   * is reused. For perspective projections, the camera position must also
+   * have moved by less than this angle, as seen from the center of the data.
+   * Default is 0.5.
+   */
+  vtkSetClampMacro(ReuseAngle, double, 0.0, 90.0);
+  vtkGetMacro(ReuseAngle, double);
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set the time, in seconds, above which a sort is considered too slow
+   * for interactive renders. 0 disables it. Default is 0.1.
+   */
+  vtkSetClampMacro(InteractiveTimeBudget, double, 0.0, VTK_DOUBLE_MAX);
+  vtkGetMacro(InteractiveTimeBudget, double);
+  ///@}
+
+  ///@{
+  /**
+   * Set to true by the representation for interactive renders.
+   */
+  void SetInteractive(bool val) { this->Interactive = val; }
+  bool GetInteractive() const { return this->Interactive; }
+  ///@}
+
+  enum SortTypes
+  {
+    REUSED_ORDER = 0,
+    INCREMENTAL_SORT = 1,
+    FULL_SORT = 2
+  };
+
+  ///@{
+  /**
+   * Returns how the order was obtained in the last InitTraversal() and how
+   * long it took, in seconds.
+   */
+  vtkGetMacro(LastSortType, int);
+  vtkGetMacro(LastSortDuration, double);
+  ///@}
+
+protected:
+  vtkPVCellCenterDepthSort();
+  ~vtkPVCellCenterDepthSort() override;
+
+  double ReuseAngle = 0.5;
+  double InteractiveTimeBudget = 0.1;
+  bool Interactive = false;
+
+  int LastSortType = FULL_SORT;
+  double LastSortDuration = 0.0;
+
+private:
+  vtkPVCellCenterDepthSort(const vtkPVCellCenterDepthSort&) = delete;
+  void operator=(const vtkPVCellCenterDepthSort&) = delete;
+
+  class vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
+};
+
+#endif
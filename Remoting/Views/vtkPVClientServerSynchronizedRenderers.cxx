@@ -8,12 +8,18 @@
 #include "vtkObjectFactory.h"
 #include "vtkOpenGLRenderer.h"
 #include "vtkSquirtCompressor.h"
+#include "vtkTimerLog.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkZlibImageCompressor.h"
+#if VTK_MODULE_ENABLE_ParaView_icet
+#include "vtkIceTCompositePass.h"
+#include "vtkIceTSynchronizedRenderers.h"
+#endif
 #if VTK_MODULE_ENABLE_ParaView_nvpipe
 #include "vtkNvPipeCompressor.h"
 #endif
 
+#include <algorithm>
 #include <cassert>
 #include <sstream>
 
@@ -24,6 +30,9 @@ vtkPVClientServerSynchronizedRenderers::vtkPVClientServerSynchronizedRenderers()
   : Compressor(nullptr)
   , LossLessCompression(true)
   , NVPipeSupport(false)
+  , CompressionLossLevel(0)
+  , LastFrameTimes{ 0.0, 0.0, 0.0, 0.0 }
+  , StartRenderTime(0.0)
 {
   this->ConfigureCompressor("vtkLZ4Compressor 0 3");
 }
@@ -34,6 +43,22 @@ vtkPVClientServerSynchronizedRenderers::~vtkPVClientServerSynchronizedRenderers(
   this->SetCompressor(nullptr);
 }
 
+//----------------------------------------------------------------------------
+void vtkPVClientServerSynchronizedRenderers::MasterStartRender()
+{
+  this->StartRenderTime = vtkTimerLog::GetUniversalTime();
+  this->Superclass::MasterStartRender();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVClientServerSynchronizedRenderers::SlaveStartRender()
+{
+  this->Superclass::SlaveStartRender();
+  // started after receiving the renderer information from the client, so that
+  // the time spent waiting for it is not counted.
+  this->StartRenderTime = vtkTimerLog::GetUniversalTime();
+}
+
 //----------------------------------------------------------------------------
 void vtkPVClientServerSynchronizedRenderers::MasterEndRender()
 {
@@ -43,6 +68,7 @@ void vtkPVClientServerSynchronizedRenderers::MasterEndRender()
 
   vtkRawImage& rawImage = this->Image;
 
+  double decompressTime = 0.0;
   int header[4];
   this->ParallelController->Receive(header, 4, 1, 0x023430);
   if (header[0] > 0)
@@ -53,7 +79,9 @@ void vtkPVClientServerSynchronizedRenderers::MasterEndRender()
       vtkUnsignedCharArray* data = vtkUnsignedCharArray::New();
       this->ParallelController->Receive(data, 1, 0x023430);
       this->Compressor->SetImageResolution(header[1], header[2]);
+      const double start = vtkTimerLog::GetUniversalTime();
       this->Decompress(data, rawImage.GetRawPtr());
+      decompressTime = vtkTimerLog::GetUniversalTime() - start;
       data->Delete();
     }
     else
@@ -62,6 +90,17 @@ void vtkPVClientServerSynchronizedRenderers::MasterEndRender()
     }
     rawImage.MarkValid();
   }
+
+  // the server stage times; whatever remains of the frame time is spent
+  // transferring the image.
+  double times[3];
+  this->ParallelController->Receive(times, 3, 1, 0x023431);
+  const double elapsed = vtkTimerLog::GetUniversalTime() - this->StartRenderTime;
+  this->LastFrameTimes[0] = times[0];
+  this->LastFrameTimes[1] = times[1];
+  this->LastFrameTimes[2] = times[2] + decompressTime;
+  this->LastFrameTimes[3] =
+    std::max(0.0, elapsed - times[0] - times[1] - times[2] - decompressTime);
 }
 
 //----------------------------------------------------------------------------
@@ -72,6 +111,16 @@ void vtkPVClientServerSynchronizedRenderers::SlaveEndRender()
 
   vtkRawImage& rawImage = this->CaptureRenderedImage();
 
+  // IceT composites while rendering, so its time is taken off the render time.
+  double times[3] = { vtkTimerLog::GetUniversalTime() - this->StartRenderTime, 0.0, 0.0 };
+#if VTK_MODULE_ENABLE_ParaView_icet
+  if (auto icet = vtkIceTSynchronizedRenderers::SafeDownCast(this->GetCaptureDelegate()))
+  {
+    times[1] = std::min(times[0], icet->GetIceTCompositePass()->GetLastCompositeTime());
+    times[0] -= times[1];
+  }
+#endif
+
   int header[4];
   header[0] = rawImage.IsValid() ? 1 : 0;
   header[1] = rawImage.GetWidth();
@@ -86,13 +135,17 @@ void vtkPVClientServerSynchronizedRenderers::SlaveEndRender()
     if (this->Compressor)
     {
       this->Compressor->SetImageResolution(header[1], header[2]);
-      this->ParallelController->Send(this->Compress(rawImage.GetRawPtr()), 1, 0x023430);
+      const double start = vtkTimerLog::GetUniversalTime();
+      vtkUnsignedCharArray* compressed = this->Compress(rawImage.GetRawPtr());
+      times[2] = vtkTimerLog::GetUniversalTime() - start;
+      this->ParallelController->Send(compressed, 1, 0x023430);
     }
     else
     {
       this->ParallelController->Send(rawImage.GetRawPtr(), 1, 0x023430);
     }
   }
+  this->ParallelController->Send(times, 3, 1, 0x023431);
 }
 
 //----------------------------------------------------------------------------
@@ -102,7 +155,31 @@ vtkUnsignedCharArray* vtkPVClientServerSynchronizedRenderers::Compress(vtkUnsign
   {
     this->Compressor->SetLossLessMode(this->LossLessCompression);
     this->Compressor->SetInput(data);
-    if (this->Compressor->Compress() == 0)
+
+    // drop quality levels temporarily, the decompressor does not need them.
+    const int lossLevel = this->LossLessCompression ? 0 : this->CompressionLossLevel;
+    vtkLZ4Compressor* lz4 = vtkLZ4Compressor::SafeDownCast(this->Compressor);
+    vtkSquirtCompressor* squirt = vtkSquirtCompressor::SafeDownCast(this->Compressor);
+    const int quality = lz4 ? lz4->GetQuality() : (squirt ? squirt->GetSquirtLevel() : 0);
+    if (lossLevel > 0 && lz4)
+    {
+      lz4->SetQuality(std::min(quality + lossLevel, 5));
+    }
+    else if (lossLevel > 0 && squirt)
+    {
+      squirt->SetSquirtLevel(std::min(quality + lossLevel, 5));
+    }
+    const int status = this->Compressor->Compress();
+    if (lossLevel > 0 && lz4)
+    {
+      lz4->SetQuality(quality);
+    }
+    else if (lossLevel > 0 && squirt)
+    {
+      squirt->SetSquirtLevel(quality);
+    }
+
+    if (status == 0)
     {
       vtkErrorMacro("Image compression failed!");
       return data;
@@ -204,4 +281,5 @@ void vtkPVClientServerSynchronizedRenderers::ConfigureCompressor(const char* str
 void vtkPVClientServerSynchronizedRenderers::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "CompressionLossLevel: " << this->CompressionLossLevel << endl;
 }
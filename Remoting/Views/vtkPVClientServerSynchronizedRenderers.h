@@ -47,6 +47,25 @@ public:
    */
   virtual void ConfigureCompressor(const char* stream);
 
+  ///@{
+  /**
+   * Number of quality levels to drop, on top of the configured ones, when
+   * lossy compression is allowed. Only vtkLZ4Compressor and
+   * vtkSquirtCompressor support it. This only matters on the server side.
+   * Default is 0.
+   */
+  vtkSetClampMacro(CompressionLossLevel, int, 0, 5);
+  vtkGetMacro(CompressionLossLevel, int);
+  ///@}
+
+  /**
+   * Returns the times, in seconds, spent on the server side rendering the
+   * geometry, compositing and compressing the last image, and the time spent
+   * transferring it, measured on the client side. The decompression time is
+   * added to the compression time. Only valid on the client side.
+   */
+  vtkGetVector4Macro(LastFrameTimes, double);
+
 protected:
   vtkPVClientServerSynchronizedRenderers();
   ~vtkPVClientServerSynchronizedRenderers() override;
@@ -62,12 +81,17 @@ protected:
   vtkUnsignedCharArray* Compress(vtkUnsignedCharArray*);
   void Decompress(vtkUnsignedCharArray* input, vtkUnsignedCharArray* outputBuffer);
 
+  void MasterStartRender() override;
+  void SlaveStartRender() override;
   void MasterEndRender() override;
   void SlaveEndRender() override;
 
   vtkImageCompressor* Compressor;
   bool LossLessCompression;
   bool NVPipeSupport;
+  int CompressionLossLevel;
+  double LastFrameTimes[4];
+  double StartRenderTime;
 
 private:
   vtkPVClientServerSynchronizedRenderers(const vtkPVClientServerSynchronizedRenderers&) = delete;
@@ -2,18 +2,27 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkPVHardwareSelector.h"
 
+#include "vtkActor.h"
 #include "vtkCamera.h"
+#include "vtkDataObject.h"
+#include "vtkMapper.h"
 #include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVLogger.h"
 #include "vtkPVRenderView.h"
 #include "vtkPVRenderViewSettings.h"
 #include "vtkProcessModule.h"
+#include "vtkProp3D.h"
+#include "vtkPropCollection.h"
 #include "vtkRenderer.h"
 #include "vtkSelection.h"
 #include "vtkWeakPointer.h"
 
+#include <algorithm>
+#include <array>
 #include <map>
+#include <utility>
+#include <vector>
 
 //#define vtkPVHardwareSelectorDEBUG
 #ifdef vtkPVHardwareSelectorDEBUG
@@ -31,6 +40,66 @@ public:
   PropMapType PropMap;
 
   vtkWeakPointer<vtkPVRenderView> View;
+
+  // State of the scene the buffers were captured for: the active camera and
+  // the visible pickable props registered for selection, with the
+  // modification time of their geometry. The camera is compared by value
+  // since its clipping range, hence its MTime, is updated on every render.
+  struct SceneState
+  {
+    std::array<double, 12> Camera{};
+    std::vector<std::pair<vtkProp*, vtkMTimeType>> Props;
+
+    bool operator==(const SceneState& other) const
+    {
+      return this->Camera == other.Camera && this->Props == other.Props;
+    }
+  };
+  SceneState CapturedScene;
+  bool CaptureSucceeded = false;
+
+  SceneState GetSceneState(vtkRenderer* renderer) const
+  {
+    SceneState state;
+    if (!renderer)
+    {
+      return state;
+    }
+    vtkCamera* camera = renderer->GetActiveCamera();
+    camera->GetPosition(&state.Camera[0]);
+    camera->GetFocalPoint(&state.Camera[3]);
+    camera->GetViewUp(&state.Camera[6]);
+    state.Camera[9] = camera->GetViewAngle();
+    state.Camera[10] = camera->GetParallelScale();
+    state.Camera[11] = camera->GetParallelProjection();
+    vtkPropCollection* props = renderer->GetViewProps();
+    vtkCollectionSimpleIterator iter;
+    props->InitTraversal(iter);
+    while (vtkProp* prop = props->GetNextProp(iter))
+    {
+      // the highlight of the selection and of the preselection, and labels,
+      // change on every hover but are not pickable or have no selection id.
+      if (!prop->GetVisibility() || !prop->GetPickable() ||
+        this->PropMap.find(prop) == this->PropMap.end())
+      {
+        continue;
+      }
+      // neither the property nor the mapper are considered: they are modified
+      // by changes that do not affect the selection buffers, e.g. colors or
+      // the fast preselection highlight.
+      vtkProp3D* prop3D = vtkProp3D::SafeDownCast(prop);
+      vtkMTimeType mtime = prop3D ? prop3D->vtkProp3D::GetMTime() : prop->GetMTime();
+      vtkActor* actor = vtkActor::SafeDownCast(prop);
+      vtkDataObject* input =
+        actor && actor->GetMapper() ? actor->GetMapper()->GetInputDataObject(0, 0) : nullptr;
+      if (input)
+      {
+        mtime = std::max(mtime, input->GetMTime());
+      }
+      state.Props.emplace_back(prop, mtime);
+    }
+    return state;
+  }
 };
 
 //----------------------------------------------------------------------------
@@ -90,12 +159,10 @@ bool vtkPVHardwareSelector::PrepareSelect()
     int* size = this->Renderer->GetSize();
     int* origin = this->Renderer->GetOrigin();
     this->SetArea(origin[0], origin[1], origin[0] + size[0] - 1, origin[1] + size[1] - 1);
-    if (this->CaptureBuffers() == false)
-    {
-      this->CaptureTime.Modified();
-      return false;
-    }
+    this->Internals->CaptureSucceeded = this->CaptureBuffers();
+    this->Internals->CapturedScene = this->Internals->GetSceneState(this->Renderer);
     this->CaptureTime.Modified();
+    return this->Internals->CaptureSucceeded;
   }
   return true;
 }
@@ -107,7 +174,29 @@ vtkSelection* vtkPVHardwareSelector::Select(int region[4])
   {
     return nullptr;
   }
+  return this->GenerateRegionSelection(region);
+}
+
+//----------------------------------------------------------------------------
+vtkSelection* vtkPVHardwareSelector::SelectFromCache(int region[4])
+{
+  if (!this->IsCacheValidForScene())
+  {
+    return nullptr;
+  }
+  return this->GenerateRegionSelection(region);
+}
 
+//----------------------------------------------------------------------------
+bool vtkPVHardwareSelector::IsCacheValidForScene()
+{
+  return !this->NeedToRenderForSelection() && this->Internals->CaptureSucceeded &&
+    this->Internals->GetSceneState(this->Renderer) == this->Internals->CapturedScene;
+}
+
+//----------------------------------------------------------------------------
+vtkSelection* vtkPVHardwareSelector::GenerateRegionSelection(int region[4])
+{
   vtkSelection* sel = this->GenerateSelection(region[0], region[1], region[2], region[3]);
   if (sel->GetNumberOfNodes() == 0 &&
     this->FieldAssociation == vtkDataObject::FIELD_ASSOCIATION_POINTS && region[0] == region[2] &&
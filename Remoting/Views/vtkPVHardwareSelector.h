@@ -11,6 +11,14 @@
  * This class does not know, however, when the cached buffers are invalid.
  * External logic must explicitly calls InvalidateCachedSelection() to ensure
  * that the cache is not reused.
+ *
+ * SelectFromCache() answers queries, such as hover queries for a pixel, only
+ * from the resident buffers and never renders. Since it runs on a single
+ * process, it also checks that the active camera and the geometry of the
+ * visible pickable props did not change since the capture, and fails
+ * otherwise; callers then have to invalidate the cache on all processes and
+ * use Select(). Only props with a selection id are considered, so the
+ * highlight of the selection or preselection does not invalidate the cache.
  */
 
 #ifndef vtkPVHardwareSelector_h
@@ -46,6 +54,20 @@ public:
    */
   vtkSelection* PolygonSelect(int* polygonPoints, vtkIdType count);
 
+  /**
+   * Same as Select() except that the selection is generated only from the
+   * buffers captured previously. Returns nullptr, without rendering, if
+   * IsCacheValidForScene() is false.
+   */
+  vtkSelection* SelectFromCache(int region[4]);
+
+  /**
+   * Returns true if buffers were captured successfully, were not invalidated
+   * since, and if the camera and the visible pickable props with a selection
+   * id are in the state they were in when captured.
+   */
+  bool IsCacheValidForScene();
+
   /**
    * Returns true when the next call to Select() will result in renders to
    * capture the selection-buffers.
@@ -91,6 +113,11 @@ protected:
 
   void SavePixelBuffer(int passNo) override;
 
+  /**
+   * Generates the selection for `region` from the captured buffers.
+   */
+  vtkSelection* GenerateRegionSelection(int region[4]);
+
   vtkTimeStamp CaptureTime;
   int UniqueId;
 
@@ -4,18 +4,42 @@
 #include "vtkPVPlotMatrixRepresentation.h"
 
 #include "vtkAnnotationLink.h"
+#include "vtkArrayDispatch.h"
+#include "vtkBlockDeliveryPreprocessor.h"
+#include "vtkChart.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataArray.h"
+#include "vtkDataArrayRange.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkFieldData.h"
+#include "vtkIdList.h"
+#include "vtkImageData.h"
+#include "vtkLookupTable.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkMultiProcessController.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVContextView.h"
+#include "vtkPVMergeTablesMultiBlock.h"
+#include "vtkPVPairwiseHistograms2D.h"
+#include "vtkPlotHistogram2D.h"
 #include "vtkPlotPoints.h"
+#include "vtkPointData.h"
+#include "vtkReductionFilter.h"
 #include "vtkScatterPlotMatrix.h"
 #include "vtkSmartPointer.h"
 #include "vtkStringArray.h"
 #include "vtkTable.h"
+#include "vtkWeakPointer.h"
 
 #if VTK_MODULE_ENABLE_VTK_FiltersOpenTURNS
 #include "vtkOTScatterPlotMatrix.h"
 #endif
 
+#include <algorithm>
+#include <cmath>
+#include <map>
 #include <set>
 #include <string>
 #include <utility>
@@ -28,6 +52,48 @@ class vtkPVPlotMatrixRepresentation::vtkInternals
 public:
   std::vector<std::pair<std::string, bool>> SeriesVisibilities;
 
+  // A density image added to a scatter plot of the matrix, with the plots
+  // hidden in its place.
+  struct DensityPlot
+  {
+    vtkWeakPointer<vtkChart> Chart;
+    vtkSmartPointer<vtkPlotHistogram2D> Plot;
+    std::vector<vtkWeakPointer<vtkPlot>> HiddenPlots;
+  };
+  std::vector<DensityPlot> DensityPlots;
+
+  std::vector<std::string> GetVisibleSeriesNames() const
+  {
+    std::vector<std::string> result;
+    for (const auto& visibility : this->SeriesVisibilities)
+    {
+      if (visibility.second)
+      {
+        result.push_back(visibility.first);
+      }
+    }
+    return result;
+  }
+
+  void RemoveDensityPlots()
+  {
+    for (auto& densityPlot : this->DensityPlots)
+    {
+      if (densityPlot.Chart)
+      {
+        densityPlot.Chart->RemovePlotInstance(densityPlot.Plot);
+      }
+      for (auto& plot : densityPlot.HiddenPlots)
+      {
+        if (plot)
+        {
+          plot->SetVisible(true);
+        }
+      }
+    }
+    this->DensityPlots.clear();
+  }
+
   vtkSmartPointer<vtkStringArray> GetOrderedVisibleColumnNames(vtkTable* table)
   {
     vtkSmartPointer<vtkStringArray> result = vtkSmartPointer<vtkStringArray>::New();
@@ -72,6 +138,40 @@ vtkColor4ub MakeColor(double r, double g, double b)
   return vtkColor4ub(static_cast<unsigned char>(r * 255), static_cast<unsigned char>(g * 255),
     static_cast<unsigned char>(b * 255));
 }
+
+// Flags the rows holding the smallest and largest finite values.
+struct ExtremaWorker
+{
+  template <typename ArrayT>
+  void operator()(ArrayT* array, std::vector<bool>& keep) const
+  {
+    const auto values = vtk::DataArrayValueRange<1>(array);
+    const vtkIdType numValues = static_cast<vtkIdType>(values.size());
+    vtkIdType minRow = -1;
+    vtkIdType maxRow = -1;
+    for (vtkIdType cc = 0; cc < numValues; ++cc)
+    {
+      const double value = static_cast<double>(values[cc]);
+      if (!std::isfinite(value))
+      {
+        continue;
+      }
+      if (minRow < 0 || value < static_cast<double>(values[minRow]))
+      {
+        minRow = cc;
+      }
+      if (maxRow < 0 || value > static_cast<double>(values[maxRow]))
+      {
+        maxRow = cc;
+      }
+    }
+    if (minRow >= 0)
+    {
+      keep[minRow] = true;
+      keep[maxRow] = true;
+    }
+  }
+};
 }
 
 //----------------------------------------------------------------------------
@@ -140,6 +240,7 @@ bool vtkPVPlotMatrixRepresentation::AddToView(vtkView* view)
 //----------------------------------------------------------------------------
 bool vtkPVPlotMatrixRepresentation::RemoveFromView(vtkView* view)
 {
+  this->Internals->RemoveDensityPlots();
   if (vtkScatterPlotMatrix* plotMatrix = this->GetPlotMatrix())
   {
     plotMatrix->SetInput(nullptr);
@@ -218,6 +319,227 @@ void vtkPVPlotMatrixRepresentation::PrepareForRendering()
 
     // Set column order
     plotMatrix->SetVisibleColumns(orderedVisibleColumns.GetPointer());
+
+    this->UpdateDensityPlots(plotMatrix, orderedVisibleColumns);
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataObject> vtkPVPlotMatrixRepresentation::ReduceDataToRoot(
+  vtkDataObject* data)
+{
+  if (!this->BinnedDensity)
+  {
+    return this->Superclass::ReduceDataToRoot(data);
+  }
+
+  vtkNew<vtkBlockDeliveryPreprocessor> preprocessor;
+  preprocessor->SetFlattenTable(this->FlattenTable);
+  preprocessor->SetFieldAssociation(this->FieldAssociation);
+  preprocessor->SetInputData(data);
+  preprocessor->Update();
+
+  // only the first table is rendered: all ranks must use the same block, even
+  // the ones on which it is empty.
+  vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
+  const bool parallel = controller && controller->GetNumberOfProcesses() > 1;
+  vtkCompositeDataSet* blocks =
+    vtkCompositeDataSet::SafeDownCast(preprocessor->GetOutputDataObject(0));
+  vtkSmartPointer<vtkCompositeDataIterator> iter;
+  iter.TakeReference(blocks->NewIterator());
+  unsigned int localIndex = VTK_UNSIGNED_INT_MAX;
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    vtkTable* table = vtkTable::SafeDownCast(iter->GetCurrentDataObject());
+    if (table && table->GetNumberOfRows() > 0)
+    {
+      localIndex = iter->GetCurrentFlatIndex();
+      break;
+    }
+  }
+  unsigned int index = localIndex;
+  if (parallel)
+  {
+    controller->AllReduce(&localIndex, &index, 1, vtkCommunicator::MIN_OP);
+  }
+  vtkSmartPointer<vtkTable> table;
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    if (iter->GetCurrentFlatIndex() == index)
+    {
+      table = vtkTable::SafeDownCast(iter->GetCurrentDataObject());
+      break;
+    }
+  }
+  if (!table)
+  {
+    table = vtkSmartPointer<vtkTable>::New();
+  }
+
+  // the histograms of all pairs are computed in a single pass over the rows.
+  const std::vector<std::string> names = this->Internals->GetVisibleSeriesNames();
+  vtkNew<vtkPVPairwiseHistograms2D> histograms;
+  if (names.size() > 1)
+  {
+    histograms->SetController(controller);
+    histograms->SetNumberOfBins(this->NumberOfDensityBins, this->NumberOfDensityBins);
+    for (const auto& name : names)
+    {
+      histograms->AddColumn(name.c_str());
+    }
+    histograms->SetInputData(table);
+    histograms->Update();
+  }
+
+  // every stride-th row is kept on each rank, with the extrema of the visible
+  // columns so that the axes of the matrix match the density images.
+  const vtkIdType localRows = table->GetNumberOfRows();
+  vtkIdType numRows = localRows;
+  if (parallel)
+  {
+    controller->AllReduce(&localRows, &numRows, 1, vtkCommunicator::SUM_OP);
+  }
+  const vtkIdType maxRows = std::max<vtkIdType>(this->MaximumNumberOfSampledRows, 1);
+  const vtkIdType stride = (numRows + maxRows - 1) / maxRows;
+  vtkSmartPointer<vtkTable> sample = table;
+  if (stride > 1)
+  {
+    std::vector<bool> keep(localRows, false);
+    for (vtkIdType cc = 0; cc < localRows; cc += stride)
+    {
+      keep[cc] = true;
+    }
+    ExtremaWorker worker;
+    for (const auto& name : names)
+    {
+      vtkDataArray* array = vtkDataArray::SafeDownCast(table->GetColumnByName(name.c_str()));
+      if (array && array->GetNumberOfComponents() == 1)
+      {
+        if (!vtkArrayDispatch::Dispatch::Execute(array, worker, keep))
+        {
+          worker(array, keep);
+        }
+      }
+    }
+
+    vtkNew<vtkIdList> ids;
+    for (vtkIdType cc = 0; cc < localRows; ++cc)
+    {
+      if (keep[cc])
+      {
+        ids->InsertNextId(cc);
+      }
+    }
+    sample = vtkSmartPointer<vtkTable>::New();
+    sample->GetFieldData()->ShallowCopy(table->GetFieldData());
+    vtkDataSetAttributes* rowData = table->GetRowData();
+    for (int cc = 0, max = rowData->GetNumberOfArrays(); cc < max; ++cc)
+    {
+      vtkAbstractArray* array = rowData->GetAbstractArray(cc);
+      vtkSmartPointer<vtkAbstractArray> subset;
+      subset.TakeReference(array->NewInstance());
+      subset->SetName(array->GetName());
+      subset->SetNumberOfComponents(array->GetNumberOfComponents());
+      subset->CopyComponentNames(array);
+      subset->InsertTuplesStartingAt(0, ids, array);
+      sample->GetRowData()->AddArray(subset);
+    }
+  }
+
+  vtkNew<vtkMultiBlockDataSet> sampled;
+  sampled->SetBlock(0, sample);
+  vtkNew<vtkReductionFilter> reductionFilter;
+  vtkNew<vtkPVMergeTablesMultiBlock> algo;
+  reductionFilter->SetPostGatherHelper(algo.GetPointer());
+  reductionFilter->SetInputData(sampled);
+  reductionFilter->Update();
+
+  // the sampled table comes first so that GetLocalOutput() returns it.
+  auto result = vtkSmartPointer<vtkMultiBlockDataSet>::New();
+  result->SetNumberOfBlocks(2);
+  result->SetBlock(0, reductionFilter->GetOutputDataObject(0));
+  result->SetBlock(1, histograms->GetOutput());
+  return result;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVPlotMatrixRepresentation::UpdateDensityPlots(
+  vtkScatterPlotMatrix* plotMatrix, vtkStringArray* visibleColumns)
+{
+  this->Internals->RemoveDensityPlots();
+  vtkMultiBlockDataSet* histograms = this->BinnedDensity && this->LocalOutput
+    ? vtkMultiBlockDataSet::SafeDownCast(this->LocalOutput->GetBlock(1))
+    : nullptr;
+  if (!histograms)
+  {
+    return;
+  }
+
+  std::map<std::pair<std::string, std::string>, vtkImageData*> images;
+  double maxCount = 2.0;
+  for (unsigned int cc = 0; cc < histograms->GetNumberOfBlocks(); ++cc)
+  {
+    vtkImageData* image = vtkImageData::SafeDownCast(histograms->GetBlock(cc));
+    vtkStringArray* names = image
+      ? vtkStringArray::SafeDownCast(image->GetFieldData()->GetAbstractArray("column_names"))
+      : nullptr;
+    vtkDataArray* counts = image ? image->GetPointData()->GetScalars() : nullptr;
+    if (names && names->GetNumberOfValues() == 2 && counts)
+    {
+      images[std::make_pair(names->GetValue(0), names->GetValue(1))] = image;
+      maxCount = std::max(maxCount, counts->GetRange(0)[1]);
+    }
+  }
+
+  // the counts are mapped on a log scale to increasingly opaque shades of the
+  // scatter plot color; empty bins are transparent.
+  vtkNew<vtkLookupTable> lut;
+  lut->SetScaleToLog10();
+  lut->SetRange(1.0, maxCount);
+  lut->SetBelowRangeColor(0.0, 0.0, 0.0, 0.0);
+  lut->UseBelowRangeColorOn();
+  const int numColors = 256;
+  lut->SetNumberOfTableValues(numColors);
+  for (int cc = 0; cc < numColors; ++cc)
+  {
+    lut->SetTableValue(cc, this->ScatterPlotColor[0] / 255.0, this->ScatterPlotColor[1] / 255.0,
+      this->ScatterPlotColor[2] / 255.0, 0.15 + 0.85 * cc / (numColors - 1));
+  }
+
+  // lay the charts out now, the layout would otherwise clear the plots added
+  // below.
+  plotMatrix->Update();
+  const int n = static_cast<int>(visibleColumns->GetNumberOfValues());
+  for (int i = 0; i < n; ++i)
+  {
+    for (int j = 0; i + j + 1 < n; ++j)
+    {
+      // same layout as vtkScatterPlotMatrix: column i along X and column
+      // n - j - 1 along Y.
+      auto image = images.find(
+        std::make_pair(visibleColumns->GetValue(i), visibleColumns->GetValue(n - j - 1)));
+      vtkChart* chart = image != images.end() ? plotMatrix->GetChart(vtkVector2i(i, j)) : nullptr;
+      if (!chart)
+      {
+        continue;
+      }
+      vtkInternals::DensityPlot densityPlot;
+      densityPlot.Chart = chart;
+      for (vtkIdType cc = 0; cc < chart->GetNumberOfPlots(); ++cc)
+      {
+        vtkPlot* plot = chart->GetPlot(cc);
+        if (plot && plot->GetVisible())
+        {
+          plot->SetVisible(false);
+          densityPlot.HiddenPlots.emplace_back(plot);
+        }
+      }
+      densityPlot.Plot = vtkSmartPointer<vtkPlotHistogram2D>::New();
+      densityPlot.Plot->SetInputData(image->second);
+      densityPlot.Plot->SetTransferFunction(lut);
+      chart->AddPlot(densityPlot.Plot);
+      this->Internals->DensityPlots.push_back(densityPlot);
+    }
   }
 }
 
@@ -240,14 +562,59 @@ void vtkPVPlotMatrixRepresentation::SetSeriesVisibility(const char* series, bool
 {
   assert(series != nullptr);
   this->Internals->SeriesVisibilities.push_back(std::pair<std::string, bool>(series, visibility));
-  this->Modified();
+  // the density images are only computed for the visible series.
+  if (this->BinnedDensity)
+  {
+    this->MarkModified();
+  }
+  else
+  {
+    this->Modified();
+  }
 }
 
 //----------------------------------------------------------------------------
 void vtkPVPlotMatrixRepresentation::ClearSeriesVisibilities()
 {
   this->Internals->SeriesVisibilities.clear();
-  this->Modified();
+  if (this->BinnedDensity)
+  {
+    this->MarkModified();
+  }
+  else
+  {
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVPlotMatrixRepresentation::SetBinnedDensity(bool binned)
+{
+  if (this->BinnedDensity != binned)
+  {
+    this->BinnedDensity = binned;
+    this->MarkModified();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVPlotMatrixRepresentation::SetNumberOfDensityBins(int bins)
+{
+  if (this->NumberOfDensityBins != bins)
+  {
+    this->NumberOfDensityBins = bins;
+    this->MarkModified();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVPlotMatrixRepresentation::SetMaximumNumberOfSampledRows(vtkIdType rows)
+{
+  if (this->MaximumNumberOfSampledRows != rows)
+  {
+    this->MaximumNumberOfSampledRows = rows;
+    this->MarkModified();
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -375,6 +742,9 @@ void vtkPVPlotMatrixRepresentation::SetActivePlotDensityMapLastDecileColor(
 void vtkPVPlotMatrixRepresentation::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "BinnedDensity: " << this->BinnedDensity << endl;
+  os << indent << "NumberOfDensityBins: " << this->NumberOfDensityBins << endl;
+  os << indent << "MaximumNumberOfSampledRows: " << this->MaximumNumberOfSampledRows << endl;
 }
 
 //----------------------------------------------------------------------------
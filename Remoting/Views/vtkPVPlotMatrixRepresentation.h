@@ -13,6 +13,12 @@
  *
  * vtkPVPlotMatrixRepresentation currently does not support multiblock of tables
  * and only the first table is rendered.
+ *
+ * When BinnedDensity is on, the 2D histograms of all pairs of visible columns
+ * are computed on the data server in a single parallel pass (see
+ * vtkPVPairwiseHistograms2D) and the scatter plots of the matrix are drawn as
+ * density images. Only a sample of about MaximumNumberOfSampledRows rows is
+ * then delivered for the active plot and the histograms on the diagonal.
  */
 
 #ifndef vtkPVPlotMatrixRepresentation_h
@@ -132,6 +138,35 @@ public:
    */
   void SetActivePlotDensityMapLastDecileColor(double r, double g, double b);
 
+  ///@{
+  /**
+   * When on, the scatter plots are drawn as density images computed on the
+   * data server and only a sample of the rows is delivered. This scales to
+   * tables with many more rows than can be drawn as points. Default is off.
+   */
+  void SetBinnedDensity(bool binned);
+  vtkGetMacro(BinnedDensity, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set the number of bins along each axis of the density images.
+   * Default is 64.
+   */
+  void SetNumberOfDensityBins(int bins);
+  vtkGetMacro(NumberOfDensityBins, int);
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set the maximum number of rows delivered when BinnedDensity is on.
+   * The rows holding the extrema of the visible columns are always delivered
+   * so that the axes span the full range of the data. Default is 10000.
+   */
+  void SetMaximumNumberOfSampledRows(vtkIdType rows);
+  vtkGetMacro(MaximumNumberOfSampledRows, vtkIdType);
+  ///@}
+
   /**
    * Returns the scatter plot matrix.
    */
@@ -157,6 +192,12 @@ protected:
    */
   bool RemoveFromView(vtkView* view) override;
 
+  /**
+   * Overridden to compute the density images and sample the rows when
+   * BinnedDensity is on.
+   */
+  vtkSmartPointer<vtkDataObject> ReduceDataToRoot(vtkDataObject* data) override;
+
 private:
   vtkPVPlotMatrixRepresentation(const vtkPVPlotMatrixRepresentation&) = delete;
   void operator=(const vtkPVPlotMatrixRepresentation&) = delete;
@@ -164,6 +205,16 @@ private:
   class vtkInternals;
   vtkInternals* Internals;
 
+  /**
+   * Adds the delivered density images to the scatter plots of the matrix, or
+   * removes the ones previously added.
+   */
+  void UpdateDensityPlots(vtkScatterPlotMatrix* plotMatrix, vtkStringArray* visibleColumns);
+
+  bool BinnedDensity = false;
+  int NumberOfDensityBins = 64;
+  vtkIdType MaximumNumberOfSampledRows = 10000;
+
   vtkColor4ub ActivePlotColor;
   vtkColor4ub ScatterPlotColor;
   vtkColor4ub HistogramColor;
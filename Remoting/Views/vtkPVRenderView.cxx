@@ -42,6 +42,7 @@
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkOrderedCompositingHelper.h"
+#include "vtkPVAdaptiveRenderingController.h"
 #include "vtkPVAxesWidget.h"
 #include "vtkPVCameraCollection.h"
 #include "vtkPVCenterAxesActor.h"
@@ -69,6 +70,7 @@
 #include "vtkPointData.h"
 #include "vtkPolarAxesActor2D.h"
 #include "vtkProcessModule.h"
+#include "vtkPropCollection.h"
 #include "vtkRenderViewBase.h"
 #include "vtkRenderWindow.h"
 #include "vtkRenderWindowInteractor.h"
@@ -102,10 +104,12 @@
 #include "vtkOSPRayRendererNode.h"
 #endif
 
+#include <algorithm>
 #include <cassert>
 #include <map>
 #include <set>
 #include <sstream>
+#include <string>
 #include <vector>
 namespace
 {
@@ -129,6 +133,9 @@ public:
 
   vtkSmartPointer<vtkImageProcessingPass> SavedImageProcessingPass;
   vtkNew<vtkToneMappingPass> ToneMappingPass;
+
+  // Array used to capture the selection buffers, empty for ids.
+  std::string SelectionBuffersArrayName;
   vtkSmartPointer<vtkRenderPass> SavedRenderPass;
 
   // State variables to maintain flags between BeginValuePassForRendering
@@ -342,6 +349,23 @@ void vtkUpdateTrackballZoomManipulators(
     }
   }
 }
+
+// Volumes are not supported by layered compositing since they do not render
+// depths.
+bool vtkHasVisibleVolumes(vtkRenderer* renderer)
+{
+  vtkPropCollection* props = renderer->GetViewProps();
+  vtkCollectionSimpleIterator iter;
+  props->InitTraversal(iter);
+  while (vtkProp* prop = props->GetNextProp(iter))
+  {
+    if (prop->GetVisibility() && prop->IsA("vtkVolume"))
+    {
+      return true;
+    }
+  }
+  return false;
+}
 }
 
 //----------------------------------------------------------------------------
@@ -385,6 +409,10 @@ vtkPVRenderView::vtkPVRenderView()
   this->PreviousSwapBuffers = 0;
   this->StillRenderImageReductionFactor = 1;
   this->InteractiveRenderImageReductionFactor = 2;
+  this->UseAdaptiveInteractiveRender = false;
+  this->AdaptiveImageReductionFactor = 0;
+  this->AdaptiveCompressionLossLevel = 0;
+  this->RefinementImageReductionFactor = 0;
   this->RemoteRenderingThreshold = 0;
   this->LODRenderingThreshold = 0;
   this->LODResolution = 0.5;
@@ -409,6 +437,7 @@ vtkPVRenderView::vtkPVRenderView()
   this->Selector = vtkSmartPointer<vtkPVHardwareSelector>::New();
   this->Selector->SetView(this); // not reference counted.
   this->NeedsOrderedCompositing = false;
+  this->NumberOfCompositingLayers = 0;
   this->RenderEmptyImages = false;
   this->UseFXAA = false;
   this->UseSSAO = false;
@@ -980,6 +1009,11 @@ void vtkPVRenderView::Select(int fieldAssociation, int region[4], const char* ar
     return;
   }
 
+  if (this->Selector->NeedToRenderForSelection())
+  {
+    this->Internals->SelectionBuffersArrayName = array ? array : "";
+  }
+
   vtkSmartPointer<vtkSelection> sel;
   // we don't render labels for hardware selection
   this->NonCompositedRenderer->SetDraw(false);
@@ -988,6 +1022,32 @@ void vtkPVRenderView::Select(int fieldAssociation, int region[4], const char* ar
   this->PostSelect(sel, array);
 }
 
+//----------------------------------------------------------------------------
+void vtkPVRenderView::SelectFromCache(int fieldAssociation, int region[4], const char* array)
+{
+  if (this->MakingSelection)
+  {
+    vtkErrorMacro("SelectFromCache was called while making another selection.");
+    return;
+  }
+
+  this->SetLastSelection(nullptr);
+  if (this->Internals->SelectionBuffersArrayName != (array ? array : ""))
+  {
+    return;
+  }
+
+  this->Selector->SetRenderer(this->GetRenderer());
+  this->Selector->SetFieldAssociation(fieldAssociation);
+
+  vtkSmartPointer<vtkSelection> sel;
+  sel.TakeReference(this->Selector->SelectFromCache(region));
+  if (sel)
+  {
+    this->FinishSelection(sel, array);
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkPVRenderView::PostSelect(vtkSelection* sel, const char* array)
 {
@@ -1045,6 +1105,11 @@ void vtkPVRenderView::SelectPolygon(int fieldAssociation, int* polygonPoints, vt
     return;
   }
 
+  if (this->Selector->NeedToRenderForSelection())
+  {
+    this->Internals->SelectionBuffersArrayName.clear();
+  }
+
   vtkSmartPointer<vtkSelection> sel;
   // we don't render labels for hardware selection
   this->NonCompositedRenderer->SetDraw(false);
@@ -1468,6 +1533,8 @@ void vtkPVRenderView::Update()
 
   // Update decisions about lod-rendering and remote-rendering.
   this->UseLODForInteractiveRender = this->ShouldUseLODRendering(geometry_size);
+  // frame time estimates do not apply to the new geometry.
+  this->AdaptiveRenderingController->Reset();
   this->UseDistributedRenderingForRender =
     this->ShouldUseDistributedRendering(geometry_size, /*using_lod=*/false);
   if (!this->UseLODForInteractiveRender)
@@ -1556,7 +1623,20 @@ void vtkPVRenderView::StillRender()
 
   this->Internals->PreRender(this->RenderView);
 
+  // when interaction stops, this still render may be an intermediate frame,
+  // the full resolution one being scheduled by the caller, see
+  // SetAdaptiveRenderParameters().
+  const int still_factor = this->StillRenderImageReductionFactor;
+  if (this->RefinementImageReductionFactor > still_factor && !this->MakingSelection)
+  {
+    vtkVLogF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "refinement frame (image reduction factor: %d)",
+      this->RefinementImageReductionFactor);
+    this->StillRenderImageReductionFactor = this->RefinementImageReductionFactor;
+  }
+  this->RefinementImageReductionFactor = 0;
+
   this->Render(false, this->SuppressRendering);
+  this->StillRenderImageReductionFactor = still_factor;
 
   vtkTimerLog::MarkEndEvent("Still Render");
 }
@@ -1650,6 +1730,10 @@ void vtkPVRenderView::Render(bool interactive, bool skip_rendering)
 
   // Use loss-less image compression for client-server for full-res renders.
   this->SynchronizedRenderers->SetLossLessCompression(!interactive);
+  const bool use_adaptive_parameters =
+    interactive && this->UseAdaptiveInteractiveRender && this->AdaptiveImageReductionFactor > 0;
+  this->SynchronizedRenderers->SetCompressionLossLevel(
+    use_adaptive_parameters ? this->AdaptiveCompressionLossLevel : 0);
 
   bool use_lod_rendering = interactive ? this->GetUseLODForInteractiveRender() : false;
   if (use_lod_rendering)
@@ -1672,9 +1756,24 @@ void vtkPVRenderView::Render(bool interactive, bool skip_rendering)
     "use_lod=%d, use_distributed_rendering=%d, use_ordered_compositing=%d", use_lod_rendering,
     use_distributed_rendering, use_ordered_compositing);
 
+  // translucent geometry may be composited in depth layers instead of
+  // redistributing the data, unless volumes need to be sorted too.
+  const bool use_layered_compositing = use_ordered_compositing &&
+    this->NumberOfCompositingLayers > 0 && !this->InTileDisplayMode() &&
+    !vtkHasVisibleVolumes(this->GetRenderer());
+
   auto deliveryManager =
     vtkPVRenderViewDataDeliveryManager::SafeDownCast(this->GetDeliveryManager());
-  if (use_ordered_compositing)
+  if (use_layered_compositing)
+  {
+    vtkVLogF(PARAVIEW_LOG_RENDERING_VERBOSITY(),
+      "Using ordered compositing w/ %d depth layers, without data redistribution",
+      this->NumberOfCompositingLayers);
+    this->SynchronizedRenderers->SetOrderedCompositingHelper(nullptr);
+    this->SynchronizedRenderers->SetNumberOfCompositingLayers(this->NumberOfCompositingLayers);
+    deliveryManager->SetUseRedistributedDataAsDeliveredData(false);
+  }
+  else if (use_ordered_compositing)
   {
     vtkTimerLog::FormatAndMarkEvent("Using ordered compositing w/ data redistribution, if needed");
     vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(),
@@ -1693,11 +1792,13 @@ void vtkPVRenderView::Render(bool interactive, bool skip_rendering)
     // tell `this->SynchronizedRenderers` who to order the ranks when doing
     // parallel rendering.
     this->SynchronizedRenderers->SetOrderedCompositingHelper(this->OrderedCompositingHelper);
+    this->SynchronizedRenderers->SetNumberOfCompositingLayers(0);
     deliveryManager->SetUseRedistributedDataAsDeliveredData(true);
   }
   else
   {
     this->SynchronizedRenderers->SetOrderedCompositingHelper(nullptr);
+    this->SynchronizedRenderers->SetNumberOfCompositingLayers(0);
     deliveryManager->SetUseRedistributedDataAsDeliveredData(false);
   }
 
@@ -1711,9 +1812,10 @@ void vtkPVRenderView::Render(bool interactive, bool skip_rendering)
     vtkPVView::REQUEST_RENDER(), this->RequestInformation, this->ReplyInformationVector);
 
   // set the image reduction factor.
-  this->SynchronizedRenderers->SetImageReductionFactor(
-    (interactive ? this->InteractiveRenderImageReductionFactor
-                 : this->StillRenderImageReductionFactor));
+  this->SynchronizedRenderers->SetImageReductionFactor(use_adaptive_parameters
+      ? this->AdaptiveImageReductionFactor
+      : (interactive ? this->InteractiveRenderImageReductionFactor
+                     : this->StillRenderImageReductionFactor));
 
   this->UsedLODForLastRender = use_lod_rendering;
 
@@ -1805,6 +1907,25 @@ void vtkPVRenderView::Render(bool interactive, bool skip_rendering)
     this->Timer->StopTimer();
   }
 
+  if (interactive && this->UseAdaptiveInteractiveRender && !this->MakingSelection &&
+    vtkProcessModule::GetProcessType() == vtkProcessModule::PROCESS_CLIENT)
+  {
+    // the stage times are only known when the image comes from the server,
+    // otherwise the whole frame is considered as geometry rendering.
+    double times[4] = { this->Timer->GetElapsedTime(), 0.0, 0.0, 0.0 };
+    if (use_distributed_rendering)
+    {
+      this->SynchronizedRenderers->GetLastFrameTimes(times);
+    }
+    auto controller = this->AdaptiveRenderingController.Get();
+    controller->AddInteractiveFrame(times[0], times[1], times[2], times[3], use_lod_rendering);
+    vtkVLogF(PARAVIEW_LOG_RENDERING_VERBOSITY(),
+      "frame times: render %lf, composite %lf, compress %lf, transfer %lf; next frame: "
+      "image reduction factor %d, lod %d, compression loss level %d",
+      times[0], times[1], times[2], times[3], controller->GetImageReductionFactor(),
+      controller->GetUseLOD() ? 1 : 0, controller->GetCompressionLossLevel());
+  }
+
   if (!this->MakingSelection)
   {
     // If we are making selection, then it's a multi-step render process and we
@@ -3317,6 +3438,44 @@ void vtkPVRenderView::SetPosition(int x, int y)
   this->Superclass::SetPosition(x, y);
 }
 
+//----------------------------------------------------------------------------
+void vtkPVRenderView::SetTargetInteractiveFrameRate(double fps)
+{
+  if (fps != this->AdaptiveRenderingController->GetTargetFrameRate())
+  {
+    this->AdaptiveRenderingController->SetTargetFrameRate(fps);
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+double vtkPVRenderView::GetTargetInteractiveFrameRate()
+{
+  return this->AdaptiveRenderingController->GetTargetFrameRate();
+}
+
+//----------------------------------------------------------------------------
+vtkPVAdaptiveRenderingController* vtkPVRenderView::GetAdaptiveRenderingController()
+{
+  return this->AdaptiveRenderingController;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVRenderView::SetAdaptiveRenderParameters(int imageReductionFactor, int useLOD,
+  int compressionLossLevel, int refinementImageReductionFactor)
+{
+  if (imageReductionFactor > 0)
+  {
+    this->AdaptiveImageReductionFactor = std::min(imageReductionFactor, 20);
+    this->AdaptiveCompressionLossLevel = compressionLossLevel;
+  }
+  if (useLOD != 0)
+  {
+    this->UseLODForInteractiveRender = true;
+  }
+  this->RefinementImageReductionFactor = std::min(refinementImageReductionFactor, 20);
+}
+
 //----------------------------------------------------------------------------
 void vtkPVRenderView::BuildAnnotationText(ostream& str)
 {
@@ -42,6 +42,7 @@ class vtkMatrix4x4;
 class vtkOrderedCompositingHelper;
 class vtkPolarAxesActor2D;
 class vtkProp;
+class vtkPVAdaptiveRenderingController;
 class vtkPVAxesWidget;
 class vtkPVCameraCollection;
 class vtkPVCenterAxesActor;
@@ -235,6 +236,49 @@ public:
   vtkGetMacro(InteractiveRenderImageReductionFactor, int);
   ///@}
 
+  ///@{
+  /**
+   * When enabled, the image reduction factor, the use of LOD and the image
+   * compression quality of interactive renders are picked from the measured
+   * frame times to meet TargetInteractiveFrameRate, and the image is refined
+   * progressively when interaction stops. InteractiveRenderImageReductionFactor
+   * is then ignored. Off by default.
+   * \note CallOnAllProcesses
+   */
+  vtkSetMacro(UseAdaptiveInteractiveRender, bool);
+  vtkGetMacro(UseAdaptiveInteractiveRender, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set the interactive frame rate, in frames per second, targeted when
+   * UseAdaptiveInteractiveRender is enabled. Default is 10.
+   */
+  void SetTargetInteractiveFrameRate(double fps);
+  double GetTargetInteractiveFrameRate();
+  ///@}
+
+  /**
+   * Provides access to the controller picking the interactive render
+   * parameters when UseAdaptiveInteractiveRender is enabled. It is only fed
+   * on the client side.
+   */
+  vtkPVAdaptiveRenderingController* GetAdaptiveRenderingController();
+
+  /**
+   * Sets the parameters picked by the adaptive rendering controller of the
+   * client for the next render. vtkSMRenderViewProxy calls this on all
+   * processes before rendering so that they all agree. The first three are
+   * only updated when `imageReductionFactor` is greater than 0, and LOD can
+   * only be turned on, until the next Update(). When
+   * `refinementImageReductionFactor` is greater than the still render one, the
+   * next StillRender() renders an intermediate frame with that factor; the
+   * full resolution frame is left to a later StillRender(), see
+   * vtkSMRenderViewProxy::RefiningStillRender().
+   */
+  void SetAdaptiveRenderParameters(int imageReductionFactor, int useLOD,
+    int compressionLossLevel, int refinementImageReductionFactor);
+
   ///@{
   /**
    * Get/Set the data-size in megabytes above which remote-rendering should be
@@ -377,6 +421,15 @@ public:
   void Select(int field_association, int region[4], const char* array = nullptr);
   ///@}
 
+  /**
+   * Same as Select() except that the selection is made only from the selection
+   * buffers captured by a previous selection with the same `array`, without
+   * rendering. This is meant to be called on the client (or driver) alone, for
+   * instance for hover queries. LastSelection is set to nullptr if the
+   * buffers cannot be reused, see vtkPVHardwareSelector::SelectFromCache.
+   */
+  void SelectFromCache(int field_association, int region[4], const char* array = nullptr);
+
   ///@{
   /**
    * Make a selection with a polygon. The polygon2DArray should contain
@@ -868,6 +921,20 @@ public:
    */
   bool GetUseOrderedCompositing();
 
+  ///@{
+  /**
+   * Get/Set the number of depth layers used to composite translucent geometry
+   * when ordered compositing is needed. When greater than 0, the data is not
+   * redistributed across ranks: the image of each rank is sorted per pixel
+   * using the depth of its front-most fragment, compositing up to that many
+   * layers (see vtkIceTCompositePass::SetNumberOfCompositingLayers). This is
+   * ignored in tile display mode and when volumes are visible, which still
+   * require data redistribution. Default is 0, i.e. data is redistributed.
+   */
+  vtkSetClampMacro(NumberOfCompositingLayers, int, 0, 64);
+  vtkGetMacro(NumberOfCompositingLayers, int);
+  ///@}
+
   /**
    * Returns true when the compositor should not use the empty
    * images optimization.
@@ -1258,6 +1325,11 @@ protected:
 
   int StillRenderImageReductionFactor;
   int InteractiveRenderImageReductionFactor;
+  bool UseAdaptiveInteractiveRender;
+  vtkNew<vtkPVAdaptiveRenderingController> AdaptiveRenderingController;
+  int AdaptiveImageReductionFactor;
+  int AdaptiveCompressionLossLevel;
+  int RefinementImageReductionFactor;
   int InteractionMode;
   bool ShowAnnotation;
   bool UpdateAnnotation;
@@ -1293,6 +1365,7 @@ protected:
 
   bool UseInteractiveRenderingForScreenshots;
   bool NeedsOrderedCompositing;
+  int NumberOfCompositingLayers;
   bool RenderEmptyImages;
 
   bool UseFXAA;
@@ -110,6 +110,18 @@ public:
   vtkGetMacro(EnableFastPreselection, bool);
   ///@}
 
+  ///@{
+  /**
+   * When enabled, single-pixel selections made while hovering, for
+   * preselection and tooltips, are answered on the client from the selection
+   * buffers captured previously as long as the camera and the geometry did not
+   * change, instead of rendering on all rendering processes each time the
+   * mouse moves. Default is true.
+   */
+  vtkSetMacro(EnableHoverSelectionCache, bool);
+  vtkGetMacro(EnableHoverSelectionCache, bool);
+  ///@}
+
   ///@{
   /**
    * When enabled and growing selection, remove the initial selection seed.
@@ -161,6 +173,7 @@ protected:
   int PointPickingRadius;
   bool DisableIceT;
   bool EnableFastPreselection;
+  bool EnableHoverSelectionCache = true;
   bool GrowSelectionRemoveSeed = false;
   bool GrowSelectionRemoveIntermediateLayers = false;
 
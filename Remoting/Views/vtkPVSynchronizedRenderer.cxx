@@ -228,6 +228,30 @@ void vtkPVSynchronizedRenderer::SetLossLessCompression(bool val)
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkPVSynchronizedRenderer::SetCompressionLossLevel(int level)
+{
+  vtkPVClientServerSynchronizedRenderers* cssync =
+    vtkPVClientServerSynchronizedRenderers::SafeDownCast(this->CSSynchronizer);
+  if (cssync)
+  {
+    cssync->SetCompressionLossLevel(level);
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVSynchronizedRenderer::GetLastFrameTimes(double times[4])
+{
+  vtkPVClientServerSynchronizedRenderers* cssync =
+    vtkPVClientServerSynchronizedRenderers::SafeDownCast(this->CSSynchronizer);
+  if (cssync)
+  {
+    cssync->GetLastFrameTimes(times);
+    return true;
+  }
+  return false;
+}
+
 //----------------------------------------------------------------------------
 void vtkPVSynchronizedRenderer::ConfigureCompressor(const char* configuration)
 {
@@ -456,6 +480,20 @@ void vtkPVSynchronizedRenderer::SetOrderedCompositingHelper(vtkOrderedCompositin
   (void)helper;
 }
 
+//----------------------------------------------------------------------------
+void vtkPVSynchronizedRenderer::SetNumberOfCompositingLayers(int layers)
+{
+#if VTK_MODULE_ENABLE_ParaView_icet
+  vtkIceTSynchronizedRenderers* sync =
+    vtkIceTSynchronizedRenderers::SafeDownCast(this->ParallelSynchronizer);
+  if (sync)
+  {
+    sync->SetNumberOfCompositingLayers(layers);
+  }
+#endif
+  (void)layers;
+}
+
 //----------------------------------------------------------------------------
 void vtkPVSynchronizedRenderer::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -61,6 +61,12 @@ public:
    */
   void SetOrderedCompositingHelper(vtkOrderedCompositingHelper* helper);
 
+  /**
+   * Set the number of depth layers used to composite translucent geometry
+   * without redistributing data. 0 disables it.
+   */
+  void SetNumberOfCompositingLayers(int layers);
+
   /**
    * Set the renderer that is being synchronized.
    */
@@ -125,8 +131,17 @@ public:
    */
   void ConfigureCompressor(const char* configuration);
   void SetLossLessCompression(bool);
+  void SetCompressionLossLevel(int);
   ///@}
 
+  /**
+   * Provides the stage times of the last image received from the server.
+   * Returns false if not in client-server mode.
+   * See vtkPVClientServerSynchronizedRenderers::GetLastFrameTimes() for
+   * details.
+   */
+  bool GetLastFrameTimes(double times[4]);
+
   /**
    * Activates or de-activated the use of Depth Buffer in an ImageProcessingPass
    */
@@ -17,13 +17,17 @@
 #include "vtkMultiBlockDataSet.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVLODActor.h"
 #include "vtkPVRenderView.h"
 #include "vtkPiecewiseFunction.h"
 #include "vtkPointData.h"
+#include "vtkPointGaussianLODFilter.h"
 #include "vtkPointGaussianMapper.h"
 #include "vtkProperty.h"
 #include "vtkRenderer.h"
 
+#include <cmath>
+
 // FIXME: remove once paraview/paraview#20385 is fixed.
 #define USE_VERTEX_CELLS 1
 
@@ -32,8 +36,13 @@ vtkStandardNewMacro(vtkPointGaussianRepresentation);
 vtkPointGaussianRepresentation::vtkPointGaussianRepresentation()
 {
   this->Mapper = vtkSmartPointer<vtkPointGaussianMapper>::New();
-  this->Actor = vtkSmartPointer<vtkActor>::New();
+  this->LODMapper = vtkSmartPointer<vtkPointGaussianMapper>::New();
+  this->LODFilter = vtkSmartPointer<vtkPointGaussianLODFilter>::New();
+  this->Actor = vtkSmartPointer<vtkPVLODActor>::New();
   this->Actor->SetMapper(this->Mapper);
+  this->Actor->SetLODMapper(this->LODMapper);
+  // the LOD splats are sized by the radius computed by the LOD filter.
+  this->LODMapper->SetScaleArray(vtkPointGaussianLODFilter::GetLODScaleArrayName());
   this->ScaleByArray = false;
   this->LastScaleArray = nullptr;
   this->LastScaleArrayComponent = 0;
@@ -167,6 +176,7 @@ void vtkPointGaussianRepresentation::SetVisibility(bool val)
 void vtkPointGaussianRepresentation::SetEmissive(bool val)
 {
   this->Mapper->SetEmissive(val);
+  this->LODMapper->SetEmissive(val);
 }
 
 //----------------------------------------------------------------------------
@@ -180,6 +190,7 @@ void vtkPointGaussianRepresentation::SetMapScalars(int val)
   }
   int mapToColorMode[] = { VTK_COLOR_MODE_DIRECT_SCALARS, VTK_COLOR_MODE_MAP_SCALARS };
   this->Mapper->SetColorMode(mapToColorMode[val]);
+  this->LODMapper->SetColorMode(mapToColorMode[val]);
 }
 
 //----------------------------------------------------------------------------
@@ -273,10 +284,38 @@ int vtkPointGaussianRepresentation::ProcessViewRequest(
     vtkPVRenderView::SetOrderedCompositingConfiguration(inInfo, this,
       vtkPVRenderView::DATA_IS_REDISTRIBUTABLE | vtkPVRenderView::USE_DATA_FOR_LOAD_BALANCING);
   }
+  else if (request_type == vtkPVView::REQUEST_UPDATE_LOD())
+  {
+    // The LOD aggregates the splats in the leaves of an octree whose depth
+    // follows the LOD resolution, from 16 to 1024 leaves along each axis.
+    auto data = vtkPVView::GetPiece(inInfo, this);
+    if (data != nullptr && !this->SuppressLOD)
+    {
+      if (inInfo->Has(vtkPVRenderView::LOD_RESOLUTION()))
+      {
+        const double factor = inInfo->Get(vtkPVRenderView::LOD_RESOLUTION());
+        this->LODFilter->SetDepth(4 + static_cast<int>(std::round(6 * factor)));
+      }
+      vtkInformation* info = this->GetInputArrayInformation(0);
+      const bool colorByPoints = info && info->Has(vtkDataObject::FIELD_NAME()) &&
+        info->Has(vtkDataObject::FIELD_ASSOCIATION()) &&
+        info->Get(vtkDataObject::FIELD_ASSOCIATION()) == vtkDataObject::FIELD_ASSOCIATION_POINTS;
+      this->LODFilter->SetColorArrayName(
+        colorByPoints ? info->Get(vtkDataObject::FIELD_NAME()) : nullptr);
+      this->LODFilter->SetInputDataObject(data);
+      this->LODFilter->Update();
+      vtkPVView::SetPieceLOD(inInfo, this, this->LODFilter->GetOutputDataObject(0));
+    }
+  }
   else if (request_type == vtkPVView::REQUEST_RENDER())
   {
     auto data = vtkPVView::GetDeliveredPiece(inInfo, this);
+    auto dataLOD = vtkPVView::GetDeliveredPieceLOD(inInfo, this);
     this->Mapper->SetInputDataObject(data);
+    this->LODMapper->SetInputDataObject(dataLOD);
+
+    const bool lod = !this->SuppressLOD && dataLOD && inInfo->Has(vtkPVRenderView::USE_LOD());
+    this->Actor->SetEnableLOD(lod ? 1 : 0);
     this->UpdateColoringParameters();
   }
   return 1;
@@ -294,25 +333,33 @@ void vtkPointGaussianRepresentation::UpdateColoringParameters()
     if (colorArrayName && colorArrayName[0])
     {
       this->Mapper->SetScalarVisibility(1);
+      this->LODMapper->SetScalarVisibility(1);
       this->Mapper->SelectColorArray(colorArrayName);
+      this->LODMapper->SelectColorArray(colorArrayName);
       this->Mapper->SetUseLookupTableScalarRange(1);
+      this->LODMapper->SetUseLookupTableScalarRange(1);
     }
     else
     {
       this->Mapper->SetScalarVisibility(0);
+      this->LODMapper->SetScalarVisibility(0);
       this->Mapper->SelectColorArray(static_cast<const char*>(nullptr));
+      this->LODMapper->SelectColorArray(static_cast<const char*>(nullptr));
     }
 
     switch (fieldAssociation)
     {
       case vtkDataObject::FIELD_ASSOCIATION_CELLS:
         this->Mapper->SetScalarVisibility(0);
+        this->LODMapper->SetScalarVisibility(0);
         this->Mapper->SelectColorArray(static_cast<const char*>(nullptr));
+        this->LODMapper->SelectColorArray(static_cast<const char*>(nullptr));
         break;
 
       case vtkDataObject::FIELD_ASSOCIATION_POINTS:
       default:
         this->Mapper->SetScalarMode(VTK_SCALAR_MODE_USE_POINT_FIELD_DATA);
+        this->LODMapper->SetScalarMode(VTK_SCALAR_MODE_USE_POINT_FIELD_DATA);
         break;
     }
   }
@@ -322,6 +369,7 @@ void vtkPointGaussianRepresentation::UpdateColoringParameters()
 void vtkPointGaussianRepresentation::SetLookupTable(vtkScalarsToColors* lut)
 {
   this->Mapper->SetLookupTable(lut);
+  this->LODMapper->SetLookupTable(lut);
 }
 
 //----------------------------------------------------------------------------
@@ -331,6 +379,7 @@ void vtkPointGaussianRepresentation::SetCustomShader(const char* shaderString)
   if (this->SelectedPreset == vtkPointGaussianRepresentation::CUSTOM)
   {
     this->Mapper->SetSplatShaderCode(this->PresetShaderStrings[this->SelectedPreset].c_str());
+    this->LODMapper->SetSplatShaderCode(this->PresetShaderStrings[this->SelectedPreset].c_str());
   }
 }
 
@@ -341,6 +390,7 @@ void vtkPointGaussianRepresentation::SetCustomTriangleScale(double scale)
   if (this->SelectedPreset == vtkPointGaussianRepresentation::CUSTOM)
   {
     this->Mapper->SetBoundScale(this->PresetShaderScales[this->SelectedPreset]);
+    this->LODMapper->SetBoundScale(this->PresetShaderScales[this->SelectedPreset]);
   }
 }
 
@@ -351,7 +401,9 @@ void vtkPointGaussianRepresentation::SelectShaderPreset(int preset)
   {
     this->SelectedPreset = preset;
     this->Mapper->SetSplatShaderCode(this->PresetShaderStrings[preset].c_str());
+    this->LODMapper->SetSplatShaderCode(this->PresetShaderStrings[preset].c_str());
     this->Mapper->SetBoundScale(this->PresetShaderScales[preset]);
+    this->LODMapper->SetBoundScale(this->PresetShaderScales[preset]);
   }
 }
 
@@ -359,6 +411,9 @@ void vtkPointGaussianRepresentation::SelectShaderPreset(int preset)
 void vtkPointGaussianRepresentation::SetSplatSize(double radius)
 {
   this->Mapper->SetScaleFactor(radius);
+  this->LODFilter->SetScaleFactor(radius);
+  // a null splat size renders points, in the LOD too.
+  this->LODMapper->SetScaleFactor(radius == 0.0 ? 0.0 : 1.0);
 }
 
 //----------------------------------------------------------------------------
@@ -369,7 +424,10 @@ void vtkPointGaussianRepresentation::SetScaleByArray(bool newVal)
     this->ScaleByArray = newVal;
     this->Modified();
     this->Mapper->SetScaleArray(this->ScaleByArray ? this->LastScaleArray : nullptr);
+    this->LODFilter->SetScaleArrayName(this->ScaleByArray ? this->LastScaleArray : nullptr);
     this->Mapper->SetScaleArrayComponent(this->ScaleByArray ? this->LastScaleArrayComponent : 0);
+    this->LODFilter->SetScaleArrayComponent(
+      this->ScaleByArray ? this->LastScaleArrayComponent : 0);
   }
 }
 
@@ -399,6 +457,7 @@ void vtkPointGaussianRepresentation::SetScaleTransferFunction(vtkPiecewiseFuncti
 void vtkPointGaussianRepresentation::UpdateMapperScaleFunction()
 {
   this->Mapper->SetScaleFunction(this->UseScaleFunction ? this->ScaleFunction : nullptr);
+  this->LODFilter->SetScaleFunction(this->UseScaleFunction ? this->ScaleFunction : nullptr);
 }
 
 //----------------------------------------------------------------------------
@@ -406,6 +465,7 @@ void vtkPointGaussianRepresentation::SelectScaleArray(int, int, int, int, const
 {
   this->SetLastScaleArray(name);
   this->Mapper->SetScaleArray(this->ScaleByArray ? name : nullptr);
+  this->LODFilter->SetScaleArrayName(this->ScaleByArray ? name : nullptr);
 }
 
 //----------------------------------------------------------------------------
@@ -413,6 +473,7 @@ void vtkPointGaussianRepresentation::SelectScaleArrayComponent(int component)
 {
   this->LastScaleArrayComponent = component;
   this->Mapper->SetScaleArrayComponent(this->ScaleByArray ? component : 0);
+  this->LODFilter->SetScaleArrayComponent(this->ScaleByArray ? component : 0);
 }
 
 //----------------------------------------------------------------------------
@@ -423,8 +484,12 @@ void vtkPointGaussianRepresentation::SetOpacityByArray(bool newVal)
     this->OpacityByArray = newVal;
     this->Modified();
     this->Mapper->SetOpacityArray(this->OpacityByArray ? this->LastOpacityArray : nullptr);
+    this->LODMapper->SetOpacityArray(this->OpacityByArray ? this->LastOpacityArray : nullptr);
+    this->LODFilter->SetOpacityArrayName(this->OpacityByArray ? this->LastOpacityArray : nullptr);
     this->Mapper->SetOpacityArrayComponent(
       this->OpacityByArray ? this->LastOpacityArrayComponent : 0);
+    this->LODMapper->SetOpacityArrayComponent(
+      this->OpacityByArray ? this->LastOpacityArrayComponent : 0);
   }
 }
 
@@ -432,6 +497,7 @@ void vtkPointGaussianRepresentation::SetOpacityByArray(bool newVal)
 void vtkPointGaussianRepresentation::SetOpacityTransferFunction(vtkPiecewiseFunction* pwf)
 {
   this->Mapper->SetScalarOpacityFunction(pwf);
+  this->LODMapper->SetScalarOpacityFunction(pwf);
 }
 
 //----------------------------------------------------------------------------
@@ -439,6 +505,8 @@ void vtkPointGaussianRepresentation::SelectOpacityArray(int, int, int, int, cons
 {
   this->SetLastOpacityArray(name);
   this->Mapper->SetOpacityArray(this->OpacityByArray ? name : nullptr);
+  this->LODMapper->SetOpacityArray(this->OpacityByArray ? name : nullptr);
+  this->LODFilter->SetOpacityArrayName(this->OpacityByArray ? name : nullptr);
 }
 
 //----------------------------------------------------------------------------
@@ -446,6 +514,7 @@ void vtkPointGaussianRepresentation::SelectOpacityArrayComponent(int component)
 {
   this->LastOpacityArrayComponent = component;
   this->Mapper->SetOpacityArrayComponent(this->OpacityByArray ? component : 0);
+  this->LODMapper->SetOpacityArrayComponent(this->OpacityByArray ? component : 0);
 }
 
 //----------------------------------------------------------------------------
@@ -5,6 +5,11 @@
  *
  * Representation for showing point data as sprites, including gaussian
  * splats, spheres, or some custom shaded representation.
+ *
+ * When the view requests LOD, the splats are aggregated in the leaves of an
+ * octree using vtkPointGaussianLODFilter: the color and opacity arrays are
+ * averaged, and each aggregated splat is sized to cover the splats of its
+ * leaf.
  */
 
 #ifndef vtkPointGaussianRepresentation_h
@@ -16,9 +21,10 @@
 #include <string>                   // for std::string
 #include <vector>                   // for std::vector
 
-class vtkActor;
 class vtkDataObject;
+class vtkPVLODActor;
 class vtkPiecewiseFunction;
+class vtkPointGaussianLODFilter;
 class vtkPointGaussianMapper;
 class vtkScalarsToColors;
 
@@ -154,6 +160,12 @@ public:
    */
   void SelectOpacityArrayComponent(int component);
 
+  /**
+   * When set to true, the LOD is not generated and the full resolution splats
+   * are always rendered. Default is false.
+   */
+  virtual void SetSuppressLOD(bool suppress) { this->SuppressLOD = suppress; }
+
   ///@{
   /**
    * Enables or disables setting opacity by an array.  Set which array
@@ -191,8 +203,10 @@ protected:
   void InitializeShaderPresets();
   void UpdateMapperScaleFunction();
 
-  vtkSmartPointer<vtkActor> Actor;
+  vtkSmartPointer<vtkPVLODActor> Actor;
   vtkSmartPointer<vtkPointGaussianMapper> Mapper;
+  vtkSmartPointer<vtkPointGaussianMapper> LODMapper;
+  vtkSmartPointer<vtkPointGaussianLODFilter> LODFilter;
   vtkSmartPointer<vtkDataObject> ProcessedData;
   vtkSmartPointer<vtkPiecewiseFunction> ScaleFunction;
 
@@ -208,6 +222,8 @@ protected:
 
   bool UseScaleFunction;
 
+  bool SuppressLOD = false;
+
   std::vector<std::string> PresetShaderStrings;
   std::vector<float> PresetShaderScales;
 
@@ -18,6 +18,7 @@
 #include "vtkMultiProcessController.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVAdaptiveRenderingController.h"
 #include "vtkPVArrayInformation.h"
 #include "vtkPVCAVEConfigInformation.h"
 #include "vtkPVDataInformation.h"
@@ -397,6 +398,16 @@ bool vtkSMRenderViewProxy::StreamingUpdate(bool render_if_needed)
   return something_delivered || OSPRayNotDone;
 }
 
+//-----------------------------------------------------------------------------
+bool vtkSMRenderViewProxy::RefiningStillRender()
+{
+  this->AllowRefinement = true;
+  this->RenderedRefinement = false;
+  this->StillRender();
+  this->AllowRefinement = false;
+  return this->RenderedRefinement;
+}
+
 //-----------------------------------------------------------------------------
 vtkTypeUInt32 vtkSMRenderViewProxy::PreRender(bool interactive)
 {
@@ -404,6 +415,25 @@ vtkTypeUInt32 vtkSMRenderViewProxy::PreRender(bool interactive)
 
   vtkPVRenderView* rv = vtkPVRenderView::SafeDownCast(this->GetClientSideObject());
   assert(rv != nullptr);
+  if (this->ObjectsCreated && rv->GetUseAdaptiveInteractiveRender())
+  {
+    // the render parameters are picked on the client from the last frames and
+    // pushed to all processes, since only the client measures complete frames.
+    vtkPVAdaptiveRenderingController* controller = rv->GetAdaptiveRenderingController();
+    const int endFactor = interactive ? 0 : controller->EndInteraction();
+    const int refinement = this->AllowRefinement ? endFactor : 0;
+    this->RenderedRefinement = refinement > 0;
+    if (interactive || refinement > 0)
+    {
+      vtkClientServerStream stream;
+      stream << vtkClientServerStream::Invoke << VTKOBJECT(this) << "SetAdaptiveRenderParameters"
+             << (interactive ? controller->GetImageReductionFactor() : 0)
+             << (interactive && controller->GetUseLOD() ? 1 : 0)
+             << (interactive ? controller->GetCompressionLossLevel() : 0) << refinement
+             << vtkClientServerStream::End;
+      this->ExecuteStream(stream);
+    }
+  }
   if (interactive && rv->GetUseLODForInteractiveRender())
   {
     // for interactive renders, we need to determine if we are going to use LOD.
@@ -1286,11 +1316,49 @@ bool vtkSMRenderViewProxy::SelectInternal(const vtkClientServerStream& csstream,
   return retVal;
 }
 
+//----------------------------------------------------------------------------
+bool vtkSMRenderViewProxy::SelectFromCache(int fieldAssociation, const int region[4],
+  const char* arrayName, vtkCollection* selectedRepresentations, vtkCollection* selectionSources,
+  bool multiple_selections, int modifier, bool selectBlocks, bool& selected)
+{
+  // Only single pixel selections, i.e. hover queries, are answered from the
+  // buffers cached by the previous selection.
+  if (!vtkPVRenderViewSettings::GetInstance()->GetEnableHoverSelectionCache() ||
+    !this->IsSelectionCached || region[0] != region[2] || region[1] != region[3] ||
+    !this->IsSelectionAvailable())
+  {
+    return false;
+  }
+
+  vtkPVRenderView* rv = vtkPVRenderView::SafeDownCast(this->GetClientSideObject());
+  int pixel[4] = { region[0], region[1], region[2], region[3] };
+  rv->SelectFromCache(fieldAssociation, pixel, arrayName);
+  if (rv->GetLastSelection() == nullptr)
+  {
+    // the scene changed since the buffers were captured: drop them on all
+    // processes so that the next selection captures new ones.
+    this->ClearSelectionCache(/*force=*/true);
+    return false;
+  }
+
+  selected = this->FetchLastSelection(
+    multiple_selections, selectedRepresentations, selectionSources, modifier, selectBlocks);
+  return true;
+}
+
 //----------------------------------------------------------------------------
 bool vtkSMRenderViewProxy::SelectSurfaceCells(const int region[4],
   vtkCollection* selectedRepresentations, vtkCollection* selectionSources, bool multiple_selections,
   int modifier, bool select_blocks, const char* arrayName)
 {
+  bool selected = false;
+  if (this->SelectFromCache(vtkDataObject::FIELD_ASSOCIATION_CELLS, region, arrayName,
+        selectedRepresentations, selectionSources, multiple_selections, modifier, select_blocks,
+        selected))
+  {
+    return selected;
+  }
+
   vtkClientServerStream stream;
   stream << vtkClientServerStream::Invoke << VTKOBJECT(this) << "SelectCells" << region[0]
          << region[1] << region[2] << region[3] << arrayName << vtkClientServerStream::End;
@@ -1303,6 +1371,14 @@ bool vtkSMRenderViewProxy::SelectSurfacePoints(const int region[4],
   vtkCollection* selectedRepresentations, vtkCollection* selectionSources, bool multiple_selections,
   int modifier, bool select_blocks, const char* arrayName)
 {
+  bool selected = false;
+  if (this->SelectFromCache(vtkDataObject::FIELD_ASSOCIATION_POINTS, region, arrayName,
+        selectedRepresentations, selectionSources, multiple_selections, modifier, select_blocks,
+        selected))
+  {
+    return selected;
+  }
+
   vtkClientServerStream stream;
   stream << vtkClientServerStream::Invoke << VTKOBJECT(this) << "SelectPoints" << region[0]
          << region[1] << region[2] << region[3] << arrayName << vtkClientServerStream::End;
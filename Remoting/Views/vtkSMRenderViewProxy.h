@@ -216,6 +216,16 @@ public:
    */
   bool GetNeedsUpdate() override;
 
+  /**
+   * Same as StillRender() except that, when interaction just stopped and the
+   * adaptive rendering controller expects the full resolution frame to be
+   * slow, it renders an intermediate frame at a reduced resolution instead
+   * and returns true. The caller should then call StillRender() for the full
+   * resolution frame, e.g. from a timer so that the intermediate frame is
+   * shown first. See vtkSMViewProxyInteractorHelper.
+   */
+  bool RefiningStillRender();
+
   /**
    * Called to render a streaming pass. Returns true if the view "streamed" some
    * geometry.
@@ -411,6 +421,10 @@ protected:
 
   bool NeedsUpdateLOD;
 
+  // Set by RefiningStillRender() around the still render it makes.
+  bool AllowRefinement = false;
+  bool RenderedRefinement = false;
+
 private:
   vtkSMRenderViewProxy(const vtkSMRenderViewProxy&) = delete;
   void operator=(const vtkSMRenderViewProxy&) = delete;
@@ -423,6 +437,17 @@ private:
     vtkCollection* selectionSources, bool multiple_selections, int modifier = /* replace */ 0,
     bool selectBlocks = false);
 
+  /**
+   * Internal method to answer a single-pixel selection, such as hover queries,
+   * from the selection buffers cached on the client, without rendering. Returns
+   * false if the buffers cannot be used, in which case the selection must be
+   * made with SelectInternal(). Otherwise `selected` is set to the result of
+   * the selection.
+   */
+  bool SelectFromCache(int fieldAssociation, const int region[4], const char* arrayName,
+    vtkCollection* selectedRepresentations, vtkCollection* selectionSources,
+    bool multiple_selections, int modifier, bool selectBlocks, bool& selected);
+
   vtkNew<vtkSMViewProxyInteractorHelper> InteractorHelper;
 
   class vtkInternals;
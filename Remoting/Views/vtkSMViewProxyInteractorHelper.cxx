@@ -6,9 +6,11 @@
 #include "vtkObjectFactory.h"
 #include "vtkRenderWindowInteractor.h"
 #include "vtkSMPropertyHelper.h"
+#include "vtkSMRenderViewProxy.h"
 #include "vtkSMSessionProxyManager.h"
 #include "vtkSMViewProxy.h"
 
+#include <algorithm>
 #include <cassert>
 
 vtkStandardNewMacro(vtkSMViewProxyInteractorHelper);
@@ -228,8 +230,22 @@ void vtkSMViewProxyInteractorHelper::Render()
   if (this->Interacting)
   {
     this->ViewProxy->InteractiveRender();
+    return;
+  }
+
+  vtkSMRenderViewProxy* renderView = vtkSMRenderViewProxy::SafeDownCast(this->ViewProxy);
+  if (renderView && renderView->RefiningStillRender())
+  {
+    // an intermediate frame was rendered, render the full resolution one
+    // later so that it is shown meanwhile. Interacting again cancels it.
+    const double delay =
+      vtkSMPropertyHelper(this->ViewProxy, "NonInteractiveRenderDelay", /*quiet*/ true)
+        .GetAsDouble();
+    this->DelayedRenderTimerId =
+      this->Interactor->CreateOneShotTimer(static_cast<unsigned long>(std::max(delay, 0.1) * 1000));
+    this->InvokeEvent(vtkCommand::CreateTimerEvent, &this->DelayedRenderTimerId);
   }
-  else
+  else if (!renderView)
   {
     this->ViewProxy->StillRender();
   }
@@ -25,7 +25,10 @@
  * \li \c NonInteractiveRenderDelay :- when present provides time in seconds to
  * delay the StillRender() call after user interaction has ended i.e.
  * vtkRenderWindowInteractor fires the vtkCommand::EndInteractionEvent. If
- * missing, or less than 0.01, the view will immediately render.
+ * missing, or less than 0.01, the view will immediately render. When the
+ * still render of a render view is an intermediate frame at a reduced
+ * resolution (see vtkSMRenderViewProxy::RefiningStillRender()), the full
+ * resolution frame is rendered after the same delay, at least 0.1 seconds.
  *
  * \li \c WindowResizeNonInteractiveRenderDelay :- when present provides time in seconds to
  * delay the StillRender() call after the window has been resized, ie. the interactor
@@ -17,11 +17,13 @@
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkOutlineSource.h"
+#include "vtkPVCellCenterDepthSort.h"
 #include "vtkPVGeometryFilter.h"
 #include "vtkPVLODVolume.h"
 #include "vtkPVRenderView.h"
 #include "vtkPolyDataMapper.h"
 #include "vtkProjectedTetrahedraMapper.h"
+#include "vtkRenderWindow.h"
 #include "vtkRenderer.h"
 #include "vtkResampleToImage.h"
 #include "vtkSMPTools.h"
@@ -55,6 +57,8 @@ vtkUnstructuredGridVolumeRepresentation::vtkUnstructuredGridVolumeRepresentation
 
   this->LODGeometryFilter->SetUseOutline(0);
 
+  this->DefaultMapper->SetVisibilitySort(this->CellSort);
+
   this->Actor->SetMapper(this->DefaultMapper);
   this->Actor->SetLODMapper(this->LODMapper);
 }
@@ -71,6 +75,10 @@ void vtkUnstructuredGridVolumeRepresentation::AddVolumeMapper(
   const char* name, vtkAbstractVolumeMapper* mapper)
 {
   this->Internals->Mappers[name] = mapper;
+  if (auto ptMapper = vtkProjectedTetrahedraMapper::SafeDownCast(mapper))
+  {
+    ptMapper->SetVisibilitySort(this->CellSort);
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -208,6 +216,11 @@ int vtkUnstructuredGridVolumeRepresentation::ProcessViewRequest(
   else if (request_type == vtkPVView::REQUEST_RENDER())
   {
     this->UpdateMapperParameters();
+
+    // interactive renders may reuse an outdated cell order when sorting is slow.
+    vtkPVRenderView* view = vtkPVRenderView::SafeDownCast(inInfo->Get(vtkPVRenderView::VIEW()));
+    this->CellSort->SetInteractive(view && view->GetRenderWindow()->GetDesiredUpdateRate() >= 1);
+
     if (inInfo->Has(vtkPVRenderView::USE_LOD()))
     {
       this->Actor->SetEnableLOD(1);
@@ -415,6 +428,21 @@ void vtkUnstructuredGridVolumeRepresentation::SetSamplingDimensions(int xdim, in
   this->ResampleToImageFilter->SetSamplingDimensions(xdim, ydim, zdim);
 }
 
+//***************************************************************************
+// Forwarded to vtkPVCellCenterDepthSort
+
+//----------------------------------------------------------------------------
+void vtkUnstructuredGridVolumeRepresentation::SetSortReuseAngle(double val)
+{
+  this->CellSort->SetReuseAngle(val);
+}
+
+//----------------------------------------------------------------------------
+void vtkUnstructuredGridVolumeRepresentation::SetInteractiveSortTimeBudget(double val)
+{
+  this->CellSort->SetInteractiveTimeBudget(val);
+}
+
 //***************************************************************************
 // Forwarded to Actor.
 
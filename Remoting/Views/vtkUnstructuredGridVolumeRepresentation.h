@@ -8,6 +8,10 @@
  * vtkUnstructuredGridVolumeRepresentation is a representation for volume
  * rendering vtkUnstructuredGrid datasets. It simply renders a translucent
  * surface for LOD i.e. interactive rendering.
+ *
+ * Projected tetrahedra mappers sort the cells with vtkPVCellCenterDepthSort,
+ * which reuses the order across small camera moves and, during interaction,
+ * when sorting again would exceed InteractiveSortTimeBudget.
  */
 
 #ifndef vtkUnstructuredGridVolumeRepresentation_h
@@ -23,6 +27,7 @@ class vtkOutlineSource;
 class vtkPiecewiseFunction;
 class vtkPolyDataMapper;
 class vtkProjectedTetrahedraMapper;
+class vtkPVCellCenterDepthSort;
 class vtkPVGeometryFilter;
 class vtkPVLODVolume;
 class vtkResampleToImage;
@@ -78,6 +83,16 @@ public:
   }
   void SetSamplingDimensions(int xdim, int ydim, int zdim);
 
+  //***************************************************************************
+  ///@{
+  /**
+   * Forwarded to vtkPVCellCenterDepthSort as ReuseAngle and
+   * InteractiveTimeBudget.
+   */
+  void SetSortReuseAngle(double);
+  void SetInteractiveSortTimeBudget(double);
+  ///@}
+
   ///@{
   /**
    * Specify whether or not to redistribute the data. The default is false
@@ -126,6 +141,7 @@ protected:
 
   vtkNew<vtkVolumeRepresentationPreprocessor> Preprocessor;
   vtkNew<vtkProjectedTetrahedraMapper> DefaultMapper;
+  vtkNew<vtkPVCellCenterDepthSort> CellSort;
 
   vtkNew<vtkResampleToImage> ResampleToImageFilter;
 
@@ -3,18 +3,27 @@
 #include "vtkXYChartRepresentation.h"
 #include "vtkXYChartRepresentationInternals.h"
 
+#include "vtkAxis.h"
+#include "vtkBlockDeliveryPreprocessor.h"
+#include "vtkCommunicator.h"
+#include "vtkCompositeDataIterator.h"
 #include "vtkDataSetAttributes.h"
 #include "vtkInformation.h"
 #include "vtkMultiBlockDataSet.h"
+#include "vtkMultiProcessController.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVChartAggregator.h"
 #include "vtkPVContextView.h"
 #include "vtkPVXYChartView.h"
+#include "vtkReductionFilter.h"
 #include "vtkScalarsToColors.h"
 #include "vtkSmartPointer.h"
 #include "vtkSortFieldData.h"
 #include "vtkTableAlgorithm.h"
 
+#include <algorithm>
+
 class vtkXYChartRepresentation::SortTableFilter : public vtkTableAlgorithm
 {
 private:
@@ -70,6 +79,9 @@ vtkXYChartRepresentation::vtkXYChartRepresentation()
   , SortDataByXAxis(false)
   , PlotDataHasChanged(false)
   , SeriesLabelPrefix(nullptr)
+  , ScreenSpaceAggregation(false)
+  , AggregationResolution{ 1024, 1024 }
+  , AggregationXRange{ 0, -1 }
 {
   this->SelectionColor[0] = 1.;
   this->SelectionColor[1] = 0.;
@@ -115,6 +127,18 @@ void vtkXYChartRepresentation::SetSortDataByXAxis(bool val)
   this->SortDataByXAxis = val;
   this->MarkModified();
 }
+
+//----------------------------------------------------------------------------
+void vtkXYChartRepresentation::SetScreenSpaceAggregation(bool val)
+{
+  if (this->ScreenSpaceAggregation == val)
+  {
+    return;
+  }
+  this->ScreenSpaceAggregation = val;
+  this->MarkModified();
+}
+
 //----------------------------------------------------------------------------
 void vtkXYChartRepresentation::SetVisibility(bool visible)
 {
@@ -313,6 +337,10 @@ int vtkXYChartRepresentation::ProcessViewRequest(
     if (view)
     {
       this->SetSortDataByXAxis(view->GetSortByXAxis());
+      if (this->ScreenSpaceAggregation)
+      {
+        this->UpdateAggregationParameters(view);
+      }
     }
   }
   return Superclass::ProcessViewRequest(request_type, inInfo, outInfo);
@@ -352,6 +380,104 @@ vtkSmartPointer<vtkDataObject> vtkXYChartRepresentation::TransformTable(
   return sortedTable;
 }
 
+//----------------------------------------------------------------------------
+void vtkXYChartRepresentation::UpdateAggregationParameters(vtkPVXYChartView* view)
+{
+  int resolution[2] = { this->AggregationResolution[0], this->AggregationResolution[1] };
+  const int* size = view->GetSize();
+  if (size[0] > 0 && size[1] > 0)
+  {
+    resolution[0] = size[0];
+    resolution[1] = size[1];
+  }
+
+  double xrange[2] = { 0, -1 };
+  vtkChart* chart = view->GetChart();
+  vtkAxis* axis = chart ? chart->GetAxis(vtkAxis::BOTTOM) : nullptr;
+  if (axis && axis->GetBehavior() == vtkAxis::FIXED)
+  {
+    xrange[0] = axis->GetUnscaledMinimum();
+    xrange[1] = axis->GetUnscaledMaximum();
+  }
+
+  if (!std::equal(resolution, resolution + 2, this->AggregationResolution) ||
+    !std::equal(xrange, xrange + 2, this->AggregationXRange))
+  {
+    std::copy(resolution, resolution + 2, this->AggregationResolution);
+    std::copy(xrange, xrange + 2, this->AggregationXRange);
+    this->MarkModified();
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataObject> vtkXYChartRepresentation::ReduceDataToRoot(vtkDataObject* data)
+{
+  if (!this->ScreenSpaceAggregation || this->UseIndexForXAxis || !this->XAxisSeriesName ||
+    !this->XAxisSeriesName[0] ||
+    (this->ChartType != vtkChart::LINE && this->ChartType != vtkChart::POINTS))
+  {
+    return this->Superclass::ReduceDataToRoot(data);
+  }
+
+  vtkNew<vtkBlockDeliveryPreprocessor> preprocessor;
+  preprocessor->SetFlattenTable(this->FlattenTable);
+  preprocessor->SetFieldAssociation(this->FieldAssociation);
+  preprocessor->SetInputData(data);
+  preprocessor->Update();
+
+  // All ranks must bin the same X range, otherwise the rows kept on each rank
+  // may not include the ones kept when aggregating all rows.
+  double xrange[2] = { this->AggregationXRange[0], this->AggregationXRange[1] };
+  if (!(xrange[0] < xrange[1]))
+  {
+    // the minimum and the negated maximum, to reduce both with MIN_OP.
+    double localRange[2] = { VTK_DOUBLE_MAX, VTK_DOUBLE_MAX };
+    vtkSmartPointer<vtkCompositeDataIterator> iter;
+    iter.TakeReference(
+      vtkCompositeDataSet::SafeDownCast(preprocessor->GetOutputDataObject(0))->NewIterator());
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+      vtkTable* table = vtkTable::SafeDownCast(iter->GetCurrentDataObject());
+      vtkDataArray* xArray =
+        table ? table->GetRowData()->GetArray(this->XAxisSeriesName) : nullptr;
+      if (xArray && xArray->GetNumberOfComponents() == 1 && xArray->GetNumberOfTuples() > 0)
+      {
+        double range[2];
+        xArray->GetFiniteRange(range, 0);
+        localRange[0] = std::min(localRange[0], range[0]);
+        localRange[1] = std::min(localRange[1], -range[1]);
+      }
+    }
+    double globalRange[2] = { localRange[0], localRange[1] };
+    if (auto controller = vtkMultiProcessController::GetGlobalController())
+    {
+      controller->AllReduce(localRange, globalRange, 2, vtkCommunicator::MIN_OP);
+    }
+    xrange[0] = globalRange[0];
+    xrange[1] = -globalRange[1];
+  }
+
+  vtkNew<vtkPVChartAggregator> preGatherHelper;
+  vtkNew<vtkPVChartAggregator> postGatherHelper;
+  for (vtkPVChartAggregator* aggregator : { preGatherHelper.Get(), postGatherHelper.Get() })
+  {
+    aggregator->SetAggregationMode(this->ChartType == vtkChart::POINTS
+        ? vtkPVChartAggregator::DENSITY
+        : vtkPVChartAggregator::MIN_MAX);
+    aggregator->SetXArrayName(this->XAxisSeriesName);
+    aggregator->SetResolution(this->AggregationResolution);
+    aggregator->SetXRange(xrange);
+  }
+
+  vtkNew<vtkReductionFilter> reductionFilter;
+  reductionFilter->SetPreGatherHelper(preGatherHelper);
+  reductionFilter->SetPostGatherHelper(postGatherHelper);
+  reductionFilter->SetInputConnection(preprocessor->GetOutputPort());
+  reductionFilter->Update();
+
+  return reductionFilter->GetOutputDataObject(0);
+}
+
 //----------------------------------------------------------------------------
 void vtkXYChartRepresentation::PrepareForRendering()
 {
@@ -23,6 +23,7 @@
 #include "vtkParaViewDeprecation.h" // for deprecation
 
 class vtkChartXY;
+class vtkPVXYChartView;
 class vtkScalarsToColors;
 
 class VTKREMOTINGVIEWS_EXPORT vtkXYChartRepresentation : public vtkChartRepresentation
@@ -91,6 +92,19 @@ public:
   vtkGetMacro(SortDataByXAxis, bool);
   ///@}
 
+  ///@{
+  /**
+   * When enabled, line and points charts using an array for the X axis reduce
+   * the rows of the data on each rank to the ones needed to draw them at the
+   * resolution of the view, using vtkPVChartAggregator, before gathering them
+   * for rendering. The aggregation covers the custom range of the bottom axis,
+   * if any, otherwise the range of the X array, and is redone when the view is
+   * resized or the custom range changes. Default is false.
+   */
+  void SetScreenSpaceAggregation(bool val);
+  vtkGetMacro(ScreenSpaceAggregation, bool);
+  ///@}
+
   ///@{
   /**
    * Set/Clear the properties for Y series/columns.
@@ -155,6 +169,12 @@ protected:
 
   vtkSmartPointer<vtkDataObject> TransformTable(vtkSmartPointer<vtkDataObject>) override;
 
+  /**
+   * Overridden to aggregate the rows on each rank and again on the root when
+   * ScreenSpaceAggregation is enabled and applies to the chart.
+   */
+  vtkSmartPointer<vtkDataObject> ReduceDataToRoot(vtkDataObject* data) override;
+
   void PrepareForRendering() override;
 
   class vtkInternals;
@@ -167,6 +187,12 @@ private:
   vtkXYChartRepresentation(const vtkXYChartRepresentation&) = delete;
   void operator=(const vtkXYChartRepresentation&) = delete;
 
+  /**
+   * Updates the aggregation resolution and X range from the view, calling
+   * MarkModified() if they changed.
+   */
+  void UpdateAggregationParameters(vtkPVXYChartView* view);
+
   int ChartType;
   char* XAxisSeriesName;
   bool UseIndexForXAxis;
@@ -174,6 +200,9 @@ private:
   bool PlotDataHasChanged;
   double SelectionColor[3];
   char* SeriesLabelPrefix;
+  bool ScreenSpaceAggregation;
+  int AggregationResolution[2];
+  double AggregationXRange[2];
 };
 
 #endif
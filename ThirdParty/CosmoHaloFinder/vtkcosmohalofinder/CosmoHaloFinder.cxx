@@ -47,6 +47,8 @@ ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <cmath>
 #include <cstdlib>
 #include <algorithm>
+#include <atomic>
+#include <thread>
 
 #include "CosmoHaloFinder.h"
 
@@ -63,6 +65,8 @@ CosmoHaloFinder::CosmoHaloFinder()
 {
 
   nmin = 1;
+  useCellList = false;
+  numThreads = 0;
 }
 
 /****************************************************************************/
@@ -290,6 +294,14 @@ void CosmoHaloFinder::Writing()
 /****************************************************************************/
 void CosmoHaloFinder::Finding()
 {
+  //
+  // The cell list reproduces the plain friends-of-friends criterion only
+  //
+  if (useCellList && nmin < 2 && !periodic) {
+    CellListFOF();
+    return;
+  }
+
   //
   // REORDER particles based on spatial locality
   //
@@ -622,4 +634,221 @@ void CosmoHaloFinder::Merge(
   return;
 }
 
+/****************************************************************************/
+namespace {
+
+// Runs func(begin, end) over [0, n) in chunks of grain on numThreads threads
+template <typename Functor>
+void parallelFor(int n, int numThreads, int grain, Functor func)
+{
+  if (numThreads <= 1 || n <= grain) {
+    func(0, n);
+    return;
+  }
+
+  std::atomic<int> next(0);
+  auto worker = [&]() {
+    int begin;
+    while ((begin = next.fetch_add(grain)) < n)
+      func(begin, min(begin + grain, n));
+  };
+
+  vector<std::thread> threads;
+  for (int t = 1; t < numThreads; t++)
+    threads.push_back(std::thread(worker));
+  worker();
+  for (size_t t = 0; t < threads.size(); t++)
+    threads[t].join();
+}
+
+// Lock-free find with path halving.  References only move to smaller ids.
+int findRoot(std::atomic<int>* parent, int i)
+{
+  int p = parent[i].load(std::memory_order_acquire);
+  while (p != i) {
+    int gp = parent[p].load(std::memory_order_acquire);
+    if (gp != p)
+      parent[i].compare_exchange_weak(p, gp,
+                                      std::memory_order_acq_rel,
+                                      std::memory_order_relaxed);
+    i = gp;
+    p = parent[i].load(std::memory_order_acquire);
+  }
+  return i;
+}
+
+// Hangs the larger root under the smaller one, retrying if another thread
+// relinked either root in the meantime.
+void unite(std::atomic<int>* parent, int i, int j)
+{
+  while (true) {
+    i = findRoot(parent, i);
+    j = findRoot(parent, j);
+    if (i == j)
+      return;
+    if (i > j)
+      std::swap(i, j);
+    int expected = j;
+    if (parent[j].compare_exchange_strong(expected, i,
+                                          std::memory_order_acq_rel))
+      return;
+  }
+}
+
+} // END anonymous namespace
+
+/****************************************************************************/
+//
+// Friends-of-friends on a cell list.  Particles are binned into cells at
+// least bb wide so all friends of a particle lie in the 27 surrounding cells.
+// Threads link friends with a union-find that always keeps the lowest
+// particle index as root, so every particle gets the same halo tag (lowest
+// particle index in its halo) as myFOF().  Halo lists are chained in
+// increasing particle order.
+//
+void CosmoHaloFinder::CellListFOF()
+{
+  if (npart <= 0)
+    return;
+
+  int nthreads = max(1, (int)std::thread::hardware_concurrency());
+  if (numThreads > 0)
+    nthreads = min(numThreads, nthreads);
+
+  //
+  // HASH particles into cells of size bb.  Only occupied cells are stored,
+  // sorted by key, so clustered data does not need a dense grid.
+  //
+  POSVEL_T lo[numDataDims], hi[numDataDims];
+  for (int d = 0; d < numDataDims; d++) {
+    lo[d] = hi[d] = data[d][0];
+    for (int i = 1; i < npart; i++) {
+      lo[d] = min(lo[d], data[d][i]);
+      hi[d] = max(hi[d], data[d][i]);
+    }
+  }
+
+  // Cells only grow if the keys would overflow
+  double cellSize = (bb > 0) ? bb : 1.0;
+  while (true) {
+    double ncells = 1.0;
+    for (int d = 0; d < numDataDims; d++)
+      ncells *= floor((hi[d] - lo[d]) / cellSize) + 1.0;
+    if (ncells < 1.0e18)
+      break;
+    cellSize *= 2.0;
+  }
+  long long dims[numDataDims];
+  for (int d = 0; d < numDataDims; d++)
+    dims[d] = (long long)floor((hi[d] - lo[d]) / cellSize) + 1;
+
+  vector<pair<long long, int> > keyed(npart);
+  parallelFor(npart, nthreads, 65536, [&](int first, int last) {
+    for (int i = first; i < last; i++) {
+      long long c[numDataDims];
+      for (int d = 0; d < numDataDims; d++)
+        c[d] = min(dims[d] - 1, (long long)((data[d][i] - lo[d]) / cellSize));
+      keyed[i].first = c[dataX] + dims[dataX] * (c[dataY] + dims[dataY] * c[dataZ]);
+      keyed[i].second = i;
+    }
+  });
+
+  // Particles of a cell stay in increasing order
+  std::sort(keyed.begin(), keyed.end());
+
+  vector<long long> cellKey;
+  vector<int> cellStart;
+  vector<int> cellParticles(npart);
+  for (int a = 0; a < npart; a++) {
+    if (a == 0 || keyed[a].first != keyed[a - 1].first) {
+      cellKey.push_back(keyed[a].first);
+      cellStart.push_back(a);
+    }
+    cellParticles[a] = keyed[a].second;
+  }
+  cellStart.push_back(npart);
+  vector<pair<long long, int> >().swap(keyed);
+  int ncells = (int)cellKey.size();
+
+  //
+  // LINK friends: each cell visits itself and the neighbor cells with a
+  // larger key, so every pair of particles is tested once
+  //
+  vector<std::atomic<int> > parent(npart);
+  parallelFor(npart, nthreads, 65536, [&](int first, int last) {
+    for (int i = first; i < last; i++)
+      parent[i].store(i, std::memory_order_relaxed);
+  });
+
+  parallelFor(ncells, nthreads, 64, [&](int first, int last) {
+    for (int c = first; c < last; c++) {
+      long long key = cellKey[c];
+      long long cx = key % dims[dataX];
+      long long cy = (key / dims[dataX]) % dims[dataY];
+      long long cz = key / (dims[dataX] * dims[dataY]);
+
+      for (int dz = -1; dz <= 1; dz++)
+      for (int dy = -1; dy <= 1; dy++)
+      for (int dx = -1; dx <= 1; dx++) {
+        long long nx = cx + dx, ny = cy + dy, nz = cz + dz;
+        if (nx < 0 || ny < 0 || nz < 0 ||
+            nx >= dims[dataX] || ny >= dims[dataY] || nz >= dims[dataZ])
+          continue;
+        long long nkey = nx + dims[dataX] * (ny + dims[dataY] * nz);
+        if (nkey < key)
+          continue;
+        int n = c;
+        if (nkey != key) {
+          vector<long long>::const_iterator it =
+            std::lower_bound(cellKey.begin() + c + 1, cellKey.end(), nkey);
+          if (it == cellKey.end() || *it != nkey)
+            continue;
+          n = (int)(it - cellKey.begin());
+        }
+
+        for (int a = cellStart[c]; a < cellStart[c + 1]; a++) {
+          int ii = cellParticles[a];
+          int rootI = findRoot(&parent[0], ii);
+          int firstB = (n == c) ? a + 1 : cellStart[n];
+          for (int b = firstB; b < cellStart[n + 1]; b++) {
+            int jj = cellParticles[b];
+
+            // fast exit
+            if (parent[jj].load(std::memory_order_relaxed) == rootI)
+              continue;
+
+            // Same test as Merge()
+            POSVEL_T xdist = fabs(data[dataX][jj] - data[dataX][ii]);
+            POSVEL_T ydist = fabs(data[dataY][jj] - data[dataY][ii]);
+            POSVEL_T zdist = fabs(data[dataZ][jj] - data[dataZ][ii]);
+
+            if ((xdist<bb) && (ydist<bb) && (zdist<bb)) {
+              POSVEL_T dist = xdist*xdist + ydist*ydist + zdist*zdist;
+              if (dist < bb*bb && findRoot(&parent[0], jj) != rootI) {
+                unite(&parent[0], rootI, jj);
+                rootI = findRoot(&parent[0], ii);
+              }
+            }
+          }
+        }
+      } // (dx,dy,dz)-loop
+    }
+  });
+
+  //
+  // BUILD halo tags and particle chains
+  //
+  parallelFor(npart, nthreads, 65536, [&](int first, int last) {
+    for (int i = first; i < last; i++) {
+      ht[i] = findRoot(&parent[0], i);
+      halo[i] = -1;
+      nextp[i] = -1;
+    }
+  });
+  for (int i = npart - 1; i >= 0; i--) {
+    nextp[i] = halo[ht[i]];
+    halo[ht[i]] = i;
+  }
+}
+
 } // END namespace cosmotk
@@ -194,6 +194,15 @@ public:
   int nmin;
   int pmin;
   bool periodic;
+
+  // Friends-of-friends backend.  When useCellList is set, halos are found on
+  // a cell-list spatial hash with a concurrent union-find using numThreads
+  // threads, at most the hardware threads (0 uses all hardware threads).
+  // The k-d tree is still used for nmin > 1 and periodic data, whose linking
+  // rules depend on it.
+  bool useCellList;
+  int numThreads;
+
   const char *infile;
   const char *outfile;
   const char *textmode;
@@ -232,6 +241,9 @@ private:
   // Recurses through the k-d tree merging particles to create halos
   void myFOF(int, int, int);
   void Merge(int, int, int, int, int);
+
+  // Threaded friends-of-friends on a cell list, see useCellList
+  void CellListFOF();
 };
 
 } // END cosmotk namespace
@@ -107,6 +107,13 @@ public:
                                 // which define a single halo
         int nmin = 1);          // The minimum number of neighbors for linking
 
+  // Select the threaded cell-list friends-of-friends in the serial finder
+  void setCellListFOF(bool useCellList, int numThreads = 0)
+  {
+    this->haloFinder.useCellList = useCellList;
+    this->haloFinder.numThreads = numThreads;
+  }
+
   // Execute the serial halo finder for this processor
   void executeHaloFinder();
 
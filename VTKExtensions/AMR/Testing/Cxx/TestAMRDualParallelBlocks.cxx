@@ -0,0 +1,267 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include <vtkAMRDualClip.h>
+#include <vtkAMRDualContour.h>
+#include <vtkCellData.h>
+#include <vtkDataSet.h>
+#include <vtkDoubleArray.h>
+#include <vtkIdList.h>
+#include <vtkLogger.h>
+#include <vtkMath.h>
+#include <vtkMultiBlockDataSet.h>
+#include <vtkMultiBlockDataSetAlgorithm.h>
+#include <vtkMultiPieceDataSet.h>
+#include <vtkNew.h>
+#include <vtkNonOverlappingAMR.h>
+#include <vtkPointData.h>
+#include <vtkSMPTools.h>
+#include <vtkSmartPointer.h>
+#include <vtkUniformGrid.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr int BlockSize = 8;
+constexpr int BlocksPerAxis = 3;
+
+// Adds the block of 8^3 cells at block index `ijk` of `level` to `amr`, with
+// a sphere distance field. Like the Spy Plot reader, blocks have a layer of
+// ghost cells on the faces shared with other blocks but not on the boundary
+// of the domain.
+void AddBlock(vtkNonOverlappingAMR* amr, int level, int blockId, const int ijk[3])
+{
+  const int numCells = (BlocksPerAxis * BlockSize) << level;
+  const double spacing = 1.0 / (1 << level);
+  const double center[3] = { 12.3, 11.7, 12.1 };
+
+  int extent[6];
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    extent[2 * axis] = std::max(0, ijk[axis] * BlockSize - 1);
+    extent[2 * axis + 1] = std::min(numCells, (ijk[axis] + 1) * BlockSize + 1);
+  }
+
+  vtkNew<vtkUniformGrid> grid;
+  grid->SetOrigin(0, 0, 0);
+  grid->SetSpacing(spacing, spacing, spacing);
+  grid->SetExtent(extent);
+
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("scalars");
+  scalars->SetNumberOfTuples(grid->GetNumberOfCells());
+  vtkIdType cellId = 0;
+  for (int k = extent[4]; k < extent[5]; ++k)
+  {
+    for (int j = extent[2]; j < extent[3]; ++j)
+    {
+      for (int i = extent[0]; i < extent[1]; ++i)
+      {
+        const double x[3] = { (i + 0.5) * spacing, (j + 0.5) * spacing, (k + 0.5) * spacing };
+        scalars->SetValue(cellId++, std::sqrt(vtkMath::Distance2BetweenPoints(x, center)));
+      }
+    }
+  }
+  grid->GetCellData()->SetScalars(scalars);
+  amr->SetDataSet(level, blockId, grid);
+}
+
+// A level of 3x3x3 blocks. When `refined` is true, the last block is replaced
+// by 2x2x2 blocks of a second level, so that the surface crosses the level
+// boundary.
+vtkSmartPointer<vtkNonOverlappingAMR> CreateAMR(bool refined)
+{
+  const int numRootBlocks = BlocksPerAxis * BlocksPerAxis * BlocksPerAxis;
+  const int blocksPerLevel[2] = { refined ? numRootBlocks - 1 : numRootBlocks, 8 };
+
+  auto amr = vtkSmartPointer<vtkNonOverlappingAMR>::New();
+  amr->Initialize(refined ? 2 : 1, blocksPerLevel);
+  for (int blockId = 0; blockId < blocksPerLevel[0]; ++blockId)
+  {
+    const int ijk[3] = { blockId % BlocksPerAxis, (blockId / BlocksPerAxis) % BlocksPerAxis,
+      blockId / (BlocksPerAxis * BlocksPerAxis) };
+    AddBlock(amr, 0, blockId, ijk);
+  }
+  if (refined)
+  {
+    for (int blockId = 0; blockId < 8; ++blockId)
+    {
+      const int first = 2 * (BlocksPerAxis - 1);
+      const int ijk[3] = { first + (blockId & 1), first + ((blockId >> 1) & 1),
+        first + (blockId >> 2) };
+      AddBlock(amr, 1, blockId, ijk);
+    }
+  }
+  return amr;
+}
+
+struct Summary
+{
+  vtkIdType NumberOfPoints = 0;
+  vtkIdType NumberOfCells = 0;
+  // coordinates and scalar value of the points, sorted.
+  std::vector<std::array<double, 4>> Points;
+  // centroids and sizes of the cells, sorted.
+  std::vector<std::array<double, 4>> Cells;
+  // coordinates in point id order, to compare runs of the same path.
+  std::vector<double> RawPoints;
+};
+
+Summary Summarize(vtkMultiBlockDataSetAlgorithm* filter)
+{
+  Summary summary;
+  auto output = vtkMultiBlockDataSet::SafeDownCast(filter->GetOutputDataObject(0));
+  auto pieces = output ? vtkMultiPieceDataSet::SafeDownCast(output->GetBlock(0)) : nullptr;
+  vtkDataSet* mesh = pieces ? pieces->GetPiece(0) : nullptr;
+  if (!mesh)
+  {
+    return summary;
+  }
+
+  summary.NumberOfPoints = mesh->GetNumberOfPoints();
+  summary.NumberOfCells = mesh->GetNumberOfCells();
+  vtkDataArray* values = mesh->GetPointData()->GetNumberOfArrays() > 0
+    ? mesh->GetPointData()->GetArray(0)
+    : nullptr;
+  for (vtkIdType ptId = 0; ptId < summary.NumberOfPoints; ++ptId)
+  {
+    double x[3];
+    mesh->GetPoint(ptId, x);
+    summary.Points.push_back({ x[0], x[1], x[2], values ? values->GetComponent(ptId, 0) : 0.0 });
+    summary.RawPoints.insert(summary.RawPoints.end(), x, x + 3);
+  }
+
+  vtkNew<vtkIdList> ptIds;
+  for (vtkIdType cellId = 0; cellId < summary.NumberOfCells; ++cellId)
+  {
+    mesh->GetCellPoints(cellId, ptIds);
+    std::array<double, 4> cell = { 0.0, 0.0, 0.0, static_cast<double>(ptIds->GetNumberOfIds()) };
+    for (vtkIdType cc = 0; cc < ptIds->GetNumberOfIds(); ++cc)
+    {
+      double x[3];
+      mesh->GetPoint(ptIds->GetId(cc), x);
+      vtkMath::Add(cell.data(), x, cell.data());
+    }
+    vtkMath::MultiplyScalar(cell.data(), 1.0 / std::max<double>(1.0, cell[3]));
+    summary.Cells.push_back(cell);
+  }
+
+  // Rounded so that the order does not depend on round-off.
+  auto round = [](std::vector<std::array<double, 4>>& tuples) {
+    for (auto& tuple : tuples)
+    {
+      for (double& value : tuple)
+      {
+        value = std::round(value * 1e6) / 1e6;
+      }
+    }
+    std::sort(tuples.begin(), tuples.end());
+  };
+  round(summary.Points);
+  round(summary.Cells);
+  return summary;
+}
+
+bool Equivalent(const Summary& a, const Summary& b)
+{
+  auto same = [](const std::vector<std::array<double, 4>>& x,
+                const std::vector<std::array<double, 4>>& y) {
+    return std::equal(x.begin(), x.end(), y.begin(), y.end(),
+      [](const std::array<double, 4>& u, const std::array<double, 4>& v) {
+        for (int cc = 0; cc < 4; ++cc)
+        {
+          if (std::abs(u[cc] - v[cc]) > 1e-5)
+          {
+            return false;
+          }
+        }
+        return true;
+      });
+  };
+  return a.NumberOfPoints == b.NumberOfPoints && a.NumberOfCells == b.NumberOfCells &&
+    same(a.Points, b.Points) && same(a.Cells, b.Cells);
+}
+
+// Runs `filter` with the serial block loop, then with the threaded one using
+// the sequential and the default SMP backends, and compares the outputs.
+template <typename FilterT>
+bool TestFilter(FilterT* filter, const char* name)
+{
+  filter->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_CELLS, "scalars");
+
+  auto run = [&](bool parallel) {
+    filter->SetEnableParallelBlockProcessing(parallel ? 1 : 0);
+    filter->Modified();
+    filter->Update();
+    return Summarize(filter);
+  };
+
+  const std::string backend = vtkSMPTools::GetBackend();
+  const Summary serial = run(false);
+  vtkSMPTools::SetBackend("Sequential");
+  const Summary sequential = run(true);
+  vtkSMPTools::SetBackend(backend.c_str());
+  const Summary threaded = run(true);
+
+  vtkLogF(INFO, "%s: %lld points, %lld cells (SMP backend %s)", name,
+    static_cast<long long>(serial.NumberOfPoints), static_cast<long long>(serial.NumberOfCells),
+    backend.c_str());
+  if (serial.NumberOfCells == 0)
+  {
+    vtkLogF(ERROR, "%s: empty output.", name);
+    return false;
+  }
+  if (!Equivalent(serial, sequential))
+  {
+    vtkLogF(ERROR, "%s: threaded block processing (Sequential backend) differs from the serial "
+                   "path: %lld points, %lld cells",
+      name, static_cast<long long>(sequential.NumberOfPoints),
+      static_cast<long long>(sequential.NumberOfCells));
+    return false;
+  }
+  if (!Equivalent(serial, threaded) || sequential.RawPoints != threaded.RawPoints)
+  {
+    vtkLogF(ERROR, "%s: output depends on the SMP backend.", name);
+    return false;
+  }
+  return true;
+}
+}
+
+int TestAMRDualParallelBlocks(int, char*[])
+{
+  bool success = true;
+  for (bool refined : { false, true })
+  {
+    vtkSmartPointer<vtkNonOverlappingAMR> amr = CreateAMR(refined);
+    const std::string levels = refined ? ", two levels" : "";
+
+    vtkNew<vtkAMRDualContour> contour;
+    contour->SetController(nullptr);
+    contour->SetEnableMultiProcessCommunication(0);
+    contour->SetIsoValue(7.5);
+    contour->SetInputData(amr);
+    success = TestFilter(contour.Get(), ("vtkAMRDualContour (merge" + levels + ")").c_str()) &&
+      success;
+    contour->SetEnableMergePoints(0);
+    success = TestFilter(contour.Get(), ("vtkAMRDualContour (no merge" + levels + ")").c_str()) &&
+      success;
+
+    vtkNew<vtkAMRDualClip> clip;
+    clip->SetController(nullptr);
+    clip->SetEnableMultiProcessCommunication(0);
+    clip->SetIsoValue(7.5);
+    clip->SetInputData(amr);
+    success = TestFilter(clip.Get(), ("vtkAMRDualClip (no merge" + levels + ")").c_str()) &&
+      success;
+    clip->SetEnableMergePoints(1);
+    success =
+      TestFilter(clip.Get(), ("vtkAMRDualClip (merge" + levels + ")").c_str()) && success;
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
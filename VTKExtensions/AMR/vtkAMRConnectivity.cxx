@@ -32,141 +32,63 @@
 #endif
 
 #include <list>
-#include <map>
+#include <unordered_map>
 
 vtkStandardNewMacro(vtkAMRConnectivity);
 
+// Union-find over the (sparse) region ids. Sets are always linked under their
+// smallest id, so the root of a member is the minimum id of its set.
 class vtkAMRConnectivityEquivalence
 {
 public:
-  vtkAMRConnectivityEquivalence()
-  {
-    set_to_min_id = vtkSmartPointer<vtkIntArray>::New();
-    set_to_min_id->SetNumberOfComponents(1);
-    set_to_min_id->SetNumberOfTuples(0);
-  }
-
+  vtkAMRConnectivityEquivalence() = default;
   ~vtkAMRConnectivityEquivalence() = default;
 
+  // Returns 0 when the two ids were already equivalent.
   int AddEquivalence(int id1, int id2)
   {
-    int min_id;
-    if (id1 < id2)
-    {
-      min_id = id1;
-    }
-    else
-    {
-      min_id = id2;
-    }
-
-    std::map<int, int>::iterator iter;
-
-    iter = id_to_set.find(id1);
-    int set1 = (iter == id_to_set.end() ? -1 : iter->second);
-    iter = id_to_set.find(id2);
-    int set2 = (iter == id_to_set.end() ? -1 : iter->second);
-
-    if (set1 >= 0 && set_to_min_id->GetValue(set1) < 0)
-    {
-      set1 = -1;
-    }
-    if (set2 >= 0 && set_to_min_id->GetValue(set2) < 0)
-    {
-      set2 = -1;
-    }
-
-    if (set1 >= 0 && set2 >= 0 && set1 == set2)
+    int root1 = this->FindRoot(id1);
+    int root2 = this->FindRoot(id2);
+    if (root1 == root2)
     {
       return 0;
     }
-    else if (set1 >= 0 && set2 >= 0)
+    if (root1 < root2)
     {
-      // merge sets
-      int min_set, max_set;
-      if (set1 < set2)
-      {
-        min_set = set1;
-        max_set = set2;
-      }
-      else
-      {
-        min_set = set2;
-        max_set = set1;
-      }
-      for (iter = id_to_set.begin(); iter != id_to_set.end(); iter++)
-      {
-        if (iter->second == max_set)
-        {
-          id_to_set[iter->first] = min_set;
-        }
-      }
-      int max_set_min = set_to_min_id->GetValue(max_set);
-      int min_set_min = set_to_min_id->GetValue(min_set);
-      // pick the smallest of the two mins to represent the set.
-      if (max_set_min < min_set_min)
-      {
-        set_to_min_id->SetValue(min_set, max_set_min);
-      }
-      set_to_min_id->SetValue(max_set, -1);
-    }
-    else if (set1 >= 0)
-    {
-      id_to_set[id2] = set1;
-      if (id2 < set_to_min_id->GetValue(set1))
-      {
-        set_to_min_id->SetValue(set1, id2);
-      }
-    }
-    else if (set2 >= 0)
-    {
-      id_to_set[id1] = set2;
-      if (id1 < set_to_min_id->GetValue(set2))
-      {
-        set_to_min_id->SetValue(set2, id1);
-      }
+      this->Parents[root2] = root1;
     }
     else
     {
-      // find an empty set.
-      int first_empty = -1;
-      for (int i = 0; i < set_to_min_id->GetNumberOfTuples(); i++)
-      {
-        if (set_to_min_id->GetValue(i) < 0)
-        {
-          first_empty = i;
-          break;
-        }
-      }
-      if (first_empty < 0)
-      {
-        first_empty = set_to_min_id->InsertNextValue(-1);
-      }
-
-      id_to_set[id1] = first_empty;
-      id_to_set[id2] = first_empty;
-      set_to_min_id->SetValue(first_empty, min_id);
-      // return zero here because its not values we've previously cared about.
+      this->Parents[root1] = root2;
     }
     return 1;
   }
 
   int GetMinimumSetId(int id)
   {
-    std::map<int, int>::iterator iter = id_to_set.find(id);
-    if (iter == id_to_set.end())
+    if (this->Parents.find(id) == this->Parents.end())
     {
-      // vtkErrorWithObjectMacro (id_to_set, << "ID out of range " << id << " (expected 0 <= x < "
-      // << id_to_set->GetNumberOfTuples () << ")");
       return -1;
     }
-    int set = id_to_set[id];
-    return (set >= 0 ? set_to_min_id->GetValue(set) : -1);
+    return this->FindRoot(id);
   }
 
 private:
-  std::map<int, int> id_to_set;
-  vtkSmartPointer<vtkIntArray> set_to_min_id;
+  int FindRoot(int id)
+  {
+    int parent = this->Parents.emplace(id, id).first->second;
+    while (parent != id)
+    {
+      // Path halving: point every other member on the path to its grandparent.
+      int grandParent = this->Parents[parent];
+      this->Parents[id] = grandParent;
+      id = grandParent;
+      parent = this->Parents[id];
+    }
+    return id;
+  }
+
+  std::unordered_map<int, int> Parents;
 };
 
 #if VTK_MODULE_ENABLE_VTK_ParallelMPI
@@ -4,6 +4,7 @@
 #include "vtkAMRDualClip.h"
 #include "vtkAMRDualGridHelper.h"
 
+#include <memory>
 #include <vector>
 
 // Pipeline & VTK
@@ -11,9 +12,15 @@
 #include "vtkInformationVector.h"
 #include "vtkMarchingCubesTriangleCases.h"
 #include "vtkMultiProcessController.h"
+#include "vtkNew.h"
 #include "vtkObject.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+// Filters used to merge the per-block outputs of the threaded path.
+#include "vtkAppendFilter.h"
+#include "vtkStaticCleanUnstructuredGrid.h"
 // PV interface
 #include "vtkCallbackCommand.h"
 #include "vtkDataArraySelection.h"
@@ -30,6 +37,7 @@
 #include "vtkMultiPieceDataSet.h"
 #include "vtkNonOverlappingAMR.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
 #include "vtkUniformGrid.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
@@ -1003,6 +1011,58 @@ void vtkAMRDualClipLocator::ShareBlockLocatorWithNeighbor(
   }
 }
 
+//============================================================================
+// Everything ProcessBlock writes to.  The serial path uses a single instance
+// for all blocks.  The threaded path uses one instance per block so blocks
+// can be processed concurrently; the meshes are appended in block order
+// afterwards, which keeps the output deterministic.
+class vtkAMRDualClipBlockOutput
+{
+public:
+  vtkAMRDualClipBlockOutput()
+  {
+    this->Mesh = vtkUnstructuredGrid::New();
+    this->Points = vtkPoints::New();
+    this->Cells = vtkCellArray::New();
+    this->Mesh->SetPoints(this->Points);
+
+    this->BlockIds = vtkIntArray::New();
+    this->BlockIds->SetName("BlockIds");
+    this->Mesh->GetCellData()->AddArray(this->BlockIds);
+
+    this->LevelMask = vtkUnsignedCharArray::New();
+    this->LevelMask->SetName("LevelMask");
+    this->Mesh->GetPointData()->AddArray(this->LevelMask);
+  }
+  ~vtkAMRDualClipBlockOutput()
+  {
+    delete this->Locator;
+    this->LevelMask->Delete();
+    this->BlockIds->Delete();
+    this->Cells->Delete();
+    this->Points->Delete();
+    this->Mesh->Delete();
+  }
+
+  vtkUnstructuredGrid* Mesh;
+  vtkPoints* Points;
+  vtkCellArray* Cells;
+  vtkIntArray* BlockIds;
+  vtkUnsignedCharArray* LevelMask;
+
+  // Locator of the block being processed.  When ShareLocators is set the
+  // locator is owned by the block (UserData) and is handed to neighbors once
+  // the block is done.  Otherwise it is owned by this object and reused.
+  vtkAMRDualClipLocator* Locator = nullptr;
+  bool ShareLocators = false;
+  // Set when the level mask of the block locators was computed up front.
+  bool LevelMasksInitialized = false;
+
+private:
+  vtkAMRDualClipBlockOutput(const vtkAMRDualClipBlockOutput&) = delete;
+  void operator=(const vtkAMRDualClipBlockOutput&) = delete;
+};
+
 //============================================================================
 //----------------------------------------------------------------------------
 // Description:
@@ -1017,6 +1077,7 @@ vtkAMRDualClip::vtkAMRDualClip()
   this->EnableDegenerateCells = 1;
   this->EnableMultiProcessCommunication = 0;
   this->EnableMergePoints = 0;
+  this->EnableParallelBlockProcessing = 0;
 
   this->Controller = nullptr;
   this->SetController(vtkMultiProcessController::GetGlobalController());
@@ -1024,21 +1085,12 @@ vtkAMRDualClip::vtkAMRDualClip()
   // Pipeline
   this->SetNumberOfOutputPorts(1);
 
-  this->LevelMaskPointArray = nullptr;
-  this->BlockIdCellArray = nullptr;
   this->Helper = nullptr;
-
-  this->BlockLocator = nullptr;
 }
 
 //----------------------------------------------------------------------------
 vtkAMRDualClip::~vtkAMRDualClip()
 {
-  if (this->BlockLocator)
-  {
-    delete this->BlockLocator;
-    this->BlockLocator = nullptr;
-  }
   this->SetController(nullptr);
 }
 
@@ -1051,6 +1103,7 @@ void vtkAMRDualClip::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "EnableInternalDecimation: " << this->EnableInternalDecimation << endl;
   os << indent << "EnableDegenerateCells: " << this->EnableDegenerateCells << endl;
   os << indent << "EnableMergePoints: " << this->EnableMergePoints << endl;
+  os << indent << "EnableParallelBlockProcessing: " << this->EnableParallelBlockProcessing << endl;
   os << indent << "Controller: " << this->Controller << endl;
 }
 
@@ -1172,58 +1225,141 @@ vtkMultiBlockDataSet* vtkAMRDualClip::DoRequestData(
     this->DistributeLevelMasks();
   }
 
-  vtkUnstructuredGrid* mesh = vtkUnstructuredGrid::New();
-  this->Points = vtkPoints::New();
-  this->Cells = vtkCellArray::New();
-  mesh->SetPoints(this->Points);
-  mpds->SetPiece(0, mesh);
-
-  this->BlockIdCellArray = vtkIntArray::New();
-  this->BlockIdCellArray->SetName("BlockIds");
-  mesh->GetCellData()->AddArray(this->BlockIdCellArray);
-
-  this->LevelMaskPointArray = vtkUnsignedCharArray::New();
-  this->LevelMaskPointArray->SetName("LevelMask");
-  mesh->GetPointData()->AddArray(this->LevelMaskPointArray);
-
-  this->Mesh = mesh;
-  this->InitializeCopyAttributes(hbdsInput, this->Mesh);
-
   // Loop through blocks
   int numLevels = hbdsInput->GetNumberOfLevels();
   int numBlocks;
   int blockId;
 
-  // Add each block.
+  if (this->EnableParallelBlockProcessing)
+  {
+    vtkSmartPointer<vtkUnstructuredGrid> mesh =
+      this->ProcessBlocksInParallel(hbdsInput, numLevels, arrayNameToProcess);
+    mpds->SetPiece(0, mesh);
+  }
+  else
+  {
+    vtkAMRDualClipBlockOutput output;
+    output.ShareLocators = (this->EnableMergePoints != 0);
+    mpds->SetPiece(0, output.Mesh);
+    this->InitializeCopyAttributes(hbdsInput, output.Mesh);
+
+    // Add each block.
+    for (int level = 0; level < numLevels; ++level)
+    {
+      numBlocks = this->Helper->GetNumberOfBlocksInLevel(level);
+      for (blockId = 0; blockId < numBlocks; ++blockId)
+      {
+        vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockId);
+        this->ProcessBlock(&output, block, blockId, arrayNameToProcess);
+      }
+    }
+
+    output.Mesh->SetCells(VTK_TETRA, output.Cells);
+  }
+
+  mpds->Delete();
+  this->Helper->Delete();
+  this->Helper = nullptr;
+
+  return mbdsOutput0;
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkUnstructuredGrid> vtkAMRDualClip::ProcessBlocksInParallel(
+  vtkNonOverlappingAMR* hbdsInput, int numLevels, const char* arrayNameToProcess)
+{
+  // Gather the local blocks in the same order the serial path visits them.
+  std::vector<vtkAMRDualGridHelperBlock*> blocks;
+  std::vector<int> blockIds;
   for (int level = 0; level < numLevels; ++level)
   {
-    numBlocks = this->Helper->GetNumberOfBlocksInLevel(level);
-    for (blockId = 0; blockId < numBlocks; ++blockId)
+    int numBlocks = this->Helper->GetNumberOfBlocksInLevel(level);
+    for (int blockId = 0; blockId < numBlocks; ++blockId)
     {
       vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockId);
-      this->ProcessBlock(block, blockId, arrayNameToProcess);
+      if (block->Image && block->Image->GetCellData()->GetArray(arrayNameToProcess))
+      {
+        blocks.push_back(block);
+        blockIds.push_back(blockId);
+      }
     }
   }
 
-  this->BlockIdCellArray->Delete();
-  this->BlockIdCellArray = nullptr;
-  this->LevelMaskPointArray->Delete();
-  this->LevelMaskPointArray = nullptr;
+  // The level masks move points between neighboring blocks, so they are
+  // resolved serially, in the order the serial path would, before any block
+  // is clipped.  This keeps the locators of all the blocks alive at once.
+  if (this->EnableMergePoints)
+  {
+    for (vtkAMRDualGridHelperBlock* block : blocks)
+    {
+      this->InitializeLevelMask(block);
+      this->ShareLevelMask(block);
+      block->RegionBits[1][1][1] = 0;
+    }
+  }
+
+  // Allocate the thread local buffers up front so the parallel loop only
+  // touches data owned by its own block.
+  const vtkIdType numberOfBlocks = static_cast<vtkIdType>(blocks.size());
+  std::vector<std::unique_ptr<vtkAMRDualClipBlockOutput>> outputs(numberOfBlocks);
+  for (vtkIdType cc = 0; cc < numberOfBlocks; ++cc)
+  {
+    outputs[cc].reset(new vtkAMRDualClipBlockOutput);
+    outputs[cc]->LevelMasksInitialized = (this->EnableMergePoints != 0);
+    this->InitializeCopyAttributes(hbdsInput, outputs[cc]->Mesh);
+  }
 
-  mesh->SetCells(VTK_TETRA, this->Cells);
+  vtkSMPTools::For(0, numberOfBlocks, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      vtkAMRDualClipBlockOutput* output = outputs[cc].get();
+      this->ProcessBlock(output, blocks[cc], blockIds[cc], arrayNameToProcess);
+      output->Mesh->SetCells(VTK_TETRA, output->Cells);
+      // The locator is not needed once the block is done.
+      delete output->Locator;
+      output->Locator = nullptr;
+      blocks[cc]->UserData = nullptr;
+    }
+  });
 
-  mesh->Delete();
-  this->Mesh = nullptr;
-  this->Points->Delete();
-  this->Points = nullptr;
-  this->Cells->Delete();
-  this->Cells = nullptr;
+  vtkNew<vtkAppendFilter> append;
+  for (vtkIdType cc = 0; cc < numberOfBlocks; ++cc)
+  {
+    if (outputs[cc]->Mesh->GetNumberOfPoints() > 0)
+    {
+      append->AddInputData(outputs[cc]->Mesh);
+    }
+  }
+  vtkSmartPointer<vtkUnstructuredGrid> mesh = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  if (append->GetNumberOfInputConnections(0) == 0)
+  {
+    // Keep the point data arrays even when this process has no output.
+    this->InitializeCopyAttributes(hbdsInput, mesh);
+    mesh->SetPoints(vtkSmartPointer<vtkPoints>::New());
+    return mesh;
+  }
+  append->Update();
 
-  mpds->Delete();
-  this->Helper->Delete();
-  this->Helper = nullptr;
+  if (!this->EnableMergePoints)
+  {
+    mesh->ShallowCopy(append->GetOutput());
+    return mesh;
+  }
 
-  return mbdsOutput0;
+  // Blocks did not share locators, so points on the block boundaries were
+  // generated once per block.  Within a level the duplicates are computed
+  // from the same indices and values, but across levels they come from
+  // blocks with different origins and spacings and may differ by round-off,
+  // so they are merged with a tolerance relative to the bounds, far below
+  // the finest cell size.  The merge keeps the lowest point id, which keeps
+  // the output independent of the thread scheduling.
+  vtkNew<vtkStaticCleanUnstructuredGrid> clean;
+  clean->SetInputConnection(append->GetOutputPort());
+  clean->ToleranceIsAbsoluteOff();
+  clean->SetTolerance(1e-9);
+  clean->Update();
+  mesh->ShallowCopy(clean->GetOutput());
+  return mesh;
 }
 
 //----------------------------------------------------------------------------
@@ -1443,7 +1579,7 @@ void vtkAMRDualClip::ShareLevelMask(vtkAMRDualGridHelperBlock* block)
 }
 
 //----------------------------------------------------------------------------
-void vtkAMRDualClip::ProcessBlock(
+void vtkAMRDualClip::ProcessBlock(vtkAMRDualClipBlockOutput* output,
   vtkAMRDualGridHelperBlock* block, int blockId, const char* arrayNameToProcess)
 {
   vtkImageData* image = block->Image;
@@ -1474,20 +1610,24 @@ void vtkAMRDualClip::ProcessBlock(
 
   // Locator merges points in this block.
   // Input the dimensions of the dual cells with ghosts.
-  if (this->EnableMergePoints)
+  if (output->LevelMasksInitialized)
+  { // Level mask was computed up front; the block locator is ours now.
+    output->Locator = vtkAMRDualClipGetBlockLocator(block);
+  }
+  else if (output->ShareLocators)
   {
     this->InitializeLevelMask(block);
-    this->BlockLocator = vtkAMRDualClipGetBlockLocator(block);
+    output->Locator = vtkAMRDualClipGetBlockLocator(block);
   }
   else
-  { // Shared locator.
-    if (this->BlockLocator == nullptr)
+  { // Locator reused by all the blocks of this output.
+    if (output->Locator == nullptr)
     {
-      this->BlockLocator = new vtkAMRDualClipLocator;
+      output->Locator = new vtkAMRDualClipLocator;
     }
-    this->BlockLocator->Initialize(
+    output->Locator->Initialize(
       extent[1] - extent[0], extent[3] - extent[2], extent[5] - extent[4]);
-    // this->BlockLocator->CopyRegionLevelDifferences(block);
+    // output->Locator->CopyRegionLevelDifferences(block);
   }
   image->GetOrigin(origin);
   spacing = image->GetSpacing();
@@ -1563,7 +1703,8 @@ void vtkAMRDualClip::ProcessBlock(
           cornerOffsets[5] = xOffset + 1 + zInc;
           cornerOffsets[6] = xOffset + yInc + zInc;
           cornerOffsets[7] = xOffset + 1 + yInc + zInc;
-          this->ProcessDualCell(block, blockId, x, y, z, cornerOffsets, volumeFractionArray);
+          this->ProcessDualCell(
+            output, block, blockId, x, y, z, cornerOffsets, volumeFractionArray);
         }
         xOffset += 1; // xInc
       }
@@ -1572,14 +1713,14 @@ void vtkAMRDualClip::ProcessBlock(
     zOffset += zInc;
   }
 
-  if (this->EnableMergePoints)
+  if (output->ShareLocators)
   {
     this->ShareLevelMask(block);
     // Copy point ids into neighbor locators.
     this->ShareBlockLocatorWithNeighbors(block);
     // We are done.  We no longer need the locator for this block.
-    delete this->BlockLocator;
-    this->BlockLocator = nullptr;
+    delete output->Locator;
+    output->Locator = nullptr;
     block->UserData = nullptr;
     // Lets use this unused flag (owner of center region/block) to indicate
     // that the block is already processes.
@@ -1594,8 +1735,9 @@ void vtkAMRDualClip::ProcessBlock(
 //----------------------------------------------------------------------------
 // Not implemented as optimally as we could.  It can be improved by making
 // a fast path for internal cells (with no degeneracies).
-void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int blockId, int x, int y,
-  int z, vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray)
+void vtkAMRDualClip::ProcessDualCell(vtkAMRDualClipBlockOutput* output,
+  vtkAMRDualGridHelperBlock* block, int blockId, int x, int y, int z, vtkIdType cornerOffsets[8],
+  vtkDataArray* volumeFractionArray)
 {
   // compute the case index
   vtkImageData* image = block->Image;
@@ -1823,8 +1965,8 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
       // convert from VTK corner ids to bit (x,y,z) corner ids.
       if (casePtId < 8)
       { // Corner (internal point)
-        ptIdPtr = this->BlockLocator->GetCornerPointer(x, y, z, casePtId, block->OriginIndex);
-        levelMaskValue = this->BlockLocator->GetLevelMaskValue(
+        ptIdPtr = output->Locator->GetCornerPointer(x, y, z, casePtId, block->OriginIndex);
+        levelMaskValue = output->Locator->GetLevelMaskValue(
           x + ((casePtId & 1) ? 1 : 0), y + ((casePtId & 2) ? 1 : 0), z + ((casePtId & 4) ? 1 : 0));
         if (levelMaskValue == 0)
         { // bug !!!!! trying to figure out what is going on.
@@ -1876,7 +2018,7 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
           pt[0] = origin[0] + spacing[0] * (double)(1 << levelDiff) * ((double)(px) + dx);
           pt[1] = origin[1] + spacing[1] * (double)(1 << levelDiff) * ((double)(py) + dy);
           pt[2] = origin[2] + spacing[2] * (double)(1 << levelDiff) * ((double)(pz) + dz);
-          *ptIdPtr = this->Points->InsertNextPoint(pt);
+          *ptIdPtr = output->Points->InsertNextPoint(pt);
           if (pt[1] > 100000.0)
           {
             cerr << "bug\n";
@@ -1890,14 +2032,14 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
           // Averaging could be a pre processing step but we would have to modify input attributes
           // .......
           vtkIdType offset = cornerOffsets[casePtId];
-          this->Mesh->GetPointData()->CopyData(block->Image->GetCellData(), offset, *ptIdPtr);
+          output->Mesh->GetPointData()->CopyData(block->Image->GetCellData(), offset, *ptIdPtr);
 
-          this->LevelMaskPointArray->InsertNextValue(levelMaskValue);
+          output->LevelMask->InsertNextValue(levelMaskValue);
         }
       }
       else
       { // Edge (clipped cell, point on iso surface)
-        ptIdPtr = this->BlockLocator->GetEdgePointer(x, y, z, casePtId - 8);
+        ptIdPtr = output->Locator->GetEdgePointer(x, y, z, casePtId - 8);
         if (*ptIdPtr == -1)
         {
           int edge = casePtId - 8;
@@ -1914,7 +2056,7 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
             cornerPoints[pt1Idx | 1] + k * (cornerPoints[pt2Idx | 1] - cornerPoints[pt1Idx | 1]);
           pt[2] =
             cornerPoints[pt1Idx | 2] + k * (cornerPoints[pt2Idx | 2] - cornerPoints[pt1Idx | 2]);
-          *ptIdPtr = this->Points->InsertNextPoint(pt);
+          *ptIdPtr = output->Points->InsertNextPoint(pt);
           if (pt[1] > 100000.0)
           {
             cerr << "bug\n";
@@ -1924,10 +2066,10 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
           // Find the offsets of the two attributes to interpolate
           vtkIdType offset0 = cornerOffsets[pt1Idx >> 2];
           vtkIdType offset1 = cornerOffsets[pt2Idx >> 2];
-          this->Mesh->GetPointData()->InterpolateEdge(
+          output->Mesh->GetPointData()->InterpolateEdge(
             block->Image->GetCellData(), *ptIdPtr, offset0, offset1, k);
 
-          this->LevelMaskPointArray->InsertNextValue(levelMaskValue);
+          output->LevelMask->InsertNextValue(levelMaskValue);
         }
       }
       pointIds[ii] = *ptIdPtr;
@@ -1935,8 +2077,8 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
     if (pointIds[0] != pointIds[1] && pointIds[0] != pointIds[2] && pointIds[0] != pointIds[3] &&
       pointIds[1] != pointIds[2] && pointIds[1] != pointIds[3] && pointIds[2] != pointIds[3])
     {
-      this->Cells->InsertNextCell(4, pointIds);
-      this->BlockIdCellArray->InsertNextValue(blockId);
+      output->Cells->InsertNextCell(4, pointIds);
+      output->BlockIds->InsertNextValue(blockId);
     }
   }
 }
@@ -17,6 +17,7 @@
 
 #include "vtkMultiBlockDataSetAlgorithm.h"
 #include "vtkPVVTKExtensionsAMRModule.h" //needed for exports
+#include "vtkSmartPointer.h"              // needed for vtkSmartPointer
 
 class vtkDataSet;
 class vtkImageData;
@@ -36,6 +37,7 @@ class vtkAMRDualGridHelper;
 class vtkAMRDualGridHelperBlock;
 class vtkAMRDualGridHelperFace;
 class vtkAMRDualClipLocator;
+class vtkAMRDualClipBlockOutput;
 
 class VTKPVVTKEXTENSIONSAMR_EXPORT vtkAMRDualClip : public vtkMultiBlockDataSetAlgorithm
 {
@@ -74,6 +76,20 @@ public:
   vtkBooleanMacro(EnableMergePoints, int);
   ///@}
 
+  ///@{
+  /**
+   * Process the blocks of this process concurrently with vtkSMPTools.
+   * Each block is clipped into its own buffers with its own locator and the
+   * results are appended in block order, so the output does not depend on the
+   * thread scheduling. When EnableMergePoints is on, the level masks are
+   * resolved serially first and the points duplicated on block boundaries are
+   * merged afterwards. Off by default.
+   */
+  vtkSetMacro(EnableParallelBlockProcessing, int);
+  vtkGetMacro(EnableParallelBlockProcessing, int);
+  vtkBooleanMacro(EnableParallelBlockProcessing, int);
+  ///@}
+
   vtkGetObjectMacro(Controller, vtkMultiProcessController);
   virtual void SetController(vtkMultiProcessController*);
 
@@ -88,9 +104,7 @@ protected:
   int EnableDegenerateCells;
   int EnableMultiProcessCommunication;
   int EnableMergePoints;
-
-  // Needed for copying cell data to point data.
-  vtkUnstructuredGrid* Mesh;
+  int EnableParallelBlockProcessing;
 
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
@@ -102,15 +116,23 @@ protected:
    */
   vtkMultiBlockDataSet* DoRequestData(vtkNonOverlappingAMR* input, const char* arrayNameToProcess);
 
+  /**
+   * Threaded counterpart of the block loop in DoRequestData.
+   */
+  vtkSmartPointer<vtkUnstructuredGrid> ProcessBlocksInParallel(
+    vtkNonOverlappingAMR* input, int numLevels, const char* arrayNameToProcess);
+
   int FillInputPortInformation(int port, vtkInformation* info) override;
   int FillOutputPortInformation(int port, vtkInformation* info) override;
 
   void ShareBlockLocatorWithNeighbors(vtkAMRDualGridHelperBlock* block);
 
-  void ProcessBlock(vtkAMRDualGridHelperBlock* block, int blockId, const char* arrayName);
+  void ProcessBlock(vtkAMRDualClipBlockOutput* output, vtkAMRDualGridHelperBlock* block,
+    int blockId, const char* arrayName);
 
-  void ProcessDualCell(vtkAMRDualGridHelperBlock* block, int blockId, int x, int y, int z,
-    vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray);
+  void ProcessDualCell(vtkAMRDualClipBlockOutput* output, vtkAMRDualGridHelperBlock* block,
+    int blockId, int x, int y, int z, vtkIdType cornerOffsets[8],
+    vtkDataArray* volumeFractionArray);
 
   void InitializeLevelMask(vtkAMRDualGridHelperBlock* block);
   void ShareLevelMask(vtkAMRDualGridHelperBlock* block);
@@ -121,14 +143,9 @@ protected:
   // void MirrorCases();
   // void AddGlyph(double x, double y, double z);
 
-  // Stuff exclusively for debugging.
-  vtkIntArray* BlockIdCellArray;
-  vtkUnsignedCharArray* LevelMaskPointArray;
-
   // Ivars used to reduce method parrameters.
+  // The output mesh and locator live in vtkAMRDualClipBlockOutput.
   vtkAMRDualGridHelper* Helper;
-  vtkPoints* Points;
-  vtkCellArray* Cells;
 
   vtkMultiProcessController* Controller;
 
@@ -137,8 +154,6 @@ protected:
   int* MessageBuffer;
   int* MessageBufferLength;
 
-  vtkAMRDualClipLocator* BlockLocator;
-
 private:
   vtkAMRDualClip(const vtkAMRDualClip&) = delete;
   void operator=(const vtkAMRDualClip&) = delete;
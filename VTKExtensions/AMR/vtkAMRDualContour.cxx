@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkAMRDualContour.h"
 #include "vtkAMRDualGridHelper.h"
+#include <memory>
 #include <vector>
 
 // Pipeline & VTK
@@ -10,9 +11,15 @@
 #include "vtkInformationVector.h"
 #include "vtkMarchingCubesTriangleCases.h"
 #include "vtkMultiProcessController.h"
+#include "vtkNew.h"
 #include "vtkObject.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+// Filters used to merge the per-block outputs of the threaded path.
+#include "vtkAppendPolyData.h"
+#include "vtkStaticCleanPolyData.h"
 // PV interface
 #include "vtkCallbackCommand.h"
 #include "vtkDataArraySelection.h"
@@ -25,10 +32,12 @@
 #include "vtkDataSet.h"
 #include "vtkFloatArray.h"
 #include "vtkImageData.h"
+#include "vtkIntArray.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiPieceDataSet.h"
 #include "vtkNonOverlappingAMR.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkUniformGrid.h"
 #include "vtkUnsignedCharArray.h"
@@ -597,6 +606,51 @@ void vtkAMRDualContourEdgeLocator::ShareBlockLocatorWithNeighbor(
   }
 }
 
+//============================================================================
+// Everything ProcessBlock writes to.  The serial path uses a single instance
+// for all blocks.  The threaded path uses one instance per block so blocks
+// can be processed concurrently; the meshes are appended in block order
+// afterwards, which keeps the output deterministic.
+class vtkAMRDualContourBlockOutput
+{
+public:
+  vtkAMRDualContourBlockOutput()
+  {
+    this->Mesh = vtkPolyData::New();
+    this->Points = vtkPoints::New();
+    this->Faces = vtkCellArray::New();
+    this->Mesh->SetPoints(this->Points);
+    this->Mesh->SetPolys(this->Faces);
+    // For debugging.
+    this->BlockIds = vtkIntArray::New();
+    this->BlockIds->SetName("BlockIds");
+    this->Mesh->GetCellData()->AddArray(this->BlockIds);
+  }
+  ~vtkAMRDualContourBlockOutput()
+  {
+    delete this->Locator;
+    this->BlockIds->Delete();
+    this->Faces->Delete();
+    this->Points->Delete();
+    this->Mesh->Delete();
+  }
+
+  vtkPolyData* Mesh;
+  vtkPoints* Points;
+  vtkCellArray* Faces;
+  vtkIntArray* BlockIds;
+
+  // Locator of the block being processed.  When ShareLocators is set the
+  // locator is owned by the block (UserData) and is handed to neighbors once
+  // the block is done.  Otherwise it is owned by this object and reused.
+  vtkAMRDualContourEdgeLocator* Locator = nullptr;
+  bool ShareLocators = false;
+
+private:
+  vtkAMRDualContourBlockOutput(const vtkAMRDualContourBlockOutput&) = delete;
+  void operator=(const vtkAMRDualContourBlockOutput&) = delete;
+};
+
 //============================================================================
 //----------------------------------------------------------------------------
 // Description:
@@ -612,6 +666,7 @@ vtkAMRDualContour::vtkAMRDualContour()
   this->EnableMultiProcessCommunication = 1;
   this->EnableMergePoints = 1;
   this->TriangulateCap = 1;
+  this->EnableParallelBlockProcessing = 0;
 
   this->Controller = nullptr;
   this->SetController(vtkMultiProcessController::GetGlobalController());
@@ -620,20 +675,12 @@ vtkAMRDualContour::vtkAMRDualContour()
   this->SetNumberOfOutputPorts(1);
 
   this->TemperatureArray = nullptr;
-  this->BlockIdCellArray = nullptr;
   this->Helper = nullptr;
-
-  this->BlockLocator = nullptr;
 }
 
 //----------------------------------------------------------------------------
 vtkAMRDualContour::~vtkAMRDualContour()
 {
-  if (this->BlockLocator)
-  {
-    delete this->BlockLocator;
-    this->BlockLocator = nullptr;
-  }
   this->SetController(nullptr);
 }
 
@@ -650,6 +697,7 @@ void vtkAMRDualContour::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "EnableMergePoints: " << this->EnableMergePoints << endl;
   os << indent << "TriangulateCap: " << this->TriangulateCap << endl;
   os << indent << "SkipGhostCopy: " << this->SkipGhostCopy << endl;
+  os << indent << "EnableParallelBlockProcessing: " << this->EnableParallelBlockProcessing << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -781,22 +829,23 @@ vtkMultiBlockDataSet* vtkAMRDualContour::DoRequestData(
 
   mpds->SetNumberOfPieces(0);
 
-  this->Mesh = vtkPolyData::New();
-  this->Points = vtkPoints::New();
-  this->Faces = vtkCellArray::New();
-  this->Mesh->SetPoints(this->Points);
-  this->Mesh->SetPolys(this->Faces);
-  mpds->SetPiece(0, this->Mesh);
+  // Loop through blocks
+  int numLevels = hbdsInput->GetNumberOfLevels();
 
-  this->InitializeCopyAttributes(hbdsInput, this->Mesh);
+  if (this->EnableParallelBlockProcessing)
+  {
+    vtkSmartPointer<vtkPolyData> mesh =
+      this->ProcessBlocksInParallel(hbdsInput, numLevels, arrayNameToProcess);
+    mpds->SetPiece(0, mesh);
+    mpds->Delete();
+    return mbdsOutput0;
+  }
 
-  // For debugging.
-  this->BlockIdCellArray = vtkIntArray::New();
-  this->BlockIdCellArray->SetName("BlockIds");
-  this->Mesh->GetCellData()->AddArray(this->BlockIdCellArray);
+  vtkAMRDualContourBlockOutput output;
+  output.ShareLocators = (this->EnableMergePoints != 0);
+  mpds->SetPiece(0, output.Mesh);
 
-  // Loop through blocks
-  int numLevels = hbdsInput->GetNumberOfLevels();
+  this->InitializeCopyAttributes(hbdsInput, output.Mesh);
 
   // Add each block.
   for (int level = 0; level < numLevels; ++level)
@@ -805,26 +854,104 @@ vtkMultiBlockDataSet* vtkAMRDualContour::DoRequestData(
     for (int blockId = 0; blockId < numBlocks; ++blockId)
     {
       vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockId);
-      this->ProcessBlock(block, blockId, arrayNameToProcess);
+      this->ProcessBlock(&output, block, blockId, arrayNameToProcess);
     }
   }
 
-  this->FinalizeCopyAttributes(this->Mesh);
-  this->BlockIdCellArray->Delete();
-  this->BlockIdCellArray = nullptr;
-
-  this->Mesh->Delete();
-  this->Mesh = nullptr;
-  this->Points->Delete();
-  this->Points = nullptr;
-  this->Faces->Delete();
-  this->Faces = nullptr;
+  this->FinalizeCopyAttributes(output.Mesh);
 
   mpds->Delete();
 
   return mbdsOutput0;
 }
 
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkPolyData> vtkAMRDualContour::ProcessBlocksInParallel(
+  vtkNonOverlappingAMR* hbdsInput, int numLevels, const char* arrayNameToProcess)
+{
+  // Gather the local blocks in the same order the serial path visits them.
+  std::vector<vtkAMRDualGridHelperBlock*> blocks;
+  std::vector<int> blockIds;
+  for (int level = 0; level < numLevels; ++level)
+  {
+    int numBlocks = this->Helper->GetNumberOfBlocksInLevel(level);
+    for (int blockId = 0; blockId < numBlocks; ++blockId)
+    {
+      vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockId);
+      if (block->Image)
+      {
+        blocks.push_back(block);
+        blockIds.push_back(blockId);
+      }
+    }
+  }
+
+  // Allocate the thread local buffers up front so the parallel loop only
+  // touches data owned by its own block.
+  const vtkIdType numberOfBlocks = static_cast<vtkIdType>(blocks.size());
+  std::vector<std::unique_ptr<vtkAMRDualContourBlockOutput>> outputs(numberOfBlocks);
+  for (vtkIdType cc = 0; cc < numberOfBlocks; ++cc)
+  {
+    outputs[cc].reset(new vtkAMRDualContourBlockOutput);
+    this->InitializeCopyAttributes(hbdsInput, outputs[cc]->Mesh);
+  }
+
+  vtkSMPTools::For(0, numberOfBlocks, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      this->ProcessBlock(outputs[cc].get(), blocks[cc], blockIds[cc], arrayNameToProcess);
+      this->FinalizeCopyAttributes(outputs[cc]->Mesh);
+      // The locator is not needed once the block is done.
+      delete outputs[cc]->Locator;
+      outputs[cc]->Locator = nullptr;
+    }
+  });
+
+  vtkNew<vtkAppendPolyData> append;
+  for (vtkIdType cc = 0; cc < numberOfBlocks; ++cc)
+  {
+    if (outputs[cc]->Mesh->GetNumberOfPoints() > 0)
+    {
+      append->AddInputData(outputs[cc]->Mesh);
+    }
+  }
+  vtkSmartPointer<vtkPolyData> mesh = vtkSmartPointer<vtkPolyData>::New();
+  if (append->GetNumberOfInputConnections(0) == 0)
+  {
+    // Keep the point data arrays even when this process has no surface.
+    this->InitializeCopyAttributes(hbdsInput, mesh);
+    mesh->SetPoints(vtkSmartPointer<vtkPoints>::New());
+    mesh->SetPolys(vtkSmartPointer<vtkCellArray>::New());
+    return mesh;
+  }
+  append->Update();
+
+  if (!this->EnableMergePoints)
+  {
+    mesh->ShallowCopy(append->GetOutput());
+    return mesh;
+  }
+
+  // Blocks did not share locators, so points on the block boundaries were
+  // generated once per block.  Within a level the duplicates are computed
+  // from the same indices and values, but across levels they come from
+  // blocks with different origins and spacings and may differ by round-off,
+  // so they are merged with a tolerance relative to the bounds, far below
+  // the finest cell size.  The merge keeps the lowest point id, which keeps
+  // the output independent of the thread scheduling.
+  vtkNew<vtkStaticCleanPolyData> clean;
+  clean->SetInputConnection(append->GetOutputPort());
+  clean->ToleranceIsAbsoluteOff();
+  clean->SetTolerance(1e-9);
+  clean->PointMergingOn();
+  clean->ConvertLinesToPointsOff();
+  clean->ConvertPolysToLinesOff();
+  clean->ConvertStripsToPolysOff();
+  clean->Update();
+  mesh->ShallowCopy(clean->GetOutput());
+  return mesh;
+}
+
 //----------------------------------------------------------------------------
 void vtkAMRDualContour::ShareBlockLocatorWithNeighbors(vtkAMRDualGridHelperBlock* block)
 {
@@ -873,7 +1000,7 @@ void vtkAMRDualContour::ShareBlockLocatorWithNeighbors(vtkAMRDualGridHelperBlock
 }
 
 //----------------------------------------------------------------------------
-void vtkAMRDualContour::ProcessBlock(
+void vtkAMRDualContour::ProcessBlock(vtkAMRDualContourBlockOutput* output,
   vtkAMRDualGridHelperBlock* block, int blockId, const char* arrayNameToProcess)
 {
   vtkImageData* image = block->Image;
@@ -903,19 +1030,19 @@ void vtkAMRDualContour::ProcessBlock(
 
   // Locator merges points in this block.
   // Input the dimensions of the dual cells with ghosts.
-  if (this->EnableMergePoints)
+  if (output->ShareLocators)
   {
-    this->BlockLocator = vtkAMRDualContourGetBlockLocator(block);
+    output->Locator = vtkAMRDualContourGetBlockLocator(block);
   }
   else
-  { // Shared locator.
-    if (this->BlockLocator == nullptr)
+  { // Locator reused by all the blocks of this output.
+    if (output->Locator == nullptr)
     {
-      this->BlockLocator = new vtkAMRDualContourEdgeLocator;
+      output->Locator = new vtkAMRDualContourEdgeLocator;
     }
-    this->BlockLocator->Initialize(
+    output->Locator->Initialize(
       extent[1] - extent[0], extent[3] - extent[2], extent[5] - extent[4]);
-    this->BlockLocator->CopyRegionLevelDifferences(block);
+    output->Locator->CopyRegionLevelDifferences(block);
   }
   image->GetOrigin(origin);
   spacing = image->GetSpacing();
@@ -996,7 +1123,8 @@ void vtkAMRDualContour::ProcessBlock(
           cornerOffsets[5] = xOffset + 1 + zInc;
           cornerOffsets[6] = xOffset + 1 + yInc + zInc;
           cornerOffsets[7] = xOffset + yInc + zInc;
-          this->ProcessDualCell(block, blockId, x, y, z, cornerOffsets, volumeFractionArray);
+          this->ProcessDualCell(
+            output, block, blockId, x, y, z, cornerOffsets, volumeFractionArray);
         }
         xOffset += 1; // xInc
       }
@@ -1005,13 +1133,13 @@ void vtkAMRDualContour::ProcessBlock(
     zOffset += zInc;
   }
 
-  if (this->EnableMergePoints)
+  if (output->ShareLocators)
   {
     // Copy point ids into neighbor locators.
     this->ShareBlockLocatorWithNeighbors(block);
     // We are done.  We no longer need the locator for this block.
-    delete this->BlockLocator;
-    this->BlockLocator = nullptr;
+    delete output->Locator;
+    output->Locator = nullptr;
     block->UserData = nullptr;
     // Lets use this unused flag (owner of center region/block) to indicate
     // that the block is already processes.
@@ -1080,8 +1208,9 @@ static int vtkAMRDualLegacyIdToBitIdMap[8] = { 0, 1, 3, 2, 4, 5, 7, 6 };
 // Not implemented as optimally as we could.  It can be improved by making
 // a fast path for internal cells (with no degeneracies).
 // Corner offsets are absolute (relative to origin / 0).
-void vtkAMRDualContour::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int blockId, int x, int y,
-  int z, vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray)
+void vtkAMRDualContour::ProcessDualCell(vtkAMRDualContourBlockOutput* output,
+  vtkAMRDualGridHelperBlock* block, int blockId, int x, int y, int z, vtkIdType cornerOffsets[8],
+  vtkDataArray* volumeFractionArray)
 {
   // compute the case index
   vtkImageData* image = block->Image;
@@ -1318,7 +1447,7 @@ void vtkAMRDualContour::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int bl
     // Only permanently keep locator for edges shared between two blocks.
     for (int ii = 0; ii < 3; ++ii, ++edge) // insert triangle
     {
-      vtkIdType* ptIdPtr = this->BlockLocator->GetEdgePointer(x, y, z, *edge);
+      vtkIdType* ptIdPtr = output->Locator->GetEdgePointer(x, y, z, *edge);
 
       if (*ptIdPtr == -1)
       {
@@ -1346,31 +1475,32 @@ void vtkAMRDualContour::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int bl
           cornerPoints[pt1Idx | 1] + k * (cornerPoints[pt2Idx | 1] - cornerPoints[pt1Idx | 1]);
         pt[2] =
           cornerPoints[pt1Idx | 2] + k * (cornerPoints[pt2Idx | 2] - cornerPoints[pt1Idx | 2]);
-        *ptIdPtr = this->Points->InsertNextPoint(pt);
+        *ptIdPtr = output->Points->InsertNextPoint(pt);
         // Interpolate attributes
         // Find the offsets of the two attributes to interpolate
         vtkIdType offset0 = cornerOffsets[vtkAMRDualIsoEdgeToVTKPointsTable[*edge][0]];
         vtkIdType offset1 = cornerOffsets[vtkAMRDualIsoEdgeToVTKPointsTable[*edge][1]];
-        this->InterpolateAttributes(block->Image, offset0, offset1, k, this->Mesh, *ptIdPtr);
+        this->InterpolateAttributes(block->Image, offset0, offset1, k, output->Mesh, *ptIdPtr);
       }
       edgePointIds[*edge] = pointIds[ii] = *ptIdPtr;
     }
     if (pointIds[0] != pointIds[1] && pointIds[0] != pointIds[2] && pointIds[1] != pointIds[2])
     {
-      this->Faces->InsertNextCell(3, pointIds);
-      this->BlockIdCellArray->InsertNextValue(blockId);
+      output->Faces->InsertNextCell(3, pointIds);
+      output->BlockIds->InsertNextValue(blockId);
     }
   }
 
   if (this->EnableCapping)
   {
-    this->CapCell(x, y, z, cubeBoundaryBits, cubeCase, edgePointIds, cornerPoints, cornerOffsets,
-      blockId, block->Image);
+    this->CapCell(output, x, y, z, cubeBoundaryBits, cubeCase, edgePointIds, cornerPoints,
+      cornerOffsets, blockId, block->Image);
   }
 }
 
 //----------------------------------------------------------------------------
-void vtkAMRDualContour::AddCapPolygon(int ptCount, vtkIdType* pointIds, int blockId)
+void vtkAMRDualContour::AddCapPolygon(
+  vtkAMRDualContourBlockOutput* output, int ptCount, vtkIdType* pointIds, int blockId)
 {
   if (this->TriangulateCap)
   {
@@ -1386,8 +1516,8 @@ void vtkAMRDualContour::AddCapPolygon(int ptCount, vtkIdType* pointIds, int bloc
         tri[2] = pointIds[low];
         if (tri[0] != tri[1] && tri[0] != tri[2] && tri[1] != tri[2])
         {
-          this->Faces->InsertNextCell(3, tri);
-          this->BlockIdCellArray->InsertNextValue(blockId);
+          output->Faces->InsertNextCell(3, tri);
+          output->BlockIds->InsertNextValue(blockId);
         }
       }
       else
@@ -1397,16 +1527,16 @@ void vtkAMRDualContour::AddCapPolygon(int ptCount, vtkIdType* pointIds, int bloc
         tri[2] = pointIds[low];
         if (tri[0] != tri[1] && tri[0] != tri[2] && tri[1] != tri[2])
         {
-          this->Faces->InsertNextCell(3, tri);
-          this->BlockIdCellArray->InsertNextValue(blockId);
+          output->Faces->InsertNextCell(3, tri);
+          output->BlockIds->InsertNextValue(blockId);
         }
         tri[0] = pointIds[high];
         tri[1] = pointIds[high + 1];
         tri[2] = pointIds[low];
         if (tri[0] != tri[1] && tri[0] != tri[2] && tri[1] != tri[2])
         {
-          this->Faces->InsertNextCell(3, tri);
-          this->BlockIdCellArray->InsertNextValue(blockId);
+          output->Faces->InsertNextCell(3, tri);
+          output->BlockIds->InsertNextValue(blockId);
         }
       }
       ++low;
@@ -1416,8 +1546,8 @@ void vtkAMRDualContour::AddCapPolygon(int ptCount, vtkIdType* pointIds, int bloc
   else
   {
     // Do not worry about degenerate polygons in this path.
-    this->Faces->InsertNextCell(ptCount, pointIds);
-    this->BlockIdCellArray->InsertNextValue(blockId);
+    output->Faces->InsertNextCell(ptCount, pointIds);
+    output->BlockIds->InsertNextValue(blockId);
   }
 }
 
@@ -1429,6 +1559,8 @@ void vtkAMRDualContour::AddCapPolygon(int ptCount, vtkIdType* pointIds, int bloc
 // It ends up being a little long to duplicate the code 6 times,
 // but it is still fast.
 void vtkAMRDualContour::CapCell(
+  // Buffers receiving the capping polygons.
+  vtkAMRDualContourBlockOutput* output,
   // cell index in block coordinates.
   int cellX, int cellY, int cellZ,
   // Which cell faces need to be capped.
@@ -1463,12 +1595,12 @@ void vtkAMRDualContour::CapCell(
         if (*capPtr < 4)
         {
           cornerIdx = (vtkAMRDualIsoNXCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
+          ptIdPtr = output->Locator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
-            this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+            *ptIdPtr = output->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
+            this->CopyAttributes(inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]],
+              output->Mesh, *ptIdPtr);
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1478,7 +1610,7 @@ void vtkAMRDualContour::CapCell(
         }
         ++capPtr;
       }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(output, ptCount, pointIds, blockId);
       if (*capPtr == -1)
       {
         ++capPtr;
@@ -1499,12 +1631,12 @@ void vtkAMRDualContour::CapCell(
         if (*capPtr < 4)
         {
           cornerIdx = (vtkAMRDualIsoPXCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
+          ptIdPtr = output->Locator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
-            this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+            *ptIdPtr = output->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
+            this->CopyAttributes(inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]],
+              output->Mesh, *ptIdPtr);
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1514,7 +1646,7 @@ void vtkAMRDualContour::CapCell(
         }
         ++capPtr;
       }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(output, ptCount, pointIds, blockId);
       if (*capPtr == -1)
       {
         ++capPtr;
@@ -1536,12 +1668,12 @@ void vtkAMRDualContour::CapCell(
         if (*capPtr < 4)
         {
           cornerIdx = (vtkAMRDualIsoNYCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
+          ptIdPtr = output->Locator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
-            this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+            *ptIdPtr = output->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
+            this->CopyAttributes(inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]],
+              output->Mesh, *ptIdPtr);
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1551,7 +1683,7 @@ void vtkAMRDualContour::CapCell(
         }
         ++capPtr;
       }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(output, ptCount, pointIds, blockId);
       if (*capPtr == -1)
       {
         ++capPtr;
@@ -1573,12 +1705,12 @@ void vtkAMRDualContour::CapCell(
         if (*capPtr < 4)
         {
           cornerIdx = (vtkAMRDualIsoPYCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
+          ptIdPtr = output->Locator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
-            this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+            *ptIdPtr = output->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
+            this->CopyAttributes(inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]],
+              output->Mesh, *ptIdPtr);
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1588,7 +1720,7 @@ void vtkAMRDualContour::CapCell(
         }
         ++capPtr;
       }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(output, ptCount, pointIds, blockId);
       if (*capPtr == -1)
       {
         ++capPtr;
@@ -1609,12 +1741,12 @@ void vtkAMRDualContour::CapCell(
         if (*capPtr < 4)
         {
           cornerIdx = (vtkAMRDualIsoNZCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
+          ptIdPtr = output->Locator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
-            this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+            *ptIdPtr = output->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
+            this->CopyAttributes(inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]],
+              output->Mesh, *ptIdPtr);
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1624,7 +1756,7 @@ void vtkAMRDualContour::CapCell(
         }
         ++capPtr;
       }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(output, ptCount, pointIds, blockId);
       if (*capPtr == -1)
       {
         ++capPtr;
@@ -1646,12 +1778,12 @@ void vtkAMRDualContour::CapCell(
         if (*capPtr < 4)
         {
           cornerIdx = (vtkAMRDualIsoPZCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
+          ptIdPtr = output->Locator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
-            this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+            *ptIdPtr = output->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
+            this->CopyAttributes(inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]],
+              output->Mesh, *ptIdPtr);
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1661,7 +1793,7 @@ void vtkAMRDualContour::CapCell(
         }
         ++capPtr;
       }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(output, ptCount, pointIds, blockId);
       if (*capPtr == -1)
       {
         ++capPtr;
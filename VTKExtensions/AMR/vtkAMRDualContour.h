@@ -24,6 +24,7 @@
 
 #include "vtkMultiBlockDataSetAlgorithm.h"
 #include "vtkPVVTKExtensionsAMRModule.h" //needed for exports
+#include "vtkSmartPointer.h"              // needed for vtkSmartPointer
 
 class vtkDataSet;
 class vtkImageData;
@@ -43,6 +44,7 @@ class vtkAMRDualGridHelper;
 class vtkAMRDualGridHelperBlock;
 class vtkAMRDualGridHelperFace;
 class vtkAMRDualContourEdgeLocator;
+class vtkAMRDualContourBlockOutput;
 
 class VTKPVVTKEXTENSIONSAMR_EXPORT vtkAMRDualContour : public vtkMultiBlockDataSetAlgorithm
 {
@@ -103,6 +105,20 @@ public:
   vtkBooleanMacro(SkipGhostCopy, int);
   ///@}
 
+  ///@{
+  /**
+   * Process the blocks of this process concurrently with vtkSMPTools.
+   * Each block is contoured into its own buffers with its own locator and the
+   * results are appended in block order, so the output does not depend on the
+   * thread scheduling. When EnableMergePoints is on, the points duplicated on
+   * block boundaries are merged afterwards instead of being shared through the
+   * block locators. Off by default.
+   */
+  vtkSetMacro(EnableParallelBlockProcessing, int);
+  vtkGetMacro(EnableParallelBlockProcessing, int);
+  vtkBooleanMacro(EnableParallelBlockProcessing, int);
+  ///@}
+
   vtkGetObjectMacro(Controller, vtkMultiProcessController);
   virtual void SetController(vtkMultiProcessController*);
 
@@ -119,6 +135,7 @@ protected:
   int EnableMergePoints;
   int TriangulateCap;
   int SkipGhostCopy;
+  int EnableParallelBlockProcessing;
 
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
@@ -138,21 +155,32 @@ protected:
    */
   vtkMultiBlockDataSet* DoRequestData(vtkNonOverlappingAMR* input, const char* arrayNameToProcess);
 
+  /**
+   * Threaded counterpart of the block loop in DoRequestData.
+   */
+  vtkSmartPointer<vtkPolyData> ProcessBlocksInParallel(
+    vtkNonOverlappingAMR* input, int numLevels, const char* arrayNameToProcess);
+
   int FillInputPortInformation(int port, vtkInformation* info) override;
   int FillOutputPortInformation(int port, vtkInformation* info) override;
 
   void ShareBlockLocatorWithNeighbors(vtkAMRDualGridHelperBlock* block);
 
-  void ProcessBlock(vtkAMRDualGridHelperBlock* block, int blockId, const char* arrayName);
+  void ProcessBlock(vtkAMRDualContourBlockOutput* output, vtkAMRDualGridHelperBlock* block,
+    int blockId, const char* arrayName);
 
-  void ProcessDualCell(vtkAMRDualGridHelperBlock* block, int blockId, int x, int y, int z,
-    vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray);
+  void ProcessDualCell(vtkAMRDualContourBlockOutput* output, vtkAMRDualGridHelperBlock* block,
+    int blockId, int x, int y, int z, vtkIdType cornerOffsets[8],
+    vtkDataArray* volumeFractionArray);
 
-  void AddCapPolygon(int ptCount, vtkIdType* pointIds, int blockId);
+  void AddCapPolygon(
+    vtkAMRDualContourBlockOutput* output, int ptCount, vtkIdType* pointIds, int blockId);
 
   // This method is getting too many arguments!
   // Capping was an after thought...
   void CapCell(
+    // Buffers receiving the capping polygons.
+    vtkAMRDualContourBlockOutput* output,
     // block coordinates
     int cellX, int cellY, int cellZ,
     // Which cell faces need to be capped.
@@ -171,14 +199,11 @@ protected:
     vtkDataSet* inData);
 
   // Stuff exclusively for debugging.
-  vtkIntArray* BlockIdCellArray;
   vtkFloatArray* TemperatureArray;
 
   // Ivars used to reduce method parrameters.
+  // The output mesh and locator live in vtkAMRDualContourBlockOutput.
   vtkAMRDualGridHelper* Helper;
-  vtkPolyData* Mesh;
-  vtkPoints* Points;
-  vtkCellArray* Faces;
 
   vtkMultiProcessController* Controller;
 
@@ -187,8 +212,6 @@ protected:
   int* MessageBuffer;
   int* MessageBufferLength;
 
-  vtkAMRDualContourEdgeLocator* BlockLocator;
-
   // Stuff for passing cell attributes to point attributes.
   void InitializeCopyAttributes(vtkNonOverlappingAMR* hbdsInput, vtkDataSet* mesh);
   void InterpolateAttributes(vtkDataSet* uGrid, vtkIdType offset0, vtkIdType offset1, double k,
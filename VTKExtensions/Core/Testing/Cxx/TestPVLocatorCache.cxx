@@ -0,0 +1,173 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include <vtkAbstractCellLocator.h>
+#include <vtkCellType.h>
+#include <vtkFindCellStrategy.h>
+#include <vtkGenericCell.h>
+#include <vtkIdList.h>
+#include <vtkLogger.h>
+#include <vtkMultiBlockDataSet.h>
+#include <vtkNew.h>
+#include <vtkPVLocatorCache.h>
+#include <vtkPoints.h>
+#include <vtkSmartPointer.h>
+#include <vtkUnstructuredGrid.h>
+#include <vtkWeakPointer.h>
+
+#include <cmath>
+
+namespace
+{
+// A grid of n^3 unit hexahedra; cell (i, j, k) has id i + n * (j + n * k).
+void CreateGrid(vtkUnstructuredGrid* grid, int n)
+{
+  const int np = n + 1;
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k < np; ++k)
+  {
+    for (int j = 0; j < np; ++j)
+    {
+      for (int i = 0; i < np; ++i)
+      {
+        points->InsertNextPoint(i, j, k);
+      }
+    }
+  }
+  grid->SetPoints(points);
+  grid->AllocateExact(n * n * n, 8 * n * n * n);
+  for (int k = 0; k < n; ++k)
+  {
+    for (int j = 0; j < n; ++j)
+    {
+      for (int i = 0; i < n; ++i)
+      {
+        const vtkIdType p0 = i + np * (j + np * k);
+        const vtkIdType hex[8] = { p0, p0 + 1, p0 + np + 1, p0 + np, p0 + np * np,
+          p0 + np * np + 1, p0 + np * np + np + 1, p0 + np * np + np };
+        grid->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+      }
+    }
+  }
+}
+}
+
+int TestPVLocatorCache(int, char*[])
+{
+  const int n = 10;
+  vtkNew<vtkUnstructuredGrid> grid;
+  CreateGrid(grid, n);
+
+  vtkNew<vtkPVLocatorCache> cache;
+  vtkAbstractCellLocator* cellLocator = cache->GetCellLocator(grid);
+  vtkLogIfF(ERROR, cellLocator == nullptr, "Missing cell locator");
+  vtkLogIfF(ERROR, cache->GetCellLocator(grid) != cellLocator || cache->GetNumberOfBuilds() != 1,
+    "Cell locator was rebuilt for an unmodified dataset");
+
+  // Sharing the locator through a shallow copy does not rebuild it, and
+  // leaves the dataset untouched.
+  {
+    vtkSmartPointer<vtkDataObject> copy = cache->ShallowCopyWithCellLocators(grid);
+    auto copyGrid = vtkUnstructuredGrid::SafeDownCast(copy);
+    vtkLogIfF(ERROR, !copyGrid || copyGrid == grid.GetPointer(), "Expected a shallow copy");
+    vtkLogIfF(ERROR, copyGrid && copyGrid->GetCellLocator() != cellLocator,
+      "Cell locator was not shared");
+    vtkLogIfF(ERROR, grid->GetCellLocator() != nullptr, "Cell locator attached to the input");
+    cache->GetCellLocator(grid);
+    vtkLogIfF(ERROR, cache->GetNumberOfBuilds() != 1, "Sharing the cell locator rebuilt it");
+  }
+
+  // Batched queries at cell centers, and outside of the grid.
+  vtkNew<vtkPoints> queries;
+  for (int k = 0; k < n; ++k)
+  {
+    for (int j = 0; j < n; ++j)
+    {
+      for (int i = 0; i < n; ++i)
+      {
+        queries->InsertNextPoint(i + 0.5, j + 0.5, k + 0.5);
+      }
+    }
+  }
+  queries->InsertNextPoint(-1.0, 0.5, 0.5);
+  vtkNew<vtkIdList> ids;
+  cache->FindCells(grid, queries, 0.0, ids);
+  vtkLogIfF(ERROR, ids->GetNumberOfIds() != queries->GetNumberOfPoints(), "Wrong number of ids");
+  for (vtkIdType cc = 0; cc < n * n * n; ++cc)
+  {
+    vtkLogIfF(ERROR, ids->GetId(cc) != cc, "Wrong cell %lld for point %lld",
+      static_cast<long long>(ids->GetId(cc)), static_cast<long long>(cc));
+  }
+  vtkLogIfF(ERROR, ids->GetId(n * n * n) != -1, "Point outside of the grid was located");
+
+  // Probes locate the cells of the batch through the strategy, and other
+  // locations through the locator.
+  {
+    vtkSmartPointer<vtkFindCellStrategy> strategy = cache->NewFindCellStrategy(grid, queries);
+    strategy->Initialize(grid);
+    vtkNew<vtkGenericCell> cell;
+    double weights[8];
+    double pcoords[3];
+    int subId;
+    double x[3] = { 1.25, 2.5, 3.75 };
+    vtkLogIfF(ERROR,
+      strategy->FindCell(x, nullptr, cell, -1, 0.0, subId, pcoords, weights) != 1 + n * (2 + n * 3),
+      "Strategy did not locate a point outside of the batch");
+    for (vtkIdType cc = 0; cc < n * n * n; cc += 7)
+    {
+      queries->GetPoint(cc, x);
+      vtkLogIfF(ERROR, strategy->FindCell(x, nullptr, cell, -1, 0.0, subId, pcoords, weights) != cc,
+        "Strategy did not locate point %lld", static_cast<long long>(cc));
+      vtkLogIfF(ERROR, std::abs(pcoords[0] - 0.5) > 1e-6 || std::abs(weights[0] - 0.125) > 1e-6,
+        "Wrong parametric coordinates for point %lld", static_cast<long long>(cc));
+    }
+    vtkLogIfF(ERROR, cache->GetNumberOfBuilds() != 1, "Strategy rebuilt the cell locator");
+  }
+
+  // Moving points rebuilds the locator.
+  grid->GetPoints()->SetPoint(0, -0.5, -0.5, -0.5);
+  grid->GetPoints()->Modified();
+  cache->GetCellLocator(grid);
+  vtkLogIfF(ERROR, cache->GetNumberOfBuilds() != 2, "Cell locator was not rebuilt");
+
+  // Composite datasets are copied block by block.
+  vtkNew<vtkUnstructuredGrid> other;
+  CreateGrid(other, 2);
+  vtkNew<vtkMultiBlockDataSet> multiBlock;
+  multiBlock->SetBlock(0, other);
+  multiBlock->SetBlock(1, vtkNew<vtkUnstructuredGrid>());
+  {
+    vtkSmartPointer<vtkDataObject> copy = cache->ShallowCopyWithCellLocators(multiBlock);
+    auto copyBlocks = vtkMultiBlockDataSet::SafeDownCast(copy);
+    auto copyBlock =
+      vtkUnstructuredGrid::SafeDownCast(copyBlocks ? copyBlocks->GetBlock(0) : nullptr);
+    vtkLogIfF(ERROR, !copyBlock || copyBlock == other.GetPointer(), "Expected a shallow copy");
+    vtkLogIfF(ERROR, copyBlock && copyBlock->GetCellLocator() != cache->GetCellLocator(other),
+      "Cell locator was not shared");
+    vtkLogIfF(ERROR, other->GetCellLocator() != nullptr, "Cell locator attached to the input");
+  }
+
+  // Least recently used entries are released.
+  cache->SetMaximumNumberOfEntries(1);
+  const vtkIdType numberOfBuilds = cache->GetNumberOfBuilds();
+  cache->GetCellLocator(grid);
+  cache->GetCellLocator(other);
+  vtkLogIfF(ERROR, cache->GetNumberOfBuilds() != numberOfBuilds + 1,
+    "Least recently used locator was not released");
+
+  // The locators do not keep their dataset alive, and entries are released
+  // with their dataset.
+  cache->SetMaximumNumberOfEntries(256);
+  vtkWeakPointer<vtkUnstructuredGrid> released;
+  {
+    vtkNew<vtkUnstructuredGrid> temporary;
+    CreateGrid(temporary, 2);
+    cache->GetCellLocator(temporary);
+    vtkLogIfF(ERROR, cache->GetNumberOfEntries() != 2, "Expected an entry for the dataset");
+    released = temporary;
+  }
+  vtkLogIfF(ERROR, released != nullptr, "Cache keeps an unused dataset alive");
+  vtkLogIfF(ERROR, cache->GetNumberOfEntries() != 1, "Entry of a deleted dataset was kept");
+
+  cache->ReleaseAllLocators();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,236 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkIntArray.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPVPostFilter.h"
+#include "vtkPVPostFilterExecutive.h"
+#include "vtkPointData.h"
+#include "vtkSmartPointer.h"
+
+#include <cmath>
+
+namespace
+{
+// 4x4x4 image with:
+// - "Vec", 3 float components, on points,
+// - "Named", 2 int components named "angle" and "speed", on points,
+// - "Mixed", 4 components on cells and 2 on points,
+// - "CellVec", 3 double components, on cells.
+vtkSmartPointer<vtkImageData> CreateInput()
+{
+  auto image = vtkSmartPointer<vtkImageData>::New();
+  image->SetDimensions(4, 4, 4);
+  const vtkIdType numPoints = image->GetNumberOfPoints();
+  const vtkIdType numCells = image->GetNumberOfCells();
+
+  vtkNew<vtkFloatArray> vec;
+  vec->SetName("Vec");
+  vec->SetNumberOfComponents(3);
+  vec->SetNumberOfTuples(numPoints);
+  vtkNew<vtkIntArray> named;
+  named->SetName("Named");
+  named->SetNumberOfComponents(2);
+  named->SetComponentName(0, "angle");
+  named->SetComponentName(1, "speed");
+  named->SetNumberOfTuples(numPoints);
+  vtkNew<vtkDoubleArray> pointMixed;
+  pointMixed->SetName("Mixed");
+  pointMixed->SetNumberOfComponents(2);
+  pointMixed->SetNumberOfTuples(numPoints);
+  for (vtkIdType cc = 0; cc < numPoints; ++cc)
+  {
+    for (int comp = 0; comp < 3; ++comp)
+    {
+      vec->SetTypedComponent(cc, comp, static_cast<float>(cc - 0.25 * comp));
+    }
+    named->SetTypedComponent(cc, 0, static_cast<int>(cc % 7));
+    named->SetTypedComponent(cc, 1, static_cast<int>(3 * cc));
+    pointMixed->SetTypedComponent(cc, 0, cc);
+    pointMixed->SetTypedComponent(cc, 1, -cc);
+  }
+  image->GetPointData()->AddArray(vec);
+  image->GetPointData()->AddArray(named);
+  image->GetPointData()->AddArray(pointMixed);
+
+  vtkNew<vtkDoubleArray> cellMixed;
+  cellMixed->SetName("Mixed");
+  cellMixed->SetNumberOfComponents(4);
+  cellMixed->SetNumberOfTuples(numCells);
+  cellMixed->Fill(1.0);
+  vtkNew<vtkDoubleArray> cellVec;
+  cellVec->SetName("CellVec");
+  cellVec->SetNumberOfComponents(3);
+  cellVec->SetNumberOfTuples(numCells);
+  for (vtkIdType cc = 0; cc < numCells; ++cc)
+  {
+    cellVec->SetTypedComponent(cc, 0, cc);
+    cellVec->SetTypedComponent(cc, 1, 2.0 * cc);
+    cellVec->SetTypedComponent(cc, 2, 1.0);
+  }
+  image->GetCellData()->AddArray(cellMixed);
+  image->GetCellData()->AddArray(cellVec);
+  return image;
+}
+
+// Requests the `name` point array of the first input from `filter`, as
+// vtkPVCompositeDataPipeline does for the arrays processed downstream.
+void RequestPointArray(vtkPVPostFilter* filter, int idx, const char* name)
+{
+  vtkNew<vtkInformation> info;
+  info->Set(vtkAlgorithm::INPUT_PORT(), 0);
+  info->Set(vtkAlgorithm::INPUT_CONNECTION(), 0);
+  info->Set(vtkDataObject::FIELD_ASSOCIATION(), vtkDataObject::FIELD_ASSOCIATION_POINTS);
+  info->Set(vtkDataObject::FIELD_NAME(), name);
+  vtkPVPostFilterExecutive::SafeDownCast(filter->GetExecutive())
+    ->SetPostArrayToProcessInformation(idx, info);
+}
+
+vtkDataArray* GetPointArray(vtkPVPostFilter* filter, const char* name)
+{
+  auto output = vtkDataSet::SafeDownCast(filter->GetOutputDataObject(0));
+  return output ? output->GetPointData()->GetArray(name) : nullptr;
+}
+
+// Checks that `array` has a single component with the `expected` data type
+// and the values of `component` of `source`, or of its magnitude when -1.
+bool CheckComponent(
+  vtkDataArray* array, vtkDataArray* source, int component, int expectedType, const char* name)
+{
+  if (!array || !source)
+  {
+    vtkLogF(ERROR, "'%s' is missing.", name);
+    return false;
+  }
+  if (array->GetNumberOfComponents() != 1 ||
+    array->GetNumberOfTuples() != source->GetNumberOfTuples() ||
+    array->GetDataType() != expectedType)
+  {
+    vtkLogF(ERROR, "'%s' has %d components, %lld tuples and type %s.", name,
+      array->GetNumberOfComponents(), static_cast<long long>(array->GetNumberOfTuples()),
+      array->GetDataTypeAsString());
+    return false;
+  }
+  for (vtkIdType cc = 0; cc < source->GetNumberOfTuples(); ++cc)
+  {
+    double expected = 0.0;
+    if (component == -1)
+    {
+      for (int comp = 0; comp < source->GetNumberOfComponents(); ++comp)
+      {
+        expected += source->GetComponent(cc, comp) * source->GetComponent(cc, comp);
+      }
+      expected = std::sqrt(expected);
+    }
+    else
+    {
+      expected = source->GetComponent(cc, component);
+    }
+    if (std::abs(array->GetComponent(cc, 0) - expected) > 1e-6 * (1.0 + std::abs(expected)))
+    {
+      vtkLogF(ERROR, "'%s' is %g instead of %g at %lld.", name, array->GetComponent(cc, 0),
+        expected, static_cast<long long>(cc));
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestPVPostFilter(int, char*[])
+{
+  bool success = true;
+  vtkSmartPointer<vtkImageData> input = CreateInput();
+  vtkDataArray* vec = input->GetPointData()->GetArray("Vec");
+  vtkDataArray* named = input->GetPointData()->GetArray("Named");
+
+  // components, by default and actual names, and magnitude.
+  {
+    vtkNew<vtkPVPostFilter> filter;
+    filter->SetInputData(input);
+    RequestPointArray(filter, 0, "Vec_Y");
+    RequestPointArray(filter, 1, "Vec_Magnitude");
+    RequestPointArray(filter, 2, "Named_speed");
+    filter->Update();
+
+    vtkDataArray* vecY = GetPointArray(filter, "Vec_Y");
+    success = CheckComponent(vecY, vec, 1, VTK_FLOAT, "Vec_Y") && success;
+    success = CheckComponent(GetPointArray(filter, "Vec_Magnitude"), vec, -1, VTK_DOUBLE,
+                "Vec_Magnitude") &&
+      success;
+    success =
+      CheckComponent(GetPointArray(filter, "Named_speed"), named, 1, VTK_INT, "Named_speed") &&
+      success;
+
+    // the implicit arrays still provide raw pointers, through a copy.
+    const float* values = vecY ? static_cast<const float*>(vecY->GetVoidPointer(0)) : nullptr;
+    if (!values || values[5] != vec->GetComponent(5, 1))
+    {
+      vtkLogF(ERROR, "GetVoidPointer does not match the values of 'Vec_Y'.");
+      success = false;
+    }
+  }
+
+  // "Mixed_3" is a component of the cell array: requested on points, where
+  // the array only has 2 components, it is not extracted.
+  {
+    vtkNew<vtkPVPostFilter> filter;
+    filter->SetInputData(input);
+    RequestPointArray(filter, 0, "Mixed_3");
+    vtkObject::GlobalWarningDisplayOff();
+    filter->Update();
+    vtkObject::GlobalWarningDisplayOn();
+    if (GetPointArray(filter, "Mixed_3") != nullptr)
+    {
+      vtkLogF(ERROR, "Out of range component 'Mixed_3' was extracted.");
+      success = false;
+    }
+  }
+
+  // cell arrays interpolated to points are reused until the input is modified.
+  {
+    vtkNew<vtkPVPostFilter> filter;
+    filter->SetInputData(input);
+    RequestPointArray(filter, 0, "CellVec");
+    RequestPointArray(filter, 1, "CellVec_X");
+    filter->Update();
+    vtkSmartPointer<vtkDataArray> converted = GetPointArray(filter, "CellVec");
+    if (!converted || converted->GetNumberOfTuples() != input->GetNumberOfPoints())
+    {
+      vtkLogF(ERROR, "'CellVec' was not interpolated to points.");
+      return EXIT_FAILURE;
+    }
+    success =
+      CheckComponent(GetPointArray(filter, "CellVec_X"), converted, 0, VTK_DOUBLE, "CellVec_X") &&
+      success;
+
+    filter->Update();
+    if (GetPointArray(filter, "CellVec") != converted)
+    {
+      vtkLogF(ERROR, "'CellVec' was interpolated again for an unchanged input.");
+      success = false;
+    }
+
+    input->Modified();
+    filter->Update();
+    vtkDataArray* reconverted = GetPointArray(filter, "CellVec");
+    if (!reconverted || reconverted == converted)
+    {
+      vtkLogF(ERROR, "'CellVec' was not interpolated again for a modified input.");
+      success = false;
+    }
+    success = CheckComponent(GetPointArray(filter, "CellVec_X"), reconverted, 0, VTK_DOUBLE,
+                "CellVec_X after modification") &&
+      success;
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,437 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkPVLocatorCache.h"
+
+#include "vtkCellLocatorStrategy.h"
+#include "vtkCommand.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataSet.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkStaticCellLocator.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+// Locators only depend on the structure of the dataset and on its points, not
+// on its attributes, so the modification time of the attributes is ignored.
+vtkMTimeType GetGeometryMTime(vtkDataSet* dataset)
+{
+  vtkMTimeType mtime = dataset->vtkObject::GetMTime();
+  auto pointSet = vtkPointSet::SafeDownCast(dataset);
+  if (pointSet && pointSet->GetPoints())
+  {
+    mtime = std::max(mtime, pointSet->GetPoints()->GetMTime());
+  }
+  return mtime;
+}
+
+// Cells of some datasets, e.g. vtkPolyData, are built lazily and must exist
+// before the dataset is accessed from several threads.
+void PrepareForThreadedAccess(vtkDataSet* dataset)
+{
+  if (dataset->GetNumberOfCells() > 0)
+  {
+    vtkNew<vtkGenericCell> cell;
+    dataset->GetCell(0, cell);
+  }
+}
+
+// Cell locator that does not reference its dataset, so that caching it does
+// not keep the dataset alive. The cache releases it when the dataset is
+// deleted.
+class vtkPVCachedCellLocator : public vtkStaticCellLocator
+{
+public:
+  static vtkPVCachedCellLocator* New();
+  vtkTypeMacro(vtkPVCachedCellLocator, vtkStaticCellLocator);
+
+  void SetDataSet(vtkDataSet* dataset) override
+  {
+    if (this->DataSet != dataset)
+    {
+      this->DataSet = dataset;
+      this->Modified();
+    }
+  }
+
+protected:
+  vtkPVCachedCellLocator() = default;
+  ~vtkPVCachedCellLocator() override { this->DataSet = nullptr; }
+
+  void ReportReferences(vtkGarbageCollector* collector) override
+  {
+    // the dataset is not referenced.
+    this->vtkObject::ReportReferences(collector);
+  }
+
+private:
+  vtkPVCachedCellLocator(const vtkPVCachedCellLocator&) = delete;
+  void operator=(const vtkPVCachedCellLocator&) = delete;
+};
+vtkStandardNewMacro(vtkPVCachedCellLocator);
+
+// Cells containing the points probed by a filter, found by
+// vtkPVLocatorCache::FindCells, keyed by the coordinates of the points.
+using vtkLocatedCells = std::map<std::array<double, 3>, vtkIdType>;
+
+// Strategy answering the queries of vtkProbeFilter from the cells located
+// beforehand, and other queries, e.g. with a tolerance, from the locator.
+class vtkPVBatchedCellLocatorStrategy : public vtkCellLocatorStrategy
+{
+public:
+  static vtkPVBatchedCellLocatorStrategy* New();
+  vtkTypeMacro(vtkPVBatchedCellLocatorStrategy, vtkCellLocatorStrategy);
+
+  vtkIdType FindCell(double x[3], vtkCell* cell, vtkGenericCell* gencell, vtkIdType cellId,
+    double tol2, int& subId, double pcoords[3], double* weights) override
+  {
+    if (this->LocatedCells && this->PointSet)
+    {
+      auto iter = this->LocatedCells->find({ x[0], x[1], x[2] });
+      if (iter != this->LocatedCells->end() && iter->second >= 0)
+      {
+        double closest[3];
+        double dist2;
+        this->PointSet->GetCell(iter->second, gencell);
+        if (gencell->EvaluatePosition(x, closest, subId, pcoords, dist2, weights) == 1)
+        {
+          return iter->second;
+        }
+      }
+    }
+    return this->Superclass::FindCell(x, cell, gencell, cellId, tol2, subId, pcoords, weights);
+  }
+
+  void CopyParameters(vtkFindCellStrategy* from) override
+  {
+    this->Superclass::CopyParameters(from);
+    if (auto batched = vtkPVBatchedCellLocatorStrategy::SafeDownCast(from))
+    {
+      this->LocatedCells = batched->LocatedCells;
+    }
+  }
+
+  // shared with the copies made for each thread by the probe.
+  std::shared_ptr<const vtkLocatedCells> LocatedCells;
+
+protected:
+  vtkPVBatchedCellLocatorStrategy() = default;
+  ~vtkPVBatchedCellLocatorStrategy() override = default;
+
+private:
+  vtkPVBatchedCellLocatorStrategy(const vtkPVBatchedCellLocatorStrategy&) = delete;
+  void operator=(const vtkPVBatchedCellLocatorStrategy&) = delete;
+};
+vtkStandardNewMacro(vtkPVBatchedCellLocatorStrategy);
+
+class vtkFindCellsFunctor
+{
+public:
+  vtkFindCellsFunctor(vtkDataSet* dataset, vtkAbstractCellLocator* locator, vtkPoints* points,
+    double tol2, vtkIdList* cellIds)
+    : DataSet(dataset)
+    , Locator(locator)
+    , Points(points)
+    , Tol2(tol2)
+    , CellIds(cellIds)
+    , MaxCellSize(std::max(dataset->GetMaxCellSize(), 1))
+  {
+  }
+
+  void Initialize() { this->Weights.Local().resize(this->MaxCellSize); }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkGenericCell* cell = this->Cell.Local();
+    double* weights = this->Weights.Local().data();
+    double x[3];
+    double pcoords[3];
+    int subId;
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      this->Points->GetPoint(i, x);
+      const vtkIdType cellId = this->Locator
+        ? this->Locator->FindCell(x, this->Tol2, cell, subId, pcoords, weights)
+        : this->DataSet->FindCell(x, nullptr, cell, -1, this->Tol2, subId, pcoords, weights);
+      this->CellIds->SetId(i, cellId);
+    }
+  }
+
+  void Reduce() {}
+
+private:
+  vtkDataSet* DataSet;
+  vtkAbstractCellLocator* Locator;
+  vtkPoints* Points;
+  double Tol2;
+  vtkIdList* CellIds;
+  int MaxCellSize;
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+  vtkSMPThreadLocal<std::vector<double>> Weights;
+};
+}
+
+class vtkPVLocatorCache::vtkInternals
+{
+public:
+  struct Entry
+  {
+    vtkSmartPointer<vtkAbstractCellLocator> CellLocator;
+    vtkMTimeType CellLocatorMTime = 0;
+    unsigned long ObserverTag = 0;
+    std::uint64_t LastUse = 0;
+  };
+
+  std::map<vtkDataSet*, Entry> Entries;
+  std::uint64_t Clock = 0;
+  std::mutex Mutex;
+
+  Entry& GetEntry(vtkDataSet* dataset, vtkPVLocatorCache* self)
+  {
+    auto iter = this->Entries.find(dataset);
+    if (iter == this->Entries.end())
+    {
+      iter = this->Entries.emplace(dataset, Entry()).first;
+      iter->second.ObserverTag = dataset->AddObserver(
+        vtkCommand::DeleteEvent, self, &vtkPVLocatorCache::OnDataSetDeleted);
+    }
+    iter->second.LastUse = ++this->Clock;
+    this->Evict(self->MaximumNumberOfEntries);
+    return iter->second;
+  }
+
+  void Release(std::map<vtkDataSet*, Entry>::iterator iter)
+  {
+    iter->first->RemoveObserver(iter->second.ObserverTag);
+    this->Entries.erase(iter);
+  }
+
+  void Evict(int maximumNumberOfEntries)
+  {
+    while (this->Entries.size() > static_cast<size_t>(maximumNumberOfEntries))
+    {
+      this->Release(std::min_element(this->Entries.begin(), this->Entries.end(),
+        [](const auto& a, const auto& b) { return a.second.LastUse < b.second.LastUse; }));
+    }
+  }
+
+  vtkAbstractCellLocator* UpdateCellLocator(
+    Entry& entry, vtkDataSet* dataset, vtkIdType& numberOfBuilds)
+  {
+    if (!entry.CellLocator)
+    {
+      entry.CellLocator = vtkSmartPointer<vtkPVCachedCellLocator>::New();
+      entry.CellLocatorMTime = 0;
+    }
+    if (entry.CellLocatorMTime != ::GetGeometryMTime(dataset))
+    {
+      entry.CellLocator->SetDataSet(dataset);
+      entry.CellLocator->ForceBuildLocator();
+      entry.CellLocatorMTime = ::GetGeometryMTime(dataset);
+      ++numberOfBuilds;
+    }
+    return entry.CellLocator;
+  }
+
+  // Shallow copy of `input` where `attach(source, copy)` is called for every
+  // non empty vtkPointSet leaf.
+  template <typename Attach>
+  static vtkSmartPointer<vtkDataObject> ShallowCopy(vtkDataObject* input, Attach&& attach)
+  {
+    auto copyLeaf = [&](vtkDataObject* leaf) {
+      vtkSmartPointer<vtkDataObject> copy;
+      if (leaf)
+      {
+        copy.TakeReference(leaf->NewInstance());
+        copy->ShallowCopy(leaf);
+        auto pointSet = vtkPointSet::SafeDownCast(leaf);
+        if (pointSet && pointSet->GetNumberOfPoints() > 0)
+        {
+          attach(pointSet, vtkPointSet::SafeDownCast(copy));
+        }
+      }
+      return copy;
+    };
+
+    auto composite = vtkCompositeDataSet::SafeDownCast(input);
+    if (!composite)
+    {
+      return copyLeaf(input);
+    }
+    vtkSmartPointer<vtkCompositeDataSet> output;
+    output.TakeReference(composite->NewInstance());
+    output->CopyStructure(composite);
+    vtkSmartPointer<vtkCompositeDataIterator> iter;
+    iter.TakeReference(composite->NewIterator());
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+      output->SetDataSet(iter, copyLeaf(iter->GetCurrentDataObject()));
+    }
+    return output;
+  }
+};
+
+vtkStandardNewMacro(vtkPVLocatorCache);
+//----------------------------------------------------------------------------
+vtkPVLocatorCache::vtkPVLocatorCache()
+  : Internals(new vtkPVLocatorCache::vtkInternals())
+{
+}
+
+//----------------------------------------------------------------------------
+vtkPVLocatorCache::~vtkPVLocatorCache()
+{
+  this->ReleaseAllLocators();
+}
+
+//----------------------------------------------------------------------------
+vtkPVLocatorCache* vtkPVLocatorCache::GetInstance()
+{
+  static vtkSmartPointer<vtkPVLocatorCache> Instance =
+    vtk::TakeSmartPointer(vtkPVLocatorCache::New());
+  return Instance;
+}
+
+//----------------------------------------------------------------------------
+vtkAbstractCellLocator* vtkPVLocatorCache::GetCellLocator(vtkDataSet* dataset)
+{
+  if (!dataset)
+  {
+    return nullptr;
+  }
+  auto& internals = *this->Internals;
+  std::lock_guard<std::mutex> lock(internals.Mutex);
+  auto& entry = internals.GetEntry(dataset, this);
+  return internals.UpdateCellLocator(entry, dataset, this->NumberOfBuilds);
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataObject> vtkPVLocatorCache::ShallowCopyWithCellLocators(
+  vtkDataObject* dataObject)
+{
+  return vtkInternals::ShallowCopy(dataObject, [this](vtkPointSet* source, vtkPointSet* copy) {
+    if (source->GetNumberOfCells() > 0)
+    {
+      copy->SetCellLocator(this->GetCellLocator(source));
+    }
+  });
+}
+
+//----------------------------------------------------------------------------
+void vtkPVLocatorCache::FindCells(
+  vtkDataSet* dataset, vtkPoints* points, double tol2, vtkIdList* cellIds)
+{
+  const vtkIdType numPoints = points ? points->GetNumberOfPoints() : 0;
+  cellIds->SetNumberOfIds(numPoints);
+  if (!dataset || dataset->GetNumberOfCells() == 0)
+  {
+    std::fill_n(cellIds->GetPointer(0), numPoints, -1);
+    return;
+  }
+
+  // Structured datasets locate cells directly.
+  vtkSmartPointer<vtkAbstractCellLocator> locator =
+    vtkPointSet::SafeDownCast(dataset) ? this->GetCellLocator(dataset) : nullptr;
+  ::PrepareForThreadedAccess(dataset);
+  ::vtkFindCellsFunctor functor(dataset, locator, points, tol2, cellIds);
+  vtkSMPTools::For(0, numPoints, functor);
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkFindCellStrategy> vtkPVLocatorCache::NewFindCellStrategy(
+  vtkPointSet* dataset, vtkPoints* points)
+{
+  auto strategy = vtkSmartPointer<vtkPVBatchedCellLocatorStrategy>::New();
+  strategy->SetCellLocator(this->GetCellLocator(dataset));
+
+  vtkNew<vtkIdList> cellIds;
+  this->FindCells(dataset, points, 0.0, cellIds);
+  auto locatedCells = std::make_shared<vtkLocatedCells>();
+  double x[3];
+  for (vtkIdType cc = 0; cc < cellIds->GetNumberOfIds(); ++cc)
+  {
+    points->GetPoint(cc, x);
+    locatedCells->emplace(std::array<double, 3>{ x[0], x[1], x[2] }, cellIds->GetId(cc));
+  }
+  strategy->LocatedCells = locatedCells;
+  return strategy;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVLocatorCache::OnDataSetDeleted(vtkObject* dataset, unsigned long, void*)
+{
+  auto& internals = *this->Internals;
+  std::lock_guard<std::mutex> lock(internals.Mutex);
+  internals.Entries.erase(static_cast<vtkDataSet*>(dataset));
+}
+
+//----------------------------------------------------------------------------
+void vtkPVLocatorCache::ReleaseLocators(vtkDataSet* dataset)
+{
+  auto& internals = *this->Internals;
+  std::lock_guard<std::mutex> lock(internals.Mutex);
+  auto iter = internals.Entries.find(dataset);
+  if (iter != internals.Entries.end())
+  {
+    internals.Release(iter);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVLocatorCache::ReleaseAllLocators()
+{
+  auto& internals = *this->Internals;
+  std::lock_guard<std::mutex> lock(internals.Mutex);
+  while (!internals.Entries.empty())
+  {
+    internals.Release(internals.Entries.begin());
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkPVLocatorCache::GetNumberOfEntries()
+{
+  auto& internals = *this->Internals;
+  std::lock_guard<std::mutex> lock(internals.Mutex);
+  return static_cast<int>(internals.Entries.size());
+}
+
+//----------------------------------------------------------------------------
+void vtkPVLocatorCache::SetMaximumNumberOfEntries(int value)
+{
+  value = std::max(value, 1);
+  if (this->MaximumNumberOfEntries != value)
+  {
+    auto& internals = *this->Internals;
+    std::lock_guard<std::mutex> lock(internals.Mutex);
+    this->MaximumNumberOfEntries = value;
+    internals.Evict(value);
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVLocatorCache::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "MaximumNumberOfEntries: " << this->MaximumNumberOfEntries << endl;
+  os << indent << "NumberOfEntries: " << this->Internals->Entries.size() << endl;
+  os << indent << "NumberOfBuilds: " << this->NumberOfBuilds << endl;
+}
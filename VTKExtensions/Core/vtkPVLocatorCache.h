@@ -0,0 +1,134 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class vtkPVLocatorCache
+ * @brief cache of cell and point locators shared by probing filters
+ *
+ * vtkPVLocatorCache keeps the cell and point locators built for datasets
+ * alive across executions, so that filters probing the same dataset
+ * repeatedly, e.g. while a probe widget is being dragged, do not rebuild them.
+ * A locator is rebuilt only when the geometry of its dataset changes, as
+ * reported by the modification time of the dataset and of its points.
+ * Entries are keyed by dataset. The cached locators do not keep their dataset
+ * alive: an entry is released when its dataset is deleted, or when more than
+ * `MaximumNumberOfEntries` datasets are cached.
+ *
+ * Locators are never attached to the datasets given to the cache. Filters
+ * probing known points get a find-cell strategy from `NewFindCellStrategy`,
+ * which locates all of them at once with `FindCells`. Filters such as
+ * vtkProbeLineFilter that only use the locators of their input get a shallow
+ * copy of the input with the locators attached (`ShallowCopyWithCellLocators`).
+ * Since the locators do not reference the input, such a copy must not be used
+ * after the input is deleted.
+ *
+ * `FindCells` answers batches of queries in parallel using vtkSMPTools.
+ *
+ * Filters should use the instance returned by `GetInstance`.
+ */
+
+#ifndef vtkPVLocatorCache_h
+#define vtkPVLocatorCache_h
+
+#include "vtkObject.h"
+#include "vtkPVVTKExtensionsCoreModule.h" // needed for export macro
+#include "vtkSmartPointer.h"                // for vtkSmartPointer
+
+#include <memory> // for std::unique_ptr
+
+class vtkAbstractCellLocator;
+class vtkDataObject;
+class vtkDataSet;
+class vtkFindCellStrategy;
+class vtkIdList;
+class vtkPointSet;
+class vtkPoints;
+
+class VTKPVVTKEXTENSIONSCORE_EXPORT vtkPVLocatorCache : public vtkObject
+{
+public:
+  static vtkPVLocatorCache* New();
+  vtkTypeMacro(vtkPVLocatorCache, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Returns the cache shared by ParaView filters.
+   */
+  static vtkPVLocatorCache* GetInstance();
+
+  /**
+   * Returns a cell locator built for `dataset`, building it only if the
+   * dataset was not seen before or if its geometry was modified since the
+   * last build.
+   */
+  vtkAbstractCellLocator* GetCellLocator(vtkDataSet* dataset);
+
+  /**
+   * Returns a shallow copy of `dataObject` in which the vtkPointSet leaves
+   * have the cached cell locators of the corresponding leaves of
+   * `dataObject` attached. VTK filters pick them up through
+   * vtkCellLocatorStrategy. Other datasets locate cells without a locator.
+   * `dataObject` is not modified.
+   */
+  vtkSmartPointer<vtkDataObject> ShallowCopyWithCellLocators(vtkDataObject* dataObject);
+
+  /**
+   * Find the cell of `dataset` containing each of `points`, in parallel.
+   * `cellIds` is resized to the number of points and receives -1 for points
+   * outside of the dataset.
+   */
+  void FindCells(vtkDataSet* dataset, vtkPoints* points, double tol2, vtkIdList* cellIds);
+
+  /**
+   * Returns a strategy for vtkProbeFilter and its subclasses probing `dataset`
+   * at `points`. The cells containing `points` are found beforehand with
+   * `FindCells`, other locations are found with the cached cell locator.
+   * The strategy must be initialized with `dataset`.
+   */
+  vtkSmartPointer<vtkFindCellStrategy> NewFindCellStrategy(
+    vtkPointSet* dataset, vtkPoints* points);
+
+  ///@{
+  /**
+   * Release the locators cached for `dataset`, or for all datasets.
+   */
+  void ReleaseLocators(vtkDataSet* dataset);
+  void ReleaseAllLocators();
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the maximum number of datasets for which locators are kept.
+   * The least recently used entries are released first. Default is 256.
+   */
+  void SetMaximumNumberOfEntries(int);
+  vtkGetMacro(MaximumNumberOfEntries, int);
+  ///@}
+
+  /**
+   * Returns the number of locators built by this cache so far.
+   */
+  vtkGetMacro(NumberOfBuilds, vtkIdType);
+
+  /**
+   * Returns the number of datasets for which locators are cached.
+   */
+  int GetNumberOfEntries();
+
+protected:
+  vtkPVLocatorCache();
+  ~vtkPVLocatorCache() override;
+
+private:
+  vtkPVLocatorCache(const vtkPVLocatorCache&) = delete;
+  void operator=(const vtkPVLocatorCache&) = delete;
+
+  void OnDataSetDeleted(vtkObject* dataset, unsigned long, void*);
+
+  int MaximumNumberOfEntries = 256;
+  vtkIdType NumberOfBuilds = 0;
+
+  class vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
+};
+
+#endif
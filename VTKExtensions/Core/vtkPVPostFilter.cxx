@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkPVPostFilter.h"
 
+#include "vtkArrayDispatch.h"
 #include "vtkArrayIteratorIncludes.h"
 #include "vtkCellData.h"
 #include "vtkCommand.h"
@@ -13,12 +14,16 @@
 #include "vtkDataObjectTypes.h"
 #include "vtkDataSet.h"
 #include "vtkDoubleArray.h"
+#include "vtkImplicitArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationStringVectorKey.h"
 #include "vtkInformationVector.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVPostFilterExecutive.h"
 #include "vtkPointData.h"
+#include "vtkSmartPointer.h"
+#include "vtkWeakPointer.h"
 
 #if VTK_MODULE_ENABLE_VTK_FiltersCore
 #include "vtkCellDataToPointData.h"
@@ -26,9 +31,13 @@
 #endif
 
 #include <cassert>
+#include <cmath>
+#include <map>
+#include <memory>
 #include <set>
 #include <sstream>
 #include <string>
+#include <tuple>
 #include <vtksys/SystemTools.hxx>
 
 namespace
@@ -111,9 +120,83 @@ void DeMangleArrayName(const std::string& mangledName, vtkDataSet* dataSet,
 }
 }
 
+class vtkPVPostFilter::vtkInternals
+{
+public:
+  // Point to cell or cell to point conversion of an array of an input dataset.
+  struct ConversionKey
+  {
+    vtkDataObject* Input;
+    std::string Name;
+    bool ToPoints;
+
+    bool operator<(const ConversionKey& other) const
+    {
+      return std::tie(this->Input, this->Name, this->ToPoints) <
+        std::tie(other.Input, other.Name, other.ToPoints);
+    }
+  };
+
+  struct Conversion
+  {
+    vtkWeakPointer<vtkDataObject> Input;
+    vtkMTimeType InputMTime = 0;
+    vtkSmartPointer<vtkAbstractArray> Result;
+  };
+
+  std::map<ConversionKey, Conversion> Conversions;
+
+  // the input dataset matching the output dataset being processed.
+  vtkDataObject* CurrentInput = nullptr;
+
+  vtkAbstractArray* GetConversion(const std::string& name, bool toPoints)
+  {
+    if (!this->CurrentInput)
+    {
+      return nullptr;
+    }
+    auto iter = this->Conversions.find(ConversionKey{ this->CurrentInput, name, toPoints });
+    if (iter == this->Conversions.end() || iter->second.Input.GetPointer() != this->CurrentInput ||
+      iter->second.InputMTime != this->CurrentInput->GetMTime())
+    {
+      return nullptr;
+    }
+    return iter->second.Result;
+  }
+
+  void SetConversion(const std::string& name, bool toPoints, vtkAbstractArray* result)
+  {
+    if (this->CurrentInput && result)
+    {
+      auto& conversion = this->Conversions[ConversionKey{ this->CurrentInput, name, toPoints }];
+      conversion.Input = this->CurrentInput;
+      conversion.InputMTime = this->CurrentInput->GetMTime();
+      conversion.Result = result;
+    }
+  }
+
+  // Release the conversions of datasets that were deleted or modified.
+  void PruneConversions()
+  {
+    for (auto iter = this->Conversions.begin(); iter != this->Conversions.end();)
+    {
+      vtkDataObject* input = iter->second.Input;
+      if (!input || input->GetMTime() != iter->second.InputMTime)
+      {
+        iter = this->Conversions.erase(iter);
+      }
+      else
+      {
+        ++iter;
+      }
+    }
+  }
+};
+
 vtkStandardNewMacro(vtkPVPostFilter);
 //----------------------------------------------------------------------------
 vtkPVPostFilter::vtkPVPostFilter()
+  : Internals(new vtkPVPostFilter::vtkInternals())
 {
   vtkPVPostFilterExecutive* exec = vtkPVPostFilterExecutive::New();
   this->SetExecutive(exec);
@@ -233,7 +316,10 @@ int vtkPVPostFilter::RequestData(
     }
     if (this->Information->Has(vtkPVPostFilterExecutive::POST_ARRAYS_TO_PROCESS()))
     {
+      this->Internals->PruneConversions();
+      this->Internals->CurrentInput = input;
       this->DoAnyNeededConversions(output);
+      this->Internals->CurrentInput = nullptr;
     }
   }
   return 1;
@@ -245,15 +331,20 @@ int vtkPVPostFilter::DoAnyNeededConversions(vtkDataObject* output)
   vtkCompositeDataSet* cd = vtkCompositeDataSet::SafeDownCast(output);
   if (cd)
   {
+    // conversions are cached per input dataset, output datasets being new
+    // shallow copies on each execution.
+    vtkCompositeDataSet* csInput = vtkCompositeDataSet::SafeDownCast(this->Internals->CurrentInput);
     vtkCompositeDataIterator* iter = cd->NewIterator();
     for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
     {
       vtkDataSet* dataset = vtkDataSet::SafeDownCast(iter->GetCurrentDataObject());
       if (dataset)
       {
+        this->Internals->CurrentInput = csInput ? csInput->GetDataSet(iter) : nullptr;
         this->DoAnyNeededConversions(dataset);
       }
     }
+    this->Internals->CurrentInput = csInput;
     iter->Delete();
   }
   else
@@ -371,17 +462,28 @@ int vtkPVPostFilter::DoAnyNeededConversions(vtkDataSet* output, const char* requ
 //----------------------------------------------------------------------------
 void vtkPVPostFilter::CellDataToPointData(vtkDataSet* output, const char* name)
 {
+  if (vtkAbstractArray* cached = this->Internals->GetConversion(name, true))
+  {
+    output->GetPointData()->AddArray(cached);
+    return;
+  }
+
+#if VTK_MODULE_ENABLE_VTK_FiltersCore
   vtkDataObject* clone = output->NewInstance();
   clone->ShallowCopy(output);
 
-#if VTK_MODULE_ENABLE_VTK_FiltersCore
   vtkCellDataToPointData* converter = vtkCellDataToPointData::New();
   converter->SetInputData(clone);
-  converter->PassCellDataOn();
+  converter->PassCellDataOff();
   converter->ProcessAllArraysOff();
   converter->AddCellDataArray(name);
   converter->Update();
-  output->ShallowCopy(converter->GetOutputDataObject(0));
+  vtkAbstractArray* result = converter->GetOutput()->GetPointData()->GetAbstractArray(name);
+  if (result)
+  {
+    output->GetPointData()->AddArray(result);
+    this->Internals->SetConversion(name, true, result);
+  }
   converter->Delete();
   clone->Delete();
 #else
@@ -393,17 +495,28 @@ void vtkPVPostFilter::CellDataToPointData(vtkDataSet* output, const char* name)
 //----------------------------------------------------------------------------
 void vtkPVPostFilter::PointDataToCellData(vtkDataSet* output, const char* name)
 {
+  if (vtkAbstractArray* cached = this->Internals->GetConversion(name, false))
+  {
+    output->GetCellData()->AddArray(cached);
+    return;
+  }
+
+#if VTK_MODULE_ENABLE_VTK_FiltersCore
   vtkDataObject* clone = output->NewInstance();
   clone->ShallowCopy(output);
 
-#if VTK_MODULE_ENABLE_VTK_FiltersCore
   vtkPointDataToCellData* converter = vtkPointDataToCellData::New();
   converter->SetInputData(clone);
-  converter->PassPointDataOn();
+  converter->PassPointDataOff();
   converter->ProcessAllArraysOff();
   converter->AddPointDataArray(name);
   converter->Update();
-  output->ShallowCopy(converter->GetOutputDataObject(0));
+  vtkAbstractArray* result = converter->GetOutput()->GetCellData()->GetAbstractArray(name);
+  if (result)
+  {
+    output->GetCellData()->AddArray(result);
+    this->Internals->SetConversion(name, false, result);
+  }
   converter->Delete();
   clone->Delete();
 #else
@@ -459,6 +572,80 @@ void CopyComponent(vtkArrayIteratorTemplate<double>* /*outIter*/,
   // conversion, which in reality should never happen. So for know we
   // are leaving it empty
 }
+
+/**
+ * Implicit array backends computing one component, or the magnitude, of the
+ * tuples of an array when accessed, so that extracting them does not copy the
+ * array. The range of the resulting arrays is cached by vtkDataArray as for
+ * any other array.
+ */
+template <typename ArrayT>
+struct vtkPVComponentBackend
+{
+  using ValueType = vtk::GetAPIType<ArrayT>;
+
+  vtkPVComponentBackend(ArrayT* array, int component)
+    : Array(array)
+    , Component(component)
+  {
+  }
+
+  ValueType operator()(vtkIdType index) const
+  {
+    return this->Array->GetTypedComponent(index, this->Component);
+  }
+
+  vtkSmartPointer<ArrayT> Array;
+  int Component;
+};
+
+template <typename ArrayT>
+struct vtkPVMagnitudeBackend
+{
+  vtkPVMagnitudeBackend(ArrayT* array)
+    : Array(array)
+  {
+  }
+
+  double operator()(vtkIdType index) const
+  {
+    double mag = 0.0;
+    for (int comp = 0, max = this->Array->GetNumberOfComponents(); comp < max; ++comp)
+    {
+      const double value = static_cast<double>(this->Array->GetTypedComponent(index, comp));
+      mag += value * value;
+    }
+    return std::sqrt(mag);
+  }
+
+  vtkSmartPointer<ArrayT> Array;
+};
+
+struct ImplicitComponentWorker
+{
+  vtkSmartPointer<vtkDataArray> Result;
+
+  template <typename ArrayT>
+  void operator()(ArrayT* array, int compNo)
+  {
+    if (compNo == -1)
+    {
+      using BackendT = vtkPVMagnitudeBackend<ArrayT>;
+      vtkNew<vtkImplicitArray<BackendT>> result;
+      result->SetBackend(std::make_shared<BackendT>(array));
+      this->Result = result;
+    }
+    else
+    {
+      using BackendT = vtkPVComponentBackend<ArrayT>;
+      vtkNew<vtkImplicitArray<BackendT>> result;
+      result->SetBackend(std::make_shared<BackendT>(array, compNo));
+      this->Result = result;
+    }
+    this->Result->SetNumberOfComponents(1);
+    this->Result->SetNumberOfTuples(array->GetNumberOfTuples());
+  }
+};
 }
 
 //----------------------------------------------------------------------------
@@ -513,6 +700,23 @@ int vtkPVPostFilter::ExtractComponent(vtkDataSetAttributes* dsa, const char* req
     cIndex = atoi(demangled_component_name);
   }
 
+  if (cIndex < -1 || cIndex >= numComps)
+  {
+    vtkWarningMacro("Invalid component " << demangled_component_name << " of " << demangled_name);
+    return 0;
+  }
+
+  // numeric arrays are exposed through an implicit array computing the
+  // component or the magnitude on access.
+  ImplicitComponentWorker worker;
+  vtkDataArray* dataArray = vtkDataArray::SafeDownCast(array);
+  if (dataArray && vtkArrayDispatch::Dispatch::Execute(dataArray, worker, cIndex))
+  {
+    worker.Result->SetName(requested_name);
+    dsa->AddArray(worker.Result);
+    return 1;
+  }
+
   // when we compute the magnitude we must place
   // the result in a double array, since we don't the size of the
   // resulting data.
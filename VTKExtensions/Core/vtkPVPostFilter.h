@@ -12,6 +12,17 @@
  *
  *  Interpolate cell centered data to point data, and the inverse if needed
  * by the filter.
+ *
+ * Components and magnitudes of numeric arrays are exposed as implicit arrays
+ * computed on access rather than copied. Interpolated arrays are cached per
+ * input dataset and reused until the input is modified.
+ *
+ * The data type of the extracted arrays is unchanged: a component has the
+ * value type of its array and a magnitude is VTK_DOUBLE. They are however
+ * vtkImplicitArray instances rather than vtkAOSDataArrayTemplate ones, so
+ * downcasting them to vtkDoubleArray or to the class of their array fails.
+ * Consumers should use the vtkDataArray API or vtkArrayDispatch, and
+ * GetVoidPointer returns a copy of the values made on its first call.
  */
 
 #ifndef vtkPVPostFilter_h
@@ -20,6 +31,7 @@
 #include "vtkDataObjectAlgorithm.h"
 #include "vtkPVVTKExtensionsCoreModule.h" // needed for export macro
 
+#include <memory> // for std::unique_ptr
 #include <string> // for std::string
 
 class VTKPVVTKEXTENSIONSCORE_EXPORT vtkPVPostFilter : public vtkDataObjectAlgorithm
@@ -58,6 +70,9 @@ protected:
 private:
   vtkPVPostFilter(const vtkPVPostFilter&) = delete;
   void operator=(const vtkPVPostFilter&) = delete;
+
+  class vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
 };
 
 #endif
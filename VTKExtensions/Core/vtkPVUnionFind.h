@@ -0,0 +1,126 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @file   vtkPVUnionFind.h
+ * @brief  union-find on arrays of parents, serial and lock-free.
+ *
+ * The connectivity filters (vtkEquivalenceSet, vtkMaterialInterfaceFilter)
+ * label connected pieces with a union-find stored as an array of parents:
+ * every member references itself, when it is the root of its set, or a
+ * smaller member.  A set is thus always rooted at its smallest member, which
+ * keeps the labels independent of the order in which the unions are done.
+ *
+ * The functions taking `T*` are serial.  The ones taking `std::atomic<T>*`
+ * may be called concurrently: roots are linked with a compare-and-swap and
+ * path halving only replaces a parent with one of its (smaller) ancestors,
+ * so concurrent finds never lose a link and the resulting roots do not
+ * depend on thread scheduling.
+ */
+
+#ifndef vtkPVUnionFind_h
+#define vtkPVUnionFind_h
+
+#include <atomic>  // for std::atomic
+#include <utility> // for std::swap
+
+namespace vtkPVUnionFind
+{
+/**
+ * Returns the root of `id`, halving the path on the way.
+ */
+template <typename T>
+T FindRoot(T* parents, T id)
+{
+  while (parents[id] != id)
+  {
+    parents[id] = parents[parents[id]];
+    id = parents[id];
+  }
+  return id;
+}
+
+/**
+ * Returns the root of `id` without modifying the parents, e.g. to read a set
+ * from several threads.
+ */
+template <typename T>
+T FindRootConst(const T* parents, T id)
+{
+  while (parents[id] != id)
+  {
+    id = parents[id];
+  }
+  return id;
+}
+
+/**
+ * Merges the sets of `id1` and `id2`, linking the larger root under the
+ * smaller one.
+ */
+template <typename T>
+void Union(T* parents, T id1, T id2)
+{
+  id1 = vtkPVUnionFind::FindRoot(parents, id1);
+  id2 = vtkPVUnionFind::FindRoot(parents, id2);
+  if (id1 < id2)
+  {
+    parents[id2] = id1;
+  }
+  else if (id2 < id1)
+  {
+    parents[id1] = id2;
+  }
+}
+
+/**
+ * Thread safe FindRoot().
+ */
+template <typename T>
+T FindRoot(std::atomic<T>* parents, T id)
+{
+  T parent = parents[id].load(std::memory_order_acquire);
+  while (parent != id)
+  {
+    T grandParent = parents[parent].load(std::memory_order_acquire);
+    if (grandParent != parent)
+    {
+      // failing only means that another thread already shortened the path.
+      parents[id].compare_exchange_weak(
+        parent, grandParent, std::memory_order_acq_rel, std::memory_order_relaxed);
+    }
+    id = grandParent;
+    parent = parents[id].load(std::memory_order_acquire);
+  }
+  return id;
+}
+
+/**
+ * Thread safe Union().  Retries when another thread linked one of the roots
+ * in the meantime.
+ */
+template <typename T>
+void Union(std::atomic<T>* parents, T id1, T id2)
+{
+  while (true)
+  {
+    id1 = vtkPVUnionFind::FindRoot(parents, id1);
+    id2 = vtkPVUnionFind::FindRoot(parents, id2);
+    if (id1 == id2)
+    {
+      return;
+    }
+    if (id1 > id2)
+    {
+      std::swap(id1, id2);
+    }
+    T expected = id2;
+    if (parents[id2].compare_exchange_strong(expected, id1, std::memory_order_acq_rel))
+    {
+      return;
+    }
+  }
+}
+}
+
+#endif
+// VTK-HeaderTest-Exclude: vtkPVUnionFind.h
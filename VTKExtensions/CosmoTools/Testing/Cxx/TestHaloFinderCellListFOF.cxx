@@ -0,0 +1,123 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-FileCopyrightText: Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <vtk_mpi.h>
+
+#include "vtkDataArray.h"
+#include "vtkMPIController.h"
+#include "vtkNew.h"
+#include "vtkPANLHaloFinder.h"
+#include "vtkPGenericIOReader.h"
+#include "vtkPointData.h"
+#include "vtkSMPTools.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+namespace
+{
+// Compares the halos found by the threaded cell-list friends-of-friends with
+// the ones found by the serial k-d tree on the same particles.
+int runCellListFOFTest(int argc, char* argv[])
+{
+  char* fname = vtkTestUtilities::ExpandDataFileName(
+    argc, argv, "Testing/Data/genericio/m000.499.allparticles");
+
+  vtkNew<vtkPGenericIOReader> reader;
+  reader->SetFileName(fname);
+  reader->UpdateInformation();
+  reader->SetXAxisVariableName("x");
+  reader->SetYAxisVariableName("y");
+  reader->SetZAxisVariableName("z");
+  reader->SetPointArrayStatus("vx", 1);
+  reader->SetPointArrayStatus("vy", 1);
+  reader->SetPointArrayStatus("vz", 1);
+  reader->SetPointArrayStatus("id", 1);
+  reader->Update();
+  delete[] fname;
+
+  vtkNew<vtkPANLHaloFinder> haloFinders[2];
+  double seconds[2];
+  for (int i = 0; i < 2; ++i)
+  {
+    haloFinders[i]->SetInputConnection(reader->GetOutputPort());
+    haloFinders[i]->SetRL(128);
+    haloFinders[i]->SetParticleMass(13070871810);
+    haloFinders[i]->SetNP(128);
+    haloFinders[i]->SetPMin(100);
+    haloFinders[i]->SetUseCellListFOF(i == 1);
+    auto start = std::chrono::steady_clock::now();
+    haloFinders[i]->Update();
+    seconds[i] = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  }
+  // the timings include the steps shared by both backends, e.g. the halo
+  // centers, and are only reported.
+  std::cout << "k-d tree FOF: " << seconds[0] << " s, threaded FOF on "
+            << vtkSMPTools::GetEstimatedNumberOfThreads() << " threads: " << seconds[1]
+            << " s, speedup: " << seconds[0] / std::max(seconds[1], 1e-9) << std::endl;
+
+  for (int port = 0; port < 2; ++port)
+  {
+    vtkUnstructuredGrid* expected = haloFinders[0]->GetOutput(port);
+    vtkUnstructuredGrid* actual = haloFinders[1]->GetOutput(port);
+    if (expected->GetNumberOfPoints() != actual->GetNumberOfPoints())
+    {
+      std::cerr << "Output " << port << " has " << actual->GetNumberOfPoints()
+                << " points instead of " << expected->GetNumberOfPoints() << std::endl;
+      return 0;
+    }
+  }
+
+  vtkDataArray* expectedTags =
+    haloFinders[0]->GetOutput(0)->GetPointData()->GetArray("fof_halo_tag");
+  vtkDataArray* actualTags =
+    haloFinders[1]->GetOutput(0)->GetPointData()->GetArray("fof_halo_tag");
+  if (!expectedTags || !actualTags)
+  {
+    std::cerr << "Missing fof_halo_tag array" << std::endl;
+    return 0;
+  }
+  for (vtkIdType i = 0; i < expectedTags->GetNumberOfTuples(); ++i)
+  {
+    if (expectedTags->GetTuple1(i) != actualTags->GetTuple1(i))
+    {
+      std::cerr << "Particle " << i << " is in halo " << actualTags->GetTuple1(i)
+                << " instead of " << expectedTags->GetTuple1(i) << std::endl;
+      return 0;
+    }
+  }
+
+  vtkDataArray* expectedCounts =
+    haloFinders[0]->GetOutput(1)->GetPointData()->GetArray("fof_halo_count");
+  vtkDataArray* actualCounts =
+    haloFinders[1]->GetOutput(1)->GetPointData()->GetArray("fof_halo_count");
+  for (vtkIdType i = 0; i < expectedCounts->GetNumberOfTuples(); ++i)
+  {
+    if (expectedCounts->GetTuple1(i) != actualCounts->GetTuple1(i))
+    {
+      std::cerr << "Halo " << i << " has " << actualCounts->GetTuple1(i) << " particles instead of "
+                << expectedCounts->GetTuple1(i) << std::endl;
+      return 0;
+    }
+  }
+  return 1;
+}
+}
+
+int TestHaloFinderCellListFOF(int argc, char* argv[])
+{
+  MPI_Init(&argc, &argv);
+
+  vtkNew<vtkMPIController> controller;
+  controller->Initialize();
+  vtkMultiProcessController::SetGlobalController(controller.GetPointer());
+
+  int retVal = runCellListFOFTest(argc, argv);
+
+  controller->Finalize();
+  return !retVal;
+}
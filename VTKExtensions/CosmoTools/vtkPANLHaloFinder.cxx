@@ -14,6 +14,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
+#include "vtkSMPTools.h"
 #include "vtkTypeInt64Array.h"
 #include "vtkUnstructuredGrid.h"
 
@@ -193,6 +194,7 @@ vtkPANLHaloFinder::vtkPANLHaloFinder()
   this->Controller = vtkMultiProcessController::GetGlobalController();
   this->SetNumberOfOutputPorts(3);
   this->RunSubHaloFinder = false;
+  this->UseCellListFOF = false;
   this->RL = 256;
   this->DistanceConvertFactor = 1.0;
   this->MassConvertFactor = 1.0;
@@ -362,6 +364,8 @@ void vtkPANLHaloFinder::ExecuteHaloFinder(
   this->Internal->haloFinder = new cosmotk::CosmoHaloFinderP();
   this->Internal->haloFinder->setParameters(
     "", this->RL, this->DeadSize, this->NP, this->PMin, this->BB, this->NMin);
+  this->Internal->haloFinder->setCellListFOF(
+    this->UseCellListFOF, vtkSMPTools::GetEstimatedNumberOfThreads());
   this->Internal->haloFinder->setParticles(this->Internal->xx.size(), &this->Internal->xx[0],
     &this->Internal->yy[0], &this->Internal->zz[0], &this->Internal->vx[0], &this->Internal->vy[0],
     &this->Internal->vz[0], &this->Internal->potential[0], &this->Internal->tag[0],
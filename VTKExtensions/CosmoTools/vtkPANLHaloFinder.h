@@ -147,6 +147,19 @@ public:
   vtkGetMacro(NMin, int);
   ///@}
 
+  ///@{
+  /**
+   * Turns on/off the threaded friends-of-friends halo finding.  Particles are
+   * hashed into cells of the linking length and linked with a concurrent
+   * union-find, giving the same halos as the serial k-d tree.  Only used when
+   * NMin is 1.
+   * Default: Off
+   */
+  vtkSetMacro(UseCellListFOF, bool);
+  vtkGetMacro(UseCellListFOF, bool);
+  vtkBooleanMacro(UseCellListFOF, bool);
+  ///@}
+
   ///@{
   /**
    * Gets/Sets the minimum number of particles required for a halo candidate to
@@ -295,6 +308,7 @@ protected:
   int NumNeighbors;
 
   bool RunSubHaloFinder;
+  bool UseCellListFOF;
 
   // Center finding parameters
   int CenterFindingMode;
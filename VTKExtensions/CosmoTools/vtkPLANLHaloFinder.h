@@ -108,6 +108,18 @@ public:
   vtkGetMacro(BB, float);
   ///@}
 
+  ///@{
+  /**
+   * Turn on the threaded friends-of-friends halo finding, which hashes
+   * particles into cells of the linking length and links them with a
+   * concurrent union-find.  The halos are the same as with the serial k-d tree.
+   * (default off)
+   */
+  vtkSetMacro(UseCellListFOF, int);
+  vtkGetMacro(UseCellListFOF, int);
+  vtkBooleanMacro(UseCellListFOF, int);
+  ///@}
+
   ///@{
   /**
    * Turn on calculation of SOD halos
@@ -255,6 +267,8 @@ protected:
   int PMin;      // The minimum particles for a halo
   float BB;      // The linking length
 
+  int UseCellListFOF; // Threaded cell-list friends-of-friends
+
   int CenterFindingMethod; // Halo center detection method
   int ComputeSOD;          // Turn on Spherical OverDensity (SOD) halos
 
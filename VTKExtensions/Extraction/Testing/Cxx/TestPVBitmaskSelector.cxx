@@ -0,0 +1,136 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkBitArray.h"
+#include "vtkCellData.h"
+#include "vtkDataSet.h"
+#include "vtkExecutive.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkNew.h"
+#include "vtkPVBitmaskSelector.h"
+#include "vtkPVExtractSelection.h"
+#include "vtkSelection.h"
+#include "vtkSelectionNode.h"
+#include "vtkSmartPointer.h"
+
+#define expect(x, msg)                                                                             \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << __LINE__ << ": " msg << endl;                                                          \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+namespace
+{
+vtkSelectionNode* GetCellNode(vtkSelection* selection)
+{
+  vtkSelectionNode* cellNode = nullptr;
+  for (unsigned int cc = 0; selection && cc < selection->GetNumberOfNodes(); ++cc)
+  {
+    if (selection->GetNode(cc)->GetFieldType() == vtkSelectionNode::CELL)
+    {
+      cellNode = selection->GetNode(cc);
+    }
+  }
+  return cellNode;
+}
+}
+
+int TestPVBitmaskSelector(int, char*[])
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(21, 21, 21);
+  const vtkIdType numCells = image->GetNumberOfCells();
+
+  // Every third cell, and a run of consecutive cells.
+  vtkNew<vtkIdTypeArray> ids;
+  for (vtkIdType cc = 0; cc < numCells; ++cc)
+  {
+    if (cc % 3 == 0 || (cc > 4000 && cc < 5000))
+    {
+      ids->InsertNextValue(cc);
+    }
+  }
+  vtkNew<vtkSelectionNode> indices;
+  indices->SetContentType(vtkSelectionNode::INDICES);
+  indices->SetFieldType(vtkSelectionNode::CELL);
+  indices->SetSelectionList(ids);
+
+  auto bitmask = vtkPVBitmaskSelector::ConvertToBitmask(indices, numCells);
+  expect(bitmask && vtkPVBitmaskSelector::IsBitmask(bitmask), "Conversion to bitmask failed.");
+  expect(bitmask->GetFieldType() == vtkSelectionNode::CELL, "Properties were not copied.");
+  expect(bitmask->GetSelectionList()->GetNumberOfTuples() == numCells, "Wrong bitmask size.");
+
+  auto roundTrip = vtkPVBitmaskSelector::ConvertToIndices(bitmask);
+  expect(roundTrip && roundTrip->GetContentType() == vtkSelectionNode::INDICES,
+    "Conversion to indices failed.");
+  vtkIdTypeArray* roundTripIds = vtkIdTypeArray::SafeDownCast(roundTrip->GetSelectionList());
+  expect(roundTripIds && roundTripIds->GetNumberOfTuples() == ids->GetNumberOfTuples(),
+    "Wrong number of indices.");
+  for (vtkIdType cc = 0; cc < ids->GetNumberOfTuples(); ++cc)
+  {
+    expect(roundTripIds->GetValue(cc) == ids->GetValue(cc), "Wrong index.");
+  }
+
+  // Extract the bitmask selection, and ask for a bitmask on the id port.
+  vtkNew<vtkSelection> selection;
+  selection->AddNode(bitmask);
+  vtkNew<vtkPVExtractSelection> extract;
+  extract->SetInputData(0, image);
+  extract->SetInputData(1, selection);
+  extract->GenerateBitmaskSelectionOn();
+  extract->Update();
+
+  vtkDataSet* extracted = vtkDataSet::SafeDownCast(
+    extract->GetOutputDataObject(vtkPVExtractSelection::OUTPUT_PORT_EXTRACTED_DATASET));
+  expect(extracted && extracted->GetNumberOfCells() == ids->GetNumberOfTuples(),
+    "Wrong number of extracted cells.");
+  vtkIdTypeArray* originalIds =
+    vtkIdTypeArray::SafeDownCast(extracted->GetCellData()->GetArray("vtkOriginalCellIds"));
+  expect(originalIds, "Missing original cell ids.");
+  for (vtkIdType cc = 0; cc < ids->GetNumberOfTuples(); ++cc)
+  {
+    expect(originalIds->GetValue(cc) == ids->GetValue(cc), "Wrong extracted cell.");
+  }
+
+  vtkSelectionNode* cellNode = GetCellNode(vtkSelection::SafeDownCast(
+    extract->GetOutputDataObject(vtkPVExtractSelection::OUTPUT_PORT_SELECTION_IDS)));
+  expect(cellNode && vtkPVBitmaskSelector::IsBitmask(cellNode), "Expected a bitmask cell node.");
+  vtkBitArray* expected = vtkBitArray::SafeDownCast(bitmask->GetSelectionList());
+  vtkBitArray* actual = vtkBitArray::SafeDownCast(cellNode->GetSelectionList());
+  expect(actual == expected, "The bitmask of the input selection was not reused.");
+
+  // Inverted bitmask: the generated one is the complement of the input.
+  bitmask->GetProperties()->Set(vtkSelectionNode::INVERSE(), 1);
+  selection->Modified();
+  extract->Update();
+  extracted = vtkDataSet::SafeDownCast(
+    extract->GetOutputDataObject(vtkPVExtractSelection::OUTPUT_PORT_EXTRACTED_DATASET));
+  expect(extracted && extracted->GetNumberOfCells() == numCells - ids->GetNumberOfTuples(),
+    "Wrong number of extracted cells for the inverted bitmask.");
+  cellNode = GetCellNode(vtkSelection::SafeDownCast(
+    extract->GetOutputDataObject(vtkPVExtractSelection::OUTPUT_PORT_SELECTION_IDS)));
+  expect(cellNode && vtkPVBitmaskSelector::IsBitmask(cellNode), "Expected a bitmask cell node.");
+  actual = vtkBitArray::SafeDownCast(cellNode->GetSelectionList());
+  expect(actual->GetNumberOfTuples() == numCells, "Wrong size of the generated bitmask.");
+  for (vtkIdType cc = 0; cc < numCells; ++cc)
+  {
+    expect(actual->GetValue(cc) != expected->GetValue(cc), "Wrong inverted bitmask.");
+  }
+
+  // Other user-defined nodes are rejected.
+  vtkNew<vtkSelectionNode> user;
+  user->SetContentType(vtkSelectionNode::USER);
+  user->SetFieldType(vtkSelectionNode::CELL);
+  user->SetSelectionList(ids);
+  vtkNew<vtkSelection> userSelection;
+  userSelection->AddNode(user);
+  extract->SetInputData(1, userSelection);
+  vtkObject::GlobalWarningDisplayOff();
+  const int status = extract->GetExecutive()->Update();
+  vtkObject::GlobalWarningDisplayOn();
+  expect(status == 0, "A user-defined node that is not a bitmask was extracted.");
+  return EXIT_SUCCESS;
+}
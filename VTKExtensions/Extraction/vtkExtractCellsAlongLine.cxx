@@ -10,6 +10,7 @@
 #include "vtkInformationVector.h"
 #include "vtkLineSource.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVLocatorCache.h"
 #include "vtkUnstructuredGrid.h"
 
 vtkStandardNewMacro(vtkExtractCellsAlongLine);
@@ -47,10 +48,15 @@ int vtkExtractCellsAlongLine::RequestData(
   this->LineSource->SetPoint1(this->Point1);
   this->LineSource->SetPoint2(this->Point2);
 
-  this->Extractor->SetInputData(input);
+  // The extractor uses the cached locators attached to a shallow copy of the
+  // input instead of building new ones, so moving the line does not rebuild
+  // them. The input itself is left untouched.
+  this->Extractor->SetInputData(
+    vtkPVLocatorCache::GetInstance()->ShallowCopyWithCellLocators(input));
   this->Extractor->Update();
 
   output->ShallowCopy(this->Extractor->GetOutputDataObject(0));
+  this->Extractor->SetInputData(nullptr);
 
   return 1;
 }
@@ -9,11 +9,14 @@
 #include "vtkMultiProcessController.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVBitmaskSelector.h"
 #include "vtkPVExtractSelection.h"
 #include "vtkSelection.h"
 #include "vtkSelectionNode.h"
 #include "vtkSmartPointer.h"
 
+#include <vector>
+
 vtkStandardNewMacro(vtkPConvertSelection);
 vtkCxxSetObjectMacro(vtkPConvertSelection, Controller, vtkMultiProcessController);
 //----------------------------------------------------------------------------
@@ -66,31 +69,73 @@ static void vtkAddProcessID(vtkSelection* input, int myId)
   }
 }
 
+//----------------------------------------------------------------------------
+// Returns true if any node of the input is a bitmask.
+static bool vtkHasBitmask(vtkSelection* input)
+{
+  unsigned int numNodes = input ? input->GetNumberOfNodes() : 0;
+  for (unsigned int cc = 0; cc < numNodes; cc++)
+  {
+    if (vtkPVBitmaskSelector::IsBitmask(input->GetNode(cc)))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+//----------------------------------------------------------------------------
+// Replaces the bitmask nodes with the equivalent index nodes, keeping the
+// order of the nodes. This avoids extracting the data to convert them.
+static void vtkExpandBitmasks(vtkSelection* input)
+{
+  std::vector<vtkSmartPointer<vtkSelectionNode>> nodes;
+  unsigned int numNodes = input->GetNumberOfNodes();
+  for (unsigned int cc = 0; cc < numNodes; cc++)
+  {
+    vtkSelectionNode* node = input->GetNode(cc);
+    auto indices = vtkPVBitmaskSelector::ConvertToIndices(node);
+    nodes.emplace_back(indices ? indices.GetPointer() : node);
+  }
+  input->RemoveAllNodes();
+  for (const auto& node : nodes)
+  {
+    input->AddNode(node);
+  }
+}
+
 //----------------------------------------------------------------------------
 int vtkPConvertSelection::RequestData(
   vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
 {
-  if (!this->Controller || this->Controller->GetNumberOfProcesses() == 1)
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  vtkSelection* input = vtkSelection::GetData(inInfo);
+
+  const bool parallel = this->Controller && this->Controller->GetNumberOfProcesses() > 1;
+  const bool expandBitmasks =
+    this->OutputType == vtkSelectionNode::INDICES && ::vtkHasBitmask(input);
+  if (!parallel && !expandBitmasks)
   {
     // nothing much to do.
     return this->Superclass::RequestData(request, inputVector, outputVector);
   }
 
-  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
-  vtkSelection* input = vtkSelection::GetData(inInfo);
-
   // vtkDataObject* data = vtkDataObject::GetData(inputVector[1], 0);
 
   vtkSelection* output = vtkSelection::GetData(outputVector, 0);
 
   // Now we need to remote components from the input that don't belong to this
   // process.
-  int myId = this->Controller->GetLocalProcessId();
+  int myId = parallel ? this->Controller->GetLocalProcessId() : -1;
 
   vtkSmartPointer<vtkSelection> newInput = vtkSmartPointer<vtkSelection>::New();
   newInput->ShallowCopy(input);
 
   ::vtkTrimTree(newInput, myId);
+  if (expandBitmasks)
+  {
+    ::vtkExpandBitmasks(newInput);
+  }
 
   // This is needed since vtkConvertSelection simply shallow copies input to
   // output and raises errors when "data" is empty.
@@ -105,7 +150,10 @@ int vtkPConvertSelection::RequestData(
   }
 
   // Now add process id to the generated output.
-  ::vtkAddProcessID(output, myId);
+  if (parallel)
+  {
+    ::vtkAddProcessID(output, myId);
+  }
   return 1;
 }
 
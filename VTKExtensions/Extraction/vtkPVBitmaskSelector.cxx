@@ -0,0 +1,239 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkPVBitmaskSelector.h"
+
+#include "vtkBitArray.h"
+#include "vtkDataObject.h"
+#include "vtkIdTypeArray.h"
+#include "vtkInformation.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
+#include "vtkSelectionNode.h"
+#include "vtkSignedCharArray.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+// vtkBitArray stores value `i` in bit `7 - i % 8` of byte `i / 8`.
+inline bool GetBit(const unsigned char* bytes, vtkIdType index)
+{
+  return ((bytes[index >> 3] >> (7 - (index & 7))) & 1) != 0;
+}
+
+inline int CountBits(unsigned char byte)
+{
+  int count = 0;
+  for (; byte; byte &= static_cast<unsigned char>(byte - 1))
+  {
+    ++count;
+  }
+  return count;
+}
+
+vtkBitArray* GetBitmask(vtkSelectionNode* node)
+{
+  return node && node->GetContentType() == vtkSelectionNode::USER
+    ? vtkBitArray::SafeDownCast(node->GetSelectionList())
+    : nullptr;
+}
+}
+
+vtkStandardNewMacro(vtkPVBitmaskSelector);
+//----------------------------------------------------------------------------
+vtkPVBitmaskSelector::vtkPVBitmaskSelector() = default;
+
+//----------------------------------------------------------------------------
+vtkPVBitmaskSelector::~vtkPVBitmaskSelector() = default;
+
+//----------------------------------------------------------------------------
+bool vtkPVBitmaskSelector::IsBitmask(vtkSelectionNode* node)
+{
+  return ::GetBitmask(node) != nullptr;
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkSelectionNode> vtkPVBitmaskSelector::ConvertToBitmask(
+  vtkSelectionNode* node, vtkIdType numberOfElements)
+{
+  vtkDataArray* ids = node ? vtkArrayDownCast<vtkDataArray>(node->GetSelectionList()) : nullptr;
+  if (!ids || node->GetContentType() != vtkSelectionNode::INDICES)
+  {
+    return nullptr;
+  }
+
+  vtkNew<vtkBitArray> bitmask;
+  bitmask->SetName("vtkSelectionBitmask");
+  bitmask->SetNumberOfTuples(std::max<vtkIdType>(numberOfElements, 0));
+  unsigned char* bytes = bitmask->GetPointer(0);
+  std::memset(bytes, 0, static_cast<size_t>((bitmask->GetNumberOfValues() + 7) / 8));
+  const vtkIdType numIds = ids->GetNumberOfValues();
+  for (vtkIdType cc = 0; cc < numIds; ++cc)
+  {
+    const vtkIdType id = static_cast<vtkIdType>(ids->GetComponent(cc, 0));
+    if (id >= 0 && id < numberOfElements)
+    {
+      bytes[id >> 3] |= static_cast<unsigned char>(0x80 >> (id & 7));
+    }
+  }
+
+  auto result = vtkSmartPointer<vtkSelectionNode>::New();
+  result->GetProperties()->Copy(node->GetProperties(), /*deep=*/1);
+  result->SetContentType(vtkSelectionNode::USER);
+  result->SetSelectionList(bitmask);
+  return result;
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkSelectionNode> vtkPVBitmaskSelector::ConvertToIndices(vtkSelectionNode* node)
+{
+  vtkBitArray* bitmask = ::GetBitmask(node);
+  if (!bitmask)
+  {
+    return nullptr;
+  }
+
+  // Count the selected elements per chunk of bytes, then write the indices of
+  // each chunk at its offset.
+  const vtkIdType numBits = bitmask->GetNumberOfValues();
+  const vtkIdType numBytes = (numBits + 7) / 8;
+  const unsigned char* bytes = bitmask->GetPointer(0);
+  const vtkIdType chunkSize = 8192;
+  const vtkIdType numChunks = (numBytes + chunkSize - 1) / chunkSize;
+  std::vector<vtkIdType> offsets(numChunks + 1, 0);
+  vtkSMPTools::For(0, numChunks, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType chunk = begin; chunk < end; ++chunk)
+    {
+      vtkIdType count = 0;
+      const vtkIdType last = std::min(numBits, (chunk + 1) * chunkSize * 8);
+      for (vtkIdType index = chunk * chunkSize * 8; index < last; index += 8)
+      {
+        // mask out the padding bits of the last byte.
+        const int padding = static_cast<int>(std::max<vtkIdType>(index + 8 - last, 0));
+        count += ::CountBits(static_cast<unsigned char>(bytes[index >> 3] >> padding));
+      }
+      offsets[chunk + 1] = count;
+    }
+  });
+  for (vtkIdType chunk = 0; chunk < numChunks; ++chunk)
+  {
+    offsets[chunk + 1] += offsets[chunk];
+  }
+
+  vtkNew<vtkIdTypeArray> ids;
+  ids->SetName("IDs");
+  ids->SetNumberOfTuples(offsets[numChunks]);
+  vtkIdType* idsPtr = ids->GetPointer(0);
+  vtkSMPTools::For(0, numChunks, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType chunk = begin; chunk < end; ++chunk)
+    {
+      vtkIdType* out = idsPtr + offsets[chunk];
+      const vtkIdType last = std::min(numBits, (chunk + 1) * chunkSize * 8);
+      for (vtkIdType index = chunk * chunkSize * 8; index < last; ++index)
+      {
+        if (::GetBit(bytes, index))
+        {
+          *out++ = index;
+        }
+      }
+    }
+  });
+
+  auto result = vtkSmartPointer<vtkSelectionNode>::New();
+  result->GetProperties()->Copy(node->GetProperties(), /*deep=*/1);
+  result->SetContentType(vtkSelectionNode::INDICES);
+  result->SetSelectionList(ids);
+  return result;
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkBitArray> vtkPVBitmaskSelector::GetSelectedElements(
+  vtkSelectionNode* node, vtkIdType numberOfElements, vtkIdType& numberOfSelected)
+{
+  numberOfSelected = 0;
+  vtkBitArray* bitmask = ::GetBitmask(node);
+  if (!bitmask)
+  {
+    return nullptr;
+  }
+
+  vtkInformation* properties = node->GetProperties();
+  const bool inverse =
+    properties->Has(vtkSelectionNode::INVERSE()) && properties->Get(vtkSelectionNode::INVERSE());
+  numberOfElements = std::max<vtkIdType>(numberOfElements, 0);
+  vtkSmartPointer<vtkBitArray> result = bitmask;
+  if (inverse || bitmask->GetNumberOfValues() != numberOfElements)
+  {
+    result = vtkSmartPointer<vtkBitArray>::New();
+    result->SetName(bitmask->GetName());
+    result->SetNumberOfTuples(numberOfElements);
+    const vtkIdType numBytes = (numberOfElements + 7) / 8;
+    const vtkIdType numCopied = std::min(numBytes, (bitmask->GetNumberOfValues() + 7) / 8);
+    unsigned char* bytes = result->GetPointer(0);
+    std::memcpy(bytes, bitmask->GetPointer(0), static_cast<size_t>(numCopied));
+    std::memset(bytes + numCopied, 0, static_cast<size_t>(numBytes - numCopied));
+    // bits of the last copied byte past the end of `bitmask` are not selected.
+    const vtkIdType numBits = std::min(numberOfElements, bitmask->GetNumberOfValues());
+    if (numBits % 8 != 0)
+    {
+      bytes[numBits / 8] &= static_cast<unsigned char>(0xff << (8 - numBits % 8));
+    }
+    if (inverse)
+    {
+      for (vtkIdType cc = 0; cc < numBytes; ++cc)
+      {
+        bytes[cc] = static_cast<unsigned char>(~bytes[cc]);
+      }
+    }
+  }
+
+  // padding bits of the last byte are not counted.
+  const unsigned char* bytes = result->GetPointer(0);
+  const vtkIdType numFullBytes = numberOfElements / 8;
+  for (vtkIdType cc = 0; cc < numFullBytes; ++cc)
+  {
+    numberOfSelected += ::CountBits(bytes[cc]);
+  }
+  if (numberOfElements % 8 != 0)
+  {
+    numberOfSelected += ::CountBits(static_cast<unsigned char>(
+      bytes[numFullBytes] & (0xff << (8 - numberOfElements % 8))));
+  }
+  return result;
+}
+
+//----------------------------------------------------------------------------
+bool vtkPVBitmaskSelector::ComputeSelectedElements(
+  vtkDataObject* input, vtkSignedCharArray* insidedness)
+{
+  vtkBitArray* bitmask = ::GetBitmask(this->Node);
+  if (!bitmask)
+  {
+    vtkErrorMacro("Selection node is not a bitmask.");
+    return false;
+  }
+
+  const int association =
+    vtkSelectionNode::ConvertSelectionFieldToAttributeType(this->Node->GetFieldType());
+  const vtkIdType numElements = input->GetNumberOfElements(association);
+  const vtkIdType numBits = std::min(numElements, bitmask->GetNumberOfValues());
+  const unsigned char* bytes = bitmask->GetPointer(0);
+  insidedness->SetNumberOfTuples(numElements);
+  signed char* inside = insidedness->GetPointer(0);
+  vtkSMPTools::For(0, numElements, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      inside[cc] = (cc < numBits && ::GetBit(bytes, cc)) ? 1 : 0;
+    }
+  });
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVBitmaskSelector::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+}
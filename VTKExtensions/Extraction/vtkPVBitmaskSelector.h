@@ -0,0 +1,85 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkPVBitmaskSelector
+ * @brief   selector for selections stored as one bit per element.
+ *
+ * vtkPVBitmaskSelector handles selection nodes with content type
+ * vtkSelectionNode::USER whose selection list is a vtkBitArray holding one
+ * bit per point, cell or row of the block it applies to. The element with
+ * index `i` is selected when bit `i` is set; elements past the end of the
+ * bitmask are not selected. A bitmask node of a block with `N` elements
+ * costs `N / 8` bytes, whatever the number of selected elements, where an
+ * id selection costs 8 bytes per selected element.
+ *
+ * vtkPVExtractSelection uses this selector for such nodes and can generate
+ * them on its selection output port. vtkSelectionSerializer transfers the
+ * bitmasks run-length encoded, so vtkSelectionDeliveryFilter delivers them
+ * without expanding them.
+ *
+ * The static helpers convert between bitmask and id selection nodes.
+ * @sa
+ * vtkPVExtractSelection vtkSelectionSerializer
+ */
+
+#ifndef vtkPVBitmaskSelector_h
+#define vtkPVBitmaskSelector_h
+
+#include "vtkPVVTKExtensionsExtractionModule.h" //needed for exports
+#include "vtkSelector.h"
+#include "vtkSmartPointer.h" // for vtkSmartPointer
+
+class vtkBitArray;
+class vtkSelectionNode;
+
+class VTKPVVTKEXTENSIONSEXTRACTION_EXPORT vtkPVBitmaskSelector : public vtkSelector
+{
+public:
+  static vtkPVBitmaskSelector* New();
+  vtkTypeMacro(vtkPVBitmaskSelector, vtkSelector);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Returns true if `node` is a bitmask selection node.
+   */
+  static bool IsBitmask(vtkSelectionNode* node);
+
+  /**
+   * Returns a bitmask selection node equivalent to the vtkSelectionNode::INDICES
+   * node `node`, for a block with `numberOfElements` elements. Indices outside
+   * of [0, numberOfElements) are ignored. The properties of `node` are copied.
+   * Returns nullptr if `node` is not an index selection.
+   */
+  static vtkSmartPointer<vtkSelectionNode> ConvertToBitmask(
+    vtkSelectionNode* node, vtkIdType numberOfElements);
+
+  /**
+   * Returns the vtkSelectionNode::INDICES node, with sorted indices, equivalent
+   * to the bitmask selection node `node`. The properties of `node` are copied.
+   * Returns nullptr if `node` is not a bitmask.
+   */
+  static vtkSmartPointer<vtkSelectionNode> ConvertToIndices(vtkSelectionNode* node);
+
+  /**
+   * Returns the bitmask of the elements selected by the bitmask node `node` in
+   * a block with `numberOfElements` elements, i.e. inverted when the node has
+   * the vtkSelectionNode::INVERSE property, and their number in
+   * `numberOfSelected`. The bitmask of `node` is returned as is when it has
+   * the right size and is not inverted. Returns nullptr if `node` is not a
+   * bitmask.
+   */
+  static vtkSmartPointer<vtkBitArray> GetSelectedElements(
+    vtkSelectionNode* node, vtkIdType numberOfElements, vtkIdType& numberOfSelected);
+
+protected:
+  vtkPVBitmaskSelector();
+  ~vtkPVBitmaskSelector() override;
+
+  bool ComputeSelectedElements(vtkDataObject* input, vtkSignedCharArray* insidedness) override;
+
+private:
+  vtkPVBitmaskSelector(const vtkPVBitmaskSelector&) = delete;
+  void operator=(const vtkPVBitmaskSelector&) = delete;
+};
+
+#endif
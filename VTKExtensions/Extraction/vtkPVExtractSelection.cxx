@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkPVExtractSelection.h"
 
+#include "vtkBitArray.h"
 #include "vtkCellData.h"
 #include "vtkCompositeDataIterator.h"
 #include "vtkCompositeDataSet.h"
@@ -14,6 +15,7 @@
 #include "vtkInformationExecutivePortKey.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVBitmaskSelector.h"
 #include "vtkPointData.h"
 #include "vtkSelection.h"
 #include "vtkSelectionNode.h"
@@ -26,6 +28,7 @@
 #include "vtkPythonSelector.h"
 #endif
 
+#include <string>
 #include <vector>
 
 class vtkPVExtractSelection::vtkSelectionNodeVector
@@ -106,6 +109,18 @@ int vtkPVExtractSelection::RequestData(
     return 1;
   }
 
+  // vtkSelectionNode::USER nodes are extracted by vtkPVBitmaskSelector, see
+  // NewSelectionOperator(), so they must be bitmasks.
+  for (unsigned int cc = 0; cc < sel->GetNumberOfNodes(); ++cc)
+  {
+    vtkSelectionNode* node = sel->GetNode(cc);
+    if (node->GetContentType() == vtkSelectionNode::USER && !vtkPVBitmaskSelector::IsBitmask(node))
+    {
+      vtkErrorMacro("Unsupported user-defined selection node, only bitmasks are supported.");
+      return 0;
+    }
+  }
+
   if (vtkSelection* output2 = vtkSelection::GetData(outputVector, 2))
   {
     // See vtkPVSingleOutputExtractSelection to know why this check is needed.
@@ -167,16 +182,17 @@ int vtkPVExtractSelection::RequestData(
       }
 
       outputDO = vtkDataObject::SafeDownCast(cdOutput->GetDataSet(iter));
+      vtkDataObject* curInput = cdInput->GetDataSet(iter);
 
       vtkSelectionNodeVector curOVector;
       if (curSel && outputDO)
       {
-        this->RequestDataInternal(curOVector, outputDO, curSel);
+        this->RequestDataInternal(curOVector, curInput, outputDO, curSel);
       }
 
       for (const auto& nonCompositeNode : non_composite_nodes)
       {
-        this->RequestDataInternal(curOVector, outputDO, nonCompositeNode);
+        this->RequestDataInternal(curOVector, curInput, outputDO, nonCompositeNode);
       }
 
       for (const auto& curO : curOVector)
@@ -195,7 +211,7 @@ int vtkPVExtractSelection::RequestData(
     unsigned int numNodes = sel->GetNumberOfNodes();
     for (unsigned int i = 0; i < numNodes; i++)
     {
-      this->RequestDataInternal(oVector, outputDO, sel->GetNode(i));
+      this->RequestDataInternal(oVector, inputDO, outputDO, sel->GetNode(i));
     }
   }
 
@@ -256,7 +272,12 @@ vtkSelectionNode* vtkPVExtractSelection::LocateSelection(
 vtkSmartPointer<vtkSelector> vtkPVExtractSelection::NewSelectionOperator(
   vtkSelectionNode::SelectionContent type)
 {
-  if (type == vtkSelectionNode::QUERY)
+  if (type == vtkSelectionNode::USER)
+  {
+    // RequestData() checked that user-defined nodes are bitmasks.
+    return vtkSmartPointer<vtkPVBitmaskSelector>::New();
+  }
+  else if (type == vtkSelectionNode::QUERY)
   {
 // Return a query operator
 #if VTK_MODULE_ENABLE_ParaView_VTKExtensionsExtractionPython
@@ -273,8 +294,8 @@ vtkSmartPointer<vtkSelector> vtkPVExtractSelection::NewSelectionOperator(
 }
 
 //----------------------------------------------------------------------------
-void vtkPVExtractSelection::RequestDataInternal(
-  vtkSelectionNodeVector& outputs, vtkDataObject* dataObjectOutput, vtkSelectionNode* sel)
+void vtkPVExtractSelection::RequestDataInternal(vtkSelectionNodeVector& outputs,
+  vtkDataObject* dataObjectInput, vtkDataObject* dataObjectOutput, vtkSelectionNode* sel)
 {
   // DON'T CLEAR THE outputs.
 
@@ -298,7 +319,7 @@ void vtkPVExtractSelection::RequestDataInternal(
     if (oids)
     {
       output->SetSelectionList(oids);
-      outputs.push_back(output);
+      this->AddOutputNode(outputs, output, sel, dataObjectInput, vtkDataObject::CELL);
     }
     output->Delete();
   }
@@ -315,7 +336,7 @@ void vtkPVExtractSelection::RequestDataInternal(
     if (oids)
     {
       output->SetSelectionList(oids);
-      outputs.push_back(output);
+      this->AddOutputNode(outputs, output, sel, dataObjectInput, vtkDataObject::POINT);
     }
     output->Delete();
   }
@@ -331,7 +352,7 @@ void vtkPVExtractSelection::RequestDataInternal(
     if (oids)
     {
       output->SetSelectionList(oids);
-      outputs.push_back(output);
+      this->AddOutputNode(outputs, output, sel, dataObjectInput, vtkDataObject::ROW);
     }
     output->Delete();
   }
@@ -347,6 +368,52 @@ void vtkPVExtractSelection::RequestDataInternal(
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkPVExtractSelection::AddOutputNode(vtkSelectionNodeVector& outputs,
+  vtkSelectionNode* output, vtkSelectionNode* sel, vtkDataObject* dataObjectInput,
+  int attributeType)
+{
+  if (this->GenerateBitmaskSelection && dataObjectInput)
+  {
+    // A bitmask costs one bit per input element, indices 64 bits per
+    // extracted element.
+    const vtkIdType numElements = dataObjectInput->GetNumberOfElements(attributeType);
+    const vtkIdType numIds = output->GetSelectionList()->GetNumberOfTuples();
+    if (numElements < 64 * numIds)
+    {
+      // When `sel` is the only node and is a bitmask of the same elements,
+      // the extracted elements include the ones it selects and are these
+      // ones when there are as many: its bitmask is reused as is, without
+      // going through the ids.
+      auto selection = vtkSelection::SafeDownCast(this->GetInputDataObject(1, 0));
+      vtkIdType numSelected = -1;
+      vtkSmartPointer<vtkBitArray> bits;
+      if (selection && selection->GetNumberOfNodes() == 1 &&
+        selection->GetExpression().find('!') == std::string::npos &&
+        vtkSelectionNode::ConvertSelectionFieldToAttributeType(sel->GetFieldType()) ==
+          attributeType)
+      {
+        bits = vtkPVBitmaskSelector::GetSelectedElements(sel, numElements, numSelected);
+      }
+      if (bits && numSelected == numIds)
+      {
+        auto bitmask = vtkSmartPointer<vtkSelectionNode>::New();
+        bitmask->GetProperties()->Copy(output->GetProperties(), /*deep=*/1);
+        bitmask->SetContentType(vtkSelectionNode::USER);
+        bitmask->SetSelectionList(bits);
+        outputs.push_back(bitmask);
+        return;
+      }
+      if (auto bitmask = vtkPVBitmaskSelector::ConvertToBitmask(output, numElements))
+      {
+        outputs.push_back(bitmask);
+        return;
+      }
+    }
+  }
+  outputs.push_back(output);
+}
+
 //----------------------------------------------------------------------------
 int vtkPVExtractSelection::GetContentType(vtkSelection* sel)
 {
@@ -372,4 +439,5 @@ int vtkPVExtractSelection::GetContentType(vtkSelection* sel)
 void vtkPVExtractSelection::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "GenerateBitmaskSelection: " << this->GenerateBitmaskSelection << endl;
 }
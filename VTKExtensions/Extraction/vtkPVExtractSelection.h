@@ -19,14 +19,19 @@
  * has the indices of the points that were extracted.
  * This second output is useful for correlating particular
  * cells in the subset with the original data set. This is used, for instance,
- * by Chart representations to show selections.
+ * by Chart representations to show selections. When
+ * `GenerateBitmaskSelection` is on, blocks for which it is smaller are given
+ * as bitmask nodes (see vtkPVBitmaskSelector) rather than as indices.
  *
  * \li Output port 2 -- is simply the input vtkSelection. We currently use this
  * for Histogram View/Representation. Since that view cannot show arbitrary ID
  * based selections, it needs to get to the original vtkSelection to determine
  * if the particular selection can be shown in the view at all.
+ *
+ * Bitmask selection nodes, i.e. vtkSelectionNode::USER nodes with a
+ * vtkBitArray selection list, are supported in the input selection.
  * @sa
- * vtkExtractSelection vtkSelection
+ * vtkExtractSelection vtkSelection vtkPVBitmaskSelector
  */
 
 #ifndef vtkPVExtractSelection_h
@@ -57,6 +62,17 @@ public:
    */
   void RemoveAllSelectionsInputs() { this->SetInputConnection(1, nullptr); }
 
+  ///@{
+  /**
+   * When on, the selection on output port 1 uses one bit per element of the
+   * input block, instead of one index per extracted element, for the blocks
+   * where more than one element in 64 is extracted. Default is off.
+   */
+  vtkSetMacro(GenerateBitmaskSelection, bool);
+  vtkGetMacro(GenerateBitmaskSelection, bool);
+  vtkBooleanMacro(GenerateBitmaskSelection, bool);
+  ///@}
+
 protected:
   vtkPVExtractSelection();
   ~vtkPVExtractSelection() override;
@@ -76,7 +92,7 @@ protected:
   /**
    * Creates a new vtkSelector for the given content type.
    * May return null if not supported. Overridden to handle
-   * vtkSelectionNode::QUERY.
+   * vtkSelectionNode::QUERY and bitmask vtkSelectionNode::USER nodes.
    */
   vtkSmartPointer<vtkSelector> NewSelectionOperator(
     vtkSelectionNode::SelectionContent type) override;
@@ -86,8 +102,15 @@ private:
   void operator=(const vtkPVExtractSelection&) = delete;
 
   class vtkSelectionNodeVector;
-  void RequestDataInternal(
-    vtkSelectionNodeVector& outputs, vtkDataObject* dataObjectOutput, vtkSelectionNode* sel);
+  void RequestDataInternal(vtkSelectionNodeVector& outputs, vtkDataObject* dataObjectInput,
+    vtkDataObject* dataObjectOutput, vtkSelectionNode* sel);
+
+  // Adds `output`, the elements extracted with `sel`, to `outputs`, as a
+  // bitmask if requested and smaller.
+  void AddOutputNode(vtkSelectionNodeVector& outputs, vtkSelectionNode* output,
+    vtkSelectionNode* sel, vtkDataObject* dataObjectInput, int attributeType);
+
+  bool GenerateBitmaskSelection = false;
 
   // Returns the combined content type for the selection.
   int GetContentType(vtkSelection* sel);
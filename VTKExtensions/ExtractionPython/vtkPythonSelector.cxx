@@ -5,18 +5,501 @@
 #include "vtkPythonSelector.h"
 #include "vtkPythonUtil.h"
 
+#include "vtkArrayDispatch.h"
 #include "vtkCompositeDataSet.h"
+#include "vtkDataArrayRange.h"
+#include "vtkDataSetAttributes.h"
 #include "vtkFieldData.h"
 #include "vtkLogger.h"
+#include "vtkMultiProcessController.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPythonInterpreter.h"
+#include "vtkSMPTools.h"
 #include "vtkSelectionNode.h"
 #include "vtkSignedCharArray.h"
 #include "vtkSmartPyObject.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
 #include <map>
 #include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+//----------------------------------------------------------------------------
+// Parsing of the query forms generated by the Find Data panel.
+struct QueryTerm
+{
+  static constexpr int SCALAR = -1;
+  static constexpr int MAGNITUDE = -2;
+
+  std::string Name;
+  int Component = SCALAR;
+
+  bool operator==(const QueryTerm& other) const
+  {
+    return this->Name == other.Name && this->Component == other.Component;
+  }
+};
+
+struct QueryClause
+{
+  enum OperatorType
+  {
+    EQUAL,
+    GREATER_EQUAL,
+    LESS_EQUAL,
+    GREATER,
+    LESS,
+    IS_ONE_OF,
+    IS_NAN
+  };
+  enum ReductionType
+  {
+    NO_REDUCTION,
+    MIN_REDUCTION,
+    MAX_REDUCTION
+  };
+
+  QueryTerm Term;
+  OperatorType Operator = EQUAL;
+  ReductionType Reduction = NO_REDUCTION;
+  std::vector<double> Values;
+};
+
+// Same as vtkSMCoreUtilities::SanitizeName and paraview.make_name_valid.
+std::string SanitizeName(const char* name)
+{
+  std::string result;
+  for (size_t cc = 0; name && name[cc]; ++cc)
+  {
+    if (std::isalnum(static_cast<unsigned char>(name[cc])) || name[cc] == '_')
+    {
+      result += name[cc];
+    }
+  }
+  if (!result.empty() && !std::isalpha(static_cast<unsigned char>(result[0])))
+  {
+    result = "a" + result;
+  }
+  return result;
+}
+
+bool IsIdentifier(const std::string& str)
+{
+  if (str.empty() || !(std::isalpha(static_cast<unsigned char>(str[0])) || str[0] == '_'))
+  {
+    return false;
+  }
+  return std::all_of(str.begin(), str.end(),
+    [](char c) { return std::isalnum(static_cast<unsigned char>(c)) || c == '_'; });
+}
+
+bool StartsWith(const std::string& str, const char* prefix)
+{
+  return str.compare(0, std::char_traits<char>::length(prefix), prefix) == 0;
+}
+
+bool ParseNumber(const std::string& str, double& value)
+{
+  if (str.empty())
+  {
+    return false;
+  }
+  char* end = nullptr;
+  value = std::strtod(str.c_str(), &end);
+  return end == str.c_str() + str.size();
+}
+
+// Returns the position of the parenthesis matching the one at `pos`, or npos.
+size_t MatchingParenthesis(const std::string& str, size_t pos)
+{
+  int depth = 0;
+  for (size_t cc = pos; cc < str.size(); ++cc)
+  {
+    depth += str[cc] == '(' ? 1 : (str[cc] == ')' ? -1 : 0);
+    if (depth == 0)
+    {
+      return cc;
+    }
+  }
+  return std::string::npos;
+}
+
+// Splits at the `&` that are not within parentheses or brackets.
+bool SplitConjunction(const std::string& str, std::vector<std::string>& parts)
+{
+  int depth = 0;
+  size_t start = 0;
+  for (size_t cc = 0; cc < str.size(); ++cc)
+  {
+    const char c = str[cc];
+    depth += (c == '(' || c == '[') ? 1 : ((c == ')' || c == ']') ? -1 : 0);
+    if (depth < 0)
+    {
+      return false;
+    }
+    if (depth == 0 && c == '&')
+    {
+      parts.push_back(str.substr(start, cc - start));
+      start = cc + 1;
+    }
+  }
+  parts.push_back(str.substr(start));
+  return depth == 0;
+}
+
+// Whether a comparison operator is found outside of parentheses or brackets.
+bool HasTopLevelComparison(const std::string& str)
+{
+  int depth = 0;
+  for (const char c : str)
+  {
+    depth += (c == '(' || c == '[') ? 1 : ((c == ')' || c == ']') ? -1 : 0);
+    if (depth == 0 && (c == '=' || c == '<' || c == '>'))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+// `name`, `name[:,c]` or `mag(name)`.
+bool ParseTerm(const std::string& str, QueryTerm& term)
+{
+  if (StartsWith(str, "mag(") && str.back() == ')')
+  {
+    term.Name = str.substr(4, str.size() - 5);
+    term.Component = QueryTerm::MAGNITUDE;
+    return IsIdentifier(term.Name);
+  }
+  const size_t bracket = str.find("[:,");
+  if (bracket != std::string::npos && str.back() == ']')
+  {
+    double component;
+    term.Name = str.substr(0, bracket);
+    if (!ParseNumber(str.substr(bracket + 3, str.size() - bracket - 4), component) ||
+      component < 0 || component != std::floor(component) || component > VTK_INT_MAX)
+    {
+      return false;
+    }
+    term.Component = static_cast<int>(component);
+    return IsIdentifier(term.Name);
+  }
+  term.Name = str;
+  term.Component = QueryTerm::SCALAR;
+  return IsIdentifier(term.Name);
+}
+
+bool ParseClauses(std::string str, std::vector<QueryClause>& clauses)
+{
+  // strip enclosing parentheses.
+  while (!str.empty() && str[0] == '(' && MatchingParenthesis(str, 0) == str.size() - 1)
+  {
+    str = str.substr(1, str.size() - 2);
+  }
+
+  std::vector<std::string> parts;
+  if (str.empty() || !SplitConjunction(str, parts))
+  {
+    return false;
+  }
+  if (parts.size() > 1)
+  {
+    // `&` binds tighter than comparisons in Python, so `a > 1 & b < 2` is not
+    // a conjunction of comparisons: these must be parenthesized or be calls.
+    return std::all_of(parts.begin(), parts.end(), [&clauses](const std::string& part) {
+      return !HasTopLevelComparison(part) && ParseClauses(part, clauses);
+    });
+  }
+
+  QueryClause clause;
+  if (StartsWith(str, "in1d(") && MatchingParenthesis(str, 4) == str.size() - 1)
+  {
+    // in1d(term,[v0,v1,...])
+    const size_t separator = str.find(",[");
+    if (separator == std::string::npos || str[str.size() - 2] != ']' ||
+      !ParseTerm(str.substr(5, separator - 5), clause.Term))
+    {
+      return false;
+    }
+    clause.Operator = QueryClause::IS_ONE_OF;
+    const std::string list = str.substr(separator + 2, str.size() - separator - 4);
+    std::vector<std::string> values;
+    for (size_t start = 0; !list.empty() && start <= list.size();)
+    {
+      size_t end = list.find(',', start);
+      end = end == std::string::npos ? list.size() : end;
+      double value;
+      // a trailing comma is allowed.
+      if (end == list.size() && start == end && start > 0)
+      {
+        break;
+      }
+      if (!ParseNumber(list.substr(start, end - start), value))
+      {
+        return false;
+      }
+      clause.Values.push_back(value);
+      start = end + 1;
+    }
+    std::sort(clause.Values.begin(), clause.Values.end());
+    clauses.push_back(clause);
+    return true;
+  }
+  if (StartsWith(str, "isnan(") && MatchingParenthesis(str, 5) == str.size() - 1)
+  {
+    clause.Operator = QueryClause::IS_NAN;
+    clauses.push_back(clause);
+    return ParseTerm(str.substr(6, str.size() - 7), clauses.back().Term);
+  }
+
+  // term OP value
+  const size_t pos = str.find_first_of("=<>");
+  if (pos == std::string::npos || pos + 1 >= str.size())
+  {
+    return false;
+  }
+  size_t valuePos = pos + 1;
+  if (str[pos] == '=' && str[pos + 1] == '=')
+  {
+    clause.Operator = QueryClause::EQUAL;
+    ++valuePos;
+  }
+  else if (str[pos] != '=' && str[pos + 1] == '=')
+  {
+    clause.Operator = str[pos] == '>' ? QueryClause::GREATER_EQUAL : QueryClause::LESS_EQUAL;
+    ++valuePos;
+  }
+  else if (str[pos] != '=')
+  {
+    clause.Operator = str[pos] == '>' ? QueryClause::GREATER : QueryClause::LESS;
+  }
+  else
+  {
+    return false;
+  }
+  if (!ParseTerm(str.substr(0, pos), clause.Term))
+  {
+    return false;
+  }
+
+  const std::string valueStr = str.substr(valuePos);
+  double value;
+  if (ParseNumber(valueStr, value))
+  {
+    clause.Values.push_back(value);
+    clauses.push_back(clause);
+    return true;
+  }
+  // term == max(term) or term == min(term)
+  QueryTerm reduced;
+  const bool isMax = StartsWith(valueStr, "max(");
+  if (clause.Operator == QueryClause::EQUAL && (isMax || StartsWith(valueStr, "min(")) &&
+    valueStr.back() == ')' && ParseTerm(valueStr.substr(4, valueStr.size() - 5), reduced) &&
+    reduced == clause.Term)
+  {
+    clause.Reduction = isMax ? QueryClause::MAX_REDUCTION : QueryClause::MIN_REDUCTION;
+    clauses.push_back(clause);
+    return true;
+  }
+  return false;
+}
+
+bool ParseQuery(const char* query, std::vector<QueryClause>& clauses)
+{
+  std::string str;
+  for (size_t cc = 0; query && query[cc]; ++cc)
+  {
+    if (!std::isspace(static_cast<unsigned char>(query[cc])))
+    {
+      str += query[cc];
+    }
+  }
+  return ParseClauses(str, clauses);
+}
+
+//----------------------------------------------------------------------------
+// Evaluation.
+
+enum class ArrayLookup
+{
+  MISSING,
+  FOUND,
+  UNSUPPORTED
+};
+
+// Resolve the array the way the Python evaluation names them: by sanitized
+// name, the last array wins.
+ArrayLookup FindArray(vtkFieldData* fd, const QueryTerm& term, vtkDataArray*& array)
+{
+  vtkAbstractArray* found = nullptr;
+  for (int cc = 0, max = fd ? fd->GetNumberOfArrays() : 0; cc < max; ++cc)
+  {
+    vtkAbstractArray* candidate = fd->GetAbstractArray(cc);
+    if (candidate && SanitizeName(candidate->GetName()) == term.Name)
+    {
+      found = candidate;
+    }
+  }
+  if (!found)
+  {
+    array = nullptr;
+    return ArrayLookup::MISSING;
+  }
+  array = vtkDataArray::SafeDownCast(found);
+  if (!array)
+  {
+    return ArrayLookup::UNSUPPORTED;
+  }
+  const int numComps = array->GetNumberOfComponents();
+  const bool valid = term.Component == QueryTerm::SCALAR
+    ? numComps == 1
+    : (term.Component == QueryTerm::MAGNITUDE ? numComps > 1 : term.Component < numComps);
+  return valid ? ArrayLookup::FOUND : ArrayLookup::UNSUPPORTED;
+}
+
+// numpy compares float32 arrays with Python numbers in single precision,
+// except in in1d which promotes to double precision. Magnitudes are computed
+// in single precision for float32 arrays too.
+template <typename ValueT>
+using SinglePrecisionT =
+  typename std::conditional<std::is_same<ValueT, float>::value, float, double>::type;
+
+template <typename CompareT, typename ValueFunctor>
+void ApplyClause(
+  const QueryClause& clause, ValueFunctor&& getValue, vtkIdType numValues, signed char* mask)
+{
+  const CompareT value =
+    clause.Values.empty() ? CompareT{} : static_cast<CompareT>(clause.Values[0]);
+  auto apply = [&](auto&& test) {
+    vtkSMPTools::For(0, numValues, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType cc = begin; cc < end; ++cc)
+      {
+        mask[cc] = static_cast<signed char>(mask[cc] & (test(getValue(cc)) ? 1 : 0));
+      }
+    });
+  };
+  switch (clause.Operator)
+  {
+    case QueryClause::EQUAL:
+      apply([value](CompareT v) { return v == value; });
+      break;
+    case QueryClause::GREATER_EQUAL:
+      apply([value](CompareT v) { return v >= value; });
+      break;
+    case QueryClause::LESS_EQUAL:
+      apply([value](CompareT v) { return v <= value; });
+      break;
+    case QueryClause::GREATER:
+      apply([value](CompareT v) { return v > value; });
+      break;
+    case QueryClause::LESS:
+      apply([value](CompareT v) { return v < value; });
+      break;
+    case QueryClause::IS_ONE_OF:
+      apply([&clause](CompareT v) {
+        const double dv = static_cast<double>(v);
+        return std::binary_search(clause.Values.begin(), clause.Values.end(), dv);
+      });
+      break;
+    case QueryClause::IS_NAN:
+      apply([](CompareT v) { return std::isnan(static_cast<double>(v)); });
+      break;
+  }
+}
+
+struct ApplyClauseWorker
+{
+  template <typename ArrayT>
+  void operator()(ArrayT* array, const QueryClause& clause, signed char* mask) const
+  {
+    using ValueT = vtk::GetAPIType<ArrayT>;
+    using MagnitudeT = SinglePrecisionT<ValueT>;
+    const auto tuples = vtk::DataArrayTupleRange(array);
+    const vtkIdType numTuples = array->GetNumberOfTuples();
+    const int component = clause.Term.Component;
+    if (component == QueryTerm::MAGNITUDE)
+    {
+      const int numComps = array->GetNumberOfComponents();
+      auto getValue = [&](vtkIdType cc) {
+        MagnitudeT sum = 0;
+        for (int comp = 0; comp < numComps; ++comp)
+        {
+          const MagnitudeT v = static_cast<MagnitudeT>(tuples[cc][comp]);
+          sum += v * v;
+        }
+        return std::sqrt(sum);
+      };
+      this->Apply<MagnitudeT>(clause, getValue, numTuples, mask);
+    }
+    else
+    {
+      const int comp = std::max(component, 0);
+      auto getValue = [&](vtkIdType cc) { return tuples[cc][comp]; };
+      this->Apply<ValueT>(clause, getValue, numTuples, mask);
+    }
+  }
+
+  template <typename ValueT, typename ValueFunctor>
+  void Apply(const QueryClause& clause, ValueFunctor&& getValue, vtkIdType numTuples,
+    signed char* mask) const
+  {
+    if (clause.Operator == QueryClause::IS_ONE_OF || std::is_integral<ValueT>::value)
+    {
+      ApplyClause<double>(clause, getValue, numTuples, mask);
+    }
+    else
+    {
+      ApplyClause<SinglePrecisionT<ValueT>>(clause, getValue, numTuples, mask);
+    }
+  }
+};
+
+// Local extremum of the term, NaN if any value is NaN as with numpy.
+struct ExtremumWorker
+{
+  template <typename ArrayT>
+  void operator()(ArrayT* array, const QueryTerm& term, bool isMax, double& result) const
+  {
+    using ValueT = vtk::GetAPIType<ArrayT>;
+    using MagnitudeT = SinglePrecisionT<ValueT>;
+    const auto tuples = vtk::DataArrayTupleRange(array);
+    const int numComps = array->GetNumberOfComponents();
+    for (const auto tuple : tuples)
+    {
+      double value;
+      if (term.Component == QueryTerm::MAGNITUDE)
+      {
+        MagnitudeT sum = 0;
+        for (int comp = 0; comp < numComps; ++comp)
+        {
+          sum += static_cast<MagnitudeT>(tuple[comp]) * static_cast<MagnitudeT>(tuple[comp]);
+        }
+        value = static_cast<double>(std::sqrt(sum));
+      }
+      else
+      {
+        value = static_cast<double>(tuple[std::max(term.Component, 0)]);
+      }
+      if (std::isnan(value) || std::isnan(result))
+      {
+        result = std::numeric_limits<double>::quiet_NaN();
+        return;
+      }
+      result = isMax ? std::max(result, value) : std::min(result, value);
+    }
+  }
+};
+}
 
 class vtkPythonSelector::vtkInternals
 {
@@ -46,6 +529,8 @@ public:
     }
   }
 
+  void RegisterMaskArray(vtkDataObject* input, vtkDataArray* mask) { this->Map[input] = mask; }
+
   vtkDataArray* GetMaskArray(vtkDataObject* input) const
   {
     auto iter = this->Map.find(input);
@@ -74,6 +559,11 @@ void vtkPythonSelector::Execute(vtkDataObject* input, vtkDataObject* output)
   assert(output != nullptr);
   assert(this->Node != nullptr);
 
+  if (this->ExecuteNativeQuery(input, output))
+  {
+    return;
+  }
+
   // ensure Python is initialized.
   vtkPythonInterpreter::Initialize();
   vtkPythonScopeGilEnsurer gilEnsurer;
@@ -119,6 +609,171 @@ void vtkPythonSelector::Execute(vtkDataObject* input, vtkDataObject* output)
   }
 }
 
+//----------------------------------------------------------------------------
+bool vtkPythonSelector::ExecuteNativeQuery(vtkDataObject* input, vtkDataObject* output)
+{
+  // The choice between the native and the Python evaluations is local: both
+  // are independent of the other ranks, except for the `min()` and `max()`
+  // reductions which are left to Python when running in parallel, so that
+  // all ranks do the same collective operations.
+  std::vector<QueryClause> clauses;
+  if (!::ParseQuery(this->Node->GetQueryString(), clauses))
+  {
+    return false;
+  }
+
+  const int fieldType = this->Node->GetFieldType();
+  if (fieldType != vtkSelectionNode::CELL && fieldType != vtkSelectionNode::POINT &&
+    fieldType != vtkSelectionNode::ROW)
+  {
+    return false;
+  }
+  const int association = vtkSelectionNode::ConvertSelectionFieldToAttributeType(fieldType);
+  const bool hasReduction = std::any_of(clauses.begin(), clauses.end(),
+    [](const QueryClause& clause) { return clause.Reduction != QueryClause::NO_REDUCTION; });
+  auto controller = vtkMultiProcessController::GetGlobalController();
+  if (hasReduction && controller && controller->GetNumberOfProcesses() > 1)
+  {
+    return false;
+  }
+  const size_t numClauses = clauses.size();
+  auto leaves = vtkCompositeDataSet::GetDataSets<vtkDataObject>(input);
+
+  // Arrays of each clause for each leaf; a leaf missing one of them is not
+  // selected, as with the Python evaluation. `id` refers to element ids when
+  // no array is named so.
+  std::vector<std::vector<vtkDataArray*>> arrays(leaves.size());
+  std::vector<std::vector<bool>> useIds(leaves.size(), std::vector<bool>(numClauses, false));
+  // {supported, clause missing on all leaves...}
+  std::vector<int> status(numClauses + 1, 1);
+  for (size_t leaf = 0; leaf < leaves.size(); ++leaf)
+  {
+    vtkFieldData* fd = leaves[leaf]->GetAttributesAsFieldData(association);
+    arrays[leaf].resize(numClauses, nullptr);
+    if (hasReduction && fd && fd->GetArray(vtkDataSetAttributes::GhostArrayName()))
+    {
+      // leave ghost-aware reductions to Python.
+      status[0] = 0;
+    }
+    for (size_t cc = 0; cc < numClauses; ++cc)
+    {
+      switch (::FindArray(fd, clauses[cc].Term, arrays[leaf][cc]))
+      {
+        case ArrayLookup::FOUND:
+          status[cc + 1] = 0;
+          break;
+        case ArrayLookup::MISSING:
+          if (clauses[cc].Term.Name == "id" && clauses[cc].Term.Component == QueryTerm::SCALAR)
+          {
+            useIds[leaf][cc] = true;
+            status[cc + 1] = 0;
+          }
+          break;
+        case ArrayLookup::UNSUPPORTED:
+          status[0] = 0;
+          break;
+      }
+    }
+  }
+
+  // `id` is an array name if any leaf has such an array.
+  for (size_t cc = 0; cc < numClauses; ++cc)
+  {
+    bool hasIds = false;
+    bool hasArray = false;
+    for (size_t leaf = 0; leaf < leaves.size(); ++leaf)
+    {
+      hasIds = hasIds || useIds[leaf][cc];
+      hasArray = hasArray || arrays[leaf][cc] != nullptr;
+    }
+    if (hasIds && hasArray)
+    {
+      status[0] = 0;
+    }
+  }
+
+  // Unknown names are reported by Python.
+  if (status[0] == 0 || std::any_of(status.begin() + 1, status.end(), [](int s) { return s; }))
+  {
+    return false;
+  }
+
+  // Resolve `term == max(term)` and `term == min(term)` into comparisons.
+  for (size_t cc = 0; cc < numClauses; ++cc)
+  {
+    QueryClause& clause = clauses[cc];
+    if (clause.Reduction == QueryClause::NO_REDUCTION)
+    {
+      continue;
+    }
+    const bool isMax = clause.Reduction == QueryClause::MAX_REDUCTION;
+    double extremum = isMax ? std::numeric_limits<double>::lowest()
+                            : std::numeric_limits<double>::max();
+    for (size_t leaf = 0; leaf < leaves.size(); ++leaf)
+    {
+      const vtkIdType numElements = leaves[leaf]->GetNumberOfElements(association);
+      if (useIds[leaf][cc] && numElements > 0)
+      {
+        extremum = isMax ? std::max(extremum, static_cast<double>(numElements - 1))
+                         : std::min(extremum, 0.0);
+      }
+      else if (vtkDataArray* array = arrays[leaf][cc])
+      {
+        ::ExtremumWorker worker;
+        if (!vtkArrayDispatch::Dispatch::Execute(array, worker, clause.Term, isMax, extremum))
+        {
+          worker(array, clause.Term, isMax, extremum);
+        }
+      }
+    }
+    clause.Operator = QueryClause::EQUAL;
+    clause.Values.assign(1, extremum);
+  }
+
+  // Evaluate the clauses on each leaf.
+  auto& internals = (*this->Internals);
+  for (size_t leaf = 0; leaf < leaves.size(); ++leaf)
+  {
+    bool complete = true;
+    for (size_t cc = 0; cc < numClauses; ++cc)
+    {
+      complete = complete && (arrays[leaf][cc] != nullptr || useIds[leaf][cc]);
+    }
+    const vtkIdType numElements = leaves[leaf]->GetNumberOfElements(association);
+    if (!complete || numElements <= 0)
+    {
+      continue;
+    }
+
+    vtkNew<vtkSignedCharArray> mask;
+    mask->SetNumberOfTuples(numElements);
+    mask->FillValue(1);
+    signed char* maskPtr = mask->GetPointer(0);
+    for (size_t cc = 0; cc < numClauses; ++cc)
+    {
+      if (useIds[leaf][cc])
+      {
+        ::ApplyClause<double>(
+          clauses[cc], [](vtkIdType id) { return static_cast<double>(id); }, numElements, maskPtr);
+      }
+      else
+      {
+        vtkDataArray* array = arrays[leaf][cc];
+        ::ApplyClauseWorker worker;
+        if (!vtkArrayDispatch::Dispatch::Execute(array, worker, clauses[cc], maskPtr))
+        {
+          worker(array, clauses[cc], maskPtr);
+        }
+      }
+    }
+    internals.RegisterMaskArray(leaves[leaf], mask);
+  }
+
+  this->Superclass::Execute(input, output);
+  internals.Reset();
+  return true;
+}
+
 //----------------------------------------------------------------------------
 bool vtkPythonSelector::ComputeSelectedElements(
   vtkDataObject* inputDO, vtkSignedCharArray* insidednessArray)
@@ -3,6 +3,13 @@
 /**
  * @class vtkPythonSelector
  * @brief Select cells/points using numpy expressions
+ *
+ * Queries made only of the forms generated by the Find Data panel, i.e. a
+ * conjunction of comparisons of an array, an array component, an array
+ * magnitude or `id` with numbers, `in1d(term, [values])`, `isnan(term)` and
+ * `term == min(term)` or `term == max(term)`, are evaluated in C++ with
+ * vtkSMPTools. Other queries are evaluated by the
+ * `paraview.detail.python_selector` module.
  */
 
 #ifndef vtkPythonSelector_h
@@ -32,6 +39,13 @@ protected:
   bool ComputeSelectedElements(vtkDataObject*, vtkSignedCharArray*) override;
 
 private:
+  /**
+   * Evaluate the query without Python. Returns false if the query must be
+   * evaluated by Python instead. No collective operation is done, so ranks
+   * may take different paths.
+   */
+  bool ExecuteNativeQuery(vtkDataObject* input, vtkDataObject* output);
+
   vtkPythonSelector(const vtkPythonSelector&) = delete;
   void operator=(const vtkPythonSelector&) = delete;
 
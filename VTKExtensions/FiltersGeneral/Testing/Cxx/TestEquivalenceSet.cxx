@@ -0,0 +1,163 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkEquivalenceSet.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Smallest member of the set of every id, by propagating the minimum along
+// the pairs until nothing changes.
+std::vector<int> ReferenceSets(const std::vector<int>& pairs, int numberOfMembers)
+{
+  std::vector<int> labels(numberOfMembers);
+  for (int ii = 0; ii < numberOfMembers; ++ii)
+  {
+    labels[ii] = ii;
+  }
+  bool changed = true;
+  while (changed)
+  {
+    changed = false;
+    for (size_t cc = 0; cc < pairs.size(); cc += 2)
+    {
+      int& label1 = labels[pairs[cc]];
+      int& label2 = labels[pairs[cc + 1]];
+      if (label1 != label2)
+      {
+        label1 = label2 = std::min(label1, label2);
+        changed = true;
+      }
+    }
+  }
+  return labels;
+}
+
+// Sequential ids of the sets, numbered by their smallest member.
+std::vector<int> Resolve(const std::vector<int>& labels, int& numberOfSets)
+{
+  std::vector<int> resolved(labels.size());
+  numberOfSets = 0;
+  for (size_t ii = 0; ii < labels.size(); ++ii)
+  {
+    resolved[ii] = labels[ii] == static_cast<int>(ii) ? numberOfSets++ : resolved[labels[ii]];
+  }
+  return resolved;
+}
+
+bool CheckSet(vtkEquivalenceSet* set, const std::vector<int>& pairs, int numberOfMembers,
+  const std::string& name)
+{
+  if (set->GetNumberOfMembers() != numberOfMembers)
+  {
+    vtkLogF(ERROR, "%s: %d members instead of %d.", name.c_str(), set->GetNumberOfMembers(),
+      numberOfMembers);
+    return false;
+  }
+
+  const std::vector<int> labels = ReferenceSets(pairs, numberOfMembers);
+  for (int ii = 0; ii < numberOfMembers; ++ii)
+  {
+    if (set->GetEquivalentSetId(ii) != labels[ii] || set->GetReference(ii) > ii)
+    {
+      vtkLogF(ERROR, "%s: member %d is in set %d (reference %d), expected %d.", name.c_str(), ii,
+        set->GetEquivalentSetId(ii), set->GetReference(ii), labels[ii]);
+      return false;
+    }
+  }
+
+  int numberOfSets;
+  const std::vector<int> resolved = Resolve(labels, numberOfSets);
+  if (set->ResolveEquivalences() != numberOfSets || set->GetNumberOfResolvedSets() != numberOfSets)
+  {
+    vtkLogF(ERROR, "%s: %d resolved sets, expected %d.", name.c_str(),
+      set->GetNumberOfResolvedSets(), numberOfSets);
+    return false;
+  }
+  for (int ii = 0; ii < numberOfMembers; ++ii)
+  {
+    if (set->GetEquivalentSetId(ii) != resolved[ii])
+    {
+      vtkLogF(ERROR, "%s: member %d resolved to %d, expected %d.", name.c_str(), ii,
+        set->GetEquivalentSetId(ii), resolved[ii]);
+      return false;
+    }
+  }
+  return true;
+}
+
+// Random pairs making many small sets and a few long chains across the range,
+// so that concurrent unions race on the same roots.
+std::vector<int> CreatePairs(int numberOfMembers, int numberOfPairs)
+{
+  std::mt19937 generator(1234);
+  std::uniform_int_distribution<int> member(0, numberOfMembers - 1);
+  std::uniform_int_distribution<int> offset(1, 8);
+  std::vector<int> pairs;
+  for (int cc = 0; cc < numberOfPairs; ++cc)
+  {
+    const int id1 = member(generator);
+    const int id2 =
+      cc % 4 == 0 ? member(generator) : std::min(numberOfMembers - 1, id1 + offset(generator));
+    pairs.push_back(id1);
+    pairs.push_back(id2);
+  }
+  // the largest id is only equivalent to itself.
+  pairs.push_back(numberOfMembers - 1);
+  pairs.push_back(numberOfMembers - 1);
+  return pairs;
+}
+}
+
+int TestEquivalenceSet(int, char*[])
+{
+  bool success = true;
+
+  // a few equivalences added one at a time.
+  {
+    const std::vector<int> pairs = { 5, 3, 7, 7, 3, 1, 9, 8, 8, 7, 2, 2 };
+    vtkNew<vtkEquivalenceSet> set;
+    for (size_t cc = 0; cc < pairs.size(); cc += 2)
+    {
+      set->AddEquivalence(pairs[cc], pairs[cc + 1]);
+    }
+    success = CheckSet(set, pairs, 10, "AddEquivalence") && success;
+  }
+
+  // batches, merged with the equivalences already in the set, with the
+  // sequential and the default SMP backends.
+  const int numberOfMembers = 20000;
+  const std::vector<int> pairs = CreatePairs(numberOfMembers, 15000);
+  const size_t half = pairs.size() / 2 - pairs.size() / 2 % 2;
+  const std::string backend = vtkSMPTools::GetBackend();
+  for (const std::string& smpBackend : { std::string("Sequential"), backend })
+  {
+    vtkSMPTools::SetBackend(smpBackend.c_str());
+
+    vtkNew<vtkEquivalenceSet> serial;
+    for (size_t cc = 0; cc < pairs.size(); cc += 2)
+    {
+      serial->AddEquivalence(pairs[cc], pairs[cc + 1]);
+    }
+    success = CheckSet(serial, pairs, numberOfMembers, "serial (" + smpBackend + ")") && success;
+
+    vtkNew<vtkEquivalenceSet> batch;
+    batch->AddEquivalences(pairs.data(), 0);
+    success = batch->GetNumberOfMembers() == 0 && success;
+    batch->AddEquivalences(pairs.data(), static_cast<vtkIdType>(half / 2));
+    batch->AddEquivalence(pairs[half], pairs[half + 1]);
+    batch->AddEquivalences(
+      pairs.data() + half + 2, static_cast<vtkIdType>((pairs.size() - half - 2) / 2));
+    success = CheckSet(batch, pairs, numberOfMembers, "AddEquivalences (" + smpBackend + ")") &&
+      success;
+  }
+  vtkSMPTools::SetBackend(backend.c_str());
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,159 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Checks that vtkHybridProbeFilter, which locates the probed point with the
+// shared vtkPVLocatorCache, probes the same values as vtkProbeFilter without
+// the cache, and that moving the location does not rebuild the locator.
+
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
+#include "vtkHybridProbeFilter.h"
+#include "vtkIdTypeArray.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPVLocatorCache.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkProbeFilter.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+
+namespace
+{
+// A grid of n^3 hexahedra spanning [0, 1]^3, with a linear point field and
+// the cell ids as cell field.
+vtkSmartPointer<vtkUnstructuredGrid> CreateGrid(int n)
+{
+  const int np = n + 1;
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> linear;
+  linear->SetName("Linear");
+  for (int k = 0; k < np; ++k)
+  {
+    for (int j = 0; j < np; ++j)
+    {
+      for (int i = 0; i < np; ++i)
+      {
+        const double x = static_cast<double>(i) / n;
+        const double y = static_cast<double>(j) / n;
+        const double z = static_cast<double>(k) / n;
+        points->InsertNextPoint(x, y, z);
+        linear->InsertNextValue(x + 2.0 * y + 3.0 * z);
+      }
+    }
+  }
+  auto grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  grid->SetPoints(points);
+  grid->GetPointData()->AddArray(linear);
+  grid->AllocateExact(n * n * n, 8 * n * n * n);
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("CellIds");
+  for (int k = 0; k < n; ++k)
+  {
+    for (int j = 0; j < n; ++j)
+    {
+      for (int i = 0; i < n; ++i)
+      {
+        const vtkIdType p0 = i + np * (j + np * k);
+        const vtkIdType hex[8] = { p0, p0 + 1, p0 + np + 1, p0 + np, p0 + np * np,
+          p0 + np * np + 1, p0 + np * np + np + 1, p0 + np * np + np };
+        cellIds->InsertNextValue(grid->InsertNextCell(VTK_HEXAHEDRON, 8, hex));
+      }
+    }
+  }
+  grid->GetCellData()->AddArray(cellIds);
+  return grid;
+}
+
+// Probes `grid` at `location` with vtkProbeFilter and its own cell locator.
+vtkSmartPointer<vtkDataSet> ProbeWithoutCache(vtkDataSet* grid, const double location[3])
+{
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  points->InsertNextPoint(location);
+  vtkNew<vtkPolyData> probed;
+  probed->SetPoints(points);
+
+  vtkNew<vtkProbeFilter> probe;
+  probe->SetInputData(probed);
+  probe->SetSourceData(grid);
+  probe->Update();
+  return vtkDataSet::SafeDownCast(probe->GetOutputDataObject(0));
+}
+
+bool CompareProbes(vtkDataSet* expected, vtkDataSet* actual, const double location[3])
+{
+  if (!actual || actual->GetNumberOfPoints() != 1)
+  {
+    vtkLogF(ERROR, "Expected a single probed point at (%g, %g, %g).", location[0], location[1],
+      location[2]);
+    return false;
+  }
+  vtkPointData* expectedPD = expected->GetPointData();
+  for (int cc = 0; cc < expectedPD->GetNumberOfArrays(); ++cc)
+  {
+    vtkDataArray* expectedArray = expectedPD->GetArray(cc);
+    if (!expectedArray)
+    {
+      continue;
+    }
+    vtkDataArray* actualArray = actual->GetPointData()->GetArray(expectedArray->GetName());
+    if (!actualArray || std::abs(actualArray->GetTuple1(0) - expectedArray->GetTuple1(0)) > 1e-9)
+    {
+      vtkLogF(ERROR, "'%s' differs from the probe without cache at (%g, %g, %g).",
+        expectedArray->GetName(), location[0], location[1], location[2]);
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestHybridProbeFilter(int, char*[])
+{
+  vtkSmartPointer<vtkUnstructuredGrid> grid = CreateGrid(8);
+  vtkPVLocatorCache* cache = vtkPVLocatorCache::GetInstance();
+  const vtkIdType numberOfBuilds = cache->GetNumberOfBuilds();
+
+  vtkNew<vtkHybridProbeFilter> probe;
+  probe->SetInputData(grid);
+  probe->SetMode(vtkHybridProbeFilter::INTERPOLATE_AT_LOCATION);
+
+  // locations as a probe widget is dragged across the grid, and out of it.
+  bool success = true;
+  for (int cc = 0; cc <= 20; ++cc)
+  {
+    const double location[3] = { 0.05 * cc + 0.013, 0.301 + 0.02 * cc, 0.707 - 0.03 * cc };
+    probe->SetLocation(location[0], location[1], location[2]);
+    probe->Update();
+    vtkSmartPointer<vtkDataSet> expected = ProbeWithoutCache(grid, location);
+    success = CompareProbes(expected, vtkDataSet::SafeDownCast(probe->GetOutputDataObject(0)),
+                location) &&
+      success;
+  }
+
+  if (cache->GetNumberOfBuilds() != numberOfBuilds + 1)
+  {
+    vtkLogF(ERROR, "Expected a single locator build, got %lld.",
+      static_cast<long long>(cache->GetNumberOfBuilds() - numberOfBuilds));
+    success = false;
+  }
+
+  // the cache does not keep the grid alive.
+  probe->SetInputData(nullptr);
+  const int numberOfEntries = cache->GetNumberOfEntries();
+  grid = nullptr;
+  if (cache->GetNumberOfEntries() != numberOfEntries - 1)
+  {
+    vtkLogF(ERROR, "The locator of the deleted grid was not released.");
+    success = false;
+  }
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,194 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Conformance test of the compiled backend of vtkPVArrayCalculator against
+// vtkFunctionParser and vtkExprTkFunctionParser.
+
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIntArray.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPVArrayCalculator.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+#include <cmath>
+
+#define vtk_assert(x)                                                                              \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << "On line " << __LINE__ << " ERROR: Condition FAILED!! : " << #x << endl;               \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+vtkSmartPointer<vtkPolyData> CreateInput(vtkIdType numberOfPoints)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(42);
+  auto next = [&random](double min, double max) {
+    random->Next();
+    return random->GetRangeValue(min, max);
+  };
+
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(numberOfPoints);
+  vtkNew<vtkDoubleArray> p;
+  p->SetName("p");
+  p->SetNumberOfTuples(numberOfPoints);
+  vtkNew<vtkFloatArray> q;
+  q->SetName("q");
+  q->SetNumberOfTuples(numberOfPoints);
+  vtkNew<vtkDoubleArray> v;
+  v->SetName("V");
+  v->SetNumberOfComponents(3);
+  v->SetNumberOfTuples(numberOfPoints);
+  vtkNew<vtkIntArray> w;
+  w->SetName("W");
+  w->SetNumberOfComponents(3);
+  w->SetNumberOfTuples(numberOfPoints);
+  for (vtkIdType i = 0; i < numberOfPoints; ++i)
+  {
+    points->SetPoint(i, next(-1, 1), next(-1, 1), next(-1, 1));
+    p->SetValue(i, next(-3, 3));
+    q->SetValue(i, static_cast<float>(next(-2, 2)));
+    for (int c = 0; c < 3; ++c)
+    {
+      v->SetTypedComponent(i, c, next(-10, 10));
+      w->SetTypedComponent(i, c, static_cast<int>(next(-100, 100)));
+    }
+  }
+
+  auto polyData = vtkSmartPointer<vtkPolyData>::New();
+  polyData->SetPoints(points);
+  polyData->GetPointData()->AddArray(p);
+  polyData->GetPointData()->AddArray(q);
+  polyData->GetPointData()->AddArray(v);
+  polyData->GetPointData()->AddArray(w);
+  return polyData;
+}
+
+vtkSmartPointer<vtkDataObject> Evaluate(vtkDataObject* input, const char* function, int parserType)
+{
+  vtkNew<vtkPVArrayCalculator> calculator;
+  calculator->SetInputData(input);
+  calculator->SetFunction(function);
+  calculator->SetResultArrayName("Result");
+  calculator->SetFunctionParserTypeFromInt(parserType);
+  calculator->SetReplaceInvalidValues(true);
+  calculator->SetReplacementValue(-1.0);
+  calculator->Update();
+  return calculator->GetOutputDataObject(0);
+}
+
+vtkDataArray* GetResult(vtkDataObject* dataObject)
+{
+  vtkDataSet* dataSet = vtkDataSet::SafeDownCast(dataObject);
+  return dataSet ? dataSet->GetPointData()->GetArray("Result") : nullptr;
+}
+
+// Compare with a tolerance of 0 for exact matches.
+bool Compare(vtkDataArray* expected, vtkDataArray* actual, double tolerance)
+{
+  vtk_assert(expected && actual);
+  vtk_assert(expected->GetNumberOfTuples() == actual->GetNumberOfTuples());
+  vtk_assert(expected->GetNumberOfComponents() == actual->GetNumberOfComponents());
+  for (vtkIdType i = 0; i < expected->GetNumberOfTuples(); ++i)
+  {
+    for (int c = 0; c < expected->GetNumberOfComponents(); ++c)
+    {
+      const double a = expected->GetComponent(i, c);
+      const double b = actual->GetComponent(i, c);
+      if (std::abs(a - b) > tolerance * std::max(1.0, std::abs(a)))
+      {
+        cerr << "Mismatch at tuple " << i << " component " << c << ": " << a << " != " << b
+             << endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool TestConformance(vtkPolyData* input)
+{
+  const char* functions[] = { "mag(V)*p", "p*p+2*q-1", "abs(q)/(1+p*p)",
+    "sqrt(abs(p))+exp(-q*q)", "V*p+W", "cross(V,W)", "norm(V)", "sin(p)*cos(q)-tan(0.1*p)",
+    "min(p,q)*max(p,q)", "coordsX*iHat+coordsY*jHat+coordsZ*kHat", "p^2-q",
+    "ln(1+p*p)+log10(1+q*q)", "floor(p)+ceil(q)+sign(p)", "V_Y*W_Z-p" };
+  for (const char* function : functions)
+  {
+    vtkSmartPointer<vtkDataObject> compiled =
+      Evaluate(input, function, vtkPVArrayCalculator::CompiledFunctionParser);
+    vtkSmartPointer<vtkDataObject> reference =
+      Evaluate(input, function, vtkArrayCalculator::FunctionParser);
+    vtkSmartPointer<vtkDataObject> exprTk =
+      Evaluate(input, function, vtkArrayCalculator::ExprTkFunctionParser);
+    cout << "Testing " << function << endl;
+    vtk_assert(Compare(GetResult(reference), GetResult(compiled), 0.0));
+    // vtkExprTkFunctionParser may reassociate constants.
+    vtk_assert(Compare(GetResult(exprTk), GetResult(compiled), 1e-12));
+  }
+  return true;
+}
+
+bool TestFallback(vtkPolyData* input)
+{
+  // Expressions that are not compiled give the vtkExprTkFunctionParser result,
+  // and invalid values are replaced the same way.
+  const char* functions[] = { "p^3", "if(p>0, p, q)", "sqrt(p)" };
+  for (const char* function : functions)
+  {
+    vtkSmartPointer<vtkDataObject> compiled =
+      Evaluate(input, function, vtkPVArrayCalculator::CompiledFunctionParser);
+    vtkSmartPointer<vtkDataObject> exprTk =
+      Evaluate(input, function, vtkArrayCalculator::ExprTkFunctionParser);
+    cout << "Testing " << function << endl;
+    vtk_assert(Compare(GetResult(exprTk), GetResult(compiled), 0.0));
+  }
+
+  // A block without the array is evaluated by the superclass as a whole.
+  vtkNew<vtkPolyData> other;
+  other->DeepCopy(input);
+  other->GetPointData()->RemoveArray("V");
+  vtkNew<vtkMultiBlockDataSet> multiBlock;
+  multiBlock->SetBlock(0, input);
+  multiBlock->SetBlock(1, other);
+  for (const char* function : { "p*q", "mag(V)" })
+  {
+    auto compiled = vtkMultiBlockDataSet::SafeDownCast(
+      Evaluate(multiBlock, function, vtkPVArrayCalculator::CompiledFunctionParser));
+    auto exprTk = vtkMultiBlockDataSet::SafeDownCast(
+      Evaluate(multiBlock, function, vtkArrayCalculator::ExprTkFunctionParser));
+    vtk_assert(compiled && exprTk);
+    cout << "Testing " << function << " on blocks" << endl;
+    vtk_assert(Compare(GetResult(exprTk->GetBlock(0)), GetResult(compiled->GetBlock(0)), 1e-12));
+    vtk_assert(!GetResult(exprTk->GetBlock(1)) == !GetResult(compiled->GetBlock(1)));
+  }
+  return true;
+}
+}
+
+int TestPVArrayCalculatorCompiled(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  vtkNew<vtkPVArrayCalculator> calculator;
+  calculator->SetFunctionParserTypeFromInt(vtkPVArrayCalculator::CompiledFunctionParser);
+  if (!calculator->GetUseCompiledFunctionParser() ||
+    calculator->GetFunctionParserType() != vtkArrayCalculator::ExprTkFunctionParser)
+  {
+    cerr << "CompiledFunctionParser was not selected." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // More than one block of tuples, with a partial last one.
+  vtkSmartPointer<vtkPolyData> input = CreateInput(5000);
+  return TestConformance(input) && TestFallback(input) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
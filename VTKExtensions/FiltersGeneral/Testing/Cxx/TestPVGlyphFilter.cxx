@@ -0,0 +1,219 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Checks the glyphs generated by vtkPVGlyphFilter against glyphs transformed
+// one by one with vtkTransform.
+
+#include "vtkCellArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIntArray.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPVGlyphFilter.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTransform.h"
+
+#include <algorithm>
+#include <cmath>
+
+#define vtk_assert(x)                                                                              \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << "On line " << __LINE__ << " ERROR: Condition FAILED!! : " << #x << endl;               \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+vtkSmartPointer<vtkPolyData> CreateInput(vtkIdType numberOfPoints)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(7);
+  auto next = [&random](double min, double max) {
+    random->Next();
+    return random->GetRangeValue(min, max);
+  };
+
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(numberOfPoints);
+  vtkNew<vtkDoubleArray> scale;
+  scale->SetName("scale");
+  scale->SetNumberOfTuples(numberOfPoints);
+  vtkNew<vtkDoubleArray> orient;
+  orient->SetName("orient");
+  orient->SetNumberOfComponents(3);
+  orient->SetNumberOfTuples(numberOfPoints);
+  vtkNew<vtkIntArray> ids;
+  ids->SetName("ids");
+  ids->SetNumberOfTuples(numberOfPoints);
+  for (vtkIdType i = 0; i < numberOfPoints; ++i)
+  {
+    points->SetPoint(i, next(-5, 5), next(-5, 5), next(-5, 5));
+    scale->SetValue(i, i % 11 == 0 ? 0.0 : next(0.1, 2));
+    // Exercise the x-only and null orientations as well.
+    if (i % 7 == 0)
+    {
+      orient->SetTuple3(i, -next(0.5, 1), 0, 0);
+    }
+    else if (i % 13 == 0)
+    {
+      orient->SetTuple3(i, 0, 0, 0);
+    }
+    else
+    {
+      orient->SetTuple3(i, next(-1, 1), next(-1, 1), next(-1, 1));
+    }
+    ids->SetValue(i, static_cast<int>(i));
+  }
+
+  auto input = vtkSmartPointer<vtkPolyData>::New();
+  input->SetPoints(points);
+  input->GetPointData()->AddArray(scale);
+  input->GetPointData()->AddArray(orient);
+  input->GetPointData()->AddArray(ids);
+  return input;
+}
+
+// A triangle and a line, with normals.
+vtkSmartPointer<vtkPolyData> CreateSource()
+{
+  vtkNew<vtkPoints> points;
+  points->InsertNextPoint(0.0, 0.0, 0.0);
+  points->InsertNextPoint(1.0, 0.2, 0.0);
+  points->InsertNextPoint(0.3, 1.0, 0.5);
+  points->InsertNextPoint(-0.5, 0.1, 0.7);
+  vtkNew<vtkFloatArray> normals;
+  normals->SetNumberOfComponents(3);
+  normals->InsertNextTuple3(0, 0, 1);
+  normals->InsertNextTuple3(0, 1, 0);
+  normals->InsertNextTuple3(1, 0, 0);
+  normals->InsertNextTuple3(0.6, 0.8, 0);
+
+  auto source = vtkSmartPointer<vtkPolyData>::New();
+  source->SetPoints(points);
+  source->AllocateEstimate(2, 3);
+  const vtkIdType triangle[3] = { 0, 1, 2 };
+  source->InsertNextCell(VTK_TRIANGLE, 3, triangle);
+  const vtkIdType line[2] = { 2, 3 };
+  source->InsertNextCell(VTK_LINE, 2, line);
+  source->GetPointData()->SetNormals(normals);
+  return source;
+}
+
+// Glyph `glyph` of the output was generated for input point `ptId`.
+bool CheckGlyph(vtkPolyData* input, vtkPolyData* source, vtkPolyData* output, vtkIdType glyph,
+  vtkIdType ptId, double scaleFactor)
+{
+  double scale = input->GetPointData()->GetArray("scale")->GetComponent(ptId, 0) * scaleFactor;
+  if (scale == 0.0)
+  {
+    scale = 1.0e-10;
+  }
+  double v[3];
+  input->GetPointData()->GetArray("orient")->GetTuple(ptId, v);
+  const double vMag = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+
+  vtkNew<vtkTransform> transform;
+  transform->Translate(input->GetPoint(ptId));
+  if (vMag > 0.0)
+  {
+    if (v[1] == 0.0 && v[2] == 0.0)
+    {
+      if (v[0] < 0)
+      {
+        transform->RotateWXYZ(180.0, 0, 1, 0);
+      }
+    }
+    else
+    {
+      transform->RotateWXYZ(180.0, (v[0] + vMag) / 2.0, v[1] / 2.0, v[2] / 2.0);
+    }
+  }
+  transform->Scale(scale, scale, scale);
+
+  const vtkIdType numSourcePts = source->GetNumberOfPoints();
+  vtkDataArray* normals = output->GetPointData()->GetNormals();
+  vtkDataArray* ids = output->GetPointData()->GetArray("ids");
+  vtk_assert(normals && ids);
+  for (vtkIdType i = 0; i < numSourcePts; ++i)
+  {
+    const vtkIdType outId = glyph * numSourcePts + i;
+    double expected[3];
+    double actual[3];
+    transform->TransformPoint(source->GetPoint(i), expected);
+    output->GetPoint(outId, actual);
+    for (int c = 0; c < 3; ++c)
+    {
+      vtk_assert(std::abs(expected[c] - actual[c]) <= 1e-5 * std::max(1.0, std::abs(expected[c])));
+    }
+    transform->TransformNormal(source->GetPointData()->GetNormals()->GetTuple3(i), expected);
+    normals->GetTuple(outId, actual);
+    for (int c = 0; c < 3; ++c)
+    {
+      vtk_assert(std::abs(expected[c] - actual[c]) <= 1e-5);
+    }
+    vtk_assert(ids->GetComponent(outId, 0) == ptId);
+  }
+  return true;
+}
+
+bool CheckTopology(vtkPolyData* output, vtkIdType numGlyphs, vtkIdType numSourcePts)
+{
+  vtk_assert(output->GetNumberOfPolys() == numGlyphs);
+  vtk_assert(output->GetNumberOfLines() == numGlyphs);
+  vtkNew<vtkIdList> pts;
+  for (vtkIdType glyph = 0; glyph < numGlyphs; glyph += 17)
+  {
+    output->GetPolys()->GetCellAtId(glyph, pts);
+    vtk_assert(pts->GetNumberOfIds() == 3 && pts->GetId(0) == glyph * numSourcePts &&
+      pts->GetId(2) == glyph * numSourcePts + 2);
+    output->GetLines()->GetCellAtId(glyph, pts);
+    vtk_assert(pts->GetNumberOfIds() == 2 && pts->GetId(0) == glyph * numSourcePts + 2 &&
+      pts->GetId(1) == glyph * numSourcePts + 3);
+  }
+  return true;
+}
+
+bool TestGlyphMode(vtkPolyData* input, vtkPolyData* source, int glyphMode, int stride)
+{
+  const double scaleFactor = 0.5;
+  vtkNew<vtkPVGlyphFilter> glyphs;
+  glyphs->SetController(nullptr);
+  glyphs->SetInputData(input);
+  glyphs->AddInputData(1, source);
+  glyphs->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "scale");
+  glyphs->SetInputArrayToProcess(1, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "orient");
+  glyphs->SetScaleFactor(scaleFactor);
+  glyphs->SetGlyphMode(glyphMode);
+  glyphs->SetStride(stride);
+  glyphs->Update();
+
+  vtkPolyData* output = vtkPolyData::SafeDownCast(glyphs->GetOutputDataObject(0));
+  vtk_assert(output);
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  const vtkIdType numGlyphs = (numPts + stride - 1) / stride;
+  const vtkIdType numSourcePts = source->GetNumberOfPoints();
+  vtk_assert(output->GetNumberOfPoints() == numGlyphs * numSourcePts);
+  vtk_assert(CheckTopology(output, numGlyphs, numSourcePts));
+  for (vtkIdType glyph = 0; glyph < numGlyphs; ++glyph)
+  {
+    vtk_assert(CheckGlyph(input, source, output, glyph, glyph * stride, scaleFactor));
+  }
+  return true;
+}
+}
+
+int TestPVGlyphFilter(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  // Several blocks of glyphs, with a partial last one.
+  vtkSmartPointer<vtkPolyData> input = CreateInput(3001);
+  vtkSmartPointer<vtkPolyData> source = CreateSource();
+  return TestGlyphMode(input, source, vtkPVGlyphFilter::ALL_POINTS, 1) &&
+      TestGlyphMode(input, source, vtkPVGlyphFilter::EVERY_NTH_POINT, 3)
+    ? EXIT_SUCCESS
+    : EXIT_FAILURE;
+}
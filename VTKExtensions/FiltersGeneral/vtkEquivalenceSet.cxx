@@ -4,6 +4,12 @@
 #include "vtkEquivalenceSet.h"
 #include "vtkIntArray.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVUnionFind.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
 
 vtkStandardNewMacro(vtkEquivalenceSet);
 
@@ -11,13 +17,54 @@ vtkStandardNewMacro(vtkEquivalenceSet);
 // A class that implements an equivalent set.  It is used to combine fragments
 // from different processes.
 //
-// I believe that this class is a strictly ordered tree of equivalences.
-// Every member points to its own id or an id smaller than itself.
+// The equivalence array is a union-find (see vtkPVUnionFind.h): every member
+// points to its own id or an id smaller than itself.
+
+namespace
+{
+//----------------------------------------------------------------------------
+// Atomic copy of an equivalence array, to link pairs concurrently.
+class vtkEquivalenceSetConcurrentArray
+{
+public:
+  vtkEquivalenceSetConcurrentArray(vtkIntArray* array)
+    : Array(array)
+    , References(static_cast<size_t>(array->GetNumberOfTuples()))
+  {
+    const int* values = array->GetPointer(0);
+    vtkSMPTools::For(0, array->GetNumberOfTuples(), [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType ii = begin; ii < end; ++ii)
+      {
+        this->References[ii].store(values[ii], std::memory_order_relaxed);
+      }
+    });
+  }
+
+  void Union(int id1, int id2) { vtkPVUnionFind::Union(this->References.data(), id1, id2); }
+
+  // Writes the merged references back to the equivalence array.
+  void Finalize()
+  {
+    int* values = this->Array->GetPointer(0);
+    vtkSMPTools::For(0, this->Array->GetNumberOfTuples(), [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType ii = begin; ii < end; ++ii)
+      {
+        values[ii] = this->References[ii].load(std::memory_order_relaxed);
+      }
+    });
+  }
+
+private:
+  vtkIntArray* Array;
+  std::vector<std::atomic<int>> References;
+};
+}
 
 //----------------------------------------------------------------------------
 vtkEquivalenceSet::vtkEquivalenceSet()
 {
   this->Resolved = 0;
+  this->NumberOfResolvedSets = 0;
   this->EquivalenceArray = vtkIntArray::New();
 }
 
@@ -100,35 +147,57 @@ void vtkEquivalenceSet::AddEquivalence(int id1, int id2)
     return;
   }
 
-  int num = this->EquivalenceArray->GetNumberOfTuples();
-
   // Expand the range to include both ids.
-  while (num <= id1 || num <= id2)
-  {
-    // All values inserted are equivalent to only themselves.
-    this->EquivalenceArray->InsertNextTuple1(num);
-    ++num;
-  }
+  this->ExpandRange(std::max(id1, id2));
 
   // Our rule for references in the equivalent set is that
   // all elements must point to a member equal to or smaller
   // than itself.
+  this->EquateInternal(id1, id2);
+}
+
+//----------------------------------------------------------------------------
+// Same as calling AddEquivalence for every pair, but the pairs are linked
+// concurrently.
+void vtkEquivalenceSet::AddEquivalences(const int* pairs, vtkIdType numberOfPairs)
+{
+  if (this->Resolved)
+  {
+    vtkGenericWarningMacro("Set already resolved, you cannot add more equivalences.");
+    return;
+  }
+  if (numberOfPairs <= 0)
+  {
+    return;
+  }
 
-  // The only problem we could encounter is changing a reference.
-  // we do not want to orphan anything previously referenced.
+  this->ExpandRange(*std::max_element(pairs, pairs + 2 * numberOfPairs));
 
-  // Replace the larger references.
-  if (id1 < id2)
+  vtkEquivalenceSetConcurrentArray unionFind(this->EquivalenceArray);
+  vtkSMPTools::For(0, numberOfPairs, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ii = begin; ii < end; ++ii)
+    {
+      unionFind.Union(pairs[2 * ii], pairs[2 * ii + 1]);
+    }
+  });
+  unionFind.Finalize();
+}
+
+//----------------------------------------------------------------------------
+void vtkEquivalenceSet::ExpandRange(int memberId)
+{
+  int num = this->EquivalenceArray->GetNumberOfTuples();
+  if (memberId < num)
   {
-    // We could follow the references to the smallest.  It might
-    // make this processing more efficient.  This is a compromise.
-    // The referenced id will always be smaller than the id so
-    // order does not change.
-    this->EquateInternal(this->GetReference(id1), id2);
+    return;
   }
-  else
+  // All values inserted are equivalent to only themselves.
+  // InsertValue grows the allocation geometrically.
+  this->EquivalenceArray->InsertValue(memberId, memberId);
+  int* values = this->EquivalenceArray->GetPointer(0);
+  for (int ii = num; ii < memberId; ++ii)
   {
-    this->EquateInternal(this->GetReference(id2), id1);
+    values[ii] = ii;
   }
 }
 
@@ -157,33 +226,11 @@ vtkIdType vtkEquivalenceSet::Capacity()
 }
 
 //----------------------------------------------------------------------------
-// id1 must be less than or equal to id2.
+// Both ids must be in range.  The larger root is linked under the smaller one
+// so references keep pointing to smaller ids.
 void vtkEquivalenceSet::EquateInternal(int id1, int id2)
 {
-  // This is the reference that might be orphaned in this process.
-  int oldRef = this->GetEquivalentSetId(id2);
-
-  // The two ids are already equal (not the only way they might be equal).
-  if (oldRef == id1)
-  {
-    return;
-  }
-
-  // The only problem we could encounter is changing a reference.
-  // we do not want to orphan anything previously referenced.
-  if (oldRef == id2)
-  {
-    this->EquivalenceArray->SetValue(id2, id1);
-  }
-  else if (oldRef > id1)
-  {
-    this->EquivalenceArray->SetValue(id2, id1);
-    this->EquateInternal(id1, oldRef);
-  }
-  else
-  { // oldRef < id1
-    this->EquateInternal(oldRef, id1);
-  }
+  vtkPVUnionFind::Union(this->EquivalenceArray->GetPointer(0), id1, id2);
 }
 
 //----------------------------------------------------------------------------
@@ -7,6 +7,11 @@
  *
  * Useful for connectivity on multiple processes.  Run connectivity
  * on each processes, then make touching fragments equivalent.
+ *
+ * The set is a union-find in which every member references an id equal to
+ * or smaller than itself.  AddEquivalences() links a batch of pairs
+ * concurrently with a lock-free union-find; since sets are always rooted at
+ * their smallest member, the result does not depend on thread scheduling.
  */
 
 #ifndef vtkEquivalenceSet_h
@@ -26,6 +31,11 @@ public:
   void Initialize();
   void AddEquivalence(int id1, int id2);
 
+  // Makes the pairs (pairs[2*i], pairs[2*i+1]) equivalent, for i in
+  // [0, numberOfPairs).  The pairs are linked in parallel.  The resulting
+  // sets are the same as calling AddEquivalence for each pair.
+  void AddEquivalences(const int* pairs, vtkIdType numberOfPairs);
+
   // The length of the equivalent array...
   // The Domain of the equivalance map is [0, numberOfMembers).
   int GetNumberOfMembers();
@@ -69,9 +79,12 @@ protected:
   // traversed by different processes or passes.
   vtkIntArray* EquivalenceArray;
 
-  // Return the id of the equivalent set.
+  // Links the sets of the two ids under the smaller root.
   void EquateInternal(int id1, int id2);
 
+  // Grows the domain so that it contains memberId.
+  void ExpandRange(int memberId);
+
 private:
   vtkEquivalenceSet(const vtkEquivalenceSet&) = delete;
   void operator=(const vtkEquivalenceSet&) = delete;
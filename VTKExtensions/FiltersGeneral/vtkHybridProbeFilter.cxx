@@ -4,13 +4,17 @@
 
 #include "vtkCompositeDataSet.h"
 #include "vtkExtractSelection.h"
+#include "vtkFindCellStrategy.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMergeBlocks.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPProbeFilter.h"
+#include "vtkPVLocatorCache.h"
+#include "vtkPointSet.h"
 #include "vtkPointSource.h"
+#include "vtkPolyData.h"
 #include "vtkSelectionNode.h"
 #include "vtkSelectionSource.h"
 #include "vtkUnstructuredGrid.h"
@@ -69,9 +73,24 @@ bool vtkHybridProbeFilter::InterpolateAtLocation(vtkDataObject* input, vtkUnstru
   pointSource->SetRadius(0.0);
   pointSource->SetOutputPointsPrecision(vtkAlgorithm::DOUBLE_PRECISION);
 
+  // Reuse the cell locators built for the input by previous executions.
+  auto cache = vtkPVLocatorCache::GetInstance();
+
   vtkNew<vtkPProbeFilter> probe;
   probe->SetInputConnection(0, pointSource->GetOutputPort());
-  probe->SetInputDataObject(1, input);
+  if (auto pointSet = vtkPointSet::SafeDownCast(input))
+  {
+    // the probed points are located at once, in parallel.
+    pointSource->Update();
+    probe->SetFindCellStrategy(
+      cache->NewFindCellStrategy(pointSet, pointSource->GetOutput()->GetPoints()));
+    probe->SetInputDataObject(1, input);
+  }
+  else
+  {
+    // the locators of the blocks are attached to a shallow copy of the input.
+    probe->SetInputDataObject(1, cache->ShallowCopyWithCellLocators(input));
+  }
   probe->Update();
 
   output->ShallowCopy(probe->GetOutputDataObject(0));
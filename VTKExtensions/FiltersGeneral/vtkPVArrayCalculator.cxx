@@ -3,24 +3,39 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkPVArrayCalculator.h"
 
+#include "vtkArrayDispatch.h"
 #include "vtkCellData.h"
 #include "vtkCompositeDataIterator.h"
 #include "vtkCompositeDataSet.h"
+#include "vtkDataArrayRange.h"
 #include "vtkDataObject.h"
 #include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
 #include "vtkGraph.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVPostFilter.h"
 #include "vtkPointData.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
+#include "vtkSMPTools.h"
 #include "vtkTable.h"
+#include "vtkTuple.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <map>
 #include <set>
 #include <sstream>
 #include <string>
+#include <vector>
 
 namespace
 {
@@ -62,6 +77,683 @@ public:
     this->Calc->AddScalarVariable(name.c_str(), this->ArrayName, this->Component);
   }
 };
+
+//----------------------------------------------------------------------------
+// Compiled backend. The expression is parsed into a list of instructions, one
+// per operation, each writing a register holding a block of tuples with 1 or
+// 3 components stored one component after the other.
+const char* const vtkCoordinateScalarNames[3] = { "coordsX", "coordsY", "coordsZ" };
+const char* const vtkCoordinateVectorName = "coords";
+
+constexpr vtkIdType vtkCalcBlockSize = 512;
+
+enum class vtkCalcOp
+{
+  Constant,
+  Load,
+  Negate,
+  Add,
+  Subtract,
+  Multiply,
+  Divide,
+  Square,
+  Abs,
+  Sqrt,
+  Exp,
+  Ln,
+  Log10,
+  Sin,
+  Cos,
+  Tan,
+  ASin,
+  ACos,
+  ATan,
+  SinH,
+  CosH,
+  TanH,
+  Ceil,
+  Floor,
+  Sign,
+  Min,
+  Max,
+  Mag,
+  Norm,
+  Dot,
+  Cross
+};
+
+struct vtkCalcInstruction
+{
+  vtkCalcOp Op = vtkCalcOp::Constant;
+  int Width = 1;
+  int Args[2] = { -1, -1 };
+  double Constant[3] = { 0.0, 0.0, 0.0 };
+  vtkDataArray* Array = nullptr;
+  int Components[3] = { 0, 0, 0 };
+  // Contiguous values of single component double arrays, used without copy.
+  const double* Direct = nullptr;
+};
+
+struct vtkCalcLoadWorker
+{
+  template <typename ArrayT>
+  void operator()(ArrayT* array, vtkIdType begin, vtkIdType end, int component, double* out)
+  {
+    const auto tuples = vtk::DataArrayTupleRange(array, begin, end);
+    for (const auto tuple : tuples)
+    {
+      *out++ = static_cast<double>(tuple[component]);
+    }
+  }
+};
+
+struct vtkCalcStoreWorker
+{
+  template <typename ArrayT>
+  void operator()(ArrayT* array, vtkIdType begin, vtkIdType end, int width, const double* values)
+  {
+    using ValueType = vtk::GetAPIType<ArrayT>;
+    auto tuples = vtk::DataArrayTupleRange(array, begin, end);
+    const vtkIdType size = end - begin;
+    for (int c = 0; c < width; ++c)
+    {
+      const double* componentValues = values + c * vtkCalcBlockSize;
+      for (vtkIdType t = 0; t < size; ++t)
+      {
+        tuples[t][c] = static_cast<ValueType>(componentValues[t]);
+      }
+    }
+  }
+};
+
+template <typename Functor>
+void vtkCalcMap(double* out, const double* a, vtkIdType size, Functor functor)
+{
+  for (vtkIdType t = 0; t < size; ++t)
+  {
+    out[t] = functor(a[t]);
+  }
+}
+
+template <typename Functor>
+void vtkCalcMap(double* out, const double* a, const double* b, vtkIdType size, Functor functor)
+{
+  for (vtkIdType t = 0; t < size; ++t)
+  {
+    out[t] = functor(a[t], b[t]);
+  }
+}
+
+class vtkCalcProgram
+{
+public:
+  std::vector<vtkCalcInstruction> Instructions;
+
+  int GetResultWidth() const { return this->Instructions.back().Width; }
+
+  /**
+   * Evaluate all tuples into result. Returns false if an invalid value was
+   * produced and replace is false.
+   */
+  bool Execute(vtkIdType numTuples, vtkDataArray* result, bool replace, double replacement) const
+  {
+    std::atomic<bool> valid(true);
+    const vtkIdType numBlocks = (numTuples + vtkCalcBlockSize - 1) / vtkCalcBlockSize;
+    vtkSMPTools::For(0, numBlocks, [&](vtkIdType firstBlock, vtkIdType lastBlock) {
+      std::vector<double> scratch(this->Instructions.size() * 3 * vtkCalcBlockSize);
+      std::vector<const double*> views(this->Instructions.size() * 3);
+      std::vector<double> values(3 * vtkCalcBlockSize);
+      const int width = this->GetResultWidth();
+      for (vtkIdType block = firstBlock; block < lastBlock; ++block)
+      {
+        const vtkIdType begin = block * vtkCalcBlockSize;
+        const vtkIdType size = std::min(vtkCalcBlockSize, numTuples - begin);
+        this->EvaluateBlock(begin, size, scratch.data(), views.data());
+
+        const double* const* resultViews = views.data() + 3 * (this->Instructions.size() - 1);
+        for (int c = 0; c < width; ++c)
+        {
+          double* out = values.data() + c * vtkCalcBlockSize;
+          std::copy(resultViews[c], resultViews[c] + size, out);
+          for (vtkIdType t = 0; t < size; ++t)
+          {
+            if (!std::isfinite(out[t]))
+            {
+              if (!replace)
+              {
+                valid = false;
+              }
+              out[t] = replacement;
+            }
+          }
+        }
+        if (!vtkArrayDispatch::Dispatch::Execute(
+              result, vtkCalcStoreWorker{}, begin, begin + size, width, values.data()))
+        {
+          vtkCalcStoreWorker{}(result, begin, begin + size, width, values.data());
+        }
+      }
+    });
+    return valid;
+  }
+
+private:
+  void EvaluateBlock(
+    vtkIdType begin, vtkIdType size, double* scratch, const double** views) const
+  {
+    for (size_t i = 0; i < this->Instructions.size(); ++i)
+    {
+      const vtkCalcInstruction& instruction = this->Instructions[i];
+      double* out[3];
+      for (int c = 0; c < 3; ++c)
+      {
+        out[c] = scratch + (3 * i + c) * vtkCalcBlockSize;
+        views[3 * i + c] = out[c];
+      }
+      const double* const* a =
+        instruction.Args[0] >= 0 ? views + 3 * instruction.Args[0] : nullptr;
+      const double* const* b =
+        instruction.Args[1] >= 0 ? views + 3 * instruction.Args[1] : nullptr;
+      const int widthA = a ? this->Instructions[instruction.Args[0]].Width : 0;
+      const int widthB = b ? this->Instructions[instruction.Args[1]].Width : 0;
+
+      switch (instruction.Op)
+      {
+        case vtkCalcOp::Constant:
+          for (int c = 0; c < instruction.Width; ++c)
+          {
+            std::fill(out[c], out[c] + size, instruction.Constant[c]);
+          }
+          break;
+
+        case vtkCalcOp::Load:
+          if (instruction.Direct)
+          {
+            views[3 * i] = instruction.Direct + begin;
+            break;
+          }
+          for (int c = 0; c < instruction.Width; ++c)
+          {
+            if (!vtkArrayDispatch::Dispatch::Execute(instruction.Array, vtkCalcLoadWorker{},
+                  begin, begin + size, instruction.Components[c], out[c]))
+            {
+              vtkCalcLoadWorker{}(
+                instruction.Array, begin, begin + size, instruction.Components[c], out[c]);
+            }
+          }
+          break;
+
+        case vtkCalcOp::Negate:
+          for (int c = 0; c < instruction.Width; ++c)
+          {
+            vtkCalcMap(out[c], a[c], size, [](double x) { return -x; });
+          }
+          break;
+
+        case vtkCalcOp::Add:
+        case vtkCalcOp::Subtract:
+        case vtkCalcOp::Multiply:
+        case vtkCalcOp::Divide:
+          for (int c = 0; c < instruction.Width; ++c)
+          {
+            // A scalar operand is combined with every component of a vector.
+            const double* x = a[widthA == 1 ? 0 : c];
+            const double* y = b[widthB == 1 ? 0 : c];
+            switch (instruction.Op)
+            {
+              case vtkCalcOp::Add:
+                vtkCalcMap(out[c], x, y, size, [](double u, double v) { return u + v; });
+                break;
+              case vtkCalcOp::Subtract:
+                vtkCalcMap(out[c], x, y, size, [](double u, double v) { return u - v; });
+                break;
+              case vtkCalcOp::Multiply:
+                vtkCalcMap(out[c], x, y, size, [](double u, double v) { return u * v; });
+                break;
+              default:
+                vtkCalcMap(out[c], x, y, size, [](double u, double v) { return u / v; });
+                break;
+            }
+          }
+          break;
+
+        case vtkCalcOp::Square:
+          vtkCalcMap(out[0], a[0], size, [](double x) { return x * x; });
+          break;
+        case vtkCalcOp::Abs:
+          vtkCalcMap(out[0], a[0], size, [](double x) { return std::fabs(x); });
+          break;
+        case vtkCalcOp::Sqrt:
+          vtkCalcMap(out[0], a[0], size, [](double x) { return std::sqrt(x); });
+          break;
+        case vtkCalcOp::Exp:
+          vtkCalcMap(out[0], a[0], size, [](double x) { return std::exp(x); });
+          break;
+        case vtkCalcOp::Ln:
+          vtkCalcMap(out[0], a[0], size, [](double x) { return std::log(x); });
+          break;
+        case vtkCalcOp::Log10:
+          vtkCalcMap(out[0], a[0], size, [](double x) { return std::log10(x); });
+          break;
+        case vtkCalcOp::Sin:
+          vtkCalcMap(out[0], a[0], size, [](double x) { return std::sin(x); });
+          break;
+        case vtkCalcOp::Cos:
+          vtkCalcMap(out[0], a[0], size, [](double x) { return std::cos(x); });
+          break;
+        case vtkCalcOp::Tan:
+          vtkCalcMap(out[0], a[0], size, [](double x) { return std::tan(x); });
+          break;
+        case vtkCalcOp::ASin:
+          vtkCalcMap(out[0], a[0], size, [](double x) { return std::asin(x); });
+          break;
+        case vtkCalcOp::ACos:
+          vtkCalcMap(out[0], a[0], size, [](double x) { return std::acos(x); });
+          break;
+        case vtkCalcOp::ATan:
+          vtkCalcMap(out[0], a[0], size, [](double x) { return std::atan(x); });
+          break;
+        case vtkCalcOp::SinH:
+          vtkCalcMap(out[0], a[0], size, [](double x) { return std::sinh(x); });
+          break;
+        case vtkCalcOp::CosH:
+          vtkCalcMap(out[0], a[0], size, [](double x) { return std::cosh(x); });
+          break;
+        case vtkCalcOp::TanH:
+          vtkCalcMap(out[0], a[0], size, [](double x) { return std::tanh(x); });
+          break;
+        case vtkCalcOp::Ceil:
+          vtkCalcMap(out[0], a[0], size, [](double x) { return std::ceil(x); });
+          break;
+        case vtkCalcOp::Floor:
+          vtkCalcMap(out[0], a[0], size, [](double x) { return std::floor(x); });
+          break;
+        case vtkCalcOp::Sign:
+          vtkCalcMap(out[0], a[0], size,
+            [](double x) { return x > 0.0 ? 1.0 : (x < 0.0 ? -1.0 : 0.0); });
+          break;
+        case vtkCalcOp::Min:
+          vtkCalcMap(out[0], a[0], b[0], size, [](double u, double v) { return u < v ? u : v; });
+          break;
+        case vtkCalcOp::Max:
+          vtkCalcMap(out[0], a[0], b[0], size, [](double u, double v) { return u > v ? u : v; });
+          break;
+
+        case vtkCalcOp::Mag:
+        case vtkCalcOp::Norm:
+        {
+          const double *x = a[0], *y = a[1], *z = a[2];
+          for (vtkIdType t = 0; t < size; ++t)
+          {
+            out[0][t] = std::sqrt(x[t] * x[t] + y[t] * y[t] + z[t] * z[t]);
+          }
+          if (instruction.Op == vtkCalcOp::Norm)
+          {
+            for (vtkIdType t = 0; t < size; ++t)
+            {
+              const double magnitude = out[0][t];
+              out[0][t] = x[t] / magnitude;
+              out[1][t] = y[t] / magnitude;
+              out[2][t] = z[t] / magnitude;
+            }
+          }
+          break;
+        }
+
+        case vtkCalcOp::Dot:
+          for (vtkIdType t = 0; t < size; ++t)
+          {
+            out[0][t] = a[0][t] * b[0][t] + a[1][t] * b[1][t] + a[2][t] * b[2][t];
+          }
+          break;
+
+        case vtkCalcOp::Cross:
+          for (vtkIdType t = 0; t < size; ++t)
+          {
+            const double a0 = a[0][t], a1 = a[1][t], a2 = a[2][t];
+            const double b0 = b[0][t], b1 = b[1][t], b2 = b[2][t];
+            out[0][t] = a1 * b2 - a2 * b1;
+            out[1][t] = a2 * b0 - a0 * b2;
+            out[2][t] = a0 * b1 - a1 * b0;
+          }
+          break;
+      }
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+// Recursive descent parser following the precedence of vtkFunctionParser. Any
+// construct it does not know makes the compilation fail.
+class vtkCalcCompiler
+{
+public:
+  // Fills the Load instruction of a variable. Returns false if unknown.
+  using Resolver = std::function<bool(const std::string&, vtkCalcInstruction&)>;
+
+  vtkCalcCompiler(const std::string& expression, const Resolver& resolver)
+    : Expression(expression)
+    , Resolve(resolver)
+  {
+  }
+
+  bool Compile(vtkCalcProgram& program)
+  {
+    this->Program = &program;
+    program.Instructions.clear();
+    this->Position = 0;
+    const int result = this->ParseSum();
+    this->SkipSpaces();
+    return result >= 0 && this->Position == this->Expression.size();
+  }
+
+private:
+  const std::string& Expression;
+  const Resolver& Resolve;
+  vtkCalcProgram* Program = nullptr;
+  size_t Position = 0;
+
+  void SkipSpaces()
+  {
+    while (this->Position < this->Expression.size() &&
+      std::isspace(static_cast<unsigned char>(this->Expression[this->Position])))
+    {
+      ++this->Position;
+    }
+  }
+
+  bool Accept(char c)
+  {
+    this->SkipSpaces();
+    if (this->Position < this->Expression.size() && this->Expression[this->Position] == c)
+    {
+      ++this->Position;
+      return true;
+    }
+    return false;
+  }
+
+  int Width(int reg) const { return this->Program->Instructions[reg].Width; }
+
+  int Emit(vtkCalcOp op, int width, int a = -1, int b = -1)
+  {
+    vtkCalcInstruction instruction;
+    instruction.Op = op;
+    instruction.Width = width;
+    instruction.Args[0] = a;
+    instruction.Args[1] = b;
+    return this->Emit(instruction);
+  }
+
+  int Emit(const vtkCalcInstruction& instruction)
+  {
+    this->Program->Instructions.push_back(instruction);
+    return static_cast<int>(this->Program->Instructions.size()) - 1;
+  }
+
+  int EmitConstant(double x, double y, double z, int width)
+  {
+    vtkCalcInstruction instruction;
+    instruction.Width = width;
+    instruction.Constant[0] = x;
+    instruction.Constant[1] = y;
+    instruction.Constant[2] = z;
+    return this->Emit(instruction);
+  }
+
+  int EmitBinary(vtkCalcOp op, int a, int b)
+  {
+    if (a < 0 || b < 0)
+    {
+      return -1;
+    }
+    const int wa = this->Width(a);
+    const int wb = this->Width(b);
+    switch (op)
+    {
+      case vtkCalcOp::Add:
+      case vtkCalcOp::Subtract:
+        return wa == wb ? this->Emit(op, wa, a, b) : -1;
+      case vtkCalcOp::Multiply:
+        return (wa == 1 || wb == 1) ? this->Emit(op, std::max(wa, wb), a, b) : -1;
+      default:
+        return wb == 1 ? this->Emit(op, wa, a, b) : -1;
+    }
+  }
+
+  // sum := product (('+' | '-') product)*
+  int ParseSum()
+  {
+    int result = this->ParseProduct();
+    while (result >= 0)
+    {
+      if (this->Accept('+'))
+      {
+        result = this->EmitBinary(vtkCalcOp::Add, result, this->ParseProduct());
+      }
+      else if (this->Accept('-'))
+      {
+        result = this->EmitBinary(vtkCalcOp::Subtract, result, this->ParseProduct());
+      }
+      else
+      {
+        break;
+      }
+    }
+    return result;
+  }
+
+  // product := unary (('*' | '/') unary)*
+  int ParseProduct()
+  {
+    int result = this->ParseUnary();
+    while (result >= 0)
+    {
+      if (this->Accept('*'))
+      {
+        result = this->EmitBinary(vtkCalcOp::Multiply, result, this->ParseUnary());
+      }
+      else if (this->Accept('/'))
+      {
+        result = this->EmitBinary(vtkCalcOp::Divide, result, this->ParseUnary());
+      }
+      else
+      {
+        break;
+      }
+    }
+    return result;
+  }
+
+  // unary := ('-' | '+') unary | power
+  int ParseUnary()
+  {
+    if (this->Accept('-'))
+    {
+      bool isPower = false;
+      const int operand = this->ParsePower(isPower);
+      // The parsers disagree on whether -x^2 negates x or x^2.
+      if (operand < 0 || isPower)
+      {
+        return -1;
+      }
+      return this->Emit(vtkCalcOp::Negate, this->Width(operand), operand);
+    }
+    if (this->Accept('+'))
+    {
+      return -1;
+    }
+    bool isPower = false;
+    return this->ParsePower(isPower);
+  }
+
+  // power := primary ('^' integer)?, with an exponent of 0, 1 or 2 only, for
+  // which pow() and repeated multiplication give the same result.
+  int ParsePower(bool& isPower)
+  {
+    const int base = this->ParsePrimary();
+    if (base < 0 || !this->Accept('^'))
+    {
+      return base;
+    }
+    isPower = true;
+    this->SkipSpaces();
+    const size_t start = this->Position;
+    while (this->Position < this->Expression.size() &&
+      std::isdigit(static_cast<unsigned char>(this->Expression[this->Position])))
+    {
+      ++this->Position;
+    }
+    const std::string exponent = this->Expression.substr(start, this->Position - start);
+    this->SkipSpaces();
+    if (this->Width(base) != 1 || exponent.empty() || exponent.size() > 1 ||
+      (this->Position < this->Expression.size() &&
+        std::strchr(".^eE(", this->Expression[this->Position])))
+    {
+      return -1;
+    }
+    switch (exponent[0])
+    {
+      case '0':
+        return this->EmitConstant(1.0, 0.0, 0.0, 1);
+      case '1':
+        return base;
+      case '2':
+        return this->Emit(vtkCalcOp::Square, 1, base);
+      default:
+        return -1;
+    }
+  }
+
+  // primary := number | '(' sum ')' | function '(' arguments ')' | variable
+  int ParsePrimary()
+  {
+    this->SkipSpaces();
+    if (this->Position >= this->Expression.size())
+    {
+      return -1;
+    }
+    const char* begin = this->Expression.c_str() + this->Position;
+    if (std::isdigit(static_cast<unsigned char>(*begin)) ||
+      (*begin == '.' && std::isdigit(static_cast<unsigned char>(begin[1]))))
+    {
+      if (begin[0] == '0' && (begin[1] == 'x' || begin[1] == 'X'))
+      {
+        return -1;
+      }
+      char* end = nullptr;
+      const double value = std::strtod(begin, &end);
+      this->Position += end - begin;
+      return this->EmitConstant(value, 0.0, 0.0, 1);
+    }
+    if (this->Accept('('))
+    {
+      const int result = this->ParseSum();
+      return this->Accept(')') ? result : -1;
+    }
+
+    std::string name;
+    if (*begin == '"')
+    {
+      const size_t close = this->Expression.find('"', this->Position + 1);
+      if (close == std::string::npos)
+      {
+        return -1;
+      }
+      name = this->Expression.substr(this->Position, close + 1 - this->Position);
+      this->Position = close + 1;
+    }
+    else
+    {
+      const size_t start = this->Position;
+      while (this->Position < this->Expression.size() &&
+        (std::isalnum(static_cast<unsigned char>(this->Expression[this->Position])) ||
+          this->Expression[this->Position] == '_'))
+      {
+        ++this->Position;
+      }
+      name = this->Expression.substr(start, this->Position - start);
+    }
+    if (name.empty())
+    {
+      return -1;
+    }
+
+    const size_t afterName = this->Position;
+    if (name[0] != '"' && this->Accept('('))
+    {
+      return this->ParseCall(name);
+    }
+    this->Position = afterName;
+
+    if (name == "iHat" || name == "jHat" || name == "kHat")
+    {
+      return this->EmitConstant(
+        name[0] == 'i' ? 1.0 : 0.0, name[0] == 'j' ? 1.0 : 0.0, name[0] == 'k' ? 1.0 : 0.0, 3);
+    }
+    vtkCalcInstruction load;
+    load.Op = vtkCalcOp::Load;
+    return this->Resolve(name, load) ? this->Emit(load) : -1;
+  }
+
+  int ParseCall(const std::string& name)
+  {
+    std::vector<int> args;
+    if (!this->Accept(')'))
+    {
+      do
+      {
+        const int arg = this->ParseSum();
+        if (arg < 0)
+        {
+          return -1;
+        }
+        args.push_back(arg);
+      } while (this->Accept(','));
+      if (!this->Accept(')'))
+      {
+        return -1;
+      }
+    }
+
+    static const std::map<std::string, vtkCalcOp> scalarFunctions = { { "abs", vtkCalcOp::Abs },
+      { "sqrt", vtkCalcOp::Sqrt }, { "exp", vtkCalcOp::Exp }, { "ln", vtkCalcOp::Ln },
+      { "log", vtkCalcOp::Ln }, { "log10", vtkCalcOp::Log10 }, { "sin", vtkCalcOp::Sin },
+      { "cos", vtkCalcOp::Cos }, { "tan", vtkCalcOp::Tan }, { "asin", vtkCalcOp::ASin },
+      { "acos", vtkCalcOp::ACos }, { "atan", vtkCalcOp::ATan }, { "sinh", vtkCalcOp::SinH },
+      { "cosh", vtkCalcOp::CosH }, { "tanh", vtkCalcOp::TanH }, { "ceil", vtkCalcOp::Ceil },
+      { "floor", vtkCalcOp::Floor }, { "sign", vtkCalcOp::Sign } };
+
+    auto scalar = scalarFunctions.find(name);
+    if (scalar != scalarFunctions.end())
+    {
+      return (args.size() == 1 && this->Width(args[0]) == 1)
+        ? this->Emit(scalar->second, 1, args[0])
+        : -1;
+    }
+    if (name == "min" || name == "max")
+    {
+      return (args.size() == 2 && this->Width(args[0]) == 1 && this->Width(args[1]) == 1)
+        ? this->Emit(name == "min" ? vtkCalcOp::Min : vtkCalcOp::Max, 1, args[0], args[1])
+        : -1;
+    }
+    if (name == "mag" || name == "norm")
+    {
+      return (args.size() == 1 && this->Width(args[0]) == 3)
+        ? this->Emit(name == "mag" ? vtkCalcOp::Mag : vtkCalcOp::Norm, name == "mag" ? 1 : 3,
+            args[0])
+        : -1;
+    }
+    if (name == "dot" || name == "cross")
+    {
+      return (args.size() == 2 && this->Width(args[0]) == 3 && this->Width(args[1]) == 3)
+        ? this->Emit(name == "dot" ? vtkCalcOp::Dot : vtkCalcOp::Cross, name == "dot" ? 1 : 3,
+            args[0], args[1])
+        : -1;
+    }
+    return -1;
+  }
+};
 }
 
 vtkStandardNewMacro(vtkPVArrayCalculator);
@@ -76,6 +768,20 @@ vtkPVArrayCalculator::vtkPVArrayCalculator()
 // ----------------------------------------------------------------------------
 vtkPVArrayCalculator::~vtkPVArrayCalculator() = default;
 
+// ----------------------------------------------------------------------------
+void vtkPVArrayCalculator::SetFunctionParserTypeFromInt(int type)
+{
+  const bool useCompiled = (type == CompiledFunctionParser);
+  if (this->UseCompiledFunctionParser != useCompiled)
+  {
+    this->UseCompiledFunctionParser = useCompiled;
+    this->Modified();
+  }
+  // Expressions the compiled backend cannot handle use vtkExprTkFunctionParser.
+  this->SetFunctionParserType(
+    useCompiled ? ExprTkFunctionParser : static_cast<FunctionParserTypes>(type));
+}
+
 // ----------------------------------------------------------------------------
 int vtkPVArrayCalculator::GetAttributeTypeFromInput(vtkDataObject* input)
 {
@@ -116,10 +822,11 @@ void vtkPVArrayCalculator::ResetArrayAndVariableNames()
 void vtkPVArrayCalculator::AddCoordinateVariableNames()
 {
   // Add coordinate scalar and vector variables
-  this->AddCoordinateScalarVariable("coordsX", 0);
-  this->AddCoordinateScalarVariable("coordsY", 1);
-  this->AddCoordinateScalarVariable("coordsZ", 2);
-  this->AddCoordinateVectorVariable("coords", 0, 1, 2);
+  for (int i = 0; i < 3; ++i)
+  {
+    this->AddCoordinateScalarVariable(vtkCoordinateScalarNames[i], i);
+  }
+  this->AddCoordinateVectorVariable(vtkCoordinateVectorName, 0, 1, 2);
 }
 
 // ----------------------------------------------------------------------------
@@ -268,11 +975,204 @@ int vtkPVArrayCalculator::RequestData(
   assert(this->GetMTime() == mtime && "post: mtime cannot be changed in RequestData()");
   (void)mtime;
 
+  if (this->UseCompiledFunctionParser &&
+    this->RequestDataCompiled(input, vtkDataObject::GetData(outputVector, 0)))
+  {
+    return 1;
+  }
   return this->Superclass::RequestData(request, inputVector, outputVector);
 }
 
+// ----------------------------------------------------------------------------
+bool vtkPVArrayCalculator::RequestDataCompiled(vtkDataObject* input, vtkDataObject* output)
+{
+  if (!this->GetFunction() || this->GetCoordinateResults() || !output)
+  {
+    return false;
+  }
+  const std::string expression = this->GetFunction();
+
+  std::vector<vtkDataObject*> leaves;
+  vtkCompositeDataSet* cdInput = vtkCompositeDataSet::SafeDownCast(input);
+  if (cdInput)
+  {
+    vtkSmartPointer<vtkCompositeDataIterator> cdIter;
+    cdIter.TakeReference(cdInput->NewIterator());
+    cdIter->SkipEmptyNodesOn();
+    for (cdIter->InitTraversal(); !cdIter->IsDoneWithTraversal(); cdIter->GoToNextItem())
+    {
+      leaves.push_back(cdIter->GetCurrentDataObject());
+    }
+  }
+  else
+  {
+    leaves.push_back(input);
+  }
+
+  // Evaluate every block before touching the output so that the superclass
+  // can still take over if any of them cannot be compiled.
+  std::vector<vtkSmartPointer<vtkDataArray>> results(leaves.size());
+  for (size_t i = 0; i < leaves.size(); ++i)
+  {
+    const int attributeType = this->GetAttributeTypeFromInput(leaves[i]);
+    vtkDataSetAttributes* attributes = leaves[i]->GetAttributes(attributeType);
+    if (!attributes)
+    {
+      return false;
+    }
+    const vtkIdType numTuples = attributes->GetNumberOfTuples();
+    if (numTuples < 1)
+    {
+      continue;
+    }
+    vtkPointSet* pointSet =
+      attributeType == vtkDataObject::POINT ? vtkPointSet::SafeDownCast(leaves[i]) : nullptr;
+
+    // Bind variables like the superclass does: the last registered array
+    // present in the block wins.
+    const vtkCalcCompiler::Resolver resolver = [&](const std::string& name,
+                                                 vtkCalcInstruction& load) {
+      bool found = false;
+      for (int j = 0; j < this->GetNumberOfScalarArrays(); ++j)
+      {
+        vtkDataArray* array = attributes->GetArray(this->GetScalarArrayName(j).c_str());
+        const int component = this->GetSelectedScalarComponent(j);
+        if (this->GetScalarVariableName(j) == name && array &&
+          component < array->GetNumberOfComponents())
+        {
+          load.Width = 1;
+          load.Array = array;
+          load.Components[0] = component;
+          found = true;
+        }
+      }
+      for (int j = 0; j < this->GetNumberOfVectorArrays(); ++j)
+      {
+        vtkDataArray* array = attributes->GetArray(this->GetVectorArrayName(j).c_str());
+        const vtkTuple<int, 3> components = this->GetSelectedVectorComponents(j);
+        if (this->GetVectorVariableName(j) == name && array &&
+          std::max({ components[0], components[1], components[2] }) <
+            array->GetNumberOfComponents())
+        {
+          load.Width = 3;
+          load.Array = array;
+          std::copy(components.GetData(), components.GetData() + 3, load.Components);
+          found = true;
+        }
+      }
+      if (!found && pointSet && pointSet->GetPoints())
+      {
+        load.Array = pointSet->GetPoints()->GetData();
+        for (int c = 0; c < 3; ++c)
+        {
+          load.Components[c] = c;
+          if (name == vtkCoordinateScalarNames[c])
+          {
+            load.Width = 1;
+            load.Components[0] = c;
+            found = true;
+            break;
+          }
+        }
+        if (name == vtkCoordinateVectorName)
+        {
+          load.Width = 3;
+          found = true;
+        }
+      }
+      vtkDoubleArray* doubleArray = vtkDoubleArray::FastDownCast(load.Array);
+      if (found && load.Width == 1 && doubleArray && doubleArray->GetNumberOfComponents() == 1)
+      {
+        load.Direct = doubleArray->GetPointer(0);
+      }
+      return found;
+    };
+
+    vtkCalcProgram program;
+    vtkCalcCompiler compiler(expression, resolver);
+    if (!compiler.Compile(program))
+    {
+      return false;
+    }
+    const int width = program.GetResultWidth();
+    if ((this->GetResultNormals() || this->GetResultTCoords()) && width != 3)
+    {
+      return false;
+    }
+
+    auto result = vtk::TakeSmartPointer(vtkDataArray::CreateDataArray(this->GetResultArrayType()));
+    if (!result)
+    {
+      return false;
+    }
+    result->SetName(this->GetResultArrayName());
+    result->SetNumberOfComponents(width);
+    result->SetNumberOfTuples(numTuples);
+    if (!program.Execute(
+          numTuples, result, this->GetReplaceInvalidValues() != 0, this->GetReplacementValue()))
+    {
+      // Let the superclass report the invalid values.
+      return false;
+    }
+    results[i] = result;
+  }
+
+  auto addResult = [this](vtkDataObject* dataObject, vtkDataArray* result) {
+    vtkDataSetAttributes* attributes =
+      dataObject->GetAttributes(this->GetAttributeTypeFromInput(dataObject));
+    if (result->GetNumberOfComponents() == 1)
+    {
+      attributes->AddArray(result);
+      attributes->SetActiveScalars(result->GetName());
+    }
+    else if (this->GetResultNormals())
+    {
+      attributes->SetNormals(result);
+    }
+    else if (this->GetResultTCoords())
+    {
+      attributes->SetTCoords(result);
+    }
+    else
+    {
+      attributes->AddArray(result);
+      attributes->SetActiveVectors(result->GetName());
+    }
+  };
+
+  if (!cdInput)
+  {
+    output->ShallowCopy(input);
+    if (results[0])
+    {
+      addResult(output, results[0]);
+    }
+    return true;
+  }
+
+  vtkCompositeDataSet* cdOutput = vtkCompositeDataSet::SafeDownCast(output);
+  cdOutput->CopyStructure(cdInput);
+  vtkSmartPointer<vtkCompositeDataIterator> cdIter;
+  cdIter.TakeReference(cdInput->NewIterator());
+  cdIter->SkipEmptyNodesOn();
+  size_t i = 0;
+  for (cdIter->InitTraversal(); !cdIter->IsDoneWithTraversal(); cdIter->GoToNextItem(), ++i)
+  {
+    vtkSmartPointer<vtkDataObject> leaf;
+    leaf.TakeReference(leaves[i]->NewInstance());
+    leaf->ShallowCopy(leaves[i]);
+    if (results[i])
+    {
+      addResult(leaf, results[i]);
+    }
+    cdOutput->SetDataSet(cdIter, leaf);
+  }
+  return true;
+}
+
 // ----------------------------------------------------------------------------
 void vtkPVArrayCalculator::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "UseCompiledFunctionParser: " << this->UseCompiledFunctionParser << endl;
 }
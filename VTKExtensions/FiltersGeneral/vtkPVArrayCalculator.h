@@ -34,16 +34,33 @@ public:
 
   static vtkPVArrayCalculator* New();
 
+  /**
+   * Parser types understood by SetFunctionParserTypeFromInt() in addition to
+   * vtkArrayCalculator::FunctionParserTypes.
+   *
+   * CompiledFunctionParser compiles the expression once per block into a plan
+   * that evaluates whole arrays in parallel, a few hundred tuples at a time.
+   * It supports arithmetic, integer powers up to 2, the usual scalar
+   * functions, iHat/jHat/kHat and the vector functions mag, norm, dot and
+   * cross. Each operation is evaluated in the order it is written, like
+   * vtkFunctionParser does, and invalid results are replaced like
+   * vtkExprTkFunctionParser does. Expressions or inputs it cannot handle, such
+   * as conditionals or CoordinateResults, are evaluated with
+   * vtkExprTkFunctionParser instead.
+   */
+  enum ExtendedFunctionParserTypes
+  {
+    CompiledFunctionParser = NumberOfFunctionParserTypes
+  };
+
   ///@{
   /**
    * Convenience function to set parser type via int equivalent to FunctionParserTypes
-   * enum. Needed because ParaView's client/server wrapper doesn't understand
-   * vtkSetEnumMacro() in the parent class.
+   * enum or CompiledFunctionParser. Needed because ParaView's client/server wrapper
+   * doesn't understand vtkSetEnumMacro() in the parent class.
    */
-  void SetFunctionParserTypeFromInt(int type)
-  {
-    this->SetFunctionParserType(static_cast<FunctionParserTypes>(type));
-  }
+  void SetFunctionParserTypeFromInt(int type);
+  vtkGetMacro(UseCompiledFunctionParser, bool);
   ///@}
 
 protected:
@@ -77,6 +94,15 @@ protected:
    */
   void AddArrayAndVariableNames(vtkDataObject* theInputObj, vtkDataSetAttributes* inDataAttrs);
 
+  /**
+   * Evaluate the function with the compiled backend. Returns false, without
+   * touching the output, when the expression or one of the blocks cannot be
+   * handled, in which case the superclass must be used.
+   */
+  bool RequestDataCompiled(vtkDataObject* input, vtkDataObject* output);
+
+  bool UseCompiledFunctionParser = false;
+
 private:
   vtkPVArrayCalculator(const vtkPVArrayCalculator&) = delete;
   void operator=(const vtkPVArrayCalculator&) = delete;
@@ -3,17 +3,22 @@
 #include "vtkPVGlyphFilter.h"
 
 // VTK includes
+#include "vtkArrayDispatch.h"
 #include "vtkBoundingBox.h"
+#include "vtkCellArray.h"
 #include "vtkCellCenters.h"
 #include "vtkCellData.h"
 #include "vtkCompositeDataIterator.h"
+#include "vtkDataArrayRange.h"
 #include "vtkDataSet.h"
 #include "vtkDataSetSurfaceFilter.h"
 #include "vtkDataSetTriangleFilter.h"
 #include "vtkFloatArray.h"
 #include "vtkGenerateIds.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMath.h"
 #include "vtkMinimalStandardRandomSequence.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiProcessController.h"
@@ -22,6 +27,7 @@
 #include "vtkOctreePointLocator.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTetra.h"
@@ -484,6 +490,265 @@ public:
   }
 };
 
+namespace
+{
+// Number of glyphs whose transforms are computed together. The transforms of a
+// block are stored one array per matrix entry so that instancing a source point
+// for all glyphs of the block is a run of independent multiply-adds.
+constexpr int GlyphBlockSize = 128;
+
+//-----------------------------------------------------------------------------
+// Same rotation matrix as vtkTransform::RotateWXYZ(), so that glyphs match the
+// ones produced by composing vtkTransform operations.
+void RotationMatrix(double angle, double x, double y, double z, double matrix[3][3])
+{
+  angle = vtkMath::RadiansFromDegrees(angle);
+  const double w = std::cos(0.5 * angle);
+  const double f = std::sin(0.5 * angle) / std::sqrt(x * x + y * y + z * z);
+  x *= f;
+  y *= f;
+  z *= f;
+
+  const double ww = w * w;
+  const double wx = w * x;
+  const double wy = w * y;
+  const double wz = w * z;
+  const double xx = x * x;
+  const double yy = y * y;
+  const double zz = z * z;
+  const double xy = x * y;
+  const double xz = x * z;
+  const double yz = y * z;
+  const double s = ww - xx - yy - zz;
+
+  matrix[0][0] = xx * 2 + s;
+  matrix[1][0] = (xy + wz) * 2;
+  matrix[2][0] = (xz - wy) * 2;
+  matrix[0][1] = (xy - wz) * 2;
+  matrix[1][1] = yy * 2 + s;
+  matrix[2][1] = (yz + wx) * 2;
+  matrix[0][2] = (xz + wy) * 2;
+  matrix[1][2] = (yz - wx) * 2;
+  matrix[2][2] = zz * 2 + s;
+}
+
+//-----------------------------------------------------------------------------
+// Writes the points (and normals) of the glyphs [begin, end) directly in the
+// preallocated output arrays. Glyph g occupies points
+// [g * NumberOfSourcePoints, (g + 1) * NumberOfSourcePoints).
+template <typename PointT>
+struct vtkPVGlyphGenerator
+{
+  vtkDataSet* Input;
+  const vtkIdType* GlyphedIds;
+  vtkDataArray* ScaleArray;
+  vtkDataArray* OrientArray;
+  bool ScaleByMagnitude;
+  double ScaleFactor;
+  const double* SourcePoints;
+  const double* SourceNormals;
+  vtkIdType NumberOfSourcePoints;
+  PointT* Points;
+  float* Normals;
+
+  // Translate(x) * RotateWXYZ() * Scale() as in the serial implementation. The
+  // inverse transpose used for normals is rotation * scale^-1.
+  void ComputeTransform(vtkIdType ptId, int g, double linear[9][GlyphBlockSize],
+    double translation[3][GlyphBlockSize], double normal[9][GlyphBlockSize]) const
+  {
+    double scale[3] = { 1.0, 1.0, 1.0 };
+    if (this->ScaleArray)
+    {
+      const int numComps = this->ScaleArray->GetNumberOfComponents();
+      if (numComps == 1)
+      {
+        scale[0] = scale[1] = scale[2] = this->ScaleArray->GetComponent(ptId, 0);
+      }
+      else if (numComps == 2 || numComps == 3)
+      {
+        double vec[3] = { 0.0, 0.0, 0.0 };
+        this->ScaleArray->GetTuple(ptId, vec);
+        if (this->ScaleByMagnitude)
+        {
+          const double norm = numComps == 2 ? vtkMath::Norm2D(vec) : vtkMath::Norm(vec);
+          scale[0] = scale[1] = scale[2] = norm;
+        }
+        else
+        {
+          scale[0] = vec[0];
+          scale[1] = vec[1];
+          // leave scale[2] alone for 2D
+          if (numComps == 3)
+          {
+            scale[2] = vec[2];
+          }
+        }
+      }
+    }
+    for (int c = 0; c < 3; ++c)
+    {
+      scale[c] *= this->ScaleFactor;
+      if (scale[c] == 0.0)
+      {
+        scale[c] = 1.0e-10;
+      }
+    }
+
+    double rotation[3][3] = { { 1.0, 0.0, 0.0 }, { 0.0, 1.0, 0.0 }, { 0.0, 0.0, 1.0 } };
+    if (this->OrientArray)
+    {
+      double v[3] = { 0.0, 0.0, 0.0 };
+      this->OrientArray->GetTuple(ptId, v);
+      const double vMag = vtkMath::Norm(v);
+      if (vMag > 0.0)
+      {
+        // if there is no y or z component
+        if (v[1] == 0.0 && v[2] == 0.0)
+        {
+          if (v[0] < 0) // just flip x if we need to
+          {
+            ::RotationMatrix(180.0, 0, 1, 0, rotation);
+          }
+        }
+        else
+        {
+          ::RotationMatrix(180.0, (v[0] + vMag) / 2.0, v[1] / 2.0, v[2] / 2.0, rotation);
+        }
+      }
+    }
+
+    double x[3];
+    this->Input->GetPoint(ptId, x);
+    for (int r = 0; r < 3; ++r)
+    {
+      for (int c = 0; c < 3; ++c)
+      {
+        linear[3 * r + c][g] = rotation[r][c] * scale[c];
+        normal[3 * r + c][g] = rotation[r][c] / scale[c];
+      }
+      translation[r][g] = x[r];
+    }
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    double linear[9][GlyphBlockSize];
+    double translation[3][GlyphBlockSize];
+    double normal[9][GlyphBlockSize];
+    const vtkIdType numSourcePts = this->NumberOfSourcePoints;
+    const vtkIdType glyphStride = 3 * numSourcePts;
+    for (vtkIdType blockBegin = begin; blockBegin < end; blockBegin += GlyphBlockSize)
+    {
+      const int count = static_cast<int>(std::min<vtkIdType>(GlyphBlockSize, end - blockBegin));
+      for (int g = 0; g < count; ++g)
+      {
+        this->ComputeTransform(this->GlyphedIds[blockBegin + g], g, linear, translation, normal);
+      }
+
+      for (vtkIdType i = 0; i < numSourcePts; ++i)
+      {
+        const double* p = this->SourcePoints + 3 * i;
+        PointT* out = this->Points + 3 * (blockBegin * numSourcePts + i);
+        for (int g = 0; g < count; ++g)
+        {
+          PointT* y = out + g * glyphStride;
+          for (int r = 0; r < 3; ++r)
+          {
+            y[r] = static_cast<PointT>(linear[3 * r][g] * p[0] + linear[3 * r + 1][g] * p[1] +
+              linear[3 * r + 2][g] * p[2] + translation[r][g]);
+          }
+        }
+        if (this->Normals)
+        {
+          const double* n = this->SourceNormals + 3 * i;
+          float* outNormal = this->Normals + 3 * (blockBegin * numSourcePts + i);
+          for (int g = 0; g < count; ++g)
+          {
+            float* y = outNormal + g * glyphStride;
+            for (int r = 0; r < 3; ++r)
+            {
+              y[r] = static_cast<float>(normal[3 * r][g] * n[0] + normal[3 * r + 1][g] * n[1] +
+                normal[3 * r + 2][g] * n[2]);
+            }
+            vtkMath::Normalize(y);
+          }
+        }
+      }
+    }
+  }
+};
+
+//-----------------------------------------------------------------------------
+// Copy every tuple of the input array `copies` times, consecutively.
+struct vtkPVGlyphReplicateTuples
+{
+  template <typename InArrayT, typename OutArrayT>
+  void operator()(InArrayT* inArray, OutArrayT* outArray, vtkIdType copies)
+  {
+    vtkSMPTools::For(0, inArray->GetNumberOfTuples(), [&](vtkIdType begin, vtkIdType end) {
+      const auto inTuples = vtk::DataArrayTupleRange(inArray);
+      auto outTuples = vtk::DataArrayTupleRange(outArray);
+      for (vtkIdType tuple = begin; tuple < end; ++tuple)
+      {
+        const auto inTuple = inTuples[tuple];
+        for (vtkIdType c = 0; c < copies; ++c)
+        {
+          outTuples[tuple * copies + c] = inTuple;
+        }
+      }
+    });
+  }
+};
+
+//-----------------------------------------------------------------------------
+// Cells of `cells` repeated for every glyph, with point ids shifted by the
+// number of points of a glyph.
+vtkSmartPointer<vtkCellArray> ReplicateCells(
+  vtkCellArray* cells, vtkIdType numGlyphs, vtkIdType numSourcePts)
+{
+  const vtkIdType numCells = cells->GetNumberOfCells();
+  std::vector<vtkIdType> offsets;
+  std::vector<vtkIdType> connectivity;
+  offsets.reserve(numCells + 1);
+  connectivity.reserve(cells->GetNumberOfConnectivityIds());
+  vtkNew<vtkIdList> cellPointIds;
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    vtkIdType npts;
+    const vtkIdType* pts;
+    cells->GetCellAtId(cellId, npts, pts, cellPointIds);
+    offsets.push_back(static_cast<vtkIdType>(connectivity.size()));
+    connectivity.insert(connectivity.end(), pts, pts + npts);
+  }
+  const vtkIdType connectivitySize = static_cast<vtkIdType>(connectivity.size());
+
+  vtkNew<vtkIdTypeArray> outOffsets;
+  outOffsets->SetNumberOfValues(numGlyphs * numCells + 1);
+  vtkNew<vtkIdTypeArray> outConnectivity;
+  outConnectivity->SetNumberOfValues(numGlyphs * connectivitySize);
+  vtkIdType* outOffsetsPtr = outOffsets->GetPointer(0);
+  vtkIdType* outConnectivityPtr = outConnectivity->GetPointer(0);
+  vtkSMPTools::For(0, numGlyphs, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType g = begin; g < end; ++g)
+    {
+      for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+      {
+        outOffsetsPtr[g * numCells + cellId] = g * connectivitySize + offsets[cellId];
+      }
+      for (vtkIdType i = 0; i < connectivitySize; ++i)
+      {
+        outConnectivityPtr[g * connectivitySize + i] = connectivity[i] + g * numSourcePts;
+      }
+    }
+  });
+  outOffsetsPtr[numGlyphs * numCells] = numGlyphs * connectivitySize;
+
+  auto result = vtkSmartPointer<vtkCellArray>::New();
+  result->SetData(outOffsets, outConnectivity);
+  return result;
+}
+}
+
 vtkStandardNewMacro(vtkPVGlyphFilter);
 vtkCxxSetObjectMacro(vtkPVGlyphFilter, Controller, vtkMultiProcessController);
 vtkCxxSetObjectMacro(vtkPVGlyphFilter, SourceTransform, vtkTransform);
@@ -830,9 +1095,6 @@ bool vtkPVGlyphFilter::Execute(unsigned int index, vtkDataSet* input,
 
   vtkDebugMacro(<< "Generating glyphs");
 
-  auto pts = vtkSmartPointer<vtkIdList>::New();
-  pts->Allocate(VTK_CELL_SIZE);
-
   unsigned char* inGhostLevels = nullptr;
   vtkDataArray* temp = nullptr;
   auto pd = input->GetPointData();
@@ -875,24 +1137,70 @@ bool vtkPVGlyphFilter::Execute(unsigned int index, vtkDataSet* input,
 
   auto sourcePts = source->GetPoints();
   vtkIdType numSourcePts = sourcePts->GetNumberOfPoints();
-  vtkIdType numSourceCells = source->GetNumberOfCells();
 
   vtkDataArray* sourceNormals = source->GetPointData()->GetNormals();
 
-  // Allocate storage for output point data
-  vtkPointData* outputPD = output->GetPointData();
-  outputPD->CopyNormalsOff();
+  // Select the points to glyph. IsPointVisible() expects the point ids of a
+  // dataset in increasing order, so this pass is serial.
+  std::vector<vtkIdType> glyphedIds;
+  vtkUniformGrid* inputUG = vtkUniformGrid::SafeDownCast(input);
+  for (vtkIdType inPtId = 0; inPtId < numPts; inPtId++)
+  {
+    if (!(inPtId % 10000))
+    {
+      this->UpdateProgress(0.5 * inPtId / numPts);
+      if (this->GetAbortExecute())
+      {
+        break;
+      }
+    }
 
-  outputPD->CopyAllocate(pd, numPts * numSourcePts);
+    // Check ghost points.
+    // If we are processing a piece, we do not want to duplicate
+    // glyphs on the borders.
+    if (inGhostLevels && inGhostLevels[inPtId] & vtkDataSetAttributes::DUPLICATEPOINT)
+    {
+      continue;
+    }
 
-  vtkNew<vtkIdList> srcPointIdList;
-  srcPointIdList->SetNumberOfIds(numSourcePts);
-  vtkNew<vtkIdList> dstPointIdList;
-  dstPointIdList->SetNumberOfIds(numSourcePts);
-  vtkNew<vtkIdList> srcCellIdList;
-  srcCellIdList->SetNumberOfIds(numSourceCells);
-  vtkNew<vtkIdList> dstCellIdList;
-  dstCellIdList->SetNumberOfIds(numSourceCells);
+    // this is used to respect blanking specified on uniform grids.
+    if (inputUG && !inputUG->IsPointVisible(inPtId))
+    {
+      // input is a vtkUniformGrid and the current point is blanked. Don't glyph
+      // it.
+      continue;
+    }
+
+    if (!this->IsPointVisible(index, input, inPtId, cellCenters))
+    {
+      continue;
+    }
+    glyphedIds.push_back(inPtId);
+  }
+  const vtkIdType numGlyphs = static_cast<vtkIdType>(glyphedIds.size());
+  const vtkIdType numNewPts = numGlyphs * numSourcePts;
+
+  // Source points, transformed by SourceTransform, and normals in double
+  // precision.
+  std::vector<double> sourceCoords(3 * numSourcePts);
+  std::vector<double> sourceNormalCoords(sourceNormals ? 3 * numSourcePts : 0);
+  for (vtkIdType i = 0; i < numSourcePts; ++i)
+  {
+    double p[3];
+    sourcePts->GetPoint(i, p);
+    if (this->SourceTransform)
+    {
+      this->SourceTransform->TransformPoint(p, &sourceCoords[3 * i]);
+    }
+    else
+    {
+      std::copy(p, p + 3, &sourceCoords[3 * i]);
+    }
+    if (sourceNormals)
+    {
+      sourceNormals->GetTuple(i, &sourceNormalCoords[3 * i]);
+    }
+  }
 
   auto newPts = vtkSmartPointer<vtkPoints>::New();
 
@@ -909,203 +1217,120 @@ bool vtkPVGlyphFilter::Execute(unsigned int index, vtkDataSet* input,
   {
     newPts->SetDataType(VTK_DOUBLE);
   }
-
-  newPts->Allocate(numPts * numSourcePts);
+  newPts->SetNumberOfPoints(numNewPts);
 
   vtkSmartPointer<vtkFloatArray> newNormals;
   if (sourceNormals)
   {
     newNormals.TakeReference(vtkFloatArray::New());
     newNormals->SetNumberOfComponents(3);
-    newNormals->Allocate(3 * numPts * numSourcePts);
+    newNormals->SetNumberOfTuples(numNewPts);
     newNormals->SetName("Normals");
   }
 
-  // Setting up for calls to PolyData::InsertNextCell()
-  output->Allocate(source, 3 * numPts * numSourceCells, numPts * numSourceCells);
-
-  vtkSmartPointer<vtkPoints> transformedSourcePts = vtkSmartPointer<vtkPoints>::New();
-  transformedSourcePts->SetDataTypeToDouble();
-  transformedSourcePts->Allocate(numSourcePts);
-
-  // Traverse all Input points, transforming Source points and copying
-  // point attributes.
-  auto trans = vtkSmartPointer<vtkTransform>::New();
-  vtkNew<vtkIdList> pointIdList;
-  vtkIdType ptIncr = 0;
-  vtkIdType cellIncr = 0;
-  for (vtkIdType inPtId = 0; inPtId < numPts; inPtId++)
+  // Instantiate the glyphs in parallel, writing directly in the output arrays.
+  if (numGlyphs > 0)
   {
-    double scalex(1.0), scaley(1.0), scalez(1.0);
-    if (!(inPtId % 10000))
-    {
-      this->UpdateProgress(static_cast<double>(inPtId) / numPts);
-      if (this->GetAbortExecute())
-      {
-        break;
-      }
-    }
+    // vtkDataSet::GetPoint() is thread safe once it was called from a single thread.
+    double x[3];
+    input->GetPoint(glyphedIds[0], x);
 
-    // Get the scalar and vector data
-    if (scaleArray)
+    float* normalsPtr = newNormals ? newNormals->GetPointer(0) : nullptr;
+    if (newPts->GetDataType() == VTK_DOUBLE)
     {
-      if (scaleArray->GetNumberOfComponents() == 1)
-      {
-        scalex = scaley = scalez = scaleArray->GetComponent(inPtId, 0);
-      }
-      else
-      {
-        // Consider the vector scaling mode
-        if (scaleArray->GetNumberOfComponents() == 2)
-        {
-          double* vec2 = scaleArray->GetTuple(inPtId);
-          if (this->VectorScaleMode == SCALE_BY_MAGNITUDE)
-          {
-            scalex = scaley = scalez = vtkMath::Norm2D(vec2);
-          }
-          else if (this->VectorScaleMode == SCALE_BY_COMPONENTS)
-          {
-            scalex = vec2[0];
-            scaley = vec2[1];
-            // leave scalez alone for 2D
-          }
-        }
-        else if (scaleArray->GetNumberOfComponents() == 3)
-        {
-          double* vec3 = scaleArray->GetTuple(inPtId);
-          if (this->VectorScaleMode == SCALE_BY_MAGNITUDE)
-          {
-            scalex = scaley = scalez = vtkMath::Norm(vec3);
-          }
-          else
-          {
-            scalex = vec3[0];
-            scaley = vec3[1];
-            scalez = vec3[2];
-          }
-        }
-      }
+      vtkPVGlyphGenerator<double> generator{ input, glyphedIds.data(), scaleArray, orientArray,
+        this->VectorScaleMode == SCALE_BY_MAGNITUDE, this->ScaleFactor, sourceCoords.data(),
+        sourceNormalCoords.data(), numSourcePts,
+        static_cast<double*>(newPts->GetData()->GetVoidPointer(0)), normalsPtr };
+      vtkSMPTools::For(0, numGlyphs, generator);
     }
-
-    // Apply scale factor
-    scalex *= this->ScaleFactor;
-    scaley *= this->ScaleFactor;
-    scalez *= this->ScaleFactor;
-
-    // Check ghost points.
-    // If we are processing a piece, we do not want to duplicate
-    // glyphs on the borders.
-    if (inGhostLevels && inGhostLevels[inPtId] & vtkDataSetAttributes::DUPLICATEPOINT)
+    else
     {
-      continue;
+      vtkPVGlyphGenerator<float> generator{ input, glyphedIds.data(), scaleArray, orientArray,
+        this->VectorScaleMode == SCALE_BY_MAGNITUDE, this->ScaleFactor, sourceCoords.data(),
+        sourceNormalCoords.data(), numSourcePts,
+        static_cast<float*>(newPts->GetData()->GetVoidPointer(0)), normalsPtr };
+      vtkSMPTools::For(0, numGlyphs, generator);
     }
+  }
+  this->UpdateProgress(0.75);
 
-    // this is used to respect blanking specified on uniform grids.
-    vtkUniformGrid* inputUG = vtkUniformGrid::SafeDownCast(input);
-    if (inputUG && !inputUG->IsPointVisible(inPtId))
-    {
-      // input is a vtkUniformGrid and the current point is blanked. Don't glyph
-      // it.
-      continue;
-    }
+  // Topology is the topology of the source repeated for every glyph.
+  if (source->GetNumberOfVerts() > 0)
+  {
+    output->SetVerts(::ReplicateCells(source->GetVerts(), numGlyphs, numSourcePts));
+  }
+  if (source->GetNumberOfLines() > 0)
+  {
+    output->SetLines(::ReplicateCells(source->GetLines(), numGlyphs, numSourcePts));
+  }
+  if (source->GetNumberOfPolys() > 0)
+  {
+    output->SetPolys(::ReplicateCells(source->GetPolys(), numGlyphs, numSourcePts));
+  }
+  if (source->GetNumberOfStrips() > 0)
+  {
+    output->SetStrips(::ReplicateCells(source->GetStrips(), numGlyphs, numSourcePts));
+  }
 
-    if (!this->IsPointVisible(index, input, inPtId, cellCenters))
+  // Point data: gather the attributes of the glyphed points once, then repeat
+  // them for every point of their glyph.
+  vtkPointData* outputPD = output->GetPointData();
+  if (pd)
+  {
+    vtkNew<vtkPointData> glyphPD;
+    glyphPD->CopyNormalsOff();
+    glyphPD->CopyAllocate(pd, numGlyphs);
+    vtkNew<vtkIdList> fromIds;
+    fromIds->SetNumberOfIds(numGlyphs);
+    vtkNew<vtkIdList> toIds;
+    toIds->SetNumberOfIds(numGlyphs);
+    for (vtkIdType g = 0; g < numGlyphs; ++g)
     {
-      continue;
+      fromIds->SetId(g, glyphedIds[g]);
+      toIds->SetId(g, g);
     }
+    glyphPD->CopyData(pd, fromIds, toIds);
 
-    // Now begin copying/transforming glyph
-    trans->Identity();
-
-    // Copy all topology (transformation independent)
-    for (vtkIdType cellId = 0; cellId < numSourceCells; cellId++)
+    for (int i = 0; i < glyphPD->GetNumberOfArrays(); ++i)
     {
-      source->GetCellPoints(cellId, pointIdList);
-      int npts = pointIdList->GetNumberOfIds();
-      pts->Reset();
-      for (vtkIdType i = 0; i < npts; i++)
+      vtkAbstractArray* inArray = glyphPD->GetAbstractArray(i);
+      auto outArray = vtk::TakeSmartPointer(inArray->NewInstance());
+      outArray->SetName(inArray->GetName());
+      outArray->SetNumberOfComponents(inArray->GetNumberOfComponents());
+      outArray->CopyComponentNames(inArray);
+      if (inArray->HasInformation())
       {
-        pts->InsertId(i, pointIdList->GetId(i) + ptIncr);
+        outArray->CopyInformation(inArray->GetInformation(), /*deep=*/1);
       }
-      output->InsertNextCell(source->GetCellType(cellId), pts);
-    }
-
-    // translate Source to Input point
-    double x[3];
-    input->GetPoint(inPtId, x);
-    trans->Translate(x[0], x[1], x[2]);
-
-    if (orientArray)
-    {
-      double v[3] = { 0.0 };
-      orientArray->GetTuple(inPtId, v);
-      double vMag = vtkMath::Norm(v);
-      if (vMag > 0.0)
+      outArray->SetNumberOfTuples(numNewPts);
+
+      vtkDataArray* inData = vtkDataArray::SafeDownCast(inArray);
+      vtkDataArray* outData = vtkDataArray::SafeDownCast(outArray);
+      vtkPVGlyphReplicateTuples replicate;
+      if (!inData || !outData ||
+        !vtkArrayDispatch::Dispatch2SameValueType::Execute(
+          inData, outData, replicate, numSourcePts))
       {
-        // if there is no y or z component
-        if (v[1] == 0.0 && v[2] == 0.0)
+        for (vtkIdType g = 0; g < numGlyphs; ++g)
         {
-          if (v[0] < 0) // just flip x if we need to
+          for (vtkIdType j = 0; j < numSourcePts; ++j)
           {
-            trans->RotateWXYZ(180.0, 0, 1, 0);
+            outArray->SetTuple(g * numSourcePts + j, g, inArray);
           }
         }
-        else
-        {
-          double vNew[3];
-          vNew[0] = (v[0] + vMag) / 2.0;
-          vNew[1] = v[1] / 2.0;
-          vNew[2] = v[2] / 2.0;
-          trans->RotateWXYZ(180.0, vNew[0], vNew[1], vNew[2]);
-        }
       }
-    }
-
-    // scale data if appropriate
-    if (scalex == 0.0)
-    {
-      scalex = 1.0e-10;
-    }
-    if (scaley == 0.0)
-    {
-      scaley = 1.0e-10;
-    }
-    if (scalez == 0.0)
-    {
-      scalez = 1.0e-10;
-    }
-    trans->Scale(scalex, scaley, scalez);
-
-    // multiply points and normals by resulting matrix
-    if (this->SourceTransform)
-    {
-      transformedSourcePts->Reset();
-      this->SourceTransform->TransformPoints(sourcePts, transformedSourcePts);
-      trans->TransformPoints(transformedSourcePts, newPts);
-    }
-    else
-    {
-      trans->TransformPoints(sourcePts, newPts);
-    }
-
-    if (newNormals.GetPointer())
-    {
-      trans->TransformNormals(sourceNormals, newNormals);
-    }
 
-    // Copy point data from source (if possible)
-    if (pd)
-    {
-      for (vtkIdType i = 0; i < numSourcePts; ++i)
+      const int outIndex = outputPD->AddArray(outArray);
+      for (int attributeType = 0; attributeType < vtkDataSetAttributes::NUM_ATTRIBUTES;
+           ++attributeType)
       {
-        srcPointIdList->SetId(i, inPtId);
-        dstPointIdList->SetId(i, ptIncr + i);
+        if (glyphPD->GetAbstractAttribute(attributeType) == inArray)
+        {
+          outputPD->SetActiveAttribute(outIndex, attributeType);
+        }
       }
-      outputPD->CopyData(pd, srcPointIdList, dstPointIdList);
     }
-
-    ptIncr += numSourcePts;
-    cellIncr += numSourceCells;
   }
 
   if (newNormals.GetPointer())
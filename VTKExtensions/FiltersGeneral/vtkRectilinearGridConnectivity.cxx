@@ -2258,6 +2258,7 @@ void vtkRectilinearGridConnectivity::AddPolygonsToFaceHash(int blockIdx, vtkPoly
   int* numComps = nullptr;    // number of integrated components
   double* tupleBuf = nullptr; // integrated component values
   double** attrPtrs = nullptr;
+  std::vector<int> equivalences; // pairs of equivalent fragment Ids
   vtkCell* thisFace = nullptr;   // a 2D polygon (instead of a 3D cell)
   vtkIdType numFaces = 0;        // number of 2D polygons in a vtkPolyData
   vtkIdType volIndex = 0;        // global volume Id attached to a 2D polygon
@@ -2382,7 +2383,8 @@ void vtkRectilinearGridConnectivity::AddPolygonsToFaceHash(int blockIdx, vtkPoly
             // this volume (R) is connected with two currently un-merged volumes
             // S and T. Thus we need to make the fragment Ids of volumes S and T
             // equivalent to each other.
-            this->EquivalenceSet->AddEquivalence(minIndex, hashFace->FragmentId);
+            equivalences.push_back(minIndex);
+            equivalences.push_back(hashFace->FragmentId);
           }
 
           // keep track of the smallest fragment id to use for this volume
@@ -2434,12 +2436,14 @@ void vtkRectilinearGridConnectivity::AddPolygonsToFaceHash(int blockIdx, vtkPoly
       // since no any neighboring volume has been found (otherwise minIndex
       // would have been updated to be less than fragIndx in case A above).
       // The code below ensures the correct number of equivalence members.
-      this->EquivalenceSet->AddEquivalence(fragIndx, fragIndx);
+      equivalences.push_back(fragIndx);
+      equivalences.push_back(fragIndx);
       fragIndx++;
     }
 
-    // update the smallest fragment Id used so far
-    minIndex = this->EquivalenceSet->GetEquivalentSetId(minIndex);
+    // The equivalences are added in a batch once all the faces are hashed,
+    // so minIndex may not be the root of its set yet. The face ids and the
+    // integrated attributes are resolved to the roots afterwards.
 
     // Label the new faces of the volume with the final (smallest) fragment id.
     for (int k = 0; k < newIndex; k++)
@@ -2456,6 +2460,13 @@ void vtkRectilinearGridConnectivity::AddPolygonsToFaceHash(int blockIdx, vtkPoly
   {
     attrPtrs[i] = nullptr;
   }
+  // union the fragments found connected above in a single (parallel) pass
+  if (!equivalences.empty())
+  {
+    this->EquivalenceSet->AddEquivalences(
+      equivalences.data(), static_cast<vtkIdType>(equivalences.size() / 2));
+  }
+
   delete[] attrPtrs;
   delete[] numComps;
   delete[] tupleBuf;
@@ -2902,6 +2913,7 @@ void vtkRectilinearGridConnectivity::AddPolygonsToFaceHash(
   int* numComps = nullptr;    // number of integrated components
   double* tupleBuf = nullptr; // integrated component values
   double** attrPtrs = nullptr;
+  std::vector<int> equivalences; // pairs of equivalent fragment Ids
   vtkCell* thisFace = nullptr;   // a 2D polygon (not a 3D cell)
   vtkIdType numFaces = 0;        // number of 2D polygons of an input vtkPolyData
   vtkIdType localFId = 0;        // Id of the local fragment being processed
@@ -3075,7 +3087,8 @@ void vtkRectilinearGridConnectivity::AddPolygonsToFaceHash(
               // 'macro' volume (R) is connected with two currently un-merged 'macro'
               // volumes S and T. Thus we need to make the fragment Ids of 'macro'
               // volumes S and T equivalent to each other.
-              this->EquivalenceSet->AddEquivalence(minIndex, hashFace->FragmentId);
+              equivalences.push_back(minIndex);
+              equivalences.push_back(hashFace->FragmentId);
             }
 
             // keep track of the smallest fragment id to use for this 'macro' volume
@@ -3122,12 +3135,14 @@ void vtkRectilinearGridConnectivity::AddPolygonsToFaceHash(
         // (otherwise minIndex would have been updated to be less than fragIndx
         // in case A above). The code below ensures the correct number of
         // equivalence members.
-        this->EquivalenceSet->AddEquivalence(fragIndx, fragIndx);
+        equivalences.push_back(fragIndx);
+        equivalences.push_back(fragIndx);
         fragIndx++;
       }
 
-      // update the smallest fragment Id used so far
-      minIndex = this->EquivalenceSet->GetEquivalentSetId(minIndex);
+      // The equivalences are added in a batch once all the faces are hashed,
+      // so minIndex may not be the root of its set yet. The face ids and the
+      // integrated attributes are resolved to the roots afterwards.
 
       // Label the new faces of the 'macro' volume with the final (smallest)
       // fragment id.
@@ -3157,6 +3172,13 @@ void vtkRectilinearGridConnectivity::AddPolygonsToFaceHash(
     lfIdsPtr = nullptr;
   } // for each input vtkPolyData
 
+  // union the fragments found connected above in a single (parallel) pass
+  if (!equivalences.empty())
+  {
+    this->EquivalenceSet->AddEquivalences(
+      equivalences.data(), static_cast<vtkIdType>(equivalences.size() / 2));
+  }
+
   delete[] attrPtrs;
   delete[] numComps;
   delete[] tupleBuf;
@@ -3574,6 +3596,7 @@ void vtkRectilinearGridConnectivity::AddInterProcessPolygonsToFaceHash(
   int* numComps = nullptr;    // number of integrated components
   double* tupleBuf = nullptr; // integrated component values
   double** attrPtrs = nullptr;
+  std::vector<int> equivalences; // pairs of equivalent fragment Ids
   vtkCell* thisFace = nullptr;   // a 2D polygon (not a 3D cell)
   vtkIdType numFaces = 0;        // number of 2D polygons of an input vtkPolyData
   vtkIdType procFIdx = 0;        // Id of the local fragment being processed
@@ -3749,7 +3772,8 @@ void vtkRectilinearGridConnectivity::AddInterProcessPolygonsToFaceHash(
               // 'macro' volume (R) is connected with two currently un-merged 'macro'
               // volumes S and T. Thus we need to make the fragment Ids of 'macro'
               // volumes S and T equivalent to each other.
-              this->EquivalenceSet->AddEquivalence(minIndex, hashFace->FragmentId);
+              equivalences.push_back(minIndex);
+              equivalences.push_back(hashFace->FragmentId);
             }
 
             // keep track of the smallest fragment id to use for this 'macro' volume
@@ -3795,12 +3819,14 @@ void vtkRectilinearGridConnectivity::AddInterProcessPolygonsToFaceHash(
         // (otherwise minIndex would have been updated to be less than fragIndx
         // in case A above). The code below ensures the correct number of
         // equivalence members.
-        this->EquivalenceSet->AddEquivalence(fragIndx, fragIndx);
+        equivalences.push_back(fragIndx);
+        equivalences.push_back(fragIndx);
         fragIndx++;
       }
 
-      // update the smallest fragment Id used so far
-      minIndex = this->EquivalenceSet->GetEquivalentSetId(minIndex);
+      // The equivalences are added in a batch once all the faces are hashed,
+      // so minIndex may not be the root of its set yet. The face ids and the
+      // integrated attributes are resolved to the roots afterwards.
 
       // Label the new faces of the 'macro' volume with the final (smallest)
       // fragment id.
@@ -3830,6 +3856,13 @@ void vtkRectilinearGridConnectivity::AddInterProcessPolygonsToFaceHash(
     fIdxsPtr = nullptr;
   } // for each input vtkPolyData
 
+  // union the fragments found connected above in a single (parallel) pass
+  if (!equivalences.empty())
+  {
+    this->EquivalenceSet->AddEquivalences(
+      equivalences.data(), static_cast<vtkIdType>(equivalences.size() / 2));
+  }
+
   delete[] attrPtrs;
   delete[] numComps;
   delete[] tupleBuf;
@@ -0,0 +1,198 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef MaterialInterfaceTestHelpers_h
+#define MaterialInterfaceTestHelpers_h
+
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkNonOverlappingAMR.h"
+#include "vtkSmartPointer.h"
+#include "vtkUniformGrid.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace MaterialInterfaceTestHelpers
+{
+constexpr int BlockSize = 8;
+constexpr int BlocksPerAxis = 3;
+constexpr int NumberOfBlocks = BlocksPerAxis * BlocksPerAxis * BlocksPerAxis;
+constexpr int NumberOfCells = BlockSize * BlocksPerAxis;
+
+using Voxel = std::array<int, 3>;
+
+// Fragments made of face connected voxels, none touching another. Several
+// cross block boundaries, and the U shaped one meets itself only at its base.
+inline std::vector<std::vector<Voxel>> CreateFragments()
+{
+  std::vector<std::vector<Voxel>> fragments(5);
+  // a bar along x through three blocks.
+  for (int i = 1; i <= 20; ++i)
+  {
+    fragments[0].push_back({ i, 2, 2 });
+  }
+  // a cube inside a single block.
+  for (int k = 10; k <= 11; ++k)
+  {
+    for (int j = 10; j <= 11; ++j)
+    {
+      for (int i = 4; i <= 5; ++i)
+      {
+        fragments[1].push_back({ i, j, k });
+      }
+    }
+  }
+  // a U over four blocks.
+  for (int j = 14; j <= 20; ++j)
+  {
+    fragments[2].push_back({ 14, j, 5 });
+    fragments[2].push_back({ 18, j, 5 });
+  }
+  for (int i = 15; i <= 17; ++i)
+  {
+    fragments[2].push_back({ i, 20, 5 });
+  }
+  // a single voxel.
+  fragments[3].push_back({ 22, 22, 22 });
+  // an L along z over two blocks.
+  for (int k = 12; k <= 19; ++k)
+  {
+    fragments[4].push_back({ 10, 5, k });
+  }
+  fragments[4].push_back({ 11, 5, 19 });
+  fragments[4].push_back({ 12, 5, 19 });
+  return fragments;
+}
+
+inline int GetBlockId(const Voxel& voxel)
+{
+  return voxel[0] / BlockSize +
+    BlocksPerAxis * (voxel[1] / BlockSize + BlocksPerAxis * (voxel[2] / BlockSize));
+}
+
+// The process that owns a block when the blocks are dealt round robin.
+inline int GetBlockOwner(int blockId, int numProcs)
+{
+  return blockId % numProcs;
+}
+
+// A single level of 3x3x3 blocks without ghost cells with a volume fraction
+// of 1 in the fragments and 0 elsewhere. Only the blocks owned by `rank` are
+// set.
+inline vtkSmartPointer<vtkNonOverlappingAMR> CreateAMR(
+  const std::vector<std::vector<Voxel>>& fragments, int rank = 0, int numProcs = 1)
+{
+  std::vector<unsigned char> fractions(NumberOfCells * NumberOfCells * NumberOfCells, 0);
+  for (const auto& fragment : fragments)
+  {
+    for (const Voxel& voxel : fragment)
+    {
+      fractions[voxel[0] + NumberOfCells * (voxel[1] + NumberOfCells * voxel[2])] = 255;
+    }
+  }
+
+  auto amr = vtkSmartPointer<vtkNonOverlappingAMR>::New();
+  amr->Initialize(1, &NumberOfBlocks);
+  for (int blockId = 0; blockId < NumberOfBlocks; ++blockId)
+  {
+    if (GetBlockOwner(blockId, numProcs) != rank)
+    {
+      continue;
+    }
+    const int ijk[3] = { blockId % BlocksPerAxis, (blockId / BlocksPerAxis) % BlocksPerAxis,
+      blockId / (BlocksPerAxis * BlocksPerAxis) };
+    vtkNew<vtkUniformGrid> grid;
+    grid->SetOrigin(ijk[0] * BlockSize, ijk[1] * BlockSize, ijk[2] * BlockSize);
+    grid->SetSpacing(1, 1, 1);
+    grid->SetDimensions(BlockSize + 1, BlockSize + 1, BlockSize + 1);
+
+    vtkNew<vtkUnsignedCharArray> fraction;
+    fraction->SetName("VolumeFraction");
+    fraction->SetNumberOfTuples(BlockSize * BlockSize * BlockSize);
+    vtkIdType cellId = 0;
+    for (int k = 0; k < BlockSize; ++k)
+    {
+      for (int j = 0; j < BlockSize; ++j)
+      {
+        for (int i = 0; i < BlockSize; ++i)
+        {
+          const int x = ijk[0] * BlockSize + i;
+          const int y = ijk[1] * BlockSize + j;
+          const int z = ijk[2] * BlockSize + k;
+          fraction->SetValue(cellId++, fractions[x + NumberOfCells * (y + NumberOfCells * z)]);
+        }
+      }
+    }
+    grid->GetCellData()->AddArray(fraction);
+    amr->SetDataSet(0, blockId, grid);
+  }
+  return amr;
+}
+
+// The volumes of the fragments, by resolved id. Each process numbers its
+// fragments in the order their first voxel is visited, its blocks in order
+// then voxels x fastest, after the fragments of the lower ranks. Ids of
+// fragments split in pieces are resolved to the smallest one, as when
+// process 0 gathered and resolved all the equivalences, so this order must
+// not depend on how the pieces were merged.
+inline std::vector<double> GetExpectedVolumes(
+  const std::vector<std::vector<Voxel>>& fragments, int numProcs = 1)
+{
+  std::vector<std::pair<std::array<int, 5>, double>> order;
+  for (const auto& fragment : fragments)
+  {
+    std::array<int, 5> first = { VTK_INT_MAX, 0, 0, 0, 0 };
+    for (const Voxel& voxel : fragment)
+    {
+      const int blockId = GetBlockId(voxel);
+      const std::array<int, 5> key = { GetBlockOwner(blockId, numProcs), blockId, voxel[2],
+        voxel[1], voxel[0] };
+      first = std::min(first, key);
+    }
+    order.emplace_back(first, static_cast<double>(fragment.size()));
+  }
+  std::sort(order.begin(), order.end());
+  std::vector<double> volumes;
+  for (const auto& item : order)
+  {
+    volumes.push_back(item.second);
+  }
+  return volumes;
+}
+
+// Checks that `volumes`, by fragment id, are the expected ones.
+inline bool CompareVolumes(
+  const std::vector<double>& expected, const std::map<int, double>& volumes, const char* what)
+{
+  bool success = volumes.size() == expected.size();
+  for (int id = 0; success && id < static_cast<int>(expected.size()); ++id)
+  {
+    auto iter = volumes.find(id);
+    success = iter != volumes.end() && std::abs(iter->second - expected[id]) < 1e-6;
+  }
+  if (!success)
+  {
+    vtkLogF(ERROR, "%s: unexpected fragments. Expected (id: volume):", what);
+    for (int id = 0; id < static_cast<int>(expected.size()); ++id)
+    {
+      vtkLogF(ERROR, "  %d: %g", id, expected[id]);
+    }
+    vtkLogF(ERROR, "Got:");
+    for (const auto& item : volumes)
+    {
+      vtkLogF(ERROR, "  %d: %g", item.first, item.second);
+    }
+  }
+  return success;
+}
+}
+
+#endif
@@ -0,0 +1,56 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "MaterialInterfaceTestHelpers.h"
+
+#include <vtkDummyController.h>
+#include <vtkFieldData.h>
+#include <vtkMaterialInterfaceFilter.h>
+#include <vtkMultiBlockDataSet.h>
+#include <vtkMultiPieceDataSet.h>
+#include <vtkPolyData.h>
+
+int TestMaterialInterfaceFragmentIds(int, char*[])
+{
+  vtkNew<vtkDummyController> controller;
+  vtkMultiProcessController::SetGlobalController(controller);
+
+  using namespace MaterialInterfaceTestHelpers;
+  const std::vector<std::vector<Voxel>> fragments = CreateFragments();
+
+  vtkNew<vtkMaterialInterfaceFilter> filter;
+  filter->SetInputData(CreateAMR(fragments));
+  filter->SelectMaterialArray("VolumeFraction");
+  filter->Update();
+
+  auto output = vtkMultiBlockDataSet::SafeDownCast(filter->GetOutputDataObject(0));
+  auto pieces = output ? vtkMultiPieceDataSet::SafeDownCast(output->GetBlock(0)) : nullptr;
+  if (!pieces)
+  {
+    vtkLogF(ERROR, "Missing fragments output.");
+    vtkMultiProcessController::SetGlobalController(nullptr);
+    return EXIT_FAILURE;
+  }
+
+  std::map<int, double> volumes;
+  for (unsigned int cc = 0; cc < pieces->GetNumberOfPieces(); ++cc)
+  {
+    auto fragment = vtkPolyData::SafeDownCast(pieces->GetPiece(cc));
+    if (!fragment)
+    {
+      continue;
+    }
+    vtkDataArray* ids = fragment->GetFieldData()->GetArray("Id");
+    vtkDataArray* volume = fragment->GetFieldData()->GetArray("Volume");
+    if (!ids || !volume)
+    {
+      vtkLogF(ERROR, "Missing Id or Volume arrays.");
+      vtkMultiProcessController::SetGlobalController(nullptr);
+      return EXIT_FAILURE;
+    }
+    volumes[static_cast<int>(ids->GetTuple1(0))] = volume->GetTuple1(0);
+  }
+
+  const bool success = CompareVolumes(GetExpectedVolumes(fragments), volumes, "Serial");
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
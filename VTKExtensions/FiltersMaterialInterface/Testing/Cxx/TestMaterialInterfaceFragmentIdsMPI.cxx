@@ -0,0 +1,94 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Checks that the fragments split across ranks, whose equivalences are merged
+// along a binary tree, get the ids and volumes that resolving all the
+// equivalences on rank 0 gave them.
+
+#include "MaterialInterfaceTestHelpers.h"
+
+#include "vtkFieldData.h"
+#include "vtkMPIController.h"
+#include "vtkMaterialInterfaceFilter.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkMultiPieceDataSet.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+
+int TestMaterialInterfaceFragmentIdsMPI(int argc, char* argv[])
+{
+  vtkNew<vtkMPIController> controller;
+  controller->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(controller);
+  const int rank = controller->GetLocalProcessId();
+  const int numProcs = controller->GetNumberOfProcesses();
+
+  using namespace MaterialInterfaceTestHelpers;
+  const std::vector<std::vector<Voxel>> fragments = CreateFragments();
+  const std::vector<double> expected = GetExpectedVolumes(fragments, numProcs);
+
+  vtkNew<vtkMaterialInterfaceFilter> filter;
+  filter->SetInputData(CreateAMR(fragments, rank, numProcs));
+  filter->SelectMaterialArray("VolumeFraction");
+  filter->Update();
+
+  bool success = true;
+  // the fragment attributes are gathered on rank 0.
+  if (rank == 0)
+  {
+    auto centers = vtkMultiBlockDataSet::SafeDownCast(filter->GetOutputDataObject(1));
+    auto points = centers ? vtkPolyData::SafeDownCast(centers->GetBlock(0)) : nullptr;
+    vtkDataArray* ids = points ? points->GetPointData()->GetArray("Id") : nullptr;
+    vtkDataArray* volume = points ? points->GetPointData()->GetArray("Volume") : nullptr;
+    if (!ids || !volume)
+    {
+      vtkLogF(ERROR, "Missing Id or Volume arrays of the fragment centers.");
+      success = false;
+    }
+    else
+    {
+      std::map<int, double> volumes;
+      for (vtkIdType cc = 0; cc < ids->GetNumberOfTuples(); ++cc)
+      {
+        volumes[static_cast<int>(ids->GetTuple1(cc))] = volume->GetTuple1(cc);
+      }
+      success = CompareVolumes(expected, volumes, "Fragment centers") && success;
+    }
+  }
+
+  // every fragment has geometry on some rank, under its resolved id.
+  const int numFragments = static_cast<int>(expected.size());
+  std::vector<int> localFound(numFragments + 1, 0);
+  auto output = vtkMultiBlockDataSet::SafeDownCast(filter->GetOutputDataObject(0));
+  auto pieces = output ? vtkMultiPieceDataSet::SafeDownCast(output->GetBlock(0)) : nullptr;
+  for (unsigned int cc = 0; pieces && cc < pieces->GetNumberOfPieces(); ++cc)
+  {
+    auto fragment = vtkPolyData::SafeDownCast(pieces->GetPiece(cc));
+    vtkDataArray* ids = fragment ? fragment->GetFieldData()->GetArray("Id") : nullptr;
+    if (ids)
+    {
+      // the last entry flags ids out of range or not matching the piece.
+      const int id = static_cast<int>(ids->GetTuple1(0));
+      const bool valid = id >= 0 && id < numFragments && id == static_cast<int>(cc);
+      localFound[valid ? id : numFragments] = 1;
+    }
+  }
+  std::vector<int> found(numFragments + 1, 0);
+  controller->AllReduce(
+    localFound.data(), found.data(), numFragments + 1, vtkCommunicator::MAX_OP);
+  for (int id = 0; id <= numFragments; ++id)
+  {
+    if ((id < numFragments) != (found[id] == 1))
+    {
+      vtkLogF(ERROR, "Fragment id %d is %s.", id, found[id] ? "unexpected" : "missing");
+      success = false;
+    }
+  }
+
+  int allSuccess = 0;
+  int localSuccess = success ? 1 : 0;
+  controller->AllReduce(&localSuccess, &allSuccess, 1, vtkCommunicator::LOGICAL_AND_OP);
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  controller->Finalize();
+  return allSuccess ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -42,7 +42,9 @@
 #include "vtkMaterialInterfaceProcessRing.h"
 #include "vtkMaterialInterfaceToProcMap.h"
 #include "vtkPointAccumulator.h"
+#include "vtkPVUnionFind.h"
 #include "vtkPointData.h"
+#include "vtkSMPTools.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnsignedIntArray.h"
 // IO & IPC
@@ -232,8 +234,11 @@ int GetEnabledArrayNames(vtkDataArraySelection* das, vector<string>& names)
 // A class that implements an equivalent set.  It is used to combine fragments
 // from different processes.
 //
-// I believe that this class is a strictly ordered tree of equivalences.
-// Every member points to its own id or an id smaller than itself.
+// Union-find over fragment ids (see vtkPVUnionFind.h).  Every root is the
+// smallest id of its set so resolved set ids are numbered by the smallest
+// member.  The parent array is what is
+// exchanged between processes; a parent array encodes all of the
+// equivalences that were added to it.
 class vtkMaterialInterfaceEquivalenceSet
 {
 public:
@@ -245,6 +250,18 @@ public:
   void Initialize();
   void AddEquivalence(int id1, int id2);
 
+  // Make sure ids [0, numberOfMembers) exist.  New members are only
+  // equivalent to themselves.
+  void Reserve(int numberOfMembers);
+
+  // Add the (unresolved) equivalences of another set, with its ids
+  // shifted by offset.  Members are processed in parallel.
+  void CopyEquivalences(vtkMaterialInterfaceEquivalenceSet* in, int offset);
+
+  // Add all the equivalences encoded in a parent array received from
+  // another process.
+  void MergeEquivalences(const int* parents, int numberOfMembers);
+
   // The length of the equivalent array...
   int GetNumberOfMembers() { return this->EquivalenceArray->GetNumberOfTuples(); }
 
@@ -273,11 +290,14 @@ public:
 private:
   // To merge connected framgments that have different ids because they were
   // traversed by different processes or passes.
+  // Before resolution this holds the union-find parents (parent <= id),
+  // after resolution the sequential set ids.
   vtkIntArray* EquivalenceArray;
 
-  // Return the id of the equivalent set.
-  int GetReference(int memberId);
-  void EquateInternal(int id1, int id2);
+  // Root of the set, compressing the path on the way.
+  int FindRoot(int memberId);
+  // Root of the set without modifying the array (safe for concurrent reads).
+  int FindRootConst(int memberId) const;
 };
 
 //----------------------------------------------------------------------------
@@ -328,27 +348,45 @@ void vtkMaterialInterfaceEquivalenceSet::Print()
 // Return the id of the equivalent set.
 int vtkMaterialInterfaceEquivalenceSet::GetEquivalentSetId(int memberId)
 {
-  int ref;
-
-  ref = this->GetReference(memberId);
-  while (!this->Resolved && ref != memberId)
+  if (memberId >= this->EquivalenceArray->GetNumberOfTuples())
+  { // We might consider this an error ...
+    return memberId;
+  }
+  if (this->Resolved)
   {
-    memberId = ref;
-    ref = this->GetReference(memberId);
+    return this->EquivalenceArray->GetValue(memberId);
   }
+  return this->FindRoot(memberId);
+}
 
-  return ref;
+//----------------------------------------------------------------------------
+int vtkMaterialInterfaceEquivalenceSet::FindRoot(int memberId)
+{
+  return vtkPVUnionFind::FindRoot(this->EquivalenceArray->GetPointer(0), memberId);
 }
 
 //----------------------------------------------------------------------------
-// Return the id of the equivalent set.
-int vtkMaterialInterfaceEquivalenceSet::GetReference(int memberId)
+int vtkMaterialInterfaceEquivalenceSet::FindRootConst(int memberId) const
 {
-  if (memberId >= this->EquivalenceArray->GetNumberOfTuples())
-  { // We might consider this an error ...
-    return memberId;
+  return vtkPVUnionFind::FindRootConst(this->EquivalenceArray->GetPointer(0), memberId);
+}
+
+//----------------------------------------------------------------------------
+void vtkMaterialInterfaceEquivalenceSet::Reserve(int numberOfMembers)
+{
+  int num = this->EquivalenceArray->GetNumberOfTuples();
+  if (num >= numberOfMembers)
+  {
+    return;
+  }
+  this->EquivalenceArray->Resize(numberOfMembers);
+  this->EquivalenceArray->SetNumberOfTuples(numberOfMembers);
+  int* parents = this->EquivalenceArray->GetPointer(0);
+  // All values inserted are equivalent to only themselves.
+  for (int ii = num; ii < numberOfMembers; ++ii)
+  {
+    parents[ii] = ii;
   }
-  return this->EquivalenceArray->GetValue(memberId);
 }
 
 //----------------------------------------------------------------------------
@@ -363,59 +401,56 @@ void vtkMaterialInterfaceEquivalenceSet::AddEquivalence(int id1, int id2)
     return;
   }
 
-  int num = this->EquivalenceArray->GetNumberOfTuples();
-
   // Expand the range to include both ids.
-  while (num <= id1 || num <= id2)
-  {
-    // All values inserted are equivalent to only themselves.
-    this->EquivalenceArray->InsertNextTuple1(num);
-    ++num;
-  }
+  this->Reserve((id1 > id2 ? id1 : id2) + 1);
 
-  // Our rule for references in the equivalent set is that
-  // all elements must point to a member equal to or smaller
-  // than itself.
-
-  // The only problem we could encounter is changing a reference.
-  // we do not want to orphan anything previously referenced.
+  // Union by minimum: the larger root is attached to the smaller one so
+  // every member points to a member equal to or smaller than itself.
+  vtkPVUnionFind::Union(this->EquivalenceArray->GetPointer(0), id1, id2);
+}
 
-  // Replace the larger references.
-  if (id1 < id2)
+//----------------------------------------------------------------------------
+void vtkMaterialInterfaceEquivalenceSet::CopyEquivalences(
+  vtkMaterialInterfaceEquivalenceSet* in, int offset)
+{
+  const int numIn = in->GetNumberOfMembers();
+  if (numIn == 0)
   {
-    // We could follow the references to the smallest.  It might
-    // make this processing more efficient.  This is a compromise.
-    // The referenced id will always be smaller than the id so
-    // order does not change.
-    this->EquateInternal(this->GetReference(id1), id2);
+    return;
   }
-  else
+  this->Reserve(numIn + offset);
+  int* parents = this->EquivalenceArray->GetPointer(0);
+  if (in->Resolved)
   {
-    this->EquateInternal(this->GetReference(id2), id1);
+    // Resolved ids do not describe a forest, fall back to unions.
+    for (int ii = 0; ii < numIn; ++ii)
+    {
+      this->AddEquivalence(ii + offset, in->GetEquivalentSetId(ii) + offset);
+    }
+    return;
   }
+
+  // The ids of the input are not in this set yet (they are only
+  // equivalent to themselves) so the roots of the input can be copied
+  // as is.  Roots are the smallest members, so the shifted roots keep
+  // the parent <= id invariant.
+  vtkSMPTools::For(0, numIn, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ii = begin; ii < end; ++ii)
+    {
+      parents[ii + offset] = in->FindRootConst(static_cast<int>(ii)) + offset;
+    }
+  });
 }
 
 //----------------------------------------------------------------------------
-// id1 must be less than or equal to id2.
-void vtkMaterialInterfaceEquivalenceSet::EquateInternal(int id1, int id2)
+void vtkMaterialInterfaceEquivalenceSet::MergeEquivalences(const int* parents, int numberOfMembers)
 {
-  // This is the reference that might be orphaned in this process.
-  int oldRef = this->GetEquivalentSetId(id2);
-
-  // The only problem we could encounter is changing a reference.
-  // we do not want to orphan anything previously referenced.
-  if (oldRef == id2 || oldRef == id1)
-  {
-    this->EquivalenceArray->SetValue(id2, id1);
-  }
-  else if (oldRef > id1)
+  for (int ii = 0; ii < numberOfMembers; ++ii)
   {
-    this->EquivalenceArray->SetValue(id2, id1);
-    this->EquateInternal(id1, oldRef);
-  }
-  else
-  { // oldRef < id1
-    this->EquateInternal(oldRef, id1);
+    if (parents[ii] != ii)
+    {
+      this->AddEquivalence(ii, parents[ii]);
+    }
   }
 }
 
@@ -452,6 +487,89 @@ int vtkMaterialInterfaceEquivalenceSet::ResolveEquivalences()
   return count;
 }
 
+//============================================================================
+// Inverse of the resolved equivalence set: for every resolved fragment, the
+// raw fragments (as process id, local index) that make it up, in increasing
+// global raw id order.  It lets the integrated attributes be accumulated
+// per resolved fragment in parallel.  Because the members are visited in
+// the same order as the serial accumulation, the sums are bitwise identical.
+class vtkMaterialInterfaceResolvedMembers
+{
+public:
+  void Build(vtkMaterialInterfaceEquivalenceSet* set, const int* numberOfRawFragmentsInProcess,
+    int numProcs, int numberOfResolvedFragments)
+  {
+    this->Offsets.assign(numberOfResolvedFragments + 1, 0);
+    int total = 0;
+    for (int procId = 0; procId < numProcs; ++procId)
+    {
+      total += numberOfRawFragmentsInProcess[procId];
+    }
+    for (int eqSetId = 0; eqSetId < total; ++eqSetId)
+    {
+      ++this->Offsets[set->GetEquivalentSetId(eqSetId) + 1];
+    }
+    for (int resId = 0; resId < numberOfResolvedFragments; ++resId)
+    {
+      this->Offsets[resId + 1] += this->Offsets[resId];
+    }
+    this->ProcIds.resize(total);
+    this->LocalIds.resize(total);
+    vector<int> next(this->Offsets.begin(), this->Offsets.end() - 1);
+    int eqSetId = 0;
+    for (int procId = 0; procId < numProcs; ++procId)
+    {
+      for (int i = 0; i < numberOfRawFragmentsInProcess[procId]; ++i, ++eqSetId)
+      {
+        int slot = next[set->GetEquivalentSetId(eqSetId)]++;
+        this->ProcIds[slot] = procId;
+        this->LocalIds[slot] = i;
+      }
+    }
+  }
+
+  // resolved[resId] += unresolved[member] (/ weight[resId] when given),
+  // for all the members of every resolved fragment.
+  void Accumulate(const vector<vtkDoubleArray*>& unresolved, vtkDoubleArray* resolved,
+    const double* weights = nullptr, int nCompsWt = 1) const
+  {
+    const int nComps = resolved->GetNumberOfComponents();
+    double* pResolved = resolved->GetPointer(0);
+    const vtkIdType numberOfResolvedFragments = static_cast<vtkIdType>(this->Offsets.size()) - 1;
+    vtkSMPTools::For(0, numberOfResolvedFragments, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType resId = begin; resId < end; ++resId)
+      {
+        double* dst = pResolved + nComps * resId;
+        for (int m = this->Offsets[resId]; m < this->Offsets[resId + 1]; ++m)
+        {
+          const double* src =
+            unresolved[this->ProcIds[m]]->GetPointer(0) + nComps * this->LocalIds[m];
+          if (weights)
+          {
+            const double wt = weights[nCompsWt * resId];
+            for (int q = 0; q < nComps; ++q)
+            {
+              dst[q] += src[q] / wt;
+            }
+          }
+          else
+          {
+            for (int q = 0; q < nComps; ++q)
+            {
+              dst[q] += src[q];
+            }
+          }
+        }
+      }
+    });
+  }
+
+private:
+  vector<int> Offsets;
+  vector<int> ProcIds;
+  vector<int> LocalIds;
+};
+
 //============================================================================
 // Helper object to clip hexahedra with implicit half sphere.
 class vtkMaterialInterfaceFilterHalfSphere
@@ -7951,152 +8069,63 @@ int vtkMaterialInterfaceFilter::ResolveIntegratedAttributes(const int controllin
 
     // prepare for resolution
     this->PrepareToResolveIntegratedAttributes();
+    // Each resolved fragment only receives contributions from its own
+    // raw fragments, so resolved fragments are accumulated in parallel.
+    vtkMaterialInterfaceResolvedMembers members;
+    members.Build(this->EquivalenceSet, this->NumberOfRawFragmentsInProcess, nProcs,
+      this->NumberOfResolvedFragments);
+
     // resolve attributes
     // First pass we'll resolve attributes which
     // are needed to resolve other attributes (eg weights)
-    int procBaseEqSetId = 0;
-    for (int procId = 0; procId < nProcs; ++procId)
+    // volume
+    members.Accumulate(volumes, this->FragmentVolumes);
+    // clip depth
+    if (this->ClipWithPlane)
     {
-      int eqSetId;
-      double* pResolved;
-      const double* pUnresolved;
-      int nUnresolved = this->NumberOfRawFragmentsInProcess[procId];
-
-      // volume
-      pUnresolved = volumes[procId]->GetPointer(0);
-      pResolved = this->FragmentVolumes->GetPointer(0);
-      eqSetId = procBaseEqSetId;
-      for (int i = 0; i < nUnresolved; ++i)
-      {
-        int resIdx = this->EquivalenceSet->GetEquivalentSetId(eqSetId);
-        pResolved[resIdx] += pUnresolved[0];
-        ++pUnresolved;
-        ++eqSetId;
-      }
-      // clip depth
-      if (this->ClipWithPlane)
-      {
-        pUnresolved = clipDepthMaxs[procId]->GetPointer(0);
-        pResolved = this->ClipDepthMaximums->GetPointer(0);
-        eqSetId = procBaseEqSetId;
-        for (int i = 0; i < nUnresolved; ++i)
-        {
-          int resIdx = this->EquivalenceSet->GetEquivalentSetId(eqSetId);
-          pResolved[resIdx] += pUnresolved[0];
-          ++pUnresolved;
-          ++eqSetId;
-        }
-        pUnresolved = clipDepthMins[procId]->GetPointer(0);
-        pResolved = this->ClipDepthMinimums->GetPointer(0);
-        eqSetId = procBaseEqSetId;
-        for (int i = 0; i < nUnresolved; ++i)
-        {
-          int resIdx = this->EquivalenceSet->GetEquivalentSetId(eqSetId);
-          pResolved[resIdx] += pUnresolved[0];
-          ++pUnresolved;
-          ++eqSetId;
-        }
-      }
-      // moments
-      if (this->ComputeMoments)
-      {
-        pUnresolved = moments[procId]->GetPointer(0);
-        pResolved = this->FragmentMoments->GetPointer(0);
-        eqSetId = procBaseEqSetId;
-        for (int i = 0; i < nUnresolved; ++i)
-        {
-          int resIdx = 4 * this->EquivalenceSet->GetEquivalentSetId(eqSetId);
-          for (int q = 0; q < 4; ++q)
-          {
-            pResolved[resIdx + q] += pUnresolved[q];
-          }
-          pUnresolved += 4;
-          ++eqSetId;
-        }
-      }
-      procBaseEqSetId += nUnresolved;
+      members.Accumulate(clipDepthMaxs, this->ClipDepthMaximums);
+      members.Accumulate(clipDepthMins, this->ClipDepthMinimums);
+    }
+    // moments
+    if (this->ComputeMoments)
+    {
+      members.Accumulate(moments, this->FragmentMoments);
     }
 
     // Second pass, resolve attributes which depend on
     // other attributes (eg weighted averages)
-    procBaseEqSetId = 0;
-    for (int procId = 0; procId < nProcs; ++procId)
+    vector<vtkDoubleArray*> unresolved(nProcs);
+    // volume weighted averages
+    for (int k = 0; k < this->NVolumeWtdAvgs; ++k)
     {
-      int eqSetId;
-      double* pResolved;
-      const double* pUnresolved;
-      int nUnresolved = this->NumberOfRawFragmentsInProcess[procId];
-      // volume weighted averages
-      double* pWt;  // these have to do with weights
-      int nCompsWt; //
-      int wtComp;   //
-      for (int k = 0; k < this->NVolumeWtdAvgs; ++k)
+      for (int procId = 0; procId < nProcs; ++procId)
       {
-        pUnresolved = volumeWtdAvgs[procId][k]->GetPointer(0);
-        pResolved = this->FragmentVolumeWtdAvgs[k]->GetPointer(0);
-        int nComps = this->FragmentVolumeWtdAvgs[k]->GetNumberOfComponents();
-        pWt = this->FragmentVolumes->GetPointer(0);
-        nCompsWt = 1;
-        wtComp = 0;
-        eqSetId = procBaseEqSetId;
-        for (int i = 0; i < nUnresolved; ++i)
-        {
-          int resId = this->EquivalenceSet->GetEquivalentSetId(eqSetId);
-          int resIdx = nComps * resId;
-          int wtIdx = nCompsWt * resId;
-          for (int q = 0; q < nComps; ++q)
-          {
-            pResolved[resIdx + q] += pUnresolved[q] / pWt[wtIdx];
-          }
-          pUnresolved += nComps;
-          ++eqSetId;
-        }
+        unresolved[procId] = volumeWtdAvgs[procId][k];
       }
-      // mass weighted averages (Mx,My,Mz,Mass)
-      if (this->ComputeMoments)
+      members.Accumulate(
+        unresolved, this->FragmentVolumeWtdAvgs[k], this->FragmentVolumes->GetPointer(0), 1);
+    }
+    // mass weighted averages (Mx,My,Mz,Mass)
+    if (this->ComputeMoments)
+    {
+      for (int k = 0; k < this->NMassWtdAvgs; ++k)
       {
-        for (int k = 0; k < this->NMassWtdAvgs; ++k)
+        for (int procId = 0; procId < nProcs; ++procId)
         {
-          pUnresolved = massWtdAvgs[procId][k]->GetPointer(0);
-          pResolved = this->FragmentMassWtdAvgs[k]->GetPointer(0);
-          int nComps = this->FragmentMassWtdAvgs[k]->GetNumberOfComponents();
-          nCompsWt = 4;
-          wtComp = 3;
-          pWt = this->FragmentMoments->GetPointer(0) + wtComp;
-          eqSetId = procBaseEqSetId;
-          for (int i = 0; i < nUnresolved; ++i)
-          {
-            int resId = this->EquivalenceSet->GetEquivalentSetId(eqSetId);
-            int resIdx = nComps * resId;
-            int wtIdx = nCompsWt * resId;
-            for (int q = 0; q < nComps; ++q)
-            {
-              pResolved[resIdx + q] += pUnresolved[q] / pWt[wtIdx];
-            }
-            pUnresolved += nComps;
-            ++eqSetId;
-          }
+          unresolved[procId] = massWtdAvgs[procId][k];
         }
+        members.Accumulate(
+          unresolved, this->FragmentMassWtdAvgs[k], this->FragmentMoments->GetPointer(0) + 3, 4);
       }
-      // sums
-      for (int k = 0; k < this->NToSum; ++k)
+    }
+    // sums
+    for (int k = 0; k < this->NToSum; ++k)
+    {
+      for (int procId = 0; procId < nProcs; ++procId)
       {
-        pUnresolved = sums[procId][k]->GetPointer(0);
-        pResolved = this->FragmentSums[k]->GetPointer(0);
-        int nComps = this->FragmentSums[k]->GetNumberOfComponents();
-        eqSetId = procBaseEqSetId;
-        for (int i = 0; i < nUnresolved; ++i)
-        {
-          int resIdx = nComps * this->EquivalenceSet->GetEquivalentSetId(eqSetId);
-          for (int q = 0; q < nComps; ++q)
-          {
-            pResolved[resIdx + q] += pUnresolved[q];
-          }
-          pUnresolved += nComps;
-          ++eqSetId;
-        }
+        unresolved[procId] = sums[procId][k];
       }
-      procBaseEqSetId += nUnresolved;
+      members.Accumulate(unresolved, this->FragmentSums[k]);
     }
     // clean up
     this->CleanUpAfterCollectIntegratedAttributes(
@@ -8291,14 +8320,7 @@ void vtkMaterialInterfaceFilter::GatherEquivalenceSets(vtkMaterialInterfaceEquiv
   }
   // Add the equivalences from our process.
   int myOffset = this->LocalToGlobalOffsets[myProcId];
-  int memberSetId;
-  for (int ii = 0; ii < numLocalMembers; ++ii)
-  {
-    memberSetId = set->GetEquivalentSetId(ii);
-    // This will be inefficient until I make the scheduled improvemnt to the
-    // add method (Ordered multilevel tree instead of a one level tree).
-    globalSet->AddEquivalence(ii + myOffset, memberSetId + myOffset);
-  }
+  globalSet->CopyEquivalences(set, myOffset);
 
   // cerr << myProcId << " Input set: " << endl;
   // set->Print();
@@ -8335,58 +8357,48 @@ void vtkMaterialInterfaceFilter::MergeGhostEquivalenceSets(
   vtkMaterialInterfaceEquivalenceSet* globalSet)
 {
   const int myProcId = this->Controller->GetLocalProcessId();
+  const int numProcs = this->Controller->GetNumberOfProcesses();
   int* buf = globalSet->GetPointer();
   const int numIds = globalSet->GetNumberOfMembers();
 
   // At this point all the sets are global and have the same number of ids.
-  // Send all the sets to process 0 to be merged.
-  if (myProcId > 0)
-  {
-    this->Controller->Send(buf, numIds, 0, 342320);
-    // Now receive the final equivalences.
-    this->Controller->Receive(&this->NumberOfResolvedFragments, 1, 0, 342321);
-    // Domain has numIds,  range has NumberOfResolvedFragments
-    this->Controller->Receive(buf, numIds, 0, 342322);
-    // We have to mark the set as resolved because the set being
-    // received has been resolved.  If we do not do this then
-    // We cannot get the proper set id.  Using the pointer
-    // here is a bad api.  TODO: Fix the API and make "Resolved" private.
-    globalSet->Resolved = 1;
-    return;
-  }
-
-  // Only process 0 from here out.
-
-  int numProcs = this->Controller->GetNumberOfProcesses();
-  int* tmp;
-  tmp = new int[numIds];
-  for (int ii = 1; ii < numProcs; ++ii)
+  // Merge them pairwise along a binary tree rooted at process 0 so that no
+  // process merges more than log2(numProcs) sets.
+  vector<int> tmp;
+  for (int stride = 1; stride < numProcs; stride *= 2)
   {
-    this->Controller->Receive(tmp, numIds, ii, 342320);
-    // Merge the values.
-    for (int jj = 0; jj < numIds; ++jj)
+    if (myProcId % (2 * stride) == stride)
     {
-      if (tmp[jj] != jj)
-      { // TODO: Make sure this is efficient.  Avoid n^2.
-        globalSet->AddEquivalence(jj, tmp[jj]);
-      }
+      // Hand our (partially merged) set to our parent and wait for the result.
+      this->Controller->Send(buf, numIds, myProcId - stride, 342320);
+      break;
+    }
+    if (myProcId % (2 * stride) == 0 && myProcId + stride < numProcs)
+    {
+      tmp.resize(numIds);
+      this->Controller->Receive(tmp.data(), numIds, myProcId + stride, 342320);
+      globalSet->MergeEquivalences(tmp.data(), numIds);
     }
   }
-  delete[] tmp;
 
   // Make the set ids sequential.
-  this->NumberOfResolvedFragments = globalSet->ResolveEquivalences();
+  if (myProcId == 0)
+  {
+    this->NumberOfResolvedFragments = globalSet->ResolveEquivalences();
+  }
 
   // The pointers should still be valid.
   // The array should not resize here.
   // Number of resolved fragemnts will be smaller
   // than TotalNumberOfRawFragments
-  for (int ii = 1; ii < numProcs; ++ii)
-  {
-    this->Controller->Send(&this->NumberOfResolvedFragments, 1, ii, 342321);
-    // Domain has numIds,  range has NumberOfResolvedFragments
-    this->Controller->Send(buf, numIds, ii, 342322);
-  }
+  this->Controller->Broadcast(&this->NumberOfResolvedFragments, 1, 0);
+  // Domain has numIds,  range has NumberOfResolvedFragments
+  this->Controller->Broadcast(buf, numIds, 0);
+  // We have to mark the set as resolved because the set being
+  // received has been resolved.  If we do not do this then
+  // We cannot get the proper set id.  Using the pointer
+  // here is a bad api.  TODO: Fix the API and make "Resolved" private.
+  globalSet->Resolved = 1;
 }
 
 //----------------------------------------------------------------------------
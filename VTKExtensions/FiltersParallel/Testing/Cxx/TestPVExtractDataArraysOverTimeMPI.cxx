@@ -0,0 +1,249 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkCompositeDataSet.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkLogger.h"
+#include "vtkMPIController.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVExtractDataArraysOverTime.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkSmartPointer.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTable.h"
+
+#include <cmath>
+#include <map>
+#include <string>
+
+namespace
+{
+constexpr int NumberOfPoints = 12;
+constexpr int NumberOfTimeSteps = 7;
+
+// Points 0 to NumberOfPoints - 1 split among the requested pieces, with a
+// "value" of 100 * id + time, and global ids unless GenerateGlobalIds is off.
+class vtkTemporalPointsSource : public vtkPolyDataAlgorithm
+{
+public:
+  static vtkTemporalPointsSource* New();
+  vtkTypeMacro(vtkTemporalPointsSource, vtkPolyDataAlgorithm);
+  vtkSetMacro(GenerateGlobalIds, bool);
+
+protected:
+  vtkTemporalPointsSource() { this->SetNumberOfInputPorts(0); }
+
+  int RequestInformation(vtkInformation*, vtkInformationVector**,
+    vtkInformationVector* outputVector) override
+  {
+    double times[NumberOfTimeSteps];
+    for (int cc = 0; cc < NumberOfTimeSteps; ++cc)
+    {
+      times[cc] = 0.5 * cc;
+    }
+    const double range[2] = { times[0], times[NumberOfTimeSteps - 1] };
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_STEPS(), times, NumberOfTimeSteps);
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_RANGE(), range, 2);
+    outInfo->Set(vtkAlgorithm::CAN_HANDLE_PIECE_REQUEST(), 1);
+    return 1;
+  }
+
+  int RequestData(
+    vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector) override
+  {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    const int piece = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER());
+    const int numPieces =
+      outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES());
+    const double time = outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP())
+      ? outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP())
+      : 0.0;
+
+    const int begin = piece * NumberOfPoints / numPieces;
+    const int end = (piece + 1) * NumberOfPoints / numPieces;
+    vtkNew<vtkPoints> points;
+    vtkNew<vtkIdTypeArray> ids;
+    ids->SetName("GlobalIds");
+    vtkNew<vtkDoubleArray> values;
+    values->SetName("value");
+    for (int id = begin; id < end; ++id)
+    {
+      points->InsertNextPoint(id, 0, 0);
+      ids->InsertNextValue(id);
+      values->InsertNextValue(100.0 * id + time);
+    }
+    vtkPolyData* output = vtkPolyData::GetData(outInfo);
+    output->SetPoints(points);
+    if (this->GenerateGlobalIds)
+    {
+      output->GetPointData()->SetGlobalIds(ids);
+    }
+    output->GetPointData()->AddArray(values);
+    output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), time);
+    return 1;
+  }
+
+  bool GenerateGlobalIds = true;
+
+private:
+  vtkTemporalPointsSource(const vtkTemporalPointsSource&) = delete;
+  void operator=(const vtkTemporalPointsSource&) = delete;
+};
+vtkStandardNewMacro(vtkTemporalPointsSource);
+
+// Tables of the output, by block name.
+std::map<std::string, vtkTable*> GetTables(vtkMultiBlockDataSet* output)
+{
+  std::map<std::string, vtkTable*> tables;
+  for (unsigned int cc = 0; output && cc < output->GetNumberOfBlocks(); ++cc)
+  {
+    auto table = vtkTable::SafeDownCast(output->GetBlock(cc));
+    if (table && output->HasMetaData(cc) &&
+      output->GetMetaData(cc)->Has(vtkCompositeDataSet::NAME()))
+    {
+      tables[output->GetMetaData(cc)->Get(vtkCompositeDataSet::NAME())] = table;
+    }
+  }
+  return tables;
+}
+
+bool SameValue(double a, double b)
+{
+  return a == b || (std::isnan(a) && std::isnan(b));
+}
+
+struct Options
+{
+  const char* Name;
+  bool GlobalIds;
+  bool UseGlobalIds;
+  bool StatisticsOnly;
+  // number of tables and of rows per table of the output.
+  size_t NumberOfTables;
+  vtkIdType NumberOfRows;
+};
+
+// Compares the tables of `output` with the ones of `expected`, rows in the
+// same order.
+bool Compare(const Options& options, vtkMultiBlockDataSet* expected,
+  vtkMultiBlockDataSet* output, int numGroups)
+{
+  const auto expectedTables = GetTables(expected);
+  const auto tables = GetTables(output);
+  if (expectedTables.size() != options.NumberOfTables || tables.size() != expectedTables.size())
+  {
+    vtkLogF(ERROR, "%s, %d groups: %d tables instead of %d.", options.Name, numGroups,
+      static_cast<int>(tables.size()), static_cast<int>(expectedTables.size()));
+    return false;
+  }
+  for (const auto& item : expectedTables)
+  {
+    vtkTable* expectedTable = item.second;
+    auto iter = tables.find(item.first);
+    vtkTable* table = iter != tables.end() ? iter->second : nullptr;
+    if (!table || table->GetNumberOfRows() != options.NumberOfRows ||
+      table->GetNumberOfRows() != expectedTable->GetNumberOfRows() ||
+      table->GetNumberOfColumns() != expectedTable->GetNumberOfColumns())
+    {
+      vtkLogF(ERROR, "%s, %d groups: table '%s' is missing or differs in size.", options.Name,
+        numGroups, item.first.c_str());
+      return false;
+    }
+    for (vtkIdType col = 0; col < expectedTable->GetNumberOfColumns(); ++col)
+    {
+      auto expectedColumn = vtkDataArray::SafeDownCast(expectedTable->GetColumn(col));
+      const char* name = expectedTable->GetColumnName(col);
+      auto column = vtkDataArray::SafeDownCast(table->GetColumnByName(name));
+      if (!expectedColumn)
+      {
+        continue;
+      }
+      if (!column || column->GetNumberOfComponents() != expectedColumn->GetNumberOfComponents())
+      {
+        vtkLogF(ERROR, "%s, %d groups: column '%s' of '%s' is missing.", options.Name, numGroups,
+          name, item.first.c_str());
+        return false;
+      }
+      for (vtkIdType row = 0; row < expectedTable->GetNumberOfRows(); ++row)
+      {
+        for (int comp = 0; comp < column->GetNumberOfComponents(); ++comp)
+        {
+          if (!SameValue(column->GetComponent(row, comp), expectedColumn->GetComponent(row, comp)))
+          {
+            vtkLogF(ERROR, "%s, %d groups: '%s' of '%s' differs at row %lld: %g instead of %g.",
+              options.Name, numGroups, name, item.first.c_str(), static_cast<long long>(row),
+              column->GetComponent(row, comp), expectedColumn->GetComponent(row, comp));
+            return false;
+          }
+        }
+      }
+    }
+  }
+  return true;
+}
+
+vtkSmartPointer<vtkMultiBlockDataSet> Extract(
+  const Options& options, vtkMultiProcessController* controller, int numGroups)
+{
+  vtkNew<vtkTemporalPointsSource> source;
+  source->SetGenerateGlobalIds(options.GlobalIds);
+  vtkNew<vtkPVExtractDataArraysOverTime> extract;
+  extract->SetController(controller);
+  extract->SetInputConnection(source->GetOutputPort());
+  extract->SetFieldAssociation(vtkDataObject::FIELD_ASSOCIATION_POINTS);
+  extract->SetReportStatisticsOnly(options.StatisticsOnly);
+  extract->SetUseGlobalIDs(options.UseGlobalIds);
+  extract->SetNumberOfTimeGroups(numGroups);
+  extract->UpdatePiece(controller->GetLocalProcessId(), controller->GetNumberOfProcesses(), 0);
+  auto output = vtkSmartPointer<vtkMultiBlockDataSet>::New();
+  output->ShallowCopy(extract->GetOutputDataObject(0));
+  return output;
+}
+}
+
+int TestPVExtractDataArraysOverTimeMPI(int argc, char* argv[])
+{
+  vtkNew<vtkMPIController> controller;
+  controller->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(controller);
+
+  const int numProcs = controller->GetNumberOfProcesses();
+  // without global ids, the tables are named after the rank holding the
+  // point, so the grouped runs must fall back to the single group.
+  const Options cases[] = {
+    { "global ids", true, true, false, NumberOfPoints, NumberOfTimeSteps },
+    { "missing global ids", false, true, false, NumberOfPoints, NumberOfTimeSteps },
+    { "global ids not used", true, false, false, NumberOfPoints, NumberOfTimeSteps },
+    { "statistics", true, true, true, 1, NumberOfTimeSteps },
+  };
+  int success = 1;
+  for (const Options& options : cases)
+  {
+    // all ranks process all time steps, as vtkPExtractDataArraysOverTime.
+    const auto expected = Extract(options, controller, 1);
+    for (int numGroups = 2; numGroups <= numProcs; ++numGroups)
+    {
+      const auto output = Extract(options, controller, numGroups);
+      if (controller->GetLocalProcessId() == 0)
+      {
+        success = Compare(options, expected, output, numGroups) && success;
+      }
+    }
+  }
+
+  int allSuccess = 0;
+  controller->AllReduce(&success, &allSuccess, 1, vtkCommunicator::LOGICAL_AND_OP);
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  controller->Finalize();
+  return allSuccess ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,363 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkPVExtractDataArraysOverTime.h"
+
+#include "vtkCommunicator.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataArray.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkFieldData.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkMultiProcessController.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVLogger.h"
+#include "vtkSmartPointer.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTable.h"
+#include "vtkWeakPointer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// Returns true if a dataset of `input` has elements of `association` without
+// global ids.
+bool IsMissingGlobalIds(vtkDataObject* input, int association)
+{
+  std::vector<vtkDataObject*> leaves;
+  if (auto composite = vtkCompositeDataSet::SafeDownCast(input))
+  {
+    leaves = vtkCompositeDataSet::GetDataSets<vtkDataObject>(composite);
+  }
+  else if (input)
+  {
+    leaves.push_back(input);
+  }
+  for (vtkDataObject* leaf : leaves)
+  {
+    vtkDataSetAttributes* attributes = leaf->GetAttributes(association);
+    if (leaf->GetNumberOfElements(association) > 0 && (!attributes || !attributes->GetGlobalIds()))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Concatenates the rows of the tables extracted by several groups, sorted by
+// time. `tables` holds the index of the group that extracted each table.
+vtkSmartPointer<vtkTable> MergeInTimeOrder(
+  const std::vector<std::pair<int, vtkTable*>>& tables, int numGroups)
+{
+  if (tables.size() == 1)
+  {
+    return tables[0].second;
+  }
+
+  // the k-th row of group g is the time step k * numGroups + g, which orders
+  // the rows when there is no time column.
+  std::vector<std::tuple<double, size_t, vtkIdType>> rows;
+  for (size_t cc = 0; cc < tables.size(); ++cc)
+  {
+    vtkTable* table = tables[cc].second;
+    vtkDataArray* time = vtkDataArray::SafeDownCast(table->GetColumnByName("Time"));
+    for (vtkIdType row = 0, max = table->GetNumberOfRows(); row < max; ++row)
+    {
+      const double key = time ? time->GetComponent(row, 0)
+                              : static_cast<double>(row) * numGroups + tables[cc].first;
+      rows.emplace_back(key, cc, row);
+    }
+  }
+  std::stable_sort(rows.begin(), rows.end(),
+    [](const std::tuple<double, size_t, vtkIdType>& a,
+      const std::tuple<double, size_t, vtkIdType>& b) { return std::get<0>(a) < std::get<0>(b); });
+
+  auto result = vtkSmartPointer<vtkTable>::New();
+  result->GetFieldData()->ShallowCopy(tables[0].second->GetFieldData());
+  vtkDataSetAttributes* rowData = tables[0].second->GetRowData();
+  for (int cc = 0, max = rowData->GetNumberOfArrays(); cc < max; ++cc)
+  {
+    vtkAbstractArray* array = rowData->GetAbstractArray(cc);
+    vtkSmartPointer<vtkAbstractArray> merged;
+    merged.TakeReference(array->NewInstance());
+    merged->SetName(array->GetName());
+    merged->SetNumberOfComponents(array->GetNumberOfComponents());
+    merged->CopyComponentNames(array);
+    merged->SetNumberOfTuples(static_cast<vtkIdType>(rows.size()));
+    if (vtkDataArray* values = vtkDataArray::SafeDownCast(merged))
+    {
+      values->Fill(0.0);
+    }
+    std::vector<vtkAbstractArray*> sources(tables.size());
+    for (size_t tt = 0; tt < tables.size(); ++tt)
+    {
+      sources[tt] = array->GetName()
+        ? tables[tt].second->GetRowData()->GetAbstractArray(array->GetName())
+        : nullptr;
+    }
+    for (size_t row = 0; row < rows.size(); ++row)
+    {
+      if (vtkAbstractArray* source = sources[std::get<1>(rows[row])])
+      {
+        merged->SetTuple(static_cast<vtkIdType>(row), std::get<2>(rows[row]), source);
+      }
+    }
+    result->GetRowData()->AddArray(merged);
+  }
+  return result;
+}
+}
+
+class vtkPVExtractDataArraysOverTime::vtkInternals
+{
+public:
+  int NumberOfGroups = 1;
+  int Group = 0;
+  vtkWeakPointer<vtkMultiProcessController> ParentController;
+  vtkSmartPointer<vtkMultiProcessController> GroupController;
+
+  int TotalNumberOfTimeSteps = 0;
+  std::chrono::steady_clock::time_point Start;
+
+  // the last execution with a single group, to report the speedup against.
+  int SerialNumberOfTimeSteps = 0;
+  double SerialElapsed = 0.0;
+
+  // Returns the group of a rank, the groups being contiguous.
+  int GetGroup(int rank, int numRanks) const
+  {
+    return static_cast<int>(static_cast<long long>(rank) * this->NumberOfGroups / numRanks);
+  }
+
+  double GetElapsed() const
+  {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - this->Start).count();
+  }
+};
+
+vtkStandardNewMacro(vtkPVExtractDataArraysOverTime);
+//----------------------------------------------------------------------------
+vtkPVExtractDataArraysOverTime::vtkPVExtractDataArraysOverTime()
+  : Internals(new vtkPVExtractDataArraysOverTime::vtkInternals())
+{
+}
+
+//----------------------------------------------------------------------------
+vtkPVExtractDataArraysOverTime::~vtkPVExtractDataArraysOverTime() = default;
+
+//----------------------------------------------------------------------------
+int vtkPVExtractDataArraysOverTime::RequestInformation(
+  vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  if (!this->Superclass::RequestInformation(request, inputVector, outputVector))
+  {
+    return 0;
+  }
+
+  auto& internals = *this->Internals;
+  vtkMultiProcessController* controller = this->Controller;
+  const int numRanks = controller ? controller->GetNumberOfProcesses() : 1;
+  // without global ids, the tables of the elements are named after the rank
+  // that extracted them, which is local to its group, so rows of different
+  // elements would be merged. Statistics are named after their block only.
+  const bool namedByRank = !this->GetReportStatisticsOnly() && !this->GetUseGlobalIDs();
+  const int numGroups = namedByRank
+    ? 1
+    : std::max(1, std::min({ this->NumberOfTimeGroups, numRanks, this->NumberOfTimeSteps }));
+
+  // all ranks execute RequestInformation, so the controller can be partitioned
+  // here.
+  if (numGroups != internals.NumberOfGroups || controller != internals.ParentController)
+  {
+    internals.NumberOfGroups = numGroups;
+    internals.ParentController = controller;
+    internals.GroupController = nullptr;
+    internals.Group = 0;
+    if (numGroups > 1)
+    {
+      const int rank = controller->GetLocalProcessId();
+      internals.Group = internals.GetGroup(rank, numRanks);
+      internals.GroupController.TakeReference(
+        controller->PartitionController(internals.Group, rank));
+    }
+  }
+
+  internals.TotalNumberOfTimeSteps = this->NumberOfTimeSteps;
+  if (numGroups > 1)
+  {
+    // this group only visits the time steps Group, Group + numGroups, ...
+    this->NumberOfTimeSteps =
+      (this->NumberOfTimeSteps - internals.Group + numGroups - 1) / numGroups;
+  }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkPVExtractDataArraysOverTime::RequestUpdateExtent(
+  vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  if (!this->Superclass::RequestUpdateExtent(request, inputVector, outputVector))
+  {
+    return 0;
+  }
+
+  const auto& internals = *this->Internals;
+  if (internals.NumberOfGroups > 1)
+  {
+    vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+    const double* times = inInfo->Get(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+    const int index = this->CurrentTimeIndex * internals.NumberOfGroups + internals.Group;
+    if (times && index < inInfo->Length(vtkStreamingDemandDrivenPipeline::TIME_STEPS()))
+    {
+      inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP(), times[index]);
+    }
+    // the whole input is partitioned among the ranks of the group.
+    inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER(),
+      internals.GroupController->GetLocalProcessId());
+    inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES(),
+      internals.GroupController->GetNumberOfProcesses());
+  }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkPVExtractDataArraysOverTime::RequestData(
+  vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  auto& internals = *this->Internals;
+  if (this->CurrentTimeIndex == 0)
+  {
+    internals.Start = std::chrono::steady_clock::now();
+
+    // all the ranks extract their first time step together, which is when the
+    // input is first known to lack global ids.
+    if (internals.NumberOfGroups > 1 && !this->GetReportStatisticsOnly())
+    {
+      int localMissing = ::IsMissingGlobalIds(
+                           vtkDataObject::GetData(inputVector[0], 0), this->GetFieldAssociation())
+        ? 1
+        : 0;
+      int missing = 0;
+      this->Controller->AllReduce(&localMissing, &missing, 1, vtkCommunicator::MAX_OP);
+      if (missing)
+      {
+        vtkVLogF(PARAVIEW_LOG_PIPELINE_VERBOSITY(),
+          "global ids are missing, extracting all time steps with a single group of ranks");
+        internals.NumberOfGroups = 1;
+        internals.Group = 0;
+        internals.GroupController = nullptr;
+        this->NumberOfTimeSteps = internals.TotalNumberOfTimeSteps;
+        // the input is the first time step of this group, start over.
+        request->Set(vtkStreamingDemandDrivenPipeline::CONTINUE_EXECUTING(), 1);
+        return 1;
+      }
+    }
+  }
+  return this->Superclass::RequestData(request, inputVector, outputVector);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVExtractDataArraysOverTime::PostExecute(
+  vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  auto& internals = *this->Internals;
+  vtkMultiProcessController* controller = this->Controller;
+  const bool isRoot = !controller || controller->GetLocalProcessId() == 0;
+  if (internals.NumberOfGroups <= 1)
+  {
+    this->Superclass::PostExecute(request, inputVector, outputVector);
+    internals.SerialNumberOfTimeSteps = internals.TotalNumberOfTimeSteps;
+    internals.SerialElapsed = internals.GetElapsed();
+    vtkVLogIfF(PARAVIEW_LOG_PIPELINE_VERBOSITY(), isRoot,
+      "extracted %d time steps in %.3f s with a single group of ranks",
+      internals.TotalNumberOfTimeSteps, internals.SerialElapsed);
+    return;
+  }
+
+  // the results are first reduced within each group, by swapping the
+  // controller without modifying the filter.
+  this->Controller = internals.GroupController;
+  this->Superclass::PostExecute(request, inputVector, outputVector);
+  this->Controller = controller;
+
+  vtkMultiBlockDataSet* output = vtkMultiBlockDataSet::GetData(outputVector, 0);
+  std::vector<vtkSmartPointer<vtkDataObject>> results;
+  controller->Gather(output, results, 0);
+  if (!isRoot)
+  {
+    output->Initialize();
+    return;
+  }
+
+  // only the first rank of each group holds its result. Tables are matched by
+  // block name.
+  std::vector<std::string> names;
+  std::map<std::string, std::vector<std::pair<int, vtkTable*>>> tables;
+  const int numRanks = controller->GetNumberOfProcesses();
+  for (int rank = 0; rank < numRanks; ++rank)
+  {
+    const int group = internals.GetGroup(rank, numRanks);
+    auto result = vtkMultiBlockDataSet::SafeDownCast(results[rank]);
+    if (!result || (rank > 0 && internals.GetGroup(rank - 1, numRanks) == group))
+    {
+      continue;
+    }
+    for (unsigned int cc = 0; cc < result->GetNumberOfBlocks(); ++cc)
+    {
+      vtkTable* table = vtkTable::SafeDownCast(result->GetBlock(cc));
+      if (!table)
+      {
+        continue;
+      }
+      const std::string name =
+        result->HasMetaData(cc) && result->GetMetaData(cc)->Has(vtkCompositeDataSet::NAME())
+        ? result->GetMetaData(cc)->Get(vtkCompositeDataSet::NAME())
+        : std::to_string(cc);
+      auto& entry = tables[name];
+      if (entry.empty())
+      {
+        names.push_back(name);
+      }
+      entry.emplace_back(group, table);
+    }
+  }
+
+  vtkNew<vtkMultiBlockDataSet> merged;
+  merged->SetNumberOfBlocks(static_cast<unsigned int>(names.size()));
+  for (unsigned int cc = 0; cc < merged->GetNumberOfBlocks(); ++cc)
+  {
+    merged->SetBlock(cc, ::MergeInTimeOrder(tables[names[cc]], internals.NumberOfGroups));
+    merged->GetMetaData(cc)->Set(vtkCompositeDataSet::NAME(), names[cc].c_str());
+  }
+  output->ShallowCopy(merged);
+
+  const double elapsed = internals.GetElapsed();
+  const int updates = (internals.TotalNumberOfTimeSteps + internals.NumberOfGroups - 1) /
+    internals.NumberOfGroups;
+  vtkVLogF(PARAVIEW_LOG_PIPELINE_VERBOSITY(),
+    "extracted %d time steps in %.3f s with %d groups of ranks: at most %d upstream updates "
+    "per rank instead of %d",
+    internals.TotalNumberOfTimeSteps, elapsed, internals.NumberOfGroups, updates,
+    internals.TotalNumberOfTimeSteps);
+  if (internals.SerialNumberOfTimeSteps == internals.TotalNumberOfTimeSteps && elapsed > 0)
+  {
+    vtkVLogF(PARAVIEW_LOG_PIPELINE_VERBOSITY(), "speedup against the last serial execution: %.2f",
+      internals.SerialElapsed / elapsed);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVExtractDataArraysOverTime::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfTimeGroups: " << this->NumberOfTimeGroups << endl;
+}
@@ -0,0 +1,71 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class vtkPVExtractDataArraysOverTime
+ * @brief vtkPExtractDataArraysOverTime that can process time steps concurrently.
+ *
+ * vtkPExtractDataArraysOverTime updates the upstream pipeline once per time
+ * step, on all ranks. When NumberOfTimeGroups is greater than 1, the ranks are
+ * instead split into that many contiguous groups and the time steps are
+ * distributed round-robin among the groups: each group requests its own
+ * partition of the input (one piece per rank of the group) for its time steps
+ * only, so that every rank updates the upstream pipeline NumberOfTimeGroups
+ * times less often. The results of each group are reduced within the group,
+ * then the rows of all groups are merged on the root node in time order.
+ *
+ * This requires the upstream pipeline to honor arbitrary piece requests, as
+ * ParaView readers do. The number of groups is limited to the number of ranks
+ * and the number of time steps. Unless ReportStatisticsOnly is on, the rows of
+ * the groups are matched by global id: a single group is used when
+ * UseGlobalIDs is off or when the input lacks global ids.
+ *
+ * The elapsed time and the number of upstream updates, compared to the
+ * serial path, are logged with `PARAVIEW_LOG_PIPELINE_VERBOSITY()`.
+ */
+
+#ifndef vtkPVExtractDataArraysOverTime_h
+#define vtkPVExtractDataArraysOverTime_h
+
+#include "vtkPExtractDataArraysOverTime.h"
+#include "vtkPVVTKExtensionsFiltersParallelModule.h" //needed for exports
+
+#include <memory> // for std::unique_ptr
+
+class VTKPVVTKEXTENSIONSFILTERSPARALLEL_EXPORT vtkPVExtractDataArraysOverTime
+  : public vtkPExtractDataArraysOverTime
+{
+public:
+  static vtkPVExtractDataArraysOverTime* New();
+  vtkTypeMacro(vtkPVExtractDataArraysOverTime, vtkPExtractDataArraysOverTime);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * Get/Set the number of groups of ranks processing time steps concurrently.
+   * Default is 1, i.e. all ranks process all time steps.
+   */
+  vtkSetClampMacro(NumberOfTimeGroups, int, 1, VTK_INT_MAX);
+  vtkGetMacro(NumberOfTimeGroups, int);
+  ///@}
+
+protected:
+  vtkPVExtractDataArraysOverTime();
+  ~vtkPVExtractDataArraysOverTime() override;
+
+  int RequestInformation(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+  int RequestUpdateExtent(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+  void PostExecute(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override;
+
+  int NumberOfTimeGroups = 1;
+
+private:
+  vtkPVExtractDataArraysOverTime(const vtkPVExtractDataArraysOverTime&) = delete;
+  void operator=(const vtkPVExtractDataArraysOverTime&) = delete;
+
+  class vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
+};
+
+#endif
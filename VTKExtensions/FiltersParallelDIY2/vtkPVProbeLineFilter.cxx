@@ -8,6 +8,7 @@
 #include "vtkInformationVector.h"
 #include "vtkLineSource.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVLocatorCache.h"
 #include "vtkProbeLineFilter.h"
 
 vtkStandardNewMacro(vtkPVProbeLineFilter);
@@ -52,9 +53,13 @@ int vtkPVProbeLineFilter::RequestData(
   this->Prober->SetComputeTolerance(this->ComputeTolerance);
   this->Prober->SetSamplingPattern(this->SamplingPattern);
 
-  this->Prober->SetInputData(input);
+  // The prober uses the cached locators attached to a shallow copy of the
+  // input instead of building new ones, so moving the line does not rebuild
+  // them. The input itself is left untouched.
+  this->Prober->SetInputData(vtkPVLocatorCache::GetInstance()->ShallowCopyWithCellLocators(input));
   this->Prober->Update();
   output->ShallowCopy(this->Prober->GetOutputDataObject(0));
+  this->Prober->SetInputData(nullptr);
 
   return 1;
 }
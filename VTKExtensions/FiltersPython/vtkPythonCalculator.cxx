@@ -253,4 +253,6 @@ void vtkPythonCalculator::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "MultilineExpression: " << this->MultilineExpression << endl;
   os << indent << "UseMultilineExpression: " << this->UseMultilineExpression << endl;
   os << indent << "ArrayName: " << this->ArrayName << endl;
+  os << indent << "UseStreamingEvaluation: " << this->UseStreamingEvaluation << endl;
+  os << indent << "StreamingChunkSize: " << this->StreamingChunkSize << endl;
 }
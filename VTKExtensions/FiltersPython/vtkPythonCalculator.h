@@ -89,6 +89,30 @@ public:
   vtkSetMacro(UseMultilineExpression, bool);
   ///@}
 
+  ///@{
+  /**
+   * If true, a single line expression made only of element-wise operations is
+   * evaluated in chunks of StreamingChunkSize tuples, or with numexpr when it
+   * is available, instead of on whole arrays. This avoids full size
+   * temporaries for every sub-expression and numpy or numexpr release the GIL
+   * during the numeric work. Other expressions, such as reductions or
+   * `volume(inputs[0])`, are evaluated on whole arrays as usual.
+   * Initial value is false.
+   */
+  vtkGetMacro(UseStreamingEvaluation, bool);
+  vtkSetMacro(UseStreamingEvaluation, bool);
+  vtkBooleanMacro(UseStreamingEvaluation, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Number of tuples per chunk when UseStreamingEvaluation is true.
+   * Initial value is 65536.
+   */
+  vtkGetMacro(StreamingChunkSize, int);
+  vtkSetClampMacro(StreamingChunkSize, int, 1, VTK_INT_MAX);
+  ///@}
+
   /**
    * For internal use only.
    */
@@ -119,6 +143,8 @@ protected:
   std::string Expression;
   std::string MultilineExpression;
   bool UseMultilineExpression = false;
+  bool UseStreamingEvaluation = false;
+  int StreamingChunkSize = 65536;
 
   char* ArrayName = nullptr;
   int ArrayAssociation = vtkDataObject::FIELD_ASSOCIATION_POINTS;
@@ -12,6 +12,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkProcessModule.h"
 #include "vtkPythonInterpreter.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
 #include <algorithm>
@@ -430,9 +431,29 @@ void vtkPythonProgrammableFilter::Exec(const char* script, const char* funcname)
   runscript += "  inputs = None\n";
   runscript += "  output = None\n";
 
-  // Call the function
-  runscript += funcname;
-  runscript += "(myarg, inputs, output, request)\n";
+  // Call the function, once per block if requested and possible
+  if (this->ExecutePerBlock && strcmp(funcname, "RequestData") == 0)
+  {
+    const int numberOfThreads = this->NumberOfThreads > 0
+      ? this->NumberOfThreads
+      : vtkSMPTools::GetEstimatedNumberOfThreads();
+    runscript += "executed = False\n";
+    runscript += "if hasnumpy:\n";
+    runscript += "  from paraview.detail import programmable_filter\n";
+    runscript += "  executed = programmable_filter.execute_per_block(";
+    runscript += funcname;
+    runscript += ", myarg, request, " + std::to_string(numberOfThreads) + ")\n";
+    runscript += "if not executed:\n";
+    runscript += "  ";
+    runscript += funcname;
+    runscript += "(myarg, inputs, output, request)\n";
+    runscript += "del executed\n";
+  }
+  else
+  {
+    runscript += funcname;
+    runscript += "(myarg, inputs, output, request)\n";
+  }
   runscript += "del inputs\n";
   runscript += "del output\n";
   runscript += "del myarg\n";
@@ -493,4 +514,6 @@ void vtkPythonProgrammableFilter::PrintSelf(ostream& os, vtkIndent indent)
     os << indent << "Request: (None)" << endl;
   }
   os << indent << "NeedsUpdate: " << this->NeedsUpdate << endl;
+  os << indent << "ExecutePerBlock: " << this->ExecutePerBlock << endl;
+  os << indent << "NumberOfThreads: " << this->NumberOfThreads << endl;
 }
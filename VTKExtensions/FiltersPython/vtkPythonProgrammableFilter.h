@@ -25,6 +25,14 @@
  * call are defined as Python variables inside both scripts. This allows
  * the developer to keep the scripts the same but change their behaviour
  * using parameters.
+ *
+ * When ExecutePerBlock is on and both the first input and the output are
+ * composite datasets, the output gets the structure of the first input and
+ * the RequestData script is called once per leaf, with `inputs` holding the
+ * matching leaves of the inputs and `output` the matching leaf of the output.
+ * The calls run on up to NumberOfThreads Python threads. They share the
+ * arrays of the datasets without copying them, and numpy releases the GIL in
+ * its loops, so array operations on different blocks run concurrently.
  */
 
 #ifndef vtkPythonProgrammableFilter_h
@@ -125,6 +133,26 @@ public:
   vtkGetStringMacro(PythonPath);
   ///@}
 
+  ///@{
+  /**
+   * Set/Get whether the RequestData script is run once per block of a
+   * composite input, see class documentation. Off by default.
+   */
+  vtkSetMacro(ExecutePerBlock, bool);
+  vtkGetMacro(ExecutePerBlock, bool);
+  vtkBooleanMacro(ExecutePerBlock, bool);
+  ///@}
+
+  ///@{
+  /**
+   * Set/Get the number of threads running the script on blocks when
+   * ExecutePerBlock is on. 0, the default, uses the number of threads
+   * reported by vtkSMPTools.
+   */
+  vtkSetClampMacro(NumberOfThreads, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfThreads, int);
+  ///@}
+
   /**
    * Set the number of input ports
    * This function is explicitly exposed to enable a vtkClientServerInterpreter to call it
@@ -187,6 +215,8 @@ protected:
   char* PythonPath;
   int OutputDataSetType;
   bool NeedsUpdate;
+  bool ExecutePerBlock = false;
+  int NumberOfThreads = 0;
 
 private:
   vtkPythonProgrammableFilter(const vtkPythonProgrammableFilter&) = delete;
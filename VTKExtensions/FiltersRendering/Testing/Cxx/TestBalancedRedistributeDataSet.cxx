@@ -0,0 +1,80 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkBalancedRedistributeDataSet.h"
+#include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkLogger.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+#include "vtkUnstructuredGrid.h"
+
+#define VERIFY(x, y)                                                                               \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    vtkLogF(ERROR, y);                                                                             \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+bool TestPolyData()
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->Update();
+  vtkPolyData* input = sphere->GetOutput();
+
+  vtkNew<vtkDoubleArray> cost;
+  cost->SetName("Cost");
+  cost->SetNumberOfTuples(input->GetNumberOfCells());
+  cost->FillValue(2.0);
+  input->GetCellData()->AddArray(cost);
+
+  vtkNew<vtkBalancedRedistributeDataSet> redistribute;
+  redistribute->SetController(nullptr);
+  redistribute->SetBalanceMode(vtkBalancedRedistributeDataSet::BALANCE_COST_ARRAY);
+  redistribute->SetCostArrayName("Cost");
+  redistribute->SetInputData(input);
+  redistribute->Update();
+
+  auto output = vtkPolyData::SafeDownCast(redistribute->GetOutputDataObject(0));
+  VERIFY(output != nullptr, "vtkPolyData expected.");
+  VERIFY(output->GetNumberOfCells() == input->GetNumberOfCells(), "all cells expected.");
+  VERIFY(output->GetCellData()->GetArray("Cost") != nullptr, "cost array expected.");
+  return true;
+}
+
+bool TestMultiBlock()
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(5, 4, 3);
+
+  vtkNew<vtkMultiBlockDataSet> input;
+  input->SetBlock(0, image);
+  input->SetBlock(2, vtkNew<vtkUnstructuredGrid>());
+
+  vtkNew<vtkBalancedRedistributeDataSet> redistribute;
+  redistribute->SetController(nullptr);
+  redistribute->SetInputData(input);
+  redistribute->Update();
+
+  auto output = vtkMultiBlockDataSet::SafeDownCast(redistribute->GetOutputDataObject(0));
+  VERIFY(output != nullptr, "vtkMultiBlockDataSet expected.");
+  VERIFY(output->GetNumberOfBlocks() == 3, "3 blocks expected.");
+  auto block = vtkImageData::SafeDownCast(output->GetBlock(0));
+  VERIFY(block != nullptr, "block 0: vtkImageData expected.");
+  VERIFY(block->GetNumberOfCells() == 24, "block 0: expecting 24 cells");
+  VERIFY(output->GetBlock(1) == nullptr, "block 1: expecting no data");
+  VERIFY(vtkUnstructuredGrid::SafeDownCast(output->GetBlock(2)) != nullptr,
+    "block 2: vtkUnstructuredGrid expected.");
+  return true;
+}
+}
+
+int TestBalancedRedistributeDataSet(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  return TestPolyData() && TestMultiBlock() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
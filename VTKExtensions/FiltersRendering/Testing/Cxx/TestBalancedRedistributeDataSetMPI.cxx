@@ -0,0 +1,315 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkBalancedRedistributeDataSet.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkIntArray.h"
+#include "vtkLogger.h"
+#include "vtkMPIController.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Unbalanced input: even ranks have spheres of decreasing size, odd ranks
+// have no cells. Cells are numbered globally with the "GlobalId" array and
+// cost 1 + (global id % 3) in the "Cost" array.
+vtkSmartPointer<vtkPolyData> CreateInput(vtkMultiProcessController* controller)
+{
+  const int rank = controller->GetLocalProcessId();
+  const int numRanks = controller->GetNumberOfProcesses();
+
+  auto input = vtkSmartPointer<vtkPolyData>::New();
+  if (rank % 2 == 0)
+  {
+    vtkNew<vtkSphereSource> sphere;
+    sphere->SetThetaResolution(8 * (numRanks - rank));
+    sphere->SetPhiResolution(8 * (numRanks - rank));
+    sphere->Update();
+    input->ShallowCopy(sphere->GetOutput());
+  }
+
+  const vtkIdType numCells = input->GetNumberOfCells();
+  std::vector<vtkIdType> counts(numRanks);
+  controller->AllGather(&numCells, counts.data(), 1);
+  vtkIdType offset = 0;
+  for (int cc = 0; cc < rank; ++cc)
+  {
+    offset += counts[cc];
+  }
+
+  vtkNew<vtkIdTypeArray> ids;
+  ids->SetName("GlobalId");
+  ids->SetNumberOfTuples(numCells);
+  vtkNew<vtkDoubleArray> cost;
+  cost->SetName("Cost");
+  cost->SetNumberOfTuples(numCells);
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    ids->SetValue(cellId, offset + cellId);
+    cost->SetValue(cellId, 1.0 + (offset + cellId) % 3);
+  }
+  input->GetCellData()->AddArray(ids);
+  input->GetCellData()->AddArray(cost);
+  return input;
+}
+
+// Checks that every cell ends up on exactly one of the first numTargets
+// ranks and that the cost (1 per cell, or the "Cost" array) of these ranks
+// is balanced.
+bool Check(vtkMultiProcessController* controller, vtkPolyData* input, int numberOfProcesses,
+  bool useCostArray, const std::string& name)
+{
+  const int rank = controller->GetLocalProcessId();
+  const int numRanks = controller->GetNumberOfProcesses();
+  const int numTargets =
+    numberOfProcesses < 1 || numberOfProcesses > numRanks ? numRanks : numberOfProcesses;
+
+  vtkNew<vtkBalancedRedistributeDataSet> redistribute;
+  redistribute->SetController(controller);
+  redistribute->SetNumberOfProcesses(numberOfProcesses);
+  if (useCostArray)
+  {
+    redistribute->SetBalanceMode(vtkBalancedRedistributeDataSet::BALANCE_COST_ARRAY);
+    redistribute->SetCostArrayName("Cost");
+  }
+  redistribute->SetInputData(input);
+  redistribute->Update();
+
+  int success = 1;
+  auto output = vtkDataSet::SafeDownCast(redistribute->GetOutputDataObject(0));
+  auto ids = output
+    ? vtkIdTypeArray::SafeDownCast(output->GetCellData()->GetArray("GlobalId"))
+    : nullptr;
+  auto cost = output ? output->GetCellData()->GetArray("Cost") : nullptr;
+  const vtkIdType numCells = output ? output->GetNumberOfCells() : 0;
+  if (!output || (numCells > 0 && (!ids || !cost)))
+  {
+    vtkLogF(ERROR, "%s: missing output or cell arrays on rank %d.", name.c_str(), rank);
+    success = 0;
+  }
+  if (rank >= numTargets && numCells > 0)
+  {
+    vtkLogF(ERROR, "%s: rank %d is not a target but has %lld cells.", name.c_str(), rank,
+      static_cast<long long>(numCells));
+    success = 0;
+  }
+
+  // every global id must be received exactly once.
+  const vtkIdType numInputCells = input->GetNumberOfCells();
+  vtkIdType totalCells = 0;
+  controller->AllReduce(&numInputCells, &totalCells, 1, vtkCommunicator::SUM_OP);
+  std::vector<int> localCounts(totalCells, 0);
+  std::vector<int> counts(totalCells, 0);
+  double localCost = 0.0;
+  for (vtkIdType cellId = 0; success && cellId < numCells; ++cellId)
+  {
+    const vtkIdType id = ids->GetValue(cellId);
+    if (id < 0 || id >= totalCells)
+    {
+      vtkLogF(ERROR, "%s: unexpected global id %lld.", name.c_str(), static_cast<long long>(id));
+      success = 0;
+      break;
+    }
+    ++localCounts[id];
+    localCost += useCostArray ? cost->GetComponent(cellId, 0) : 1.0;
+  }
+  controller->AllReduce(localCounts.data(), counts.data(), totalCells, vtkCommunicator::SUM_OP);
+  const auto lost = std::count(counts.begin(), counts.end(), 0);
+  const auto duplicated = std::count_if(counts.begin(), counts.end(), [](int c) { return c > 1; });
+  if (lost > 0 || duplicated > 0)
+  {
+    vtkLogF(ERROR, "%s: %lld cells lost and %lld duplicated over %lld.", name.c_str(),
+      static_cast<long long>(lost), static_cast<long long>(duplicated),
+      static_cast<long long>(totalCells));
+    success = 0;
+  }
+
+  std::vector<double> rankCosts(numRanks);
+  controller->AllGather(&localCost, rankCosts.data(), 1);
+  const auto range = std::minmax_element(rankCosts.begin(), rankCosts.begin() + numTargets);
+  // ranks get the cells whose middle falls in their share of the total cost:
+  // with unit costs the counts differ by at most one, otherwise a share may
+  // be off by up to a cell cost on each side.
+  const double tolerance = useCostArray ? 2 * 3.0 : 1.0;
+  if (*range.second - *range.first > tolerance)
+  {
+    vtkLogF(ERROR, "%s: unbalanced output, rank costs range from %g to %g.", name.c_str(),
+      *range.first, *range.second);
+    success = 0;
+  }
+
+  int allSuccess = 0;
+  controller->AllReduce(&success, &allSuccess, 1, vtkCommunicator::LOGICAL_AND_OP);
+  return allSuccess != 0;
+}
+
+// Vertices, lines, triangles and strips of 4 points on every rank, in this
+// order. Cells are numbered globally with "GlobalId", have their type in
+// "Type" and the sum of the coordinates of their points in "PointSum".
+vtkSmartPointer<vtkPolyData> CreateMixedInput(vtkMultiProcessController* controller)
+{
+  const int rank = controller->GetLocalProcessId();
+  constexpr int cellsPerType = 25;
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  vtkNew<vtkCellArray> verts;
+  vtkNew<vtkCellArray> lines;
+  vtkNew<vtkCellArray> polys;
+  vtkNew<vtkCellArray> strips;
+  vtkCellArray* cellArrays[4] = { verts, lines, polys, strips };
+  const int sizes[4] = { 1, 3, 3, 4 };
+  vtkNew<vtkIdList> cell;
+  for (int type = 0; type < 4; ++type)
+  {
+    for (int cc = 0; cc < cellsPerType; ++cc)
+    {
+      cell->Reset();
+      for (int i = 0; i < sizes[type]; ++i)
+      {
+        cell->InsertNextId(
+          points->InsertNextPoint(rank + 0.01 * cc, type + 0.1 * (i % 2), 0.1 * i));
+      }
+      cellArrays[type]->InsertNextCell(cell);
+    }
+  }
+  auto input = vtkSmartPointer<vtkPolyData>::New();
+  input->SetPoints(points);
+  input->SetVerts(verts);
+  input->SetLines(lines);
+  input->SetPolys(polys);
+  input->SetStrips(strips);
+
+  const vtkIdType numCells = input->GetNumberOfCells();
+  vtkNew<vtkIdTypeArray> ids;
+  ids->SetName("GlobalId");
+  ids->SetNumberOfTuples(numCells);
+  vtkNew<vtkIntArray> types;
+  types->SetName("Type");
+  types->SetNumberOfTuples(numCells);
+  vtkNew<vtkDoubleArray> sums;
+  sums->SetName("PointSum");
+  sums->SetNumberOfTuples(numCells);
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    ids->SetValue(cellId, rank * numCells + cellId);
+    types->SetValue(cellId, input->GetCellType(cellId));
+    double sum = 0.0;
+    input->GetCellPoints(cellId, cell);
+    for (vtkIdType i = 0; i < cell->GetNumberOfIds(); ++i)
+    {
+      const double* x = points->GetPoint(cell->GetId(i));
+      sum += x[0] + x[1] + x[2];
+    }
+    sums->SetValue(cellId, sum);
+  }
+  input->GetCellData()->AddArray(ids);
+  input->GetCellData()->AddArray(types);
+  input->GetCellData()->AddArray(sums);
+  return input;
+}
+
+// Checks that redistributing the mixed poly data keeps every cell once, with
+// its type and points, and the cells of every type in global order.
+bool CheckMixed(vtkMultiProcessController* controller)
+{
+  vtkSmartPointer<vtkPolyData> input = CreateMixedInput(controller);
+  vtkNew<vtkBalancedRedistributeDataSet> redistribute;
+  redistribute->SetController(controller);
+  // a single target receives the inputs as a whole, three targets cut the
+  // inputs of ranks 1 and 2 in the middle of their lines and triangles.
+  int success = 1;
+  for (int numTargets : { 1, 3 })
+  {
+    redistribute->SetNumberOfProcesses(numTargets);
+    redistribute->SetInputData(input);
+    redistribute->Update();
+    auto output = vtkPolyData::SafeDownCast(redistribute->GetOutputDataObject(0));
+    if (!output)
+    {
+      vtkLogF(ERROR, "mixed cells: vtkPolyData expected.");
+      success = 0;
+      break;
+    }
+    vtkDataArray* ids = output->GetCellData()->GetArray("GlobalId");
+    vtkDataArray* types = output->GetCellData()->GetArray("Type");
+    vtkDataArray* sums = output->GetCellData()->GetArray("PointSum");
+    const vtkIdType numCells = output->GetNumberOfCells();
+    if (numCells > 0 && (!ids || !types || !sums))
+    {
+      vtkLogF(ERROR, "mixed cells: missing cell arrays.");
+      success = 0;
+      break;
+    }
+    vtkIdType numLocalCells = numCells;
+    vtkIdType numReceivedCells = 0;
+    controller->AllReduce(&numLocalCells, &numReceivedCells, 1, vtkCommunicator::SUM_OP);
+    if (numReceivedCells != input->GetNumberOfCells() * controller->GetNumberOfProcesses())
+    {
+      vtkLogF(ERROR, "mixed cells: %lld cells received.", static_cast<long long>(numReceivedCells));
+      success = 0;
+    }
+
+    vtkNew<vtkIdList> cell;
+    for (vtkIdType cellId = 0; success && cellId < numCells; ++cellId)
+    {
+      double sum = 0.0;
+      output->GetCellPoints(cellId, cell);
+      for (vtkIdType i = 0; i < cell->GetNumberOfIds(); ++i)
+      {
+        const double* x = output->GetPoint(cell->GetId(i));
+        sum += x[0] + x[1] + x[2];
+      }
+      if (output->GetCellType(cellId) != static_cast<int>(types->GetTuple1(cellId)) ||
+        std::abs(sum - sums->GetTuple1(cellId)) > 1e-9)
+      {
+        vtkLogF(ERROR, "mixed cells: cell %lld changed type or points.",
+          static_cast<long long>(ids->GetTuple1(cellId)));
+        success = 0;
+      }
+      if (cellId > 0 && output->GetCellType(cellId) == output->GetCellType(cellId - 1) &&
+        ids->GetTuple1(cellId) <= ids->GetTuple1(cellId - 1))
+      {
+        vtkLogF(ERROR, "mixed cells: cell %lld is out of order.",
+          static_cast<long long>(ids->GetTuple1(cellId)));
+        success = 0;
+      }
+    }
+  }
+
+  int allSuccess = 0;
+  controller->AllReduce(&success, &allSuccess, 1, vtkCommunicator::LOGICAL_AND_OP);
+  return allSuccess != 0;
+}
+}
+
+int TestBalancedRedistributeDataSetMPI(int argc, char* argv[])
+{
+  vtkNew<vtkMPIController> controller;
+  controller->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(controller);
+
+  vtkSmartPointer<vtkPolyData> input = CreateInput(controller);
+  const int half = (controller->GetNumberOfProcesses() + 1) / 2;
+  bool success = Check(controller, input, 0, false, "all ranks");
+  success = Check(controller, input, half, false, "first half of the ranks") && success;
+  success = Check(controller, input, 0, true, "cost array") && success;
+  success = CheckMixed(controller) && success;
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  controller->Finalize();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
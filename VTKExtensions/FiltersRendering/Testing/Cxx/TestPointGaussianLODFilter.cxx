@@ -0,0 +1,159 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkCellArray.h"
+#include "vtkFloatArray.h"
+#include "vtkLogger.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPiecewiseFunction.h"
+#include "vtkPointData.h"
+#include "vtkPointGaussianLODFilter.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#define VERIFY(x, y)                                                                               \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    vtkLogF(ERROR, y);                                                                             \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+namespace
+{
+// Checks that the LOD scale of each octant of `output` is the radius of the
+// smallest splat centered at its point covering the splats of radius
+// `radius[i]` of the points of `input` in that octant.
+bool CheckLODScale(vtkPolyData* input, vtkPolyData* output, const std::vector<double>& radius)
+{
+  vtkDataArray* lodScale =
+    output->GetPointData()->GetArray(vtkPointGaussianLODFilter::GetLODScaleArrayName());
+  if (lodScale == nullptr)
+  {
+    vtkLogF(ERROR, "The LOD scale array is missing.");
+    return false;
+  }
+  for (vtkIdType leaf = 0; leaf < output->GetNumberOfPoints(); ++leaf)
+  {
+    double center[3];
+    output->GetPoint(leaf, center);
+    double expected = 0.0;
+    for (vtkIdType cc = 0; cc < input->GetNumberOfPoints(); ++cc)
+    {
+      double x[3];
+      input->GetPoint(cc, x);
+      if ((x[0] < 0.5) == (center[0] < 0.5) && (x[1] < 0.5) == (center[1] < 0.5) &&
+        (x[2] < 0.5) == (center[2] < 0.5))
+      {
+        expected =
+          std::max(expected, std::sqrt(vtkMath::Distance2BetweenPoints(x, center)) + radius[cc]);
+      }
+    }
+    if (std::abs(lodScale->GetTuple1(leaf) - expected) > 1e-5)
+    {
+      vtkLogF(ERROR, "The LOD scale of leaf %lld is %g instead of %g.",
+        static_cast<long long>(leaf), lodScale->GetTuple1(leaf), expected);
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestPointGaussianLODFilter(int, char*[])
+{
+  // 10x10x10 lattice whose scalars are the x coordinate of the points, with a
+  // "Size" array growing along z and an "Other" array that is not averaged.
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkFloatArray> scalars;
+  scalars->SetName("X");
+  vtkNew<vtkFloatArray> sizes;
+  sizes->SetName("Size");
+  vtkNew<vtkFloatArray> other;
+  other->SetName("Other");
+  for (int k = 0; k < 10; ++k)
+  {
+    for (int j = 0; j < 10; ++j)
+    {
+      for (int i = 0; i < 10; ++i)
+      {
+        points->InsertNextPoint(0.1 * i, 0.1 * j, 0.1 * k);
+        scalars->InsertNextValue(0.1f * i);
+        sizes->InsertNextValue(1.0f + k);
+        other->InsertNextValue(1.0f);
+      }
+    }
+  }
+  vtkNew<vtkPolyData> input;
+  input->SetPoints(points);
+  input->GetPointData()->SetScalars(scalars);
+  input->GetPointData()->AddArray(sizes);
+  input->GetPointData()->AddArray(other);
+
+  vtkNew<vtkPointGaussianLODFilter> filter;
+  filter->SetInputData(input);
+  filter->SetDepth(1);
+  filter->SetColorArrayName("X");
+  filter->SetScaleFactor(0.05);
+  filter->Update();
+
+  auto output = filter->GetOutput();
+  VERIFY(output->GetNumberOfPoints() == 8, "Expected one point per octant.");
+  VERIFY(output->GetNumberOfVerts() == 8, "Expected one vertex per point.");
+  auto outScalars = output->GetPointData()->GetScalars();
+  VERIFY(outScalars != nullptr, "Active scalars were not passed.");
+  for (vtkIdType cc = 0; cc < 8; ++cc)
+  {
+    double x[3];
+    output->GetPoint(cc, x);
+    VERIFY(std::abs(x[0] - outScalars->GetTuple1(cc)) < 1e-6, "Point data was not averaged.");
+    VERIFY(std::abs(x[1] - 0.2) < 1e-6 || std::abs(x[1] - 0.7) < 1e-6, "Wrong centroid.");
+  }
+  VERIFY(output->GetPointData()->GetArray("Other") == nullptr &&
+      output->GetPointData()->GetArray("Size") == nullptr,
+    "Only the color and opacity arrays should be averaged.");
+  VERIFY(CheckLODScale(input, output, std::vector<double>(1000, 0.05)),
+    "The splats do not cover their leaf.");
+
+  // scaled by the "Size" array, then through a scale function doubling it.
+  filter->SetScaleArrayName("Size");
+  filter->Update();
+  std::vector<double> radius(1000);
+  for (vtkIdType cc = 0; cc < 1000; ++cc)
+  {
+    radius[cc] = 0.05 * sizes->GetValue(cc);
+  }
+  VERIFY(CheckLODScale(input, filter->GetOutput(), radius),
+    "The splats do not cover their leaf with a scale array.");
+  vtkNew<vtkPiecewiseFunction> scaleFunction;
+  scaleFunction->AddPoint(1.0, 2.0);
+  scaleFunction->AddPoint(1024.0, 2048.0);
+  filter->SetScaleFunction(scaleFunction);
+  filter->Update();
+  for (auto& value : radius)
+  {
+    value *= 2.0;
+  }
+  VERIFY(CheckLODScale(input, filter->GetOutput(), radius),
+    "The splats do not cover their leaf with a scale function.");
+
+  // the finest octree keeps every point of the lattice.
+  filter->SetDepth(4);
+  filter->Update();
+  VERIFY(filter->GetOutput()->GetNumberOfPoints() == 1000, "Points should not be merged.");
+  auto lodScale = filter->GetOutput()->GetPointData()->GetArray(
+    vtkPointGaussianLODFilter::GetLODScaleArrayName());
+  for (vtkIdType cc = 0; cc < 1000; ++cc)
+  {
+    double x[3];
+    filter->GetOutput()->GetPoint(cc, x);
+    const double expected = 0.1 * (1.0 + std::round(10.0 * x[2]));
+    VERIFY(std::abs(lodScale->GetTuple1(cc) - expected) < 1e-5,
+      "A single splat should keep its radius.");
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,76 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkResampledBrickImageSource.h"
+#include "vtkSmartPointer.h"
+
+#include <cmath>
+
+#define VERIFY(x, y)                                                                               \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    vtkLogF(ERROR, y);                                                                             \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+namespace
+{
+// Brick of the 9x9x9 image whose scalars are the x coordinate of the points.
+vtkSmartPointer<vtkImageData> CreateBrick(int xmin, int xmax)
+{
+  auto brick = vtkSmartPointer<vtkImageData>::New();
+  brick->SetExtent(xmin, xmax, 0, 8, 0, 8);
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("X");
+  scalars->SetNumberOfTuples(brick->GetNumberOfPoints());
+  for (vtkIdType cc = 0; cc < brick->GetNumberOfPoints(); ++cc)
+  {
+    scalars->SetValue(cc, brick->GetPoint(cc)[0]);
+  }
+  brick->GetPointData()->SetScalars(scalars);
+  return brick;
+}
+}
+
+int TestResampledBrickImageSource(int, char*[])
+{
+  const int wholeExtent[6] = { 0, 8, 0, 8, 0, 8 };
+  const double origin[3] = { 0, 0, 0 };
+  const double spacing[3] = { 1, 1, 1 };
+
+  vtkNew<vtkResampledBrickImageSource> source;
+  source->SetMaxDimensions(5, 5, 5);
+  VERIFY(source->NeedsInitialization(), "Source should need initialization.");
+  VERIFY(source->Initialize(wholeExtent, origin, spacing), "Failed to initialize.");
+  VERIFY(!source->NeedsInitialization(), "Source should be initialized.");
+
+  VERIFY(source->AddBrick(CreateBrick(0, 4)), "First brick was not added.");
+  source->Update();
+  auto image = vtkImageData::SafeDownCast(source->GetOutputDataObject(0));
+  VERIFY(image && image->GetNumberOfPoints() == 125, "Wrong resampled image dimensions.");
+  auto scalars = image->GetPointData()->GetArray("X");
+  VERIFY(scalars != nullptr, "Missing resampled array.");
+  // samples are at x = 0, 2, 4, 6, 8; the last two are not covered yet.
+  VERIFY(scalars->GetTuple1(2) == 4 && scalars->GetTuple1(4) == 0, "Wrong samples.");
+
+  VERIFY(source->AddBrick(CreateBrick(4, 8)), "Second brick was not added.");
+  for (vtkIdType cc = 0; cc < image->GetNumberOfPoints(); ++cc)
+  {
+    VERIFY(std::abs(scalars->GetTuple1(cc) - image->GetPoint(cc)[0]) < 1e-6, "Wrong samples.");
+  }
+
+  // restricting the spatial bounds increases the resolution.
+  source->SetSpatialBounds(0, 4, 0, 4, 0, 4);
+  VERIFY(source->NeedsInitialization(), "Source should need initialization.");
+  VERIFY(source->Initialize(wholeExtent, origin, spacing), "Failed to initialize.");
+  source->Update();
+  image = vtkImageData::SafeDownCast(source->GetOutputDataObject(0));
+  VERIFY(image->GetSpacing()[0] == 1, "Wrong resampled image spacing.");
+  VERIFY(!source->AddBrick(CreateBrick(6, 8)), "Brick outside the bounds should be skipped.");
+  return EXIT_SUCCESS;
+}
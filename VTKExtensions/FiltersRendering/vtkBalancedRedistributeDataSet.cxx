@@ -0,0 +1,514 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkBalancedRedistributeDataSet.h"
+
+#include "vtkAppendFilter.h"
+#include "vtkAppendPolyData.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDIYUtilities.h"
+#include "vtkDataArray.h"
+#include "vtkExtractCells.h"
+#include "vtkFieldData.h"
+#include "vtkIdList.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMultiProcessController.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnstructuredGrid.h"
+
+// clang-format off
+#include "vtk_diy2.h"
+#include VTK_DIY2(diy/assigner.hpp)
+#include VTK_DIY2(diy/decomposition.hpp)
+#include VTK_DIY2(diy/master.hpp)
+#include VTK_DIY2(diy/mpi.hpp)
+#include VTK_DIY2(diy/reduce-operations.hpp)
+// clang-format on
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+// A range of cells of one leaf, either sent to or received from Rank.
+struct vtkRedistributePiece
+{
+  int Leaf;
+  int Rank;
+  vtkSmartPointer<vtkDataSet> Data;
+};
+
+struct vtkRedistributeBlock
+{
+  std::vector<vtkRedistributePiece> Pieces;
+};
+
+//----------------------------------------------------------------------------
+// Cells of poly data are numbered vertices first, then lines, polygons and
+// strips. The range is copied cell array by cell array, so the cells keep
+// their order and type, and only the points they use are kept.
+vtkSmartPointer<vtkPolyData> ExtractPolyDataCellRange(
+  vtkPolyData* input, vtkIdType first, vtkIdType last)
+{
+  auto output = vtkSmartPointer<vtkPolyData>::New();
+  vtkCellData* inCD = input->GetCellData();
+  vtkCellData* outCD = output->GetCellData();
+  outCD->CopyAllocate(inCD, last - first + 1);
+
+  std::vector<vtkIdType> pointMap(input->GetNumberOfPoints(), -1);
+  vtkNew<vtkIdList> usedPoints;
+  vtkNew<vtkIdList> cell;
+  vtkCellArray* inCells[4] = { input->GetVerts(), input->GetLines(), input->GetPolys(),
+    input->GetStrips() };
+  vtkSmartPointer<vtkCellArray> outCells[4];
+  vtkIdType offset = 0;
+  vtkIdType outCellId = 0;
+  for (int type = 0; type < 4; ++type)
+  {
+    const vtkIdType numCells = inCells[type] ? inCells[type]->GetNumberOfCells() : 0;
+    const vtkIdType begin = std::max<vtkIdType>(first - offset, 0);
+    const vtkIdType end = std::min<vtkIdType>(last - offset + 1, numCells);
+    if (begin < end)
+    {
+      outCells[type] = vtkSmartPointer<vtkCellArray>::New();
+      for (vtkIdType cellId = begin; cellId < end; ++cellId)
+      {
+        inCells[type]->GetCellAtId(cellId, cell);
+        for (vtkIdType i = 0; i < cell->GetNumberOfIds(); ++i)
+        {
+          vtkIdType& pointId = pointMap[cell->GetId(i)];
+          if (pointId < 0)
+          {
+            pointId = usedPoints->GetNumberOfIds();
+            usedPoints->InsertNextId(cell->GetId(i));
+          }
+          cell->SetId(i, pointId);
+        }
+        outCells[type]->InsertNextCell(cell);
+        outCD->CopyData(inCD, offset + cellId, outCellId++);
+      }
+    }
+    offset += numCells;
+  }
+  output->SetVerts(outCells[0]);
+  output->SetLines(outCells[1]);
+  output->SetPolys(outCells[2]);
+  output->SetStrips(outCells[3]);
+
+  const vtkIdType numPoints = usedPoints->GetNumberOfIds();
+  vtkNew<vtkPoints> points;
+  points->SetDataType(input->GetPoints() ? input->GetPoints()->GetDataType() : VTK_FLOAT);
+  points->SetNumberOfPoints(numPoints);
+  if (numPoints > 0)
+  {
+    input->GetPoints()->GetPoints(usedPoints, points);
+  }
+  output->SetPoints(points);
+  vtkPointData* inPD = input->GetPointData();
+  vtkPointData* outPD = output->GetPointData();
+  outPD->CopyAllocate(inPD, numPoints);
+  for (vtkIdType pointId = 0; pointId < numPoints; ++pointId)
+  {
+    outPD->CopyData(inPD, usedPoints->GetId(pointId), pointId);
+  }
+  output->GetFieldData()->PassData(input->GetFieldData());
+  return output;
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataSet> ExtractCellRange(vtkDataSet* input, vtkIdType first, vtkIdType last)
+{
+  if (first == 0 && last == input->GetNumberOfCells() - 1)
+  {
+    return input;
+  }
+
+  if (auto polyData = vtkPolyData::SafeDownCast(input))
+  {
+    return ExtractPolyDataCellRange(polyData, first, last);
+  }
+  vtkNew<vtkExtractCells> extractor;
+  extractor->SetInputData(input);
+  extractor->AddCellRange(first, last);
+  extractor->Update();
+  return extractor->GetOutput();
+}
+
+//----------------------------------------------------------------------------
+// Pieces are expected in source rank order so the result is deterministic.
+vtkSmartPointer<vtkDataSet> MergePieces(
+  std::vector<vtkRedistributePiece>::const_iterator begin,
+  std::vector<vtkRedistributePiece>::const_iterator end)
+{
+  if (end - begin == 1)
+  {
+    vtkSmartPointer<vtkDataSet> result;
+    result.TakeReference(begin->Data->NewInstance());
+    result->ShallowCopy(begin->Data);
+    return result;
+  }
+
+  bool allPolyData = std::all_of(begin, end, [](const vtkRedistributePiece& piece) {
+    return vtkPolyData::SafeDownCast(piece.Data) != nullptr;
+  });
+  if (allPolyData)
+  {
+    vtkNew<vtkAppendPolyData> append;
+    for (auto iter = begin; iter != end; ++iter)
+    {
+      append->AddInputData(vtkPolyData::SafeDownCast(iter->Data));
+    }
+    append->Update();
+    return append->GetOutput();
+  }
+
+  vtkNew<vtkAppendFilter> append;
+  for (auto iter = begin; iter != end; ++iter)
+  {
+    append->AddInputData(iter->Data);
+  }
+  append->Update();
+  return append->GetOutput();
+}
+}
+
+vtkStandardNewMacro(vtkBalancedRedistributeDataSet);
+vtkCxxSetObjectMacro(vtkBalancedRedistributeDataSet, Controller, vtkMultiProcessController);
+//----------------------------------------------------------------------------
+vtkBalancedRedistributeDataSet::vtkBalancedRedistributeDataSet()
+{
+  this->Controller = nullptr;
+  this->NumberOfProcesses = 0;
+  this->BalanceMode = BALANCE_CELL_COUNT;
+  this->CostArrayName = nullptr;
+  this->SetController(vtkMultiProcessController::GetGlobalController());
+}
+
+//----------------------------------------------------------------------------
+vtkBalancedRedistributeDataSet::~vtkBalancedRedistributeDataSet()
+{
+  this->SetController(nullptr);
+  this->SetCostArrayName(nullptr);
+}
+
+//----------------------------------------------------------------------------
+int vtkBalancedRedistributeDataSet::FillInputPortInformation(
+  int vtkNotUsed(port), vtkInformation* info)
+{
+  info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkDataSet");
+  info->Append(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkCompositeDataSet");
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkBalancedRedistributeDataSet::RequestDataObject(
+  vtkInformation*, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  vtkDataObject* input = vtkDataObject::GetData(inputVector[0], 0);
+  vtkDataObject* output = vtkDataObject::GetData(outputVector, 0);
+  if (!input)
+  {
+    return 0;
+  }
+
+  // Composite datasets keep their type, poly data stays poly data and every
+  // other dataset becomes an unstructured grid.
+  int outputType = VTK_UNSTRUCTURED_GRID;
+  if (vtkCompositeDataSet::SafeDownCast(input))
+  {
+    outputType = input->GetDataObjectType();
+  }
+  else if (vtkPolyData::SafeDownCast(input))
+  {
+    outputType = VTK_POLY_DATA;
+  }
+
+  if (!output || output->GetDataObjectType() != outputType)
+  {
+    if (vtkCompositeDataSet::SafeDownCast(input))
+    {
+      output = input->NewInstance();
+    }
+    else if (outputType == VTK_POLY_DATA)
+    {
+      output = vtkPolyData::New();
+    }
+    else
+    {
+      output = vtkUnstructuredGrid::New();
+    }
+    outputVector->GetInformationObject(0)->Set(vtkDataObject::DATA_OBJECT(), output);
+    output->FastDelete();
+  }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkBalancedRedistributeDataSet::RequestData(
+  vtkInformation*, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  vtkDataObject* input = vtkDataObject::GetData(inputVector[0], 0);
+  vtkDataObject* output = vtkDataObject::GetData(outputVector, 0);
+
+  const int numProcs = this->Controller ? this->Controller->GetNumberOfProcesses() : 1;
+  const int myRank = this->Controller ? this->Controller->GetLocalProcessId() : 0;
+  const int numTargets = (this->NumberOfProcesses < 1 || this->NumberOfProcesses > numProcs)
+    ? numProcs
+    : this->NumberOfProcesses;
+
+  // Leaves are listed in the same order on every rank, including empty ones.
+  std::vector<vtkDataSet*> leaves;
+  vtkCompositeDataSet* cdInput = vtkCompositeDataSet::SafeDownCast(input);
+  if (cdInput)
+  {
+    vtkSmartPointer<vtkCompositeDataIterator> iter;
+    iter.TakeReference(cdInput->NewIterator());
+    iter->SkipEmptyNodesOff();
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+      leaves.push_back(vtkDataSet::SafeDownCast(iter->GetCurrentDataObject()));
+    }
+  }
+  else
+  {
+    leaves.push_back(vtkDataSet::SafeDownCast(input));
+  }
+
+  // Cost of the local cells and of the cells on every rank.
+  std::vector<vtkDataArray*> costArrays(leaves.size(), nullptr);
+  if (this->BalanceMode == BALANCE_COST_ARRAY && this->CostArrayName)
+  {
+    for (size_t leaf = 0; leaf < leaves.size(); ++leaf)
+    {
+      if (leaves[leaf])
+      {
+        costArrays[leaf] = leaves[leaf]->GetCellData()->GetArray(this->CostArrayName);
+      }
+    }
+  }
+  auto cellCost = [&costArrays](size_t leaf, vtkIdType cellId) {
+    return costArrays[leaf] ? std::max(0.0, costArrays[leaf]->GetComponent(cellId, 0)) : 1.0;
+  };
+
+  std::vector<double> rankCosts(numProcs, 0.0);
+  double totalCost = 0.0;
+  for (int pass = 0; pass < 2; ++pass)
+  {
+    double localCost = 0.0;
+    for (size_t leaf = 0; leaf < leaves.size(); ++leaf)
+    {
+      const vtkIdType numCells = leaves[leaf] ? leaves[leaf]->GetNumberOfCells() : 0;
+      for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+      {
+        localCost += cellCost(leaf, cellId);
+      }
+    }
+    if (numProcs > 1)
+    {
+      this->Controller->AllGather(&localCost, rankCosts.data(), 1);
+    }
+    else
+    {
+      rankCosts[0] = localCost;
+    }
+    totalCost = 0.0;
+    for (double cost : rankCosts)
+    {
+      totalCost += cost;
+    }
+    if (totalCost > 0.0 || pass == 1)
+    {
+      break;
+    }
+    // All costs are zero: balance the number of cells instead.
+    std::fill(costArrays.begin(), costArrays.end(), nullptr);
+  }
+
+  // Walk the cells in global order and cut them into consecutive ranges of
+  // equal cost. Ranges for this rank are kept, the others are sent.
+  std::vector<vtkRedistributePiece> received;
+  std::vector<vtkRedistributePiece> outgoing;
+  double position = 0.0;
+  for (int rank = 0; rank < myRank; ++rank)
+  {
+    position += rankCosts[rank];
+  }
+  for (size_t leaf = 0; totalCost > 0.0 && leaf < leaves.size(); ++leaf)
+  {
+    vtkDataSet* dataSet = leaves[leaf];
+    const vtkIdType numCells = dataSet ? dataSet->GetNumberOfCells() : 0;
+    auto addRange = [&](int target, vtkIdType first, vtkIdType last) {
+      vtkRedistributePiece piece{ static_cast<int>(leaf), target,
+        ExtractCellRange(dataSet, first, last) };
+      if (target == myRank)
+      {
+        received.push_back(piece);
+      }
+      else
+      {
+        outgoing.push_back(piece);
+      }
+    };
+
+    int rangeTarget = -1;
+    vtkIdType rangeStart = 0;
+    for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+    {
+      const double cost = cellCost(leaf, cellId);
+      const int target = std::min(
+        numTargets - 1, static_cast<int>((position + 0.5 * cost) * numTargets / totalCost));
+      position += cost;
+      if (target != rangeTarget)
+      {
+        if (rangeTarget >= 0)
+        {
+          addRange(rangeTarget, rangeStart, cellId - 1);
+        }
+        rangeTarget = target;
+        rangeStart = cellId;
+      }
+    }
+    if (rangeTarget >= 0)
+    {
+      addRange(rangeTarget, rangeStart, numCells - 1);
+    }
+  }
+
+  if (numProcs > 1)
+  {
+    diy::mpi::communicator comm = vtkDIYUtilities::GetCommunicator(this->Controller);
+    diy::Master master(
+      comm, 1, -1, []() { return static_cast<void*>(new vtkRedistributeBlock); },
+      [](void* block) { delete static_cast<vtkRedistributeBlock*>(block); });
+    diy::ContiguousAssigner assigner(comm.size(), comm.size());
+    diy::RegularDecomposer<diy::DiscreteBounds> decomposer(
+      /*dim*/ 1, diy::interval(0, comm.size() - 1), comm.size());
+    decomposer.decompose(comm.rank(), assigner, master);
+
+    diy::all_to_all(master, assigner,
+      [&outgoing](vtkRedistributeBlock* block, const diy::ReduceProxy& rp) {
+        if (rp.in_link().size() == 0)
+        {
+          for (const auto& piece : outgoing)
+          {
+            const diy::BlockID dest = rp.out_link().target(piece.Rank);
+            rp.enqueue(dest, piece.Leaf);
+            vtkDataSet* dataSet = piece.Data;
+            rp.enqueue<vtkDataSet*>(dest, dataSet);
+          }
+        }
+        else
+        {
+          for (int i = 0; i < rp.in_link().size(); ++i)
+          {
+            const diy::BlockID src = rp.in_link().target(i);
+            while (rp.incoming(src.gid))
+            {
+              vtkRedistributePiece piece;
+              piece.Rank = src.gid;
+              rp.dequeue(src, piece.Leaf);
+              vtkDataSet* dataSet = nullptr;
+              rp.dequeue<vtkDataSet*>(src, dataSet);
+              piece.Data.TakeReference(dataSet);
+              if (piece.Data)
+              {
+                block->Pieces.push_back(piece);
+              }
+            }
+          }
+        }
+      });
+    outgoing.clear();
+
+    auto block = static_cast<vtkRedistributeBlock*>(master.block(0));
+    received.insert(received.end(), block->Pieces.begin(), block->Pieces.end());
+  }
+
+  // Append the pieces of every leaf in source rank order.
+  std::stable_sort(received.begin(), received.end(),
+    [](const vtkRedistributePiece& a, const vtkRedistributePiece& b) {
+      return a.Leaf < b.Leaf || (a.Leaf == b.Leaf && a.Rank < b.Rank);
+    });
+  std::vector<vtkSmartPointer<vtkDataSet>> merged(leaves.size());
+  for (auto begin = received.cbegin(); begin != received.cend();)
+  {
+    auto end = std::find_if(begin, received.cend(),
+      [begin](const vtkRedistributePiece& piece) { return piece.Leaf != begin->Leaf; });
+    if (begin->Leaf >= 0 && begin->Leaf < static_cast<int>(merged.size()))
+    {
+      merged[begin->Leaf] = MergePieces(begin, end);
+    }
+    else
+    {
+      vtkWarningMacro("Received block " << begin->Leaf << " that does not exist on rank "
+                                        << myRank << ". The input structure must be the same "
+                                        << "on all ranks.");
+    }
+    begin = end;
+  }
+
+  vtkCompositeDataSet* cdOutput = vtkCompositeDataSet::SafeDownCast(output);
+  if (!cdInput)
+  {
+    vtkDataSet* result = merged[0];
+    if (result && vtkPolyData::SafeDownCast(output) && !vtkPolyData::SafeDownCast(result))
+    {
+      vtkErrorMacro("Received " << result->GetClassName() << " for poly data on rank " << myRank
+                                << ". The input type must be the same on all ranks.");
+      return 0;
+    }
+    if (result && result->GetDataObjectType() != output->GetDataObjectType())
+    {
+      // A dataset of another type was moved as a whole.
+      vtkNew<vtkAppendFilter> converter;
+      converter->AddInputData(result);
+      converter->Update();
+      result = converter->GetOutput();
+      output->ShallowCopy(result);
+    }
+    else if (result)
+    {
+      output->ShallowCopy(result);
+    }
+    return 1;
+  }
+
+  cdOutput->CopyStructure(cdInput);
+  vtkSmartPointer<vtkCompositeDataIterator> iter;
+  iter.TakeReference(cdOutput->NewIterator());
+  iter->SkipEmptyNodesOff();
+  size_t leaf = 0;
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem(), ++leaf)
+  {
+    if (merged[leaf])
+    {
+      cdOutput->SetDataSet(iter, merged[leaf]);
+    }
+    else if (leaves[leaf])
+    {
+      vtkSmartPointer<vtkDataSet> empty;
+      empty.TakeReference(leaves[leaf]->NewInstance());
+      cdOutput->SetDataSet(iter, empty);
+    }
+  }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkBalancedRedistributeDataSet::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Controller: " << this->Controller << endl;
+  os << indent << "NumberOfProcesses: " << this->NumberOfProcesses << endl;
+  os << indent << "BalanceMode: " << this->BalanceMode << endl;
+  os << indent << "CostArrayName: " << (this->CostArrayName ? this->CostArrayName : "(none)")
+     << endl;
+}
@@ -0,0 +1,105 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkBalancedRedistributeDataSet
+ * @brief   balance cells over a number of ranks with a DIY all-to-all exchange
+ *
+ * vtkBalancedRedistributeDataSet moves cells between ranks so that the first
+ * NumberOfProcesses ranks end up with about the same cost. The cost of a cell
+ * is either 1 (BALANCE_CELL_COUNT) or the value of the cell array named
+ * CostArrayName (BALANCE_COST_ARRAY). Cells are assigned to ranks in the global
+ * order (rank, block, cell id), so neighboring cells of the input stay together
+ * and every rank exchanges data with only a few others. All pieces are
+ * exchanged in a single DIY all-to-all, so there is no serialized schedule
+ * between ranks.
+ *
+ * Any vtkDataSet is supported. Poly data stays poly data: its cells keep
+ * their order and type, so vertices, lines and strips are moved as they are.
+ * Other datasets become unstructured grids, except for the leaves of a
+ * composite dataset that are moved as a whole, which keep their type. The
+ * pieces are appended on the receiving rank. For composite datasets every
+ * leaf is redistributed and the output has the structure of the input, which
+ * must be the same on all ranks.
+ *
+ * This supersedes vtkAllToNRedistributeCompositePolyData and the
+ * vtkRedistributePolyData family of filters.
+ */
+
+#ifndef vtkBalancedRedistributeDataSet_h
+#define vtkBalancedRedistributeDataSet_h
+
+#include "vtkDataObjectAlgorithm.h"
+#include "vtkPVVTKExtensionsFiltersRenderingModule.h" // needed for export macro
+
+class vtkMultiProcessController;
+
+class VTKPVVTKEXTENSIONSFILTERSRENDERING_EXPORT vtkBalancedRedistributeDataSet
+  : public vtkDataObjectAlgorithm
+{
+public:
+  static vtkBalancedRedistributeDataSet* New();
+  vtkTypeMacro(vtkBalancedRedistributeDataSet, vtkDataObjectAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  enum BalanceModes
+  {
+    BALANCE_CELL_COUNT = 0,
+    BALANCE_COST_ARRAY = 1
+  };
+
+  ///@{
+  /**
+   * The controller used to exchange data. Defaults to the global controller.
+   */
+  virtual void SetController(vtkMultiProcessController*);
+  vtkGetObjectMacro(Controller, vtkMultiProcessController);
+  ///@}
+
+  ///@{
+  /**
+   * Number of ranks, starting at rank 0, that receive the data. A value
+   * smaller than 1 or larger than the number of ranks uses all ranks.
+   * Default is 0.
+   */
+  vtkSetMacro(NumberOfProcesses, int);
+  vtkGetMacro(NumberOfProcesses, int);
+  ///@}
+
+  ///@{
+  /**
+   * Choose what is balanced: the number of cells or the sum of the cell array
+   * CostArrayName. Default is BALANCE_CELL_COUNT.
+   */
+  vtkSetClampMacro(BalanceMode, int, BALANCE_CELL_COUNT, BALANCE_COST_ARRAY);
+  vtkGetMacro(BalanceMode, int);
+  ///@}
+
+  ///@{
+  /**
+   * Name of the cell array giving the cost of each cell when BalanceMode is
+   * BALANCE_COST_ARRAY. Negative costs count as 0 and blocks without the
+   * array use a cost of 1 per cell.
+   */
+  vtkSetStringMacro(CostArrayName);
+  vtkGetStringMacro(CostArrayName);
+  ///@}
+
+protected:
+  vtkBalancedRedistributeDataSet();
+  ~vtkBalancedRedistributeDataSet() override;
+
+  int FillInputPortInformation(int port, vtkInformation* info) override;
+  int RequestDataObject(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+
+  vtkMultiProcessController* Controller;
+  int NumberOfProcesses;
+  int BalanceMode;
+  char* CostArrayName;
+
+private:
+  vtkBalancedRedistributeDataSet(const vtkBalancedRedistributeDataSet&) = delete;
+  void operator=(const vtkBalancedRedistributeDataSet&) = delete;
+};
+
+#endif
@@ -3,7 +3,7 @@
 // SPDX-License-Identifier: BSD-3-Clause
 #include "vtkMPIMoveData.h"
 
-#include "vtkAllToNRedistributeCompositePolyData.h"
+#include "vtkBalancedRedistributeDataSet.h"
 #include "vtkCellData.h"
 #include "vtkCharArray.h"
 #include "vtkCompositeDataIterator.h"
@@ -17,6 +17,7 @@
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiProcessController.h"
 #include "vtkMultiProcessControllerHelper.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkOutlineFilter.h"
 #include "vtkPVLogger.h"
@@ -479,8 +480,8 @@ int vtkMPIMoveData::RequestData(
 }
 
 //-----------------------------------------------------------------------------
-// Use LANL filter to redistribute the data.
-// We will marshal more than once, but that is OK.
+// Redistribute the data over the first n processes with a balanced
+// all-to-all exchange.
 void vtkMPIMoveData::DataServerAllToN(vtkDataObject* input, vtkDataObject* output, int n)
 {
   vtkMultiProcessController* controller = this->Controller;
@@ -500,7 +501,7 @@ void vtkMPIMoveData::DataServerAllToN(vtkDataObject* input, vtkDataObject* outpu
   }
   if (input == nullptr || output == nullptr)
   {
-    vtkErrorMacro("All to N only works for poly data currently.");
+    vtkErrorMacro("Missing input or output for the All to N redistribution.");
     return;
   }
 
@@ -513,15 +514,12 @@ void vtkMPIMoveData::DataServerAllToN(vtkDataObject* input, vtkDataObject* outpu
 
   // Perform the M to N operation.
   vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "redistribute MxN (M=%d, N=%d)", m, n);
-  vtkAllToNRedistributeCompositePolyData* AllToN = nullptr;
-  AllToN = vtkAllToNRedistributeCompositePolyData::New();
-  AllToN->SetController(controller);
-  AllToN->SetNumberOfProcesses(n);
-  AllToN->SetInputData(input);
-  AllToN->Update();
-  output->ShallowCopy(AllToN->GetOutputDataObject(0));
-  AllToN->Delete();
-  AllToN = nullptr;
+  vtkNew<vtkBalancedRedistributeDataSet> allToN;
+  allToN->SetController(controller);
+  allToN->SetNumberOfProcesses(n);
+  allToN->SetInputData(input);
+  allToN->Update();
+  output->ShallowCopy(allToN->GetOutputDataObject(0));
 }
 
 //-----------------------------------------------------------------------------
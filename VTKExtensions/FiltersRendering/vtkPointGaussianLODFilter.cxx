@@ -0,0 +1,326 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkPointGaussianLODFilter.h"
+
+#include "vtkArrayDispatch.h"
+#include "vtkCellArray.h"
+#include "vtkDataArrayRange.h"
+#include "vtkFieldData.h"
+#include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPiecewiseFunction.h"
+#include "vtkPointData.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace
+{
+using LeafKey = std::pair<vtkTypeUInt64, vtkIdType>;
+
+vtkTypeUInt64 MortonCode(const int ijk[3], int depth)
+{
+  vtkTypeUInt64 code = 0;
+  for (int bit = 0; bit < depth; ++bit)
+  {
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      code |= static_cast<vtkTypeUInt64>((ijk[axis] >> bit) & 1) << (3 * bit + axis);
+    }
+  }
+  return code;
+}
+
+// Computes the key of the octree leaf containing each point.
+struct ComputeKeysWorker
+{
+  template <typename ArrayT>
+  void operator()(ArrayT* points, const double bounds[6], int depth, std::vector<LeafKey>& keys)
+  {
+    const int numLeaves = 1 << depth;
+    double scale[3];
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      const double length = bounds[2 * axis + 1] - bounds[2 * axis];
+      scale[axis] = length > 0.0 ? numLeaves / length : 0.0;
+    }
+
+    vtkSMPTools::For(0, points->GetNumberOfTuples(), [&](vtkIdType begin, vtkIdType end) {
+      vtkIdType ptId = begin;
+      for (const auto point : vtk::DataArrayTupleRange<3>(points, begin, end))
+      {
+        int ijk[3];
+        for (int axis = 0; axis < 3; ++axis)
+        {
+          ijk[axis] = vtkMath::ClampValue(
+            static_cast<int>((point[axis] - bounds[2 * axis]) * scale[axis]), 0, numLeaves - 1);
+        }
+        keys[ptId] = LeafKey(MortonCode(ijk, depth), ptId);
+        ++ptId;
+      }
+    });
+  }
+};
+}
+
+vtkStandardNewMacro(vtkPointGaussianLODFilter);
+//----------------------------------------------------------------------------
+vtkPointGaussianLODFilter::vtkPointGaussianLODFilter() = default;
+
+//----------------------------------------------------------------------------
+vtkPointGaussianLODFilter::~vtkPointGaussianLODFilter()
+{
+  this->SetColorArrayName(nullptr);
+  this->SetOpacityArrayName(nullptr);
+  this->SetScaleArrayName(nullptr);
+}
+
+//----------------------------------------------------------------------------
+void vtkPointGaussianLODFilter::SetScaleFunction(vtkPiecewiseFunction* function)
+{
+  if (this->ScaleFunction != function)
+  {
+    this->ScaleFunction = function;
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkPiecewiseFunction* vtkPointGaussianLODFilter::GetScaleFunction()
+{
+  return this->ScaleFunction;
+}
+
+//----------------------------------------------------------------------------
+vtkMTimeType vtkPointGaussianLODFilter::GetMTime()
+{
+  vtkMTimeType mtime = this->Superclass::GetMTime();
+  if (this->ScaleFunction)
+  {
+    mtime = std::max(mtime, this->ScaleFunction->GetMTime());
+  }
+  return mtime;
+}
+
+//----------------------------------------------------------------------------
+int vtkPointGaussianLODFilter::FillInputPortInformation(int, vtkInformation* info)
+{
+  info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkPointSet");
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkPointGaussianLODFilter::RequestData(
+  vtkInformation*, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  auto input = vtkPointSet::GetData(inputVector[0], 0);
+  auto output = vtkPolyData::GetData(outputVector, 0);
+
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  if (numPts == 0)
+  {
+    return 1;
+  }
+
+  double bounds[6];
+  input->GetBounds(bounds);
+
+  std::vector<LeafKey> keys(numPts);
+  vtkDataArray* inPoints = input->GetPoints()->GetData();
+  ComputeKeysWorker worker;
+  using Dispatcher = vtkArrayDispatch::DispatchByValueType<vtkArrayDispatch::Reals>;
+  if (!Dispatcher::Execute(inPoints, worker, bounds, this->Depth, keys))
+  {
+    worker(inPoints, bounds, this->Depth, keys);
+  }
+  vtkSMPTools::Sort(keys.begin(), keys.end());
+
+  // offsets of the first point of each occupied leaf in `keys`.
+  std::vector<vtkIdType> leafOffsets;
+  for (vtkIdType cc = 0; cc < numPts; ++cc)
+  {
+    if (cc == 0 || keys[cc].first != keys[cc - 1].first)
+    {
+      leafOffsets.push_back(cc);
+    }
+  }
+  leafOffsets.push_back(numPts);
+  const vtkIdType numLeaves = static_cast<vtkIdType>(leafOffsets.size()) - 1;
+
+  vtkNew<vtkPoints> outPoints;
+  outPoints->SetDataType(inPoints->GetDataType());
+  outPoints->SetNumberOfPoints(numLeaves);
+
+  // only the color and opacity arrays are averaged.
+  vtkPointData* inPD = input->GetPointData();
+  vtkPointData* outPD = output->GetPointData();
+  std::vector<std::pair<vtkDataArray*, vtkDataArray*>> arrays;
+  for (int idx = 0; idx < inPD->GetNumberOfArrays(); ++idx)
+  {
+    vtkDataArray* array = inPD->GetArray(idx);
+    if (array == nullptr || array->GetName() == nullptr ||
+      ((this->ColorArrayName == nullptr || strcmp(array->GetName(), this->ColorArrayName) != 0) &&
+        (this->OpacityArrayName == nullptr ||
+          strcmp(array->GetName(), this->OpacityArrayName) != 0)))
+    {
+      continue;
+    }
+    auto outArray = vtkSmartPointer<vtkDataArray>::Take(array->NewInstance());
+    outArray->SetName(array->GetName());
+    outArray->SetNumberOfComponents(array->GetNumberOfComponents());
+    outArray->CopyComponentNames(array);
+    outArray->SetNumberOfTuples(numLeaves);
+    const int outIdx = outPD->AddArray(outArray);
+    const int attribute = inPD->IsArrayAnAttribute(idx);
+    if (attribute >= 0)
+    {
+      outPD->SetActiveAttribute(outIdx, attribute);
+    }
+    arrays.emplace_back(array, outArray);
+  }
+
+  // the splat radius of the input points, as computed by vtkPointGaussianMapper,
+  // with the scale function sampled in a table.
+  vtkDataArray* scaleArray = this->ScaleArrayName ? inPD->GetArray(this->ScaleArrayName) : nullptr;
+  int scaleComp = 0;
+  if (scaleArray && this->ScaleArrayComponent < scaleArray->GetNumberOfComponents())
+  {
+    scaleComp = this->ScaleArrayComponent;
+  }
+  std::vector<double> scaleTable;
+  double scaleRange[2] = { 0.0, 0.0 };
+  if (scaleArray && this->ScaleFunction)
+  {
+    scaleTable.resize(1024);
+    this->ScaleFunction->GetRange(scaleRange);
+    this->ScaleFunction->GetTable(
+      scaleRange[0], scaleRange[1], static_cast<int>(scaleTable.size()), scaleTable.data());
+  }
+  auto splatRadius = [&](vtkIdType ptId) {
+    if (!scaleArray)
+    {
+      return this->ScaleFactor;
+    }
+    double scale = scaleArray->GetComponent(ptId, scaleComp);
+    if (!scaleTable.empty())
+    {
+      const double range = scaleRange[1] - scaleRange[0];
+      const int last = static_cast<int>(scaleTable.size()) - 1;
+      const int idx = range > 0.0
+        ? vtkMath::ClampValue(
+            static_cast<int>((scale - scaleRange[0]) * last / range + 0.5), 0, last)
+        : 0;
+      scale = scaleTable[idx];
+    }
+    return this->ScaleFactor * scale;
+  };
+
+  vtkNew<vtkFloatArray> lodScale;
+  lodScale->SetName(vtkPointGaussianLODFilter::GetLODScaleArrayName());
+  lodScale->SetNumberOfTuples(numLeaves);
+  outPD->AddArray(lodScale);
+
+  vtkSMPTools::For(0, numLeaves, [&](vtkIdType begin, vtkIdType end) {
+    std::vector<double> tuple, sum;
+    for (vtkIdType leaf = begin; leaf < end; ++leaf)
+    {
+      const vtkIdType first = leafOffsets[leaf];
+      const vtkIdType last = leafOffsets[leaf + 1];
+      const double weight = 1.0 / (last - first);
+
+      double centroid[3] = { 0.0, 0.0, 0.0 };
+      for (vtkIdType cc = first; cc < last; ++cc)
+      {
+        double x[3];
+        inPoints->GetTuple(keys[cc].second, x);
+        vtkMath::Add(centroid, x, centroid);
+      }
+      vtkMath::MultiplyScalar(centroid, weight);
+      outPoints->SetPoint(leaf, centroid);
+
+      // the smallest splat centered at the centroid covering those of the leaf.
+      double radius = 0.0;
+      for (vtkIdType cc = first; cc < last; ++cc)
+      {
+        double x[3];
+        inPoints->GetTuple(keys[cc].second, x);
+        radius = std::max(radius,
+          std::sqrt(vtkMath::Distance2BetweenPoints(x, centroid)) +
+            std::abs(splatRadius(keys[cc].second)));
+      }
+      lodScale->SetValue(leaf, static_cast<float>(radius));
+
+      for (const auto& array : arrays)
+      {
+        const int numComps = array.first->GetNumberOfComponents();
+        tuple.resize(numComps);
+        sum.assign(numComps, 0.0);
+        for (vtkIdType cc = first; cc < last; ++cc)
+        {
+          array.first->GetTuple(keys[cc].second, tuple.data());
+          for (int comp = 0; comp < numComps; ++comp)
+          {
+            sum[comp] += tuple[comp];
+          }
+        }
+        for (int comp = 0; comp < numComps; ++comp)
+        {
+          sum[comp] *= weight;
+        }
+        array.second->SetTuple(leaf, sum.data());
+      }
+    }
+  });
+
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numLeaves + 1);
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(numLeaves);
+  vtkSMPTools::For(0, numLeaves + 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      offsets->SetValue(cc, cc);
+      if (cc < numLeaves)
+      {
+        connectivity->SetValue(cc, cc);
+      }
+    }
+  });
+  vtkNew<vtkCellArray> verts;
+  verts->SetData(offsets, connectivity);
+
+  output->SetPoints(outPoints);
+  output->SetVerts(verts);
+  output->GetFieldData()->PassData(input->GetFieldData());
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkPointGaussianLODFilter::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Depth: " << this->Depth << endl;
+  os << indent << "ColorArrayName: " << (this->ColorArrayName ? this->ColorArrayName : "(none)")
+     << endl;
+  os << indent
+     << "OpacityArrayName: " << (this->OpacityArrayName ? this->OpacityArrayName : "(none)")
+     << endl;
+  os << indent << "ScaleFactor: " << this->ScaleFactor << endl;
+  os << indent << "ScaleArrayName: " << (this->ScaleArrayName ? this->ScaleArrayName : "(none)")
+     << endl;
+  os << indent << "ScaleArrayComponent: " << this->ScaleArrayComponent << endl;
+  os << indent << "ScaleFunction: " << this->ScaleFunction << endl;
+}
@@ -0,0 +1,122 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkPointGaussianLODFilter
+ * @brief   aggregates a point cloud into the leaves of an octree
+ *
+ * vtkPointGaussianLODFilter builds a reduced point cloud used as the LOD of
+ * vtkPointGaussianRepresentation. The bounds of the input are subdivided
+ * into the leaves of a complete octree of the given Depth, and all the input
+ * points falling in the same leaf are replaced by a single point, at their
+ * centroid. The output thus has at most 8^Depth points, each with a vertex
+ * cell, sorted along a Morton curve.
+ *
+ * Only the color and opacity arrays are passed, as the mean of the values of
+ * the points of each leaf. The radius of the splat of each input point is
+ * computed as vtkPointGaussianMapper does, from ScaleFactor, ScaleArrayName
+ * and ScaleFunction, and the output has a float array, named
+ * GetLODScaleArrayName(), holding the radius of a splat that covers all the
+ * splats aggregated in its leaf. It is meant to be used as scale array of a
+ * vtkPointGaussianMapper with a scale factor of 1 and no scale function.
+ *
+ * Only the occupied leaves are generated. The leaf of each point is computed
+ * and sorted, and the leaves are aggregated, using vtkSMPTools.
+ */
+
+#ifndef vtkPointGaussianLODFilter_h
+#define vtkPointGaussianLODFilter_h
+
+#include "vtkPVVTKExtensionsFiltersRenderingModule.h" // needed for export macro
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkSmartPointer.h" // for vtkSmartPointer
+
+class vtkPiecewiseFunction;
+
+class VTKPVVTKEXTENSIONSFILTERSRENDERING_EXPORT vtkPointGaussianLODFilter
+  : public vtkPolyDataAlgorithm
+{
+public:
+  static vtkPointGaussianLODFilter* New();
+  vtkTypeMacro(vtkPointGaussianLODFilter, vtkPolyDataAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * Get/Set the depth of the octree. Default is 7, i.e. at most 128 points
+   * along each axis.
+   */
+  vtkSetClampMacro(Depth, int, 1, 10);
+  vtkGetMacro(Depth, int);
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set the names of the point arrays used for coloring and opacity. They
+   * are the only arrays averaged in the output. Default is none.
+   */
+  vtkSetStringMacro(ColorArrayName);
+  vtkGetStringMacro(ColorArrayName);
+  vtkSetStringMacro(OpacityArrayName);
+  vtkGetStringMacro(OpacityArrayName);
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set the splat radius, or the factor applied to the scale array if
+   * ScaleArrayName is set. Default is 1.
+   */
+  vtkSetMacro(ScaleFactor, double);
+  vtkGetMacro(ScaleFactor, double);
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set the point array, and its component, scaling the splats. Default
+   * is none.
+   */
+  vtkSetStringMacro(ScaleArrayName);
+  vtkGetStringMacro(ScaleArrayName);
+  vtkSetMacro(ScaleArrayComponent, int);
+  vtkGetMacro(ScaleArrayComponent, int);
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set the function mapping the scale array to the splat scale. Default
+   * is none.
+   */
+  void SetScaleFunction(vtkPiecewiseFunction* function);
+  vtkPiecewiseFunction* GetScaleFunction();
+  ///@}
+
+  /**
+   * Name of the output array holding the radius of the aggregated splats.
+   */
+  static const char* GetLODScaleArrayName() { return "PointGaussianLODScale"; }
+
+  /**
+   * Overridden to take the scale function into account.
+   */
+  vtkMTimeType GetMTime() override;
+
+protected:
+  vtkPointGaussianLODFilter();
+  ~vtkPointGaussianLODFilter() override;
+
+  int FillInputPortInformation(int port, vtkInformation* info) override;
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+
+  int Depth = 7;
+  char* ColorArrayName = nullptr;
+  char* OpacityArrayName = nullptr;
+  double ScaleFactor = 1.0;
+  char* ScaleArrayName = nullptr;
+  int ScaleArrayComponent = 0;
+  vtkSmartPointer<vtkPiecewiseFunction> ScaleFunction;
+
+private:
+  vtkPointGaussianLODFilter(const vtkPointGaussianLODFilter&) = delete;
+  void operator=(const vtkPointGaussianLODFilter&) = delete;
+};
+
+#endif
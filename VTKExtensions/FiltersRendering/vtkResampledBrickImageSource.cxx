@@ -0,0 +1,204 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkResampledBrickImageSource.h"
+
+#include "vtkBoundingBox.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkImageData.h"
+#include "vtkMath.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVStreamingMacros.h"
+#include "vtkPointData.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+// Resizes the arrays allocated by CopyAllocate() and zeroes them, so that
+// samples not covered by any brick yet are well defined.
+void ResizeArrays(vtkPointData* pd, vtkIdType numSamples)
+{
+  for (int cc = 0; cc < pd->GetNumberOfArrays(); ++cc)
+  {
+    vtkAbstractArray* array = pd->GetAbstractArray(cc);
+    array->SetNumberOfTuples(numSamples);
+    if (auto dataArray = vtkDataArray::SafeDownCast(array))
+    {
+      dataArray->Fill(0.0);
+    }
+  }
+}
+}
+
+vtkStandardNewMacro(vtkResampledBrickImageSource);
+//----------------------------------------------------------------------------
+vtkResampledBrickImageSource::vtkResampledBrickImageSource()
+{
+  this->MaxDimensions[0] = this->MaxDimensions[1] = this->MaxDimensions[2] = 128;
+  vtkMath::UninitializeBounds(this->SpatialBounds);
+}
+
+//----------------------------------------------------------------------------
+vtkResampledBrickImageSource::~vtkResampledBrickImageSource() = default;
+
+//----------------------------------------------------------------------------
+void vtkResampledBrickImageSource::Reset()
+{
+  vtkMath::UninitializeBounds(this->SpatialBounds);
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+bool vtkResampledBrickImageSource::Initialize(
+  const int wholeExtent[6], const double origin[3], const double spacing[3])
+{
+  double bounds[6];
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    if (wholeExtent[2 * axis] > wholeExtent[2 * axis + 1])
+    {
+      vtkStreamingStatusMacro("Insufficient data. Image is empty.");
+      return false;
+    }
+    bounds[2 * axis] = origin[axis] + wholeExtent[2 * axis] * spacing[axis];
+    bounds[2 * axis + 1] = origin[axis] + wholeExtent[2 * axis + 1] * spacing[axis];
+  }
+
+  vtkBoundingBox bbox(bounds);
+  if (vtkMath::AreBoundsInitialized(this->SpatialBounds) && bbox.IntersectBox(this->SpatialBounds))
+  {
+    bbox.GetBounds(bounds);
+  }
+
+  // the number of samples is clamped to the value the user specified, but not
+  // more than the resolution available in the data itself.
+  int dimensions[3];
+  double outSpacing[3];
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    const double length = bounds[2 * axis + 1] - bounds[2 * axis];
+    const int dataDimensions = static_cast<int>(std::floor(length / spacing[axis])) + 1;
+    dimensions[axis] = std::max(1, std::min(dataDimensions, this->MaxDimensions[axis]));
+    outSpacing[axis] = dimensions[axis] > 1 ? length / (dimensions[axis] - 1) : spacing[axis];
+  }
+
+  vtkStreamingStatusMacro("resampled image resolution: " << dimensions[0] << ", " << dimensions[1]
+                                                         << ", " << dimensions[2]);
+
+  auto output = vtkSmartPointer<vtkImageData>::New();
+  output->SetDimensions(dimensions);
+  output->SetOrigin(bounds[0], bounds[2], bounds[4]);
+  output->SetSpacing(outSpacing);
+
+  // arrays are allocated when the first brick is added.
+  this->ResampledImage = output;
+  this->ResampledCellData = nullptr;
+
+  this->SetOutput(output);
+  this->InitializationTime.Modified();
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkResampledBrickImageSource::AddBrick(vtkImageData* brick)
+{
+  if (this->ResampledImage == nullptr || brick == nullptr || brick->GetNumberOfPoints() == 0)
+  {
+    return false;
+  }
+
+  vtkImageData* output = this->ResampledImage;
+  vtkPointData* outPD = output->GetPointData();
+  const vtkIdType numSamples = output->GetNumberOfPoints();
+  if (this->ResampledCellData == nullptr)
+  {
+    outPD->CopyAllocate(brick->GetPointData(), numSamples);
+    ResizeArrays(outPD, numSamples);
+
+    this->ResampledCellData = vtkSmartPointer<vtkPointData>::New();
+    this->ResampledCellData->CopyAllocate(brick->GetCellData(), numSamples);
+    ResizeArrays(this->ResampledCellData, numSamples);
+    for (int cc = 0; cc < this->ResampledCellData->GetNumberOfArrays(); ++cc)
+    {
+      vtkAbstractArray* array = this->ResampledCellData->GetAbstractArray(cc);
+      if (array->GetName() && outPD->GetAbstractArray(array->GetName()) == nullptr)
+      {
+        outPD->AddArray(array);
+      }
+    }
+  }
+
+  const double* origin = output->GetOrigin();
+  const double* spacing = output->GetSpacing();
+  const int* dimensions = output->GetDimensions();
+  const double* brickOrigin = brick->GetOrigin();
+  const double* brickSpacing = brick->GetSpacing();
+  const int* brickExtent = brick->GetExtent();
+
+  // range of samples within the brick. Neighboring bricks share their
+  // boundary points, so a sample on a boundary may be set by either.
+  int range[6];
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    const double lo = brickOrigin[axis] + brickExtent[2 * axis] * brickSpacing[axis];
+    const double hi = brickOrigin[axis] + brickExtent[2 * axis + 1] * brickSpacing[axis];
+    range[2 * axis] =
+      std::max(0, static_cast<int>(std::ceil((lo - origin[axis]) / spacing[axis] - 1e-6)));
+    range[2 * axis + 1] = std::min(dimensions[axis] - 1,
+      static_cast<int>(std::floor((hi - origin[axis]) / spacing[axis] + 1e-6)));
+    if (range[2 * axis] > range[2 * axis + 1])
+    {
+      // this brick is skipped since it doesn't intersect our region of interest.
+      return false;
+    }
+  }
+
+  const bool hasCells = brick->GetNumberOfCells() > 0 &&
+    this->ResampledCellData->GetNumberOfArrays() > 0;
+  for (int k = range[4]; k <= range[5]; ++k)
+  {
+    for (int j = range[2]; j <= range[3]; ++j)
+    {
+      const vtkIdType row = (static_cast<vtkIdType>(k) * dimensions[1] + j) * dimensions[0];
+      for (int i = range[0]; i <= range[1]; ++i)
+      {
+        const int ijk[3] = { i, j, k };
+        int donorPoint[3], donorCell[3];
+        for (int axis = 0; axis < 3; ++axis)
+        {
+          const double x = origin[axis] + ijk[axis] * spacing[axis];
+          const double index = (x - brickOrigin[axis]) / brickSpacing[axis];
+          donorPoint[axis] = vtkMath::ClampValue(static_cast<int>(std::lround(index)),
+            brickExtent[2 * axis], brickExtent[2 * axis + 1]);
+          donorCell[axis] = vtkMath::ClampValue(static_cast<int>(std::floor(index)),
+            brickExtent[2 * axis], std::max(brickExtent[2 * axis], brickExtent[2 * axis + 1] - 1));
+        }
+        const vtkIdType receiver = row + i;
+        outPD->CopyData(brick->GetPointData(), brick->ComputePointId(donorPoint), receiver);
+        if (hasCells)
+        {
+          this->ResampledCellData->CopyData(
+            brick->GetCellData(), brick->ComputeCellId(donorCell), receiver);
+        }
+      }
+    }
+  }
+
+  // mark data modified, otherwise mappers are confused.
+  for (int cc = 0; cc < outPD->GetNumberOfArrays(); ++cc)
+  {
+    outPD->GetAbstractArray(cc)->Modified();
+  }
+  this->Output->Modified();
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkResampledBrickImageSource::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "MaxDimensions: " << this->MaxDimensions[0] << ", " << this->MaxDimensions[1]
+     << ", " << this->MaxDimensions[2] << endl;
+}
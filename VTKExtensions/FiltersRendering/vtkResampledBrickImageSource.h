@@ -0,0 +1,102 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkResampledBrickImageSource
+ * @brief   image data source that resamples bricks of a larger image
+ *
+ * vtkResampledBrickImageSource produces an image data of at most
+ * MaxDimensions points covering an image, or the part of it within
+ * SpatialBounds, to which the bricks of that image are added one at a time.
+ * Each sample takes the value of the nearest point of the brick containing
+ * it; the cell data of the bricks is passed along as point data. The output
+ * can thus be volume rendered while the bricks are streamed, without ever
+ * holding the full resolution image.
+ *
+ * All bricks must have the same arrays, in the same order, and the same
+ * origin and spacing as the image they are extracted from.
+ *
+ * @attention
+ * We subclass vtkTrivialProducer since it deals with all the meta-data that
+ * needs to be passed down the pipeline for image data, keeping the code here
+ * simple.
+ */
+
+#ifndef vtkResampledBrickImageSource_h
+#define vtkResampledBrickImageSource_h
+
+#include "vtkPVVTKExtensionsFiltersRenderingModule.h" // needed for export macro
+#include "vtkSmartPointer.h"                          // needed for vtkSmartPointer
+#include "vtkTrivialProducer.h"
+
+class vtkImageData;
+class vtkPointData;
+
+class VTKPVVTKEXTENSIONSFILTERSRENDERING_EXPORT vtkResampledBrickImageSource
+  : public vtkTrivialProducer
+{
+public:
+  static vtkResampledBrickImageSource* New();
+  vtkTypeMacro(vtkResampledBrickImageSource, vtkTrivialProducer);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * Get/Set the maximum number of samples along each axis.
+   */
+  vtkSetVector3Macro(MaxDimensions, int);
+  vtkGetVector3Macro(MaxDimensions, int);
+  ///@}
+
+  ///@{
+  /**
+   * When provided, the resampled image is set up to cover these bounds,
+   * clamped to the image bounds. If not provided, the image bounds are used.
+   */
+  vtkSetVector6Macro(SpatialBounds, double);
+  vtkGetVector6Macro(SpatialBounds, double);
+  ///@}
+
+  /**
+   * To restart the resample process, call this method. The output image data
+   * is set up in the next call to Initialize().
+   */
+  void Reset();
+
+  /**
+   * Sets up the resampled volume for the image with the given whole extent,
+   * origin and spacing. Returns false if the image is empty.
+   */
+  bool Initialize(const int wholeExtent[6], const double origin[3], const double spacing[3]);
+
+  /**
+   * Adds the samples falling in `brick` to the resampled volume. Returns true
+   * if any sample was updated.
+   */
+  bool AddBrick(vtkImageData* brick);
+
+  /**
+   * Returns true if Initialize() must be called before adding bricks.
+   */
+  bool NeedsInitialization() const { return (this->MTime > this->InitializationTime); }
+
+protected:
+  vtkResampledBrickImageSource();
+  ~vtkResampledBrickImageSource() override;
+
+  int MaxDimensions[3];
+  double SpatialBounds[6];
+
+  vtkSmartPointer<vtkImageData> ResampledImage;
+
+  // samples of the brick cell data, whose arrays are also added to the output
+  // point data.
+  vtkSmartPointer<vtkPointData> ResampledCellData;
+
+private:
+  vtkResampledBrickImageSource(const vtkResampledBrickImageSource&) = delete;
+  void operator=(const vtkResampledBrickImageSource&) = delete;
+
+  vtkTimeStamp InitializationTime;
+};
+
+#endif
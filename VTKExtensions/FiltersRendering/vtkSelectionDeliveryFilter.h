@@ -7,6 +7,9 @@
  * data-server nodes to the client. This should not be instantiated on the
  * pure-render-server nodes to avoid odd side effects (We can fix this later if
  * the need arises).
+ *
+ * Bitmask selection nodes (see vtkPVBitmaskSelector) are delivered as they
+ * are, run-length encoded by vtkSelectionSerializer.
  */
 
 #ifndef vtkSelectionDeliveryFilter_h
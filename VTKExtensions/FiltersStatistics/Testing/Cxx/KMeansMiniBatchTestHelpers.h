@@ -0,0 +1,139 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkCommunicator.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkLogger.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkMultiProcessController.h"
+#include "vtkNew.h"
+#include "vtkPSciVizKMeans.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTable.h"
+
+#include <array>
+#include <cmath>
+#include <vector>
+
+namespace KMeansMiniBatchTestHelpers
+{
+using Centers = std::vector<std::array<double, 2>>;
+
+const Centers TrueCenters = { { 5., 5. }, { 15., 5. }, { 5., 15. } };
+
+// Points spread uniformly within 1 of the true centers, taken in turn, with
+// their coordinates as "x" and "y" point arrays.
+vtkSmartPointer<vtkPolyData> CreateClusters(int numberOfPoints, int seed)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(seed);
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> xs;
+  xs->SetName("x");
+  vtkNew<vtkDoubleArray> ys;
+  ys->SetName("y");
+  for (int cc = 0; cc < numberOfPoints; ++cc)
+  {
+    const auto& center = TrueCenters[cc % TrueCenters.size()];
+    const double x = random->GetNextRangeValue(center[0] - 1., center[0] + 1.);
+    const double y = random->GetNextRangeValue(center[1] - 1., center[1] + 1.);
+    points->InsertNextPoint(x, y, 0.);
+    xs->InsertNextValue(x);
+    ys->InsertNextValue(y);
+  }
+  auto clusters = vtkSmartPointer<vtkPolyData>::New();
+  clusters->SetPoints(points);
+  clusters->GetPointData()->AddArray(xs);
+  clusters->GetPointData()->AddArray(ys);
+  return clusters;
+}
+
+// The cluster centers of the model of `input`, only available on rank 0.
+Centers Run(vtkPolyData* input, bool useMiniBatch, int batchSize)
+{
+  vtkNew<vtkPSciVizKMeans> kmeans;
+  kmeans->SetInputData(input);
+  kmeans->EnableAttributeArray("x");
+  kmeans->EnableAttributeArray("y");
+  kmeans->SetTask(vtkSciVizStatistics::MODEL_INPUT);
+  kmeans->SetK(static_cast<int>(TrueCenters.size()));
+  kmeans->SetUseMiniBatch(useMiniBatch);
+  kmeans->SetBatchSize(batchSize);
+  kmeans->Update();
+
+  Centers centers;
+  auto model = vtkMultiBlockDataSet::SafeDownCast(kmeans->GetOutputDataObject(0));
+  auto table =
+    model && model->GetNumberOfBlocks() > 0 ? vtkTable::SafeDownCast(model->GetBlock(0)) : nullptr;
+  vtkDataArray* xs = table ? vtkDataArray::SafeDownCast(table->GetColumnByName("x")) : nullptr;
+  vtkDataArray* ys = table ? vtkDataArray::SafeDownCast(table->GetColumnByName("y")) : nullptr;
+  for (vtkIdType row = 0; xs && ys && row < table->GetNumberOfRows(); ++row)
+  {
+    centers.push_back({ xs->GetTuple1(row), ys->GetTuple1(row) });
+  }
+  return centers;
+}
+
+// Checks that every center of `actual` is within `tolerance` of a distinct
+// center of `expected`.
+bool Compare(const Centers& expected, const Centers& actual, double tolerance, const char* what)
+{
+  if (actual.size() != expected.size())
+  {
+    vtkLogF(ERROR, "%s: expected %d centers, got %d.", what, static_cast<int>(expected.size()),
+      static_cast<int>(actual.size()));
+    return false;
+  }
+  std::vector<bool> matched(expected.size(), false);
+  for (const auto& center : actual)
+  {
+    bool found = false;
+    for (size_t cc = 0; cc < expected.size() && !found; ++cc)
+    {
+      if (!matched[cc] && std::abs(center[0] - expected[cc][0]) <= tolerance &&
+        std::abs(center[1] - expected[cc][1]) <= tolerance)
+      {
+        matched[cc] = found = true;
+      }
+    }
+    if (!found)
+    {
+      vtkLogF(ERROR, "%s: center (%g, %g) is not within %g of an expected center.", what,
+        center[0], center[1], tolerance);
+      return false;
+    }
+  }
+  return true;
+}
+
+// Runs the checks on the clusters of every rank of `controller`.
+bool TestMiniBatch(vtkMultiProcessController* controller)
+{
+  const int rank = controller->GetLocalProcessId();
+  vtkSmartPointer<vtkPolyData> input = CreateClusters(3000, 1 + rank);
+
+  const Centers full = Run(input, false, 0);
+  const Centers miniBatch = Run(input, true, 300);
+  // a batch larger than the data falls back to the full algorithm.
+  const Centers fallback = Run(input, true, 1000000);
+
+  int success = 1;
+  if (rank == 0)
+  {
+    // the means of uniform samples of 1000 points per cluster and rank.
+    success = Compare(TrueCenters, full, 0.1, "Full k-means") && success;
+    // mini-batch centers seed the final full pass, which converges to the
+    // same means on separable clusters.
+    success = Compare(full, miniBatch, 1e-6, "Mini-batch k-means") && success;
+    success = Compare(full, fallback, 0., "Mini-batch k-means with a large batch") && success;
+  }
+  int allSuccess = 0;
+  controller->AllReduce(&success, &allSuccess, 1, vtkCommunicator::LOGICAL_AND_OP);
+  return allSuccess != 0;
+}
+}
@@ -0,0 +1,19 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Checks that mini-batch k-means finds the centers of full k-means on
+// separable clusters, and that a batch larger than the data falls back to
+// full k-means.
+
+#include "KMeansMiniBatchTestHelpers.h"
+
+#include "vtkDummyController.h"
+
+int TestPSciVizKMeansMiniBatch(int, char*[])
+{
+  vtkNew<vtkDummyController> controller;
+  vtkMultiProcessController::SetGlobalController(controller);
+  const bool success = KMeansMiniBatchTestHelpers::TestMiniBatch(controller);
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
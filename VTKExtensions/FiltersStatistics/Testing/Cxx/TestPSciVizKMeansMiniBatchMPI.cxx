@@ -0,0 +1,20 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Same as TestPSciVizKMeansMiniBatch, with the clusters of every rank: the
+// batches are drawn from all ranks and only the sums are exchanged.
+
+#include "KMeansMiniBatchTestHelpers.h"
+
+#include "vtkMPIController.h"
+
+int TestPSciVizKMeansMiniBatchMPI(int argc, char* argv[])
+{
+  vtkNew<vtkMPIController> controller;
+  controller->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(controller);
+  const bool success = KMeansMiniBatchTestHelpers::TestMiniBatch(controller);
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  controller->Finalize();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
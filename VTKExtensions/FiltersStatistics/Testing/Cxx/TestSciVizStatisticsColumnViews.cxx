@@ -0,0 +1,287 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Checks that the statistics filters, which read multi-component arrays and
+// the training sample through implicit column views, produce the same models
+// as the statistics engines run on tables where the components and the
+// sampled rows are copied.
+
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkDummyController.h"
+#include "vtkIntArray.h"
+#include "vtkLogger.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPContingencyStatistics.h"
+#include "vtkPDescriptiveStatistics.h"
+#include "vtkPSciVizContingencyStats.h"
+#include "vtkPSciVizDescriptiveStats.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkStringArray.h"
+#include "vtkTable.h"
+#include "vtkVariantArray.h"
+
+#include <cmath>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace
+{
+constexpr vtkIdType NumberOfPoints = 1000;
+
+// Points with a 3-component double array "Vec", a 2-component int array
+// "Count" and a 2-component string array "Labels".
+vtkSmartPointer<vtkPolyData> CreateInput()
+{
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(NumberOfPoints);
+  vtkNew<vtkDoubleArray> vec;
+  vec->SetName("Vec");
+  vec->SetNumberOfComponents(3);
+  vec->SetNumberOfTuples(NumberOfPoints);
+  vtkNew<vtkIntArray> count;
+  count->SetName("Count");
+  count->SetNumberOfComponents(2);
+  count->SetNumberOfTuples(NumberOfPoints);
+  vtkNew<vtkStringArray> labels;
+  labels->SetName("Labels");
+  labels->SetNumberOfComponents(2);
+  labels->SetNumberOfTuples(NumberOfPoints);
+  for (vtkIdType i = 0; i < NumberOfPoints; ++i)
+  {
+    points->SetPoint(i, i, 0., 0.);
+    vec->SetTypedTuple(i, std::vector<double>{ 0.5 * i, std::sin(0.1 * i), i % 7 * 1. }.data());
+    count->SetTypedComponent(i, 0, static_cast<int>(i % 5));
+    count->SetTypedComponent(i, 1, static_cast<int>(i * i % 11));
+    labels->SetValue(2 * i, "a" + std::to_string(i % 3));
+    labels->SetValue(2 * i + 1, "b" + std::to_string(i % 4));
+  }
+  auto input = vtkSmartPointer<vtkPolyData>::New();
+  input->SetPoints(points);
+  input->GetPointData()->AddArray(vec);
+  input->GetPointData()->AddArray(count);
+  input->GetPointData()->AddArray(labels);
+  return input;
+}
+
+// The table of the given arrays of `input`, in this order, with every
+// component copied to its own "<name>_<component>" column.
+vtkSmartPointer<vtkTable> CopyColumns(vtkPolyData* input, const std::vector<std::string>& names)
+{
+  auto table = vtkSmartPointer<vtkTable>::New();
+  for (const auto& name : names)
+  {
+    vtkAbstractArray* array = input->GetPointData()->GetAbstractArray(name.c_str());
+    const int numComps = array->GetNumberOfComponents();
+    for (int comp = 0; comp < numComps; ++comp)
+    {
+      vtkSmartPointer<vtkAbstractArray> column =
+        vtk::TakeSmartPointer(vtkAbstractArray::CreateArray(array->GetDataType()));
+      column->SetName((name + "_" + std::to_string(comp)).c_str());
+      column->SetNumberOfTuples(array->GetNumberOfTuples());
+      for (vtkIdType i = 0; i < array->GetNumberOfTuples(); ++i)
+      {
+        column->SetVariantValue(i, array->GetVariantValue(i * numComps + comp));
+      }
+      table->AddColumn(column);
+    }
+  }
+  return table;
+}
+
+// The training rows the statistics filters draw, copied row by row.
+vtkSmartPointer<vtkTable> CopySample(vtkTable* table, vtkIdType sampleSize)
+{
+  std::set<vtkIdType> rows;
+  const vtkIdType numRows = table->GetNumberOfRows();
+  const double frac = static_cast<double>(sampleSize) / numRows;
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  for (vtkIdType i = 0; i < numRows; ++i)
+  {
+    random->Next();
+    if (random->GetValue() < frac)
+    {
+      rows.insert(i);
+    }
+  }
+  while (static_cast<vtkIdType>(rows.size()) > sampleSize)
+  {
+    random->Next();
+    rows.erase(static_cast<vtkIdType>(random->GetRangeValue(0, numRows - 1)));
+  }
+  while (static_cast<vtkIdType>(rows.size()) < sampleSize)
+  {
+    random->Next();
+    rows.insert(static_cast<vtkIdType>(random->GetRangeValue(0, numRows - 1)));
+  }
+
+  auto sample = vtkSmartPointer<vtkTable>::New();
+  for (vtkIdType col = 0; col < table->GetNumberOfColumns(); ++col)
+  {
+    vtkAbstractArray* source = table->GetColumn(col);
+    vtkSmartPointer<vtkAbstractArray> column =
+      vtk::TakeSmartPointer(vtkAbstractArray::CreateArray(source->GetDataType()));
+    column->SetName(source->GetName());
+    sample->AddColumn(column);
+  }
+  sample->SetNumberOfRows(sampleSize);
+  vtkNew<vtkVariantArray> row;
+  vtkIdType sampleRow = 0;
+  for (vtkIdType id : rows)
+  {
+    table->GetRow(id, row);
+    sample->SetRow(sampleRow++, row);
+  }
+  return sample;
+}
+
+// Learn and Derive on `table` as the statistics filters do.
+template <typename EngineT>
+vtkSmartPointer<vtkMultiBlockDataSet> ComputeModel(vtkTable* table, bool useColumnStatus)
+{
+  vtkNew<EngineT> engine;
+  engine->SetInputData(vtkStatisticsAlgorithm::INPUT_DATA, table);
+  for (vtkIdType col = 0; col < table->GetNumberOfColumns(); ++col)
+  {
+    if (useColumnStatus)
+    {
+      engine->SetColumnStatus(table->GetColumnName(col), 1);
+    }
+    else
+    {
+      engine->AddColumn(table->GetColumnName(col));
+    }
+  }
+  engine->SetLearnOption(true);
+  engine->SetDeriveOption(true);
+  engine->SetAssessOption(false);
+  engine->Update();
+  auto model = vtkSmartPointer<vtkMultiBlockDataSet>::New();
+  model->CompositeShallowCopy(vtkMultiBlockDataSet::SafeDownCast(
+    engine->GetOutputDataObject(vtkStatisticsAlgorithm::OUTPUT_MODEL)));
+  return model;
+}
+
+bool CompareModels(vtkMultiBlockDataSet* expected, vtkDataObject* actualObject, const char* what)
+{
+  auto actual = vtkMultiBlockDataSet::SafeDownCast(actualObject);
+  if (!actual || actual->GetNumberOfBlocks() != expected->GetNumberOfBlocks() ||
+    expected->GetNumberOfBlocks() == 0)
+  {
+    vtkLogF(ERROR, "%s: the models have different blocks.", what);
+    return false;
+  }
+  for (unsigned int block = 0; block < expected->GetNumberOfBlocks(); ++block)
+  {
+    auto expectedTable = vtkTable::SafeDownCast(expected->GetBlock(block));
+    auto actualTable = vtkTable::SafeDownCast(actual->GetBlock(block));
+    if (!expectedTable || !actualTable)
+    {
+      if (expectedTable != actualTable)
+      {
+        vtkLogF(ERROR, "%s: block %u is not a table in both models.", what, block);
+        return false;
+      }
+      continue;
+    }
+    if (expectedTable->GetNumberOfRows() != actualTable->GetNumberOfRows() ||
+      expectedTable->GetNumberOfColumns() != actualTable->GetNumberOfColumns())
+    {
+      vtkLogF(ERROR, "%s: block %u has %lld x %lld values instead of %lld x %lld.", what, block,
+        static_cast<long long>(actualTable->GetNumberOfRows()),
+        static_cast<long long>(actualTable->GetNumberOfColumns()),
+        static_cast<long long>(expectedTable->GetNumberOfRows()),
+        static_cast<long long>(expectedTable->GetNumberOfColumns()));
+      return false;
+    }
+    for (vtkIdType col = 0; col < expectedTable->GetNumberOfColumns(); ++col)
+    {
+      auto expectedColumn = vtkDataArray::SafeDownCast(expectedTable->GetColumn(col));
+      auto actualColumn = vtkDataArray::SafeDownCast(actualTable->GetColumn(col));
+      for (vtkIdType row = 0; row < expectedTable->GetNumberOfRows(); ++row)
+      {
+        const bool same = expectedColumn && actualColumn
+          ? std::abs(expectedColumn->GetTuple1(row) - actualColumn->GetTuple1(row)) <=
+            1e-12 * (1. + std::abs(expectedColumn->GetTuple1(row)))
+          : expectedTable->GetValue(row, col).ToString() ==
+            actualTable->GetValue(row, col).ToString();
+        if (!same)
+        {
+          vtkLogF(ERROR, "%s: block %u differs at (%lld, %s): %s instead of %s.", what, block,
+            static_cast<long long>(row), expectedTable->GetColumnName(col),
+            actualTable->GetValue(row, col).ToString().c_str(),
+            expectedTable->GetValue(row, col).ToString().c_str());
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+// Runs `filter` on the arrays `names` of `input`, on all the rows or on a
+// sample of `trainingFraction` of them, and compares its model with the
+// engine run on copies.
+template <typename FilterT, typename EngineT>
+bool Check(vtkPolyData* input, const std::vector<std::string>& names, double trainingFraction,
+  bool useColumnStatus, const char* what)
+{
+  vtkNew<FilterT> filter;
+  filter->SetInputData(input);
+  for (const auto& name : names)
+  {
+    filter->EnableAttributeArray(name.c_str());
+  }
+  if (trainingFraction < 1.)
+  {
+    filter->SetTask(vtkSciVizStatistics::CREATE_MODEL);
+    filter->SetTrainingFraction(trainingFraction);
+  }
+  else
+  {
+    filter->SetTask(vtkSciVizStatistics::MODEL_INPUT);
+  }
+  filter->Update();
+
+  vtkSmartPointer<vtkTable> table = CopyColumns(input, names);
+  if (trainingFraction < 1.)
+  {
+    table = CopySample(table, static_cast<vtkIdType>(NumberOfPoints * trainingFraction));
+  }
+  vtkSmartPointer<vtkMultiBlockDataSet> expected = ComputeModel<EngineT>(table, useColumnStatus);
+  return CompareModels(expected, filter->GetOutputDataObject(0), what);
+}
+}
+
+int TestSciVizStatisticsColumnViews(int, char*[])
+{
+  vtkNew<vtkDummyController> controller;
+  vtkMultiProcessController::SetGlobalController(controller);
+
+  vtkSmartPointer<vtkPolyData> input = CreateInput();
+  // the filters list the arrays in name order.
+  const std::vector<std::string> numeric = { "Count", "Vec" };
+  const std::vector<std::string> strings = { "Labels" };
+  bool success = true;
+  success = Check<vtkPSciVizDescriptiveStats, vtkPDescriptiveStatistics>(
+              input, numeric, 1., false, "Descriptive statistics of components") &&
+    success;
+  success = Check<vtkPSciVizDescriptiveStats, vtkPDescriptiveStatistics>(
+              input, numeric, 0.2, false, "Descriptive statistics of a sample") &&
+    success;
+  success = Check<vtkPSciVizContingencyStats, vtkPContingencyStatistics>(
+              input, strings, 1., true, "Contingency statistics of string components") &&
+    success;
+  success = Check<vtkPSciVizContingencyStats, vtkPContingencyStatistics>(
+              input, strings, 0.2, true, "Contingency statistics of a sample") &&
+    success;
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -3,15 +3,286 @@
 #include "vtkPSciVizKMeans.h"
 #include "vtkSciVizStatisticsPrivate.h"
 
+#include "vtkCommunicator.h"
 #include "vtkDataSetAttributes.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMinimalStandardRandomSequence.h"
 #include "vtkMultiBlockDataSet.h"
+#include "vtkMultiProcessController.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPKMeansStatistics.h"
+#include "vtkPVLogger.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkTable.h"
+#include "vtkTimerLog.h"
+#include "vtkUnsignedCharArray.h"
 #include "vtkVariantArray.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace
+{
+/**
+ * Assign every observation of a batch to its closest center. Observations
+ * and centers are stored contiguously, Dimension values each.
+ */
+struct vtkMiniBatchAssignment
+{
+  const double* Batch;
+  const double* Centers;
+  int NumberOfCenters;
+  int Dimension;
+  int* Assignment;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    const int dim = this->Dimension;
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      const double* x = this->Batch + i * dim;
+      double bestDistance = std::numeric_limits<double>::max();
+      int best = 0;
+      for (int k = 0; k < this->NumberOfCenters; ++k)
+      {
+        const double* c = this->Centers + k * dim;
+        double distance = 0.;
+        for (int j = 0; j < dim; ++j)
+        {
+          const double delta = x[j] - c[j];
+          distance += delta * delta;
+        }
+        if (distance < bestDistance)
+        {
+          bestDistance = distance;
+          best = k;
+        }
+      }
+      this->Assignment[i] = best;
+    }
+  }
+};
+
+/**
+ * Find k cluster centers of the columns of `inData` with mini-batch k-means.
+ * The result is a table of initial cluster centers in the format expected on
+ * the LEARN_PARAMETERS port of vtkKMeansStatistics. Return nullptr when the
+ * columns are not numeric scalars, when there are fewer observations than
+ * centers or when a batch would hold all the observations, in which case the
+ * full algorithm is used.
+ */
+vtkSmartPointer<vtkTable> ComputeMiniBatchCenters(vtkTable* inData,
+  vtkMultiProcessController* controller, int numberOfCenters, int batchSize, int maxIterations,
+  double tolerance)
+{
+  const int dim = static_cast<int>(inData->GetNumberOfColumns());
+  std::vector<vtkDataArray*> columns(dim);
+  for (int j = 0; j < dim; ++j)
+  {
+    columns[j] = vtkDataArray::SafeDownCast(inData->GetColumn(j));
+    if (!columns[j] || columns[j]->GetNumberOfComponents() != 1)
+    {
+      return nullptr;
+    }
+  }
+  if (dim == 0 || numberOfCenters < 1)
+  {
+    return nullptr;
+  }
+
+  const int numberOfProcesses = controller ? controller->GetNumberOfProcesses() : 1;
+  const int rank = controller ? controller->GetLocalProcessId() : 0;
+  auto sum = [&](const double* local, double* global, vtkIdType length) {
+    if (numberOfProcesses > 1)
+    {
+      controller->AllReduce(local, global, length, vtkCommunicator::SUM_OP);
+    }
+    else
+    {
+      std::copy(local, local + length, global);
+    }
+  };
+
+  // Count the observations, ghost rows excluded.
+  const vtkIdType numberOfRows = inData->GetNumberOfRows();
+  vtkUnsignedCharArray* ghosts = inData->GetRowData()->GetGhostArray();
+  vtkIdType numberOfObservations = numberOfRows;
+  if (ghosts)
+  {
+    numberOfObservations -= std::count_if(ghosts->GetPointer(0),
+      ghosts->GetPointer(0) + numberOfRows, [](unsigned char ghost) { return ghost != 0; });
+  }
+  double localCount = static_cast<double>(numberOfObservations);
+  double globalCount = 0.;
+  sum(&localCount, &globalCount, 1);
+  if (globalCount < numberOfCenters || batchSize >= globalCount)
+  {
+    return nullptr;
+  }
+
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1 + rank);
+  auto drawRow = [&]() -> vtkIdType {
+    // Ghost rows are rejected; give up on ranks made mostly of ghosts.
+    for (int attempt = 0; numberOfObservations > 0 && attempt < 64; ++attempt)
+    {
+      random->Next();
+      const vtkIdType row = std::min(
+        static_cast<vtkIdType>(random->GetValue() * numberOfRows), numberOfRows - 1);
+      if (!ghosts || !ghosts->GetValue(row))
+      {
+        return row;
+      }
+    }
+    return -1;
+  };
+  auto getObservation = [&](vtkIdType row, double* x) {
+    for (int j = 0; j < dim; ++j)
+    {
+      x[j] = columns[j]->GetComponent(row, 0);
+    }
+  };
+
+  // Initial centers: the first k observations in rank order, which are also
+  // the initial centers of the full algorithm on a single rank.
+  std::vector<double> candidates(numberOfCenters * dim, 0.);
+  int numberOfCandidates = 0;
+  for (vtkIdType row = 0; row < numberOfRows && numberOfCandidates < numberOfCenters; ++row)
+  {
+    if (!ghosts || !ghosts->GetValue(row))
+    {
+      getObservation(row, &candidates[numberOfCandidates++ * dim]);
+    }
+  }
+  std::vector<int> allNumberOfCandidates(numberOfProcesses, numberOfCandidates);
+  std::vector<double> allCandidates(candidates);
+  if (numberOfProcesses > 1)
+  {
+    allCandidates.resize(candidates.size() * numberOfProcesses);
+    controller->AllGather(&numberOfCandidates, allNumberOfCandidates.data(), 1);
+    controller->AllGather(candidates.data(), allCandidates.data(),
+      static_cast<vtkIdType>(candidates.size()));
+  }
+  std::vector<double> centers;
+  for (int p = 0; p < numberOfProcesses; ++p)
+  {
+    const double* first = &allCandidates[p * candidates.size()];
+    const int count =
+      std::min(allNumberOfCandidates[p], numberOfCenters - static_cast<int>(centers.size() / dim));
+    centers.insert(centers.end(), first, first + count * dim);
+  }
+  if (static_cast<int>(centers.size()) != numberOfCenters * dim)
+  {
+    return nullptr;
+  }
+
+  // This rank's share of every batch.
+  const vtkIdType localBatchSize = numberOfObservations > 0
+    ? static_cast<vtkIdType>(std::ceil(batchSize * localCount / globalCount))
+    : 0;
+  std::vector<double> batch(localBatchSize * dim);
+  std::vector<int> assignment(localBatchSize);
+  // Per center: coordinate sums followed by the number of observations.
+  std::vector<double> localSums(numberOfCenters * (dim + 1));
+  std::vector<double> sums(localSums.size());
+  std::vector<double> seen(numberOfCenters, 0.);
+
+  const double start = vtkTimerLog::GetUniversalTime();
+  int iteration = 0;
+  double change = 0.;
+  bool converged = false;
+  while (!converged && iteration < maxIterations)
+  {
+    ++iteration;
+    const double iterationStart = vtkTimerLog::GetUniversalTime();
+
+    vtkIdType size = 0;
+    for (vtkIdType i = 0; i < localBatchSize; ++i)
+    {
+      const vtkIdType row = drawRow();
+      if (row >= 0)
+      {
+        getObservation(row, &batch[size++ * dim]);
+      }
+    }
+    vtkMiniBatchAssignment assign{ batch.data(), centers.data(), numberOfCenters, dim,
+      assignment.data() };
+    vtkSMPTools::For(0, size, assign);
+
+    std::fill(localSums.begin(), localSums.end(), 0.);
+    for (vtkIdType i = 0; i < size; ++i)
+    {
+      double* centerSums = &localSums[assignment[i] * (dim + 1)];
+      for (int j = 0; j < dim; ++j)
+      {
+        centerSums[j] += batch[i * dim + j];
+      }
+      centerSums[dim] += 1.;
+    }
+    sum(localSums.data(), sums.data(), static_cast<vtkIdType>(sums.size()));
+
+    // Move every center with a step of 1 / (observations seen so far), and
+    // measure the largest displacement relative to the center norm.
+    change = 0.;
+    for (int k = 0; k < numberOfCenters; ++k)
+    {
+      const double* centerSums = &sums[k * (dim + 1)];
+      const double count = centerSums[dim];
+      if (count == 0.)
+      {
+        continue;
+      }
+      seen[k] += count;
+      double* center = &centers[k * dim];
+      double displacement = 0.;
+      double norm = 0.;
+      for (int j = 0; j < dim; ++j)
+      {
+        const double delta = (centerSums[j] - count * center[j]) / seen[k];
+        displacement += delta * delta;
+        norm += center[j] * center[j];
+        center[j] += delta;
+      }
+      change = std::max(change, norm > 0. ? std::sqrt(displacement / norm) : 0.);
+    }
+    converged = change <= tolerance;
+    vtkVLogF(PARAVIEW_LOG_EXECUTION_VERBOSITY(),
+      "mini-batch k-means iteration %d: relative change %g (%g s)", iteration, change,
+      vtkTimerLog::GetUniversalTime() - iterationStart);
+  }
+  vtkVLogF(PARAVIEW_LOG_EXECUTION_VERBOSITY(),
+    "mini-batch k-means %s after %d iterations, relative change %g (%g s)",
+    converged ? "converged" : "stopped", iteration, change,
+    vtkTimerLog::GetUniversalTime() - start);
+
+  auto parameters = vtkSmartPointer<vtkTable>::New();
+  vtkNew<vtkIdTypeArray> numberOfClusters;
+  numberOfClusters->SetName("Number of Clusters");
+  numberOfClusters->SetNumberOfTuples(numberOfCenters);
+  numberOfClusters->FillValue(numberOfCenters);
+  parameters->AddColumn(numberOfClusters);
+  for (int j = 0; j < dim; ++j)
+  {
+    vtkNew<vtkDoubleArray> coordinates;
+    coordinates->SetName(columns[j]->GetName());
+    coordinates->SetNumberOfTuples(numberOfCenters);
+    for (int k = 0; k < numberOfCenters; ++k)
+    {
+      coordinates->SetValue(k, centers[k * dim + j]);
+    }
+    parameters->AddColumn(coordinates);
+  }
+  return parameters;
+}
+}
+
 vtkStandardNewMacro(vtkPSciVizKMeans);
 
 vtkPSciVizKMeans::vtkPSciVizKMeans()
@@ -19,6 +290,8 @@ vtkPSciVizKMeans::vtkPSciVizKMeans()
   this->K = 5;
   this->MaxNumIterations = 50;
   this->Tolerance = 0.01;
+  this->UseMiniBatch = false;
+  this->BatchSize = 1000;
 }
 
 vtkPSciVizKMeans::~vtkPSciVizKMeans() = default;
@@ -29,6 +302,8 @@ void vtkPSciVizKMeans::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "K: " << K << "\n";
   os << indent << "MaxNumIterations: " << this->MaxNumIterations << "\n";
   os << indent << "Tolerance: " << this->Tolerance << "\n";
+  os << indent << "UseMiniBatch: " << this->UseMiniBatch << "\n";
+  os << indent << "BatchSize: " << this->BatchSize << "\n";
 }
 
 int vtkPSciVizKMeans::LearnAndDerive(vtkMultiBlockDataSet* modelDO, vtkTable* inData)
@@ -39,6 +314,17 @@ int vtkPSciVizKMeans::LearnAndDerive(vtkMultiBlockDataSet* modelDO, vtkTable* in
   stats->SetDefaultNumberOfClusters(this->K);
   stats->SetMaxNumIterations(this->MaxNumIterations);
   stats->SetTolerance(this->Tolerance);
+  if (this->UseMiniBatch)
+  {
+    vtkSmartPointer<vtkTable> centers = ::ComputeMiniBatchCenters(inData, this->Controller,
+      this->K, this->BatchSize, this->MaxNumIterations, this->Tolerance);
+    if (centers)
+    {
+      // A single pass from the mini-batch centers computes the model tables.
+      stats->SetInputData(vtkStatisticsAlgorithm::LEARN_PARAMETERS, centers);
+      stats->SetMaxNumIterations(1);
+    }
+  }
   vtkIdType ncols = inData->GetNumberOfColumns();
   for (vtkIdType i = 0; i < ncols; ++i)
   {
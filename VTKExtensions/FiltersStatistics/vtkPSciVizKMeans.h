@@ -17,6 +17,16 @@
  * The model is then a set of cluster centers.
  * Data is assessed by assigning a cluster center and distance to the
  * cluster to each point in the input data set.
+ *
+ * When UseMiniBatch is on, the centers are first found with mini-batch
+ * k-means, starting from the first K observations: every iteration assigns
+ * BatchSize randomly drawn observations, spread over all ranks, to their
+ * closest center and moves each center toward the mean of its observations
+ * with a step that decreases with the number of observations it has seen.
+ * Only the per-center sums are reduced between ranks. The model is then
+ * produced by a single pass of vtkPKMeansStatistics seeded with these
+ * centers. The residual change and time of every iteration are logged with
+ * PARAVIEW_LOG_EXECUTION_VERBOSITY().
  */
 
 #ifndef vtkPSciVizKMeans_h
@@ -61,6 +71,27 @@ public:
   vtkGetMacro(Tolerance, double);
   ///@}
 
+  ///@{
+  /**
+   * Find the cluster centers with mini-batch k-means instead of full passes
+   * over the training data. MaxNumIterations and Tolerance then apply to the
+   * mini-batch iterations. The default is false.
+   */
+  vtkSetMacro(UseMiniBatch, bool);
+  vtkGetMacro(UseMiniBatch, bool);
+  vtkBooleanMacro(UseMiniBatch, bool);
+  ///@}
+
+  ///@{
+  /**
+   * The number of observations drawn over all ranks at every mini-batch
+   * iteration. When it is at least the number of observations, the full
+   * algorithm is used. The default value is 1000.
+   */
+  vtkSetClampMacro(BatchSize, int, 1, VTK_INT_MAX);
+  vtkGetMacro(BatchSize, int);
+  ///@}
+
 protected:
   vtkPSciVizKMeans();
   ~vtkPSciVizKMeans() override;
@@ -72,6 +103,8 @@ protected:
   int K;
   int MaxNumIterations;
   double Tolerance;
+  bool UseMiniBatch;
+  int BatchSize;
 
 private:
   vtkPSciVizKMeans(const vtkPSciVizKMeans&) = delete;
@@ -4,13 +4,17 @@
 #include "vtkSciVizStatisticsPrivate.h"
 
 #include "vtkAlgorithm.h"
+#include "vtkArrayDispatch.h"
 #include "vtkCellData.h"
 #include "vtkCompositeDataSet.h"
 #include "vtkDataArray.h"
 #include "vtkDataObject.h"
 #include "vtkDataObjectTreeIterator.h"
 #include "vtkDataSetAttributes.h"
+#include "vtkDataArrayRange.h"
 #include "vtkDemandDrivenPipeline.h"
+#include "vtkIdList.h"
+#include "vtkImplicitArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationIntegerKey.h"
 #include "vtkInformationVector.h"
@@ -25,15 +29,80 @@
 #include "vtkStringArray.h"
 #include "vtkTable.h"
 #include "vtkUnsignedCharArray.h"
-#include "vtkVariantArray.h"
 
+#include <memory>
 #include <set>
 #include <sstream>
+#include <vector>
 
 vtkCxxSetObjectMacro(vtkSciVizStatistics, Controller, vtkMultiProcessController);
 
 vtkInformationKeyMacro(vtkSciVizStatistics, MULTIPLE_MODELS, Integer);
 
+namespace
+{
+/**
+ * Implicit array backend reading one component of an array, optionally
+ * through a list of tuple ids. Reads are const so views can be shared between
+ * threads.
+ */
+template <typename ArrayT>
+struct vtkSciVizColumnBackend
+{
+  using ValueType = vtk::GetAPIType<ArrayT>;
+
+  vtkSciVizColumnBackend(ArrayT* array, int component, vtkIdList* ids)
+    : Array(array)
+    , Component(component)
+    , Ids(ids)
+  {
+  }
+
+  ValueType operator()(vtkIdType index) const
+  {
+    const vtkIdType tuple = this->Ids ? this->Ids->GetId(index) : index;
+    return this->Array->GetTypedComponent(tuple, this->Component);
+  }
+
+  vtkSmartPointer<ArrayT> Array;
+  int Component;
+  vtkSmartPointer<vtkIdList> Ids;
+};
+
+struct vtkSciVizColumnViewWorker
+{
+  vtkSmartPointer<vtkAbstractArray> View;
+
+  template <typename ArrayT>
+  void operator()(ArrayT* array, int component, vtkIdList* ids)
+  {
+    using BackendT = vtkSciVizColumnBackend<ArrayT>;
+    vtkNew<vtkImplicitArray<BackendT>> view;
+    view->SetBackend(std::make_shared<BackendT>(array, component, ids));
+    view->SetNumberOfComponents(1);
+    view->SetNumberOfTuples(ids ? ids->GetNumberOfIds() : array->GetNumberOfTuples());
+    this->View = view;
+  }
+};
+
+/**
+ * Create a single-component column that reads `component` of `source`
+ * without copying it. When `ids` is given, tuple i of the column is tuple
+ * ids[i] of the source. Return nullptr for arrays that cannot be dispatched.
+ */
+vtkSmartPointer<vtkAbstractArray> NewColumnView(
+  vtkAbstractArray* source, int component, vtkIdList* ids)
+{
+  vtkDataArray* array = vtkDataArray::SafeDownCast(source);
+  vtkSciVizColumnViewWorker worker;
+  if (!array || !vtkArrayDispatch::Dispatch::Execute(array, worker, component, ids))
+  {
+    return nullptr;
+  }
+  return worker.View;
+}
+}
+
 vtkSciVizStatistics::vtkSciVizStatistics()
 {
   this->P = new vtkSciVizStatisticsP;
@@ -500,6 +569,7 @@ int vtkSciVizStatistics::RequestData(
       train = vtkSmartPointer<vtkTable>::New();
       this->PrepareTrainingTable(train, inTable, M);
     }
+    this->P->ColumnSources.clear();
 
     // Calculate detailed statistical model from the input data set
     vtkMultiBlockDataSet* outModelDS = vtkMultiBlockDataSet::SafeDownCast(outModel);
@@ -556,6 +626,7 @@ int vtkSciVizStatistics::RequestData(
 
 int vtkSciVizStatistics::PrepareFullDataTable(vtkTable* inTable, vtkFieldData* dataAttrIn)
 {
+  this->P->ColumnSources.clear();
   for (auto colIt = this->P->Buffer.begin(); colIt != this->P->Buffer.end(); ++colIt)
   {
     vtkAbstractArray* arr = dataAttrIn->GetAbstractArray(colIt->c_str());
@@ -567,7 +638,6 @@ int vtkSciVizStatistics::PrepareFullDataTable(vtkTable* inTable, vtkFieldData* d
       {
         // Create a column in the table for each component of non-scalar arrays requested.
         // FIXME: Should we add a "norm" column when arr is a vtkDataArray? It would make sense.
-        std::vector<vtkAbstractArray*> comps;
         const char* compName;
 
         // Check component names can be used
@@ -591,49 +661,42 @@ int vtkSciVizStatistics::PrepareFullDataTable(vtkTable* inTable, vtkFieldData* d
           os << arr->GetName() << "_";
           useCompNames ? os << compName : os << i;
 
-          vtkAbstractArray* arrCol = vtkAbstractArray::CreateArray(arr->GetDataType());
-          arrCol->SetName(os.str().c_str());
-          arrCol->SetNumberOfComponents(1);
-          arrCol->SetNumberOfTuples(ntup);
-          comps.push_back(arrCol);
-          inTable->AddColumn(arrCol);
-          arrCol->FastDelete();
-        }
-        vtkIdType vidx = 0;
-        vtkDataArray* darr = vtkDataArray::SafeDownCast(arr);
-        vtkStringArray* sarr = vtkStringArray::SafeDownCast(arr);
-        if (darr)
-        {
-          for (int i = 0; i < ncomp; ++i)
-          {
-            vtkDataArray::SafeDownCast(comps[i])->CopyComponent(0, darr, i);
-          }
-        }
-        else if (sarr)
-        {
-          std::vector<vtkStringArray*> scomps;
-          for (int i = 0; i < ncomp; ++i, ++vidx)
+          // Numeric components are strided views of the input array.
+          vtkSmartPointer<vtkAbstractArray> arrCol = ::NewColumnView(arr, i, nullptr);
+          if (arrCol)
           {
-            scomps[i] = vtkStringArray::SafeDownCast(comps[i]);
+            this->P->ColumnSources[arrCol] = { arr, i };
           }
-          for (vtkIdType j = 0; j < ntup; ++j)
+          else
           {
-            for (int i = 0; i < ncomp; ++i, ++vidx)
+            arrCol = vtk::TakeSmartPointer(vtkAbstractArray::CreateArray(arr->GetDataType()));
+            arrCol->SetNumberOfComponents(1);
+            arrCol->SetNumberOfTuples(ntup);
+            vtkDataArray* darr = vtkDataArray::SafeDownCast(arr);
+            vtkStringArray* sarr = vtkStringArray::SafeDownCast(arr);
+            if (darr)
             {
-              scomps[i]->SetValue(j, sarr->GetValue(vidx));
+              vtkDataArray::SafeDownCast(arrCol)->CopyComponent(0, darr, i);
             }
-          }
-        }
-        else
-        {
-          // Inefficient, but works for any array type.
-          for (vtkIdType j = 0; j < ntup; ++j)
-          {
-            for (int i = 0; i < ncomp; ++i, ++vidx)
+            else if (sarr)
+            {
+              vtkStringArray* scol = vtkStringArray::SafeDownCast(arrCol);
+              for (vtkIdType j = 0; j < ntup; ++j)
+              {
+                scol->SetValue(j, sarr->GetValue(j * ncomp + i));
+              }
+            }
+            else
             {
-              comps[i]->InsertVariantValue(j, arr->GetVariantValue(vidx));
+              // Inefficient, but works for any array type.
+              for (vtkIdType j = 0; j < ntup; ++j)
+              {
+                arrCol->SetVariantValue(j, arr->GetVariantValue(j * ncomp + i));
+              }
             }
           }
+          arrCol->SetName(os.str().c_str());
+          inTable->AddColumn(arrCol);
         }
       }
       else
@@ -667,8 +730,11 @@ int vtkSciVizStatistics::PrepareTrainingTable(
 
   vtkUnsignedCharArray* ghosts = fullDataTable->GetRowData()->GetGhostArray();
 
-  std::set<vtkIdType> trainRows;
+  // Flag the sampled rows. The sequence of random numbers, hence the sample,
+  // does not depend on how the rows are stored.
   vtkIdType N = fullDataTable->GetNumberOfRows();
+  std::vector<bool> trainRows(N, false);
+  vtkIdType numberOfTrainRows = 0;
   double frac = static_cast<double>(M) / static_cast<double>(N);
   vtkNew<vtkMinimalStandardRandomSequence> rand;
   for (vtkIdType i = 0; i < N; ++i)
@@ -680,43 +746,67 @@ int vtkSciVizStatistics::PrepareTrainingTable(
     rand->Next();
     if (rand->GetValue() < frac)
     {
-      trainRows.insert(i);
+      trainRows[i] = true;
+      ++numberOfTrainRows;
     }
   }
   // Now add or subtract entries as required.
-  N = N - 1;
-  while (static_cast<vtkIdType>(trainRows.size()) > M)
+  const vtkIdType last = N - 1;
+  while (numberOfTrainRows > M)
   {
     rand->Next();
-    vtkIdType rec = static_cast<vtkIdType>(rand->GetRangeValue(0, N));
-    trainRows.erase(rec);
+    vtkIdType rec = static_cast<vtkIdType>(rand->GetRangeValue(0, last));
+    if (trainRows[rec])
+    {
+      trainRows[rec] = false;
+      --numberOfTrainRows;
+    }
   }
-  while (static_cast<vtkIdType>(trainRows.size()) < M)
+  while (numberOfTrainRows < M)
   {
     rand->Next();
-    vtkIdType rec = static_cast<vtkIdType>(rand->GetRangeValue(0, N));
-    if (!ghosts || !ghosts->GetValue(rec))
+    vtkIdType rec = static_cast<vtkIdType>(rand->GetRangeValue(0, last));
+    if (!trainRows[rec] && (!ghosts || !ghosts->GetValue(rec)))
     {
-      trainRows.insert(rec);
+      trainRows[rec] = true;
+      ++numberOfTrainRows;
     }
   }
-  // Finally, copy the subset into the training table
+  vtkNew<vtkIdList> ids;
+  ids->Allocate(M);
+  for (vtkIdType i = 0; i < N; ++i)
+  {
+    if (trainRows[i])
+    {
+      ids->InsertNextId(i);
+    }
+  }
+
+  // Finally, index the subset of every column. Numeric columns are views of
+  // the input arrays; the ghost array and other columns are gathered.
   trainingTable->Initialize();
   for (int i = 0; i < fullDataTable->GetNumberOfColumns(); ++i)
   {
     vtkAbstractArray* srcCol = fullDataTable->GetColumn(i);
-    vtkAbstractArray* dstCol = vtkAbstractArray::CreateArray(srcCol->GetDataType());
+    vtkSmartPointer<vtkAbstractArray> dstCol;
+    auto source = this->P->ColumnSources.find(srcCol);
+    if (source != this->P->ColumnSources.end())
+    {
+      dstCol = ::NewColumnView(source->second.Array, source->second.Component, ids);
+    }
+    else if (srcCol != ghosts && srcCol->GetNumberOfComponents() == 1)
+    {
+      dstCol = ::NewColumnView(srcCol, 0, ids);
+    }
+    if (!dstCol)
+    {
+      dstCol = vtk::TakeSmartPointer(srcCol->NewInstance());
+      dstCol->SetNumberOfComponents(srcCol->GetNumberOfComponents());
+      dstCol->SetNumberOfTuples(M);
+      srcCol->GetTuples(ids, dstCol);
+    }
     dstCol->SetName(srcCol->GetName());
     trainingTable->AddColumn(dstCol);
-    dstCol->FastDelete();
-  }
-  trainingTable->SetNumberOfRows(M);
-  vtkNew<vtkVariantArray> row;
-  vtkIdType dstRow = 0;
-  for (std::set<vtkIdType>::iterator it = trainRows.begin(); it != trainRows.end(); ++it, ++dstRow)
-  {
-    fullDataTable->GetRow(*it, row);
-    trainingTable->SetRow(dstRow, row);
   }
   return 1;
 }
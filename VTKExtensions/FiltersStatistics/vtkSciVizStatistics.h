@@ -151,9 +151,16 @@ protected:
   virtual int RequestData(vtkDataObject* observationsOut, vtkDataObject* modelOut,
     vtkDataObject* observationsIn, vtkDataObject* modelIn);
 
+  ///@{
+  /**
+   * Build the tables handed to the statistics engines. Components of numeric
+   * multi-component arrays and the sampled rows of the training table are
+   * implicit views of the input arrays rather than copies.
+   */
   virtual int PrepareFullDataTable(vtkTable* table, vtkFieldData* dataAttrIn);
   virtual int PrepareTrainingTable(
     vtkTable* trainingTable, vtkTable* fullDataTable, vtkIdType numObservations);
+  ///@}
 
   /**
    * Method subclasses <b>must</b> override to calculate a full model from the given input data.
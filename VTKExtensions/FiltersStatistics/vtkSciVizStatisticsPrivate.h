@@ -10,12 +10,31 @@
 #ifndef vtkSciVizStatisticsPrivate_h
 #define vtkSciVizStatisticsPrivate_h
 
+#include "vtkAbstractArray.h"
+#include "vtkSmartPointer.h"
 #include "vtkStatisticsAlgorithmPrivate.h"
 
+#include <map>
+
 class vtkSciVizStatisticsP : public vtkStatisticsAlgorithmPrivate
 {
 public:
   bool Has(std::string arrName) { return this->Buffer.find(arrName) != this->Buffer.end(); }
+
+  /**
+   * Component of an input array that a column of the full data table is a view of.
+   */
+  struct ColumnSource
+  {
+    vtkSmartPointer<vtkAbstractArray> Array;
+    int Component;
+  };
+
+  /**
+   * Sources of the full data table columns that are views of multi-component
+   * arrays, so that training views index the input arrays directly.
+   */
+  std::map<vtkAbstractArray*, ColumnSource> ColumnSources;
 };
 
 #endif // vtkSciVizStatisticsPrivate_h
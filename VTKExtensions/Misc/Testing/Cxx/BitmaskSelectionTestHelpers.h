@@ -0,0 +1,67 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef BitmaskSelectionTestHelpers_h
+#define BitmaskSelectionTestHelpers_h
+
+#include "vtkBitArray.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkSelection.h"
+#include "vtkSelectionNode.h"
+#include "vtkSmartPointer.h"
+
+#include <functional>
+
+namespace BitmaskSelectionTestHelpers
+{
+// A bitmask selection node of `numberOfBits` points, whose bit `i` is
+// `isSet(i)`.
+inline vtkSmartPointer<vtkSelectionNode> CreateNode(
+  vtkIdType numberOfBits, const std::function<bool(vtkIdType)>& isSet)
+{
+  vtkNew<vtkBitArray> bits;
+  bits->SetName("Bitmask");
+  bits->SetNumberOfValues(numberOfBits);
+  for (vtkIdType cc = 0; cc < numberOfBits; ++cc)
+  {
+    bits->SetValue(cc, isSet(cc) ? 1 : 0);
+  }
+  auto node = vtkSmartPointer<vtkSelectionNode>::New();
+  node->SetContentType(vtkSelectionNode::USER);
+  node->SetFieldType(vtkSelectionNode::POINT);
+  node->SetSelectionList(bits);
+  return node;
+}
+
+// Checks that `actual` is a bitmask node with the same field type and bits
+// as `expected`.
+inline bool CompareNodes(vtkSelectionNode* expected, vtkSelectionNode* actual, const char* what)
+{
+  if (!actual || actual->GetContentType() != vtkSelectionNode::USER ||
+    actual->GetFieldType() != expected->GetFieldType())
+  {
+    vtkLogF(ERROR, "%s: expected a bitmask node of points.", what);
+    return false;
+  }
+  auto expectedBits = vtkBitArray::SafeDownCast(expected->GetSelectionList());
+  auto actualBits = vtkBitArray::SafeDownCast(actual->GetSelectionList());
+  if (!actualBits || actualBits->GetNumberOfValues() != expectedBits->GetNumberOfValues())
+  {
+    vtkLogF(ERROR, "%s: the selection list is not a bitmask of %lld bits.", what,
+      static_cast<long long>(expectedBits->GetNumberOfValues()));
+    return false;
+  }
+  for (vtkIdType cc = 0; cc < expectedBits->GetNumberOfValues(); ++cc)
+  {
+    if (actualBits->GetValue(cc) != expectedBits->GetValue(cc))
+    {
+      vtkLogF(ERROR, "%s: bit %lld differs.", what, static_cast<long long>(cc));
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+#endif
@@ -0,0 +1,121 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkDoubleArray.h"
+#include "vtkIntArray.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPVChartAggregator.h"
+#include "vtkSmartPointer.h"
+#include "vtkTable.h"
+
+#include <cmath>
+
+#define expect(x, msg)                                                                             \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << __LINE__ << ": " msg << endl;                                                          \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+namespace
+{
+// Rows [begin, end) of a signal with a single spike at row 5000.
+vtkSmartPointer<vtkMultiBlockDataSet> CreateData(vtkIdType begin, vtkIdType end)
+{
+  vtkNew<vtkDoubleArray> x;
+  x->SetName("x");
+  vtkNew<vtkDoubleArray> y;
+  y->SetName("y");
+  vtkNew<vtkIntArray> z;
+  z->SetName("z");
+  for (vtkIdType cc = begin; cc < end; ++cc)
+  {
+    x->InsertNextValue(static_cast<double>(cc));
+    y->InsertNextValue(cc == 5000 ? 10.0 : std::sin(cc * 0.01));
+    z->InsertNextValue(static_cast<int>(cc % 7));
+  }
+  vtkNew<vtkTable> table;
+  table->AddColumn(x);
+  table->AddColumn(y);
+  table->AddColumn(z);
+  auto data = vtkSmartPointer<vtkMultiBlockDataSet>::New();
+  data->SetBlock(0, table);
+  return data;
+}
+
+vtkTable* GetTable(vtkPVChartAggregator* aggregator)
+{
+  return vtkTable::SafeDownCast(aggregator->GetOutput()->GetBlock(0));
+}
+}
+
+int TestPVChartAggregator(int, char*[])
+{
+  const vtkIdType numRows = 100000;
+  auto data = CreateData(0, numRows);
+
+  vtkNew<vtkPVChartAggregator> aggregator;
+  aggregator->SetXArrayName("x");
+  aggregator->SetResolution(100, 100);
+  aggregator->SetInputDataObject(0, data);
+  aggregator->Update();
+
+  vtkTable* result = GetTable(aggregator);
+  expect(result && result->GetNumberOfRows() > 0 && result->GetNumberOfRows() <= 100 * 6 + 12,
+    "Wrong number of aggregated rows.");
+  expect(result->GetNumberOfColumns() == 3, "Columns were not passed.");
+  bool spikeFound = false;
+  for (vtkIdType cc = 0; cc < result->GetNumberOfRows(); ++cc)
+  {
+    spikeFound |= result->GetValueByName(cc, "y").ToDouble() == 10.0;
+    expect(cc == 0 ||
+        result->GetValueByName(cc, "x").ToDouble() > result->GetValueByName(cc - 1, "x").ToDouble(),
+      "Rows are not in input order.");
+  }
+  expect(spikeFound, "The spike was lost.");
+  expect(result->GetValueByName(0, "x").ToDouble() == 0.0 &&
+      result->GetValueByName(result->GetNumberOfRows() - 1, "x").ToDouble() == numRows - 1,
+    "The X extrema were lost.");
+
+  // Aggregating the aggregated halves gives the same rows.
+  aggregator->SetXRange(0, numRows - 1);
+  aggregator->Update();
+  vtkNew<vtkTable> expected;
+  expected->DeepCopy(GetTable(aggregator));
+
+  vtkNew<vtkPVChartAggregator> first;
+  first->SetXArrayName("x");
+  first->SetResolution(100, 100);
+  first->SetXRange(0, numRows - 1);
+  first->SetInputDataObject(0, CreateData(0, numRows / 2));
+  first->Update();
+  vtkNew<vtkPVChartAggregator> second;
+  second->SetXArrayName("x");
+  second->SetResolution(100, 100);
+  second->SetXRange(0, numRows - 1);
+  second->SetInputDataObject(0, CreateData(numRows / 2, numRows));
+  second->Update();
+
+  aggregator->SetInputDataObject(0, first->GetOutput());
+  aggregator->AddInputDataObject(0, second->GetOutput());
+  aggregator->Update();
+  result = GetTable(aggregator);
+  expect(result->GetNumberOfRows() == expected->GetNumberOfRows(),
+    "Wrong number of rows after two passes.");
+  for (vtkIdType cc = 0; cc < result->GetNumberOfRows(); ++cc)
+  {
+    expect(result->GetValueByName(cc, "x") == expected->GetValueByName(cc, "x"),
+      "Wrong row after two passes.");
+  }
+
+  // Density keeps at most one row per occupied cell, plus the extrema.
+  aggregator->SetInputDataObject(0, data);
+  aggregator->SetAggregationModeToDensity();
+  aggregator->SetXRange(0, -1);
+  aggregator->Update();
+  result = GetTable(aggregator);
+  expect(result && result->GetNumberOfRows() > 100 && result->GetNumberOfRows() <= 2 * 100 * 100,
+    "Wrong number of rows for density aggregation.");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,105 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkFieldData.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPVPairwiseHistograms2D.h"
+#include "vtkPointData.h"
+#include "vtkStringArray.h"
+#include "vtkTable.h"
+
+#define expect(x, msg)                                                                             \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    cerr << __LINE__ << ": " msg << endl;                                                          \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+int TestPVPairwiseHistograms2D(int, char*[])
+{
+  const vtkIdType numRows = 1000;
+  vtkNew<vtkDoubleArray> a;
+  a->SetName("a");
+  vtkNew<vtkDoubleArray> b;
+  b->SetName("b");
+  vtkNew<vtkIntArray> c;
+  c->SetName("c");
+  for (vtkIdType cc = 0; cc < numRows; ++cc)
+  {
+    a->InsertNextValue(static_cast<double>(cc));
+    b->InsertNextValue(static_cast<double>(numRows - 1 - cc));
+    c->InsertNextValue(static_cast<int>(cc % 10));
+  }
+  vtkNew<vtkTable> table;
+  table->AddColumn(a);
+  table->AddColumn(b);
+  table->AddColumn(c);
+
+  vtkNew<vtkPVPairwiseHistograms2D> histograms;
+  histograms->SetInputData(table);
+  histograms->SetNumberOfBins(10, 10);
+  histograms->Update();
+
+  vtkMultiBlockDataSet* output = histograms->GetOutput();
+  expect(output->GetNumberOfBlocks() == 3, "Expected one histogram per pair of columns.");
+  for (unsigned int pair = 0; pair < 3; ++pair)
+  {
+    vtkImageData* image = vtkImageData::SafeDownCast(output->GetBlock(pair));
+    expect(image && image->GetNumberOfPoints() == 100, "Wrong histogram size.");
+    vtkDataArray* values = image->GetPointData()->GetArray("bin_values");
+    expect(values, "Missing bin values.");
+    double total = 0;
+    for (vtkIdType cc = 0; cc < values->GetNumberOfTuples(); ++cc)
+    {
+      total += values->GetTuple1(cc);
+    }
+    expect(total == numRows, "Rows were not all counted.");
+  }
+
+  // a and b are anti-correlated: only the anti-diagonal bins are filled.
+  vtkImageData* ab = vtkImageData::SafeDownCast(output->GetBlock(0));
+  auto names = vtkStringArray::SafeDownCast(ab->GetFieldData()->GetAbstractArray("column_names"));
+  expect(names && names->GetValue(0) == "a" && names->GetValue(1) == "b", "Wrong column names.");
+  expect(ab->GetOrigin()[0] == 0.0 && ab->GetSpacing()[0] == (numRows - 1) / 10.0,
+    "Wrong histogram bounds.");
+  vtkDataArray* values = ab->GetPointData()->GetArray("bin_values");
+  for (int j = 0; j < 10; ++j)
+  {
+    for (int i = 0; i < 10; ++i)
+    {
+      const double expected = i + j == 9 ? numRows / 10.0 : 0.0;
+      expect(values->GetTuple1(j * 10 + i) == expected, "Wrong bin value.");
+    }
+  }
+
+  // a and b along axes with different numbers of bins.
+  histograms->SetNumberOfBins(10, 5);
+  histograms->Update();
+  values = vtkImageData::SafeDownCast(histograms->GetOutput()->GetBlock(0))
+             ->GetPointData()
+             ->GetArray("bin_values");
+  expect(values && values->GetNumberOfTuples() == 50, "Wrong histogram size for 10x5 bins.");
+  for (int j = 0; j < 5; ++j)
+  {
+    for (int i = 0; i < 10; ++i)
+    {
+      const double expected = i / 2 + j == 4 ? numRows / 10.0 : 0.0;
+      expect(values->GetTuple1(j * 10 + i) == expected, "Wrong bin value for 10x5 bins.");
+    }
+  }
+
+  // only the requested columns are used.
+  histograms->AddColumn("c");
+  histograms->AddColumn("a");
+  histograms->Update();
+  output = histograms->GetOutput();
+  expect(output->GetNumberOfBlocks() == 1, "Expected a single pair.");
+  ab = vtkImageData::SafeDownCast(output->GetBlock(0));
+  expect(ab->GetOrigin()[0] == 0.0 && ab->GetSpacing()[0] == 0.9, "Wrong bounds for c.");
+  return EXIT_SUCCESS;
+}
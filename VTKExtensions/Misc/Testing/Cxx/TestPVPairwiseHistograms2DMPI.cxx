@@ -0,0 +1,152 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Checks that vtkPVPairwiseHistograms2D run on several ranks, whose tables
+// have different ranges and sizes and one of which has no columns, produces
+// on rank 0 the histograms of all the rows computed on a single rank.
+
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkLogger.h"
+#include "vtkMPIController.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPVPairwiseHistograms2D.h"
+#include "vtkPointData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTable.h"
+
+#include <cmath>
+#include <limits>
+#include <string>
+
+namespace
+{
+// The rows of ranks [first, last). Rank 1 has an empty table without
+// columns, rank 0 a non-finite value, and the ranges grow with the rank.
+vtkSmartPointer<vtkTable> CreateTable(int first, int last)
+{
+  vtkNew<vtkDoubleArray> a;
+  a->SetName("a");
+  vtkNew<vtkDoubleArray> b;
+  b->SetName("b");
+  vtkNew<vtkIntArray> c;
+  c->SetName("c");
+  for (int rank = first; rank < last; ++rank)
+  {
+    if (rank == 1)
+    {
+      continue;
+    }
+    for (int cc = 0, max = 50 + 30 * rank; cc < max; ++cc)
+    {
+      a->InsertNextValue(1000.0 * rank + 0.5 * cc);
+      b->InsertNextValue(rank == 0 && cc == 3 ? std::numeric_limits<double>::quiet_NaN()
+                                              : (rank + 1) * std::sin(0.1 * cc));
+      c->InsertNextValue((cc * (rank + 1)) % 13);
+    }
+  }
+  auto table = vtkSmartPointer<vtkTable>::New();
+  if (a->GetNumberOfTuples() > 0)
+  {
+    table->AddColumn(a);
+    table->AddColumn(b);
+    table->AddColumn(c);
+  }
+  return table;
+}
+
+bool CompareHistograms(vtkDataObject* expectedObject, vtkDataObject* actualObject, const char* what)
+{
+  auto expected = vtkMultiBlockDataSet::SafeDownCast(expectedObject);
+  auto actual = vtkMultiBlockDataSet::SafeDownCast(actualObject);
+  if (!actual || actual->GetNumberOfBlocks() != expected->GetNumberOfBlocks() ||
+    expected->GetNumberOfBlocks() != 3)
+  {
+    vtkLogF(ERROR, "%s: expected one histogram per pair of columns.", what);
+    return false;
+  }
+  for (unsigned int pair = 0; pair < expected->GetNumberOfBlocks(); ++pair)
+  {
+    auto expectedImage = vtkImageData::SafeDownCast(expected->GetBlock(pair));
+    auto actualImage = vtkImageData::SafeDownCast(actual->GetBlock(pair));
+    if (!actualImage || actualImage->GetNumberOfPoints() != expectedImage->GetNumberOfPoints())
+    {
+      vtkLogF(ERROR, "%s: histogram %u has the wrong size.", what, pair);
+      return false;
+    }
+    for (int axis = 0; axis < 2; ++axis)
+    {
+      if (actualImage->GetOrigin()[axis] != expectedImage->GetOrigin()[axis] ||
+        actualImage->GetSpacing()[axis] != expectedImage->GetSpacing()[axis])
+      {
+        vtkLogF(ERROR, "%s: histogram %u does not span the global range.", what, pair);
+        return false;
+      }
+    }
+    vtkDataArray* expectedValues = expectedImage->GetPointData()->GetArray("bin_values");
+    vtkDataArray* actualValues = actualImage->GetPointData()->GetArray("bin_values");
+    for (vtkIdType cc = 0; cc < expectedValues->GetNumberOfTuples(); ++cc)
+    {
+      if (!actualValues || actualValues->GetTuple1(cc) != expectedValues->GetTuple1(cc))
+      {
+        vtkLogF(ERROR, "%s: histogram %u differs at bin %lld.", what, pair,
+          static_cast<long long>(cc));
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestPVPairwiseHistograms2DMPI(int argc, char* argv[])
+{
+  vtkNew<vtkMPIController> controller;
+  controller->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(controller);
+  const int rank = controller->GetLocalProcessId();
+  const int numProcs = controller->GetNumberOfProcesses();
+
+  vtkSmartPointer<vtkTable> local = CreateTable(rank, rank + 1);
+  vtkSmartPointer<vtkTable> all = CreateTable(0, numProcs);
+
+  bool success = true;
+  // equal numbers of bins share the bins of each column between both axes.
+  const int numBins[][2] = { { 10, 10 }, { 8, 5 } };
+  for (const auto& bins : numBins)
+  {
+    vtkNew<vtkPVPairwiseHistograms2D> histograms;
+    histograms->SetController(controller);
+    histograms->SetInputData(local);
+    histograms->SetNumberOfBins(bins[0], bins[1]);
+    histograms->Update();
+
+    vtkNew<vtkPVPairwiseHistograms2D> expected;
+    expected->SetInputData(all);
+    expected->SetNumberOfBins(bins[0], bins[1]);
+    expected->Update();
+
+    const std::string what = std::to_string(bins[0]) + "x" + std::to_string(bins[1]) + " bins";
+    if (rank == 0)
+    {
+      success = CompareHistograms(expected->GetOutputDataObject(0),
+                  histograms->GetOutputDataObject(0), what.c_str()) &&
+        success;
+    }
+    else if (histograms->GetOutput()->GetNumberOfBlocks() != 0)
+    {
+      vtkLogF(ERROR, "%s: only rank 0 should have histograms.", what.c_str());
+      success = false;
+    }
+  }
+
+  int allSuccess = 0;
+  int localSuccess = success ? 1 : 0;
+  controller->AllReduce(&localSuccess, &allSuccess, 1, vtkCommunicator::LOGICAL_AND_OP);
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  controller->Finalize();
+  return allSuccess ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,70 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Checks that vtkReductionFilter, as used by vtkSelectionDeliveryFilter,
+// gathers the bitmask selection nodes of every rank as bitmasks.
+
+#include "BitmaskSelectionTestHelpers.h"
+
+#include "vtkAppendSelection.h"
+#include "vtkMPIController.h"
+#include "vtkReductionFilter.h"
+
+#include <string>
+
+namespace
+{
+// The bitmask of rank `rank`, whose size and bits differ between ranks.
+vtkSmartPointer<vtkSelectionNode> CreateRankNode(int rank)
+{
+  return BitmaskSelectionTestHelpers::CreateNode(
+    1000 + rank, [rank](vtkIdType cc) { return (cc + rank) % 3 == 0 || cc < 8 * rank; });
+}
+}
+
+int TestReductionFilterBitmaskMPI(int argc, char* argv[])
+{
+  vtkNew<vtkMPIController> controller;
+  controller->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(controller);
+  const int rank = controller->GetLocalProcessId();
+  const int numProcs = controller->GetNumberOfProcesses();
+
+  vtkNew<vtkSelection> selection;
+  selection->AddNode(CreateRankNode(rank));
+
+  vtkNew<vtkAppendSelection> append;
+  append->SetAppendByUnion(0);
+  vtkNew<vtkReductionFilter> reduction;
+  reduction->SetController(controller);
+  reduction->SetPostGatherHelper(append);
+  reduction->SetReductionMode(vtkReductionFilter::REDUCE_ALL_TO_ONE);
+  reduction->SetReductionProcessId(0);
+  reduction->SetInputData(selection);
+  reduction->Update();
+
+  bool success = true;
+  if (rank == 0)
+  {
+    auto output = vtkSelection::SafeDownCast(reduction->GetOutputDataObject(0));
+    if (!output || static_cast<int>(output->GetNumberOfNodes()) != numProcs)
+    {
+      vtkLogF(ERROR, "Expected one node per rank.");
+      success = false;
+    }
+    for (int cc = 0; success && cc < numProcs; ++cc)
+    {
+      const std::string what = "Bitmask of rank " + std::to_string(cc);
+      success = BitmaskSelectionTestHelpers::CompareNodes(
+                  CreateRankNode(cc), output->GetNode(cc), what.c_str()) &&
+        success;
+    }
+  }
+
+  int allSuccess = 0;
+  int localSuccess = success ? 1 : 0;
+  controller->AllReduce(&localSuccess, &allSuccess, 1, vtkCommunicator::LOGICAL_AND_OP);
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  controller->Finalize();
+  return allSuccess ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,70 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Checks that vtkSelectionSerializer writes bitmask selection nodes as run
+// lengths, whose size does not depend on the number of elements, and parses
+// them back to the same bitmasks.
+
+#include "BitmaskSelectionTestHelpers.h"
+
+#include "vtkSelectionSerializer.h"
+
+#include <sstream>
+#include <string>
+
+namespace
+{
+bool CheckRoundTrip(vtkIdType numberOfBits, const std::function<bool(vtkIdType)>& isSet,
+  size_t maxLength, const char* what)
+{
+  vtkSmartPointer<vtkSelectionNode> node =
+    BitmaskSelectionTestHelpers::CreateNode(numberOfBits, isSet);
+  vtkNew<vtkSelection> selection;
+  selection->AddNode(node);
+
+  std::ostringstream xml;
+  vtkSelectionSerializer::PrintXML(xml, vtkIndent(), 1, selection);
+  const std::string str = xml.str();
+  if (str.find("encoding=\"runs\"") == std::string::npos)
+  {
+    vtkLogF(ERROR, "%s: the bitmask is not written as run lengths.", what);
+    return false;
+  }
+  if (str.size() > maxLength)
+  {
+    vtkLogF(ERROR, "%s: the xml has %zu characters, expected at most %zu.", what, str.size(),
+      maxLength);
+    return false;
+  }
+
+  vtkNew<vtkSelection> parsed;
+  vtkSelectionSerializer::Parse(str.c_str(), parsed);
+  if (parsed->GetNumberOfNodes() != 1)
+  {
+    vtkLogF(ERROR, "%s: expected a single node, got %u.", what, parsed->GetNumberOfNodes());
+    return false;
+  }
+  return BitmaskSelectionTestHelpers::CompareNodes(node, parsed->GetNode(0), what);
+}
+}
+
+int TestSelectionSerializerBitmask(int, char*[])
+{
+  bool success = true;
+  success = CheckRoundTrip(100003, [](vtkIdType) { return false; }, 1000, "Empty mask") &&
+    success;
+  success = CheckRoundTrip(100003, [](vtkIdType) { return true; }, 1000, "All set mask") &&
+    success;
+  success =
+    CheckRoundTrip(1001, [](vtkIdType cc) { return cc % 2 == 1; }, 10000, "Alternating mask") &&
+    success;
+  success = CheckRoundTrip(1001, [](vtkIdType cc) { return cc % 2 == 0; }, 10000,
+              "Alternating mask starting with a set bit") &&
+    success;
+  success = CheckRoundTrip(1000, [](vtkIdType cc) { return cc >= 100 && cc < 900; }, 1000,
+              "Mask of a range") &&
+    success;
+  success = CheckRoundTrip(0, [](vtkIdType) { return true; }, 1000, "Mask of no element") &&
+    success;
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
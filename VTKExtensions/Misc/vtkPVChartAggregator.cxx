@@ -0,0 +1,302 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkPVChartAggregator.h"
+
+#include "vtkArrayDispatch.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkDataArray.h"
+#include "vtkDataArrayRange.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkIdList.h"
+#include "vtkInformationVector.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
+#include "vtkTable.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+// Computes the X bin of each row: bins 1 to numBins cover [xmin, xmax], bins 0
+// and numBins + 1 hold the rows below and above it, and -1 marks rows to skip.
+struct BinWorker
+{
+  template <typename ArrayT>
+  void operator()(
+    ArrayT* array, const double range[2], int numBins, std::vector<int>& bins) const
+  {
+    const auto values = vtk::DataArrayValueRange<1>(array);
+    const double scale = range[1] > range[0] ? numBins / (range[1] - range[0]) : 0.0;
+    const vtkIdType numValues = static_cast<vtkIdType>(values.size());
+    vtkSMPTools::For(0, numValues, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType cc = begin; cc < end; ++cc)
+      {
+        const double x = static_cast<double>(values[cc]);
+        if (std::isnan(x))
+        {
+          bins[cc] = -1;
+        }
+        else if (x < range[0])
+        {
+          bins[cc] = 0;
+        }
+        else if (x > range[1])
+        {
+          bins[cc] = numBins + 1;
+        }
+        else
+        {
+          bins[cc] = 1 + std::min(numBins - 1, static_cast<int>((x - range[0]) * scale));
+        }
+      }
+    });
+  }
+};
+
+// Finds the rows with the smallest and largest finite value in each slot,
+// `slotOf` giving the slot of a row or -1 to skip it.
+struct ExtremaWorker
+{
+  template <typename ArrayT, typename SlotFunctor>
+  void operator()(ArrayT* array, const SlotFunctor& slotOf, std::vector<vtkIdType>& minRows,
+    std::vector<vtkIdType>& maxRows) const
+  {
+    const auto values = vtk::DataArrayValueRange<1>(array);
+    const vtkIdType numValues = static_cast<vtkIdType>(values.size());
+    for (vtkIdType cc = 0; cc < numValues; ++cc)
+    {
+      const int slot = slotOf(cc);
+      const double value = static_cast<double>(values[cc]);
+      if (slot < 0 || !std::isfinite(value))
+      {
+        continue;
+      }
+      vtkIdType& minRow = minRows[slot];
+      vtkIdType& maxRow = maxRows[slot];
+      if (minRow < 0 || value < static_cast<double>(values[minRow]))
+      {
+        minRow = cc;
+      }
+      if (maxRow < 0 || value > static_cast<double>(values[maxRow]))
+      {
+        maxRow = cc;
+      }
+    }
+  }
+};
+
+// Finds the first row falling in each occupied cell of the plot area.
+struct DensityWorker
+{
+  template <typename ArrayT>
+  void operator()(ArrayT* array, const std::vector<int>& bins, const double range[2],
+    int numXBins, int numYBins, std::vector<vtkIdType>& rows) const
+  {
+    const double scale = range[1] > range[0] ? numYBins / (range[1] - range[0]) : 0.0;
+    std::vector<bool> occupied(static_cast<size_t>(numXBins) * numYBins, false);
+    const auto values = vtk::DataArrayValueRange<1>(array);
+    const vtkIdType numValues = static_cast<vtkIdType>(values.size());
+    for (vtkIdType cc = 0; cc < numValues; ++cc)
+    {
+      const double y = static_cast<double>(values[cc]);
+      if (bins[cc] < 1 || bins[cc] > numXBins || !(y >= range[0] && y <= range[1]))
+      {
+        continue;
+      }
+      const int ybin = std::min(numYBins - 1, static_cast<int>((y - range[0]) * scale));
+      const size_t cell = static_cast<size_t>(bins[cc] - 1) * numYBins + ybin;
+      if (!occupied[cell])
+      {
+        occupied[cell] = true;
+        rows.push_back(cc);
+      }
+    }
+  }
+};
+
+template <typename SlotFunctor>
+void AddExtrema(
+  vtkDataArray* array, const SlotFunctor& slotOf, int numSlots, std::vector<vtkIdType>& rows)
+{
+  std::vector<vtkIdType> minRows(numSlots, -1);
+  std::vector<vtkIdType> maxRows(numSlots, -1);
+  ExtremaWorker worker;
+  if (!vtkArrayDispatch::Dispatch::Execute(array, worker, slotOf, minRows, maxRows))
+  {
+    worker(array, slotOf, minRows, maxRows);
+  }
+  for (int slot = 0; slot < numSlots; ++slot)
+  {
+    if (minRows[slot] >= 0)
+    {
+      rows.push_back(minRows[slot]);
+      rows.push_back(maxRows[slot]);
+    }
+  }
+}
+}
+
+vtkStandardNewMacro(vtkPVChartAggregator);
+//----------------------------------------------------------------------------
+vtkPVChartAggregator::vtkPVChartAggregator()
+  : AggregationMode(vtkPVChartAggregator::MIN_MAX)
+  , XArrayName(nullptr)
+  , Resolution{ 1024, 1024 }
+  , XRange{ 0, -1 }
+{
+}
+
+//----------------------------------------------------------------------------
+vtkPVChartAggregator::~vtkPVChartAggregator()
+{
+  this->SetXArrayName(nullptr);
+}
+
+//----------------------------------------------------------------------------
+int vtkPVChartAggregator::RequestData(
+  vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  if (!this->Superclass::RequestData(request, inputVector, outputVector))
+  {
+    return 0;
+  }
+  if (this->XArrayName == nullptr || this->XArrayName[0] == '\0')
+  {
+    return 1;
+  }
+
+  // the leaves may be the input tables themselves: they are replaced rather
+  // than modified.
+  vtkMultiBlockDataSet* output = vtkMultiBlockDataSet::GetData(outputVector, 0);
+  vtkSmartPointer<vtkCompositeDataIterator> iter;
+  iter.TakeReference(output->NewIterator());
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    if (vtkTable* table = vtkTable::SafeDownCast(iter->GetCurrentDataObject()))
+    {
+      auto result = this->Aggregate(table);
+      if (result != table)
+      {
+        output->SetDataSet(iter, result);
+      }
+    }
+  }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkTable> vtkPVChartAggregator::Aggregate(vtkTable* table)
+{
+  vtkDataSetAttributes* rowData = table->GetRowData();
+  vtkDataArray* xArray = rowData->GetArray(this->XArrayName);
+  const vtkIdType numRows = table->GetNumberOfRows();
+  const int numXBins = std::max(this->Resolution[0], 1);
+  const int numYBins = std::max(this->Resolution[1], 1);
+  if (xArray == nullptr || xArray->GetNumberOfComponents() != 1 || numRows <= numXBins)
+  {
+    return table;
+  }
+
+  double range[2] = { this->XRange[0], this->XRange[1] };
+  if (!(range[0] < range[1]))
+  {
+    xArray->GetFiniteRange(range, 0);
+    if (!(range[0] <= range[1]))
+    {
+      return table;
+    }
+  }
+
+  std::vector<int> bins(numRows);
+  BinWorker binWorker;
+  if (!vtkArrayDispatch::Dispatch::Execute(xArray, binWorker, range, numXBins, bins))
+  {
+    binWorker(xArray, range, numXBins, bins);
+  }
+
+  std::vector<vtkDataArray*> arrays(1, xArray);
+  for (int cc = 0, max = rowData->GetNumberOfArrays(); cc < max; ++cc)
+  {
+    vtkDataArray* array = rowData->GetArray(cc);
+    if (array && array != xArray && array->GetNumberOfComponents() == 1)
+    {
+      arrays.push_back(array);
+    }
+  }
+
+  std::vector<vtkIdType> rows;
+  if (this->AggregationMode == vtkPVChartAggregator::MIN_MAX)
+  {
+    auto slotOf = [&bins](vtkIdType row) { return bins[row]; };
+    for (vtkDataArray* array : arrays)
+    {
+      ::AddExtrema(array, slotOf, numXBins + 2, rows);
+    }
+  }
+  else
+  {
+    // the Y cells of each series span the range of its visible values. The
+    // rows with extreme values are kept so that the ranges, hence the cells,
+    // are the same when aggregating the result again.
+    auto slotOf = [&bins, numXBins](vtkIdType row) {
+      return (bins[row] >= 1 && bins[row] <= numXBins) ? 0 : -1;
+    };
+    DensityWorker densityWorker;
+    for (size_t cc = 0; cc < arrays.size(); ++cc)
+    {
+      const size_t first = rows.size();
+      ::AddExtrema(arrays[cc], slotOf, 1, rows);
+      if (cc == 0 || rows.size() == first)
+      {
+        continue;
+      }
+      const double yRange[2] = { arrays[cc]->GetComponent(rows[first], 0),
+        arrays[cc]->GetComponent(rows[first + 1], 0) };
+      if (!vtkArrayDispatch::Dispatch::Execute(
+            arrays[cc], densityWorker, bins, yRange, numXBins, numYBins, rows))
+      {
+        densityWorker(arrays[cc], bins, yRange, numXBins, numYBins, rows);
+      }
+    }
+  }
+
+  std::sort(rows.begin(), rows.end());
+  rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+  if (static_cast<vtkIdType>(rows.size()) >= numRows)
+  {
+    return table;
+  }
+
+  vtkNew<vtkIdList> ids;
+  ids->SetNumberOfIds(static_cast<vtkIdType>(rows.size()));
+  std::copy(rows.begin(), rows.end(), ids->GetPointer(0));
+
+  auto result = vtkSmartPointer<vtkTable>::New();
+  result->GetFieldData()->ShallowCopy(table->GetFieldData());
+  for (int cc = 0, max = rowData->GetNumberOfArrays(); cc < max; ++cc)
+  {
+    vtkAbstractArray* array = rowData->GetAbstractArray(cc);
+    vtkSmartPointer<vtkAbstractArray> subset;
+    subset.TakeReference(array->NewInstance());
+    subset->SetName(array->GetName());
+    subset->SetNumberOfComponents(array->GetNumberOfComponents());
+    subset->CopyComponentNames(array);
+    subset->InsertTuplesStartingAt(0, ids, array);
+    result->GetRowData()->AddArray(subset);
+  }
+  return result;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVChartAggregator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "AggregationMode: " << this->AggregationMode << endl;
+  os << indent << "XArrayName: " << (this->XArrayName ? this->XArrayName : "(nullptr)") << endl;
+  os << indent << "Resolution: " << this->Resolution[0] << ", " << this->Resolution[1] << endl;
+  os << indent << "XRange: " << this->XRange[0] << ", " << this->XRange[1] << endl;
+}
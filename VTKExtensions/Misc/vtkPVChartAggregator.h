@@ -0,0 +1,119 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class   vtkPVChartAggregator
+ * @brief   reduces tables to the rows needed to draw them at screen resolution.
+ *
+ * vtkPVChartAggregator merges its inputs like vtkPVMergeTablesMultiBlock and
+ * then, for each table, keeps only the rows that affect how the table is drawn
+ * by a line or scatter plot `Resolution[0]` pixels wide and `Resolution[1]`
+ * pixels high, using the column named XArrayName for the X axis and all other
+ * single-component numeric columns as Y series:
+ *
+ * \li MIN_MAX (line plots): the X range is split into `Resolution[0]` bins and,
+ * for each bin, the rows with the smallest and largest X and the rows with the
+ * smallest and largest value of each Y series are kept (M4 aggregation). The
+ * lines drawn through the remaining rows cover the same pixels as with all rows.
+ * \li DENSITY (scatter plots): for each Y series, the plot area is split into
+ * `Resolution[0]` by `Resolution[1]` cells and the first row falling in each
+ * cell is kept.
+ *
+ * The output has at most a few rows per pixel and per series, whatever the
+ * number of input rows. The kept rows are passed in their input order with all
+ * their columns. The rows with extreme values are always kept, so that the
+ * filter can be used both as the pre-gather and the post-gather helper of
+ * vtkReductionFilter: in MIN_MAX mode, aggregating the gathered tables of all
+ * ranks gives the same rows as aggregating all rows at once, provided all
+ * ranks use the same XRange. In DENSITY mode, the Y cells of each series span
+ * the range of its values on each rank, so the cells of the two passes may be
+ * offset by less than a pixel.
+ *
+ * When XRange is valid, i.e. XRange[0] < XRange[1], the bins only cover
+ * that range. Rows outside of it are then aggregated in one bin on each side
+ * in MIN_MAX mode, so that the lines leaving the range are still drawn, and
+ * skipped in DENSITY mode. Otherwise the range of the X column is used.
+ *
+ * Tables without the X column, or which would not get smaller, are passed
+ * unchanged.
+ */
+
+#ifndef vtkPVChartAggregator_h
+#define vtkPVChartAggregator_h
+
+#include "vtkPVMergeTablesMultiBlock.h"
+#include "vtkPVVTKExtensionsMiscModule.h" // needed for export macro
+#include "vtkSmartPointer.h"               // needed for vtkSmartPointer
+
+class vtkTable;
+
+class VTKPVVTKEXTENSIONSMISC_EXPORT vtkPVChartAggregator : public vtkPVMergeTablesMultiBlock
+{
+public:
+  static vtkPVChartAggregator* New();
+  vtkTypeMacro(vtkPVChartAggregator, vtkPVMergeTablesMultiBlock);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  enum AggregationModes
+  {
+    MIN_MAX = 0,
+    DENSITY = 1
+  };
+
+  ///@{
+  /**
+   * Get/Set how rows are aggregated. Default is MIN_MAX.
+   */
+  vtkSetClampMacro(AggregationMode, int, MIN_MAX, DENSITY);
+  vtkGetMacro(AggregationMode, int);
+  void SetAggregationModeToMinMax() { this->SetAggregationMode(MIN_MAX); }
+  void SetAggregationModeToDensity() { this->SetAggregationMode(DENSITY); }
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set the name of the column used for the X axis.
+   */
+  vtkSetStringMacro(XArrayName);
+  vtkGetStringMacro(XArrayName);
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set the number of pixels of the plot area along X and Y. The Y
+   * resolution is only used in DENSITY mode. Default is 1024 by 1024.
+   */
+  vtkSetVector2Macro(Resolution, int);
+  vtkGetVector2Macro(Resolution, int);
+  ///@}
+
+  ///@{
+  /**
+   * Get/Set the range of X values that is visible. Ignored unless
+   * XRange[0] < XRange[1], which is not the case by default.
+   */
+  vtkSetVector2Macro(XRange, double);
+  vtkGetVector2Macro(XRange, double);
+  ///@}
+
+protected:
+  vtkPVChartAggregator();
+  ~vtkPVChartAggregator() override;
+
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+
+  /**
+   * Returns the aggregated table, or `table` itself if it cannot be reduced.
+   */
+  vtkSmartPointer<vtkTable> Aggregate(vtkTable* table);
+
+  int AggregationMode;
+  char* XArrayName;
+  int Resolution[2];
+  double XRange[2];
+
+private:
+  vtkPVChartAggregator(const vtkPVChartAggregator&) = delete;
+  void operator=(const vtkPVChartAggregator&) = delete;
+};
+
+#endif
@@ -0,0 +1,343 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+#include "vtkPVPairwiseHistograms2D.h"
+
+#include "vtkArrayDispatch.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkDataArray.h"
+#include "vtkDataArrayRange.h"
+#include "vtkDoubleArray.h"
+#include "vtkFieldData.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkMultiProcessController.h"
+#include "vtkMultiProcessStream.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkSMPTools.h"
+#include "vtkStringArray.h"
+#include "vtkTable.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Computes the bin of each value, or `Invalid` for values that are not
+// finite. Bins are stored in the narrowest type that holds them since there
+// is one per row for each column.
+template <typename BinT>
+struct BinWorker
+{
+  static constexpr BinT Invalid = std::numeric_limits<BinT>::max();
+
+  template <typename ArrayT>
+  void operator()(
+    ArrayT* array, const double range[2], int numBins, std::vector<BinT>& bins) const
+  {
+    const auto values = vtk::DataArrayValueRange<1>(array);
+    const double scale = range[1] > range[0] ? numBins / (range[1] - range[0]) : 0.0;
+    const vtkIdType numValues = static_cast<vtkIdType>(values.size());
+    bins.resize(numValues);
+    vtkSMPTools::For(0, numValues, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType cc = begin; cc < end; ++cc)
+      {
+        const double x = static_cast<double>(values[cc]);
+        bins[cc] = std::isfinite(x)
+          ? static_cast<BinT>(
+              std::max(0, std::min(numBins - 1, static_cast<int>((x - range[0]) * scale))))
+          : Invalid;
+      }
+    });
+  }
+};
+
+// Adds the rows of each pair to its histogram in `counts`. The bins of a
+// column are computed once and shared by all its pairs, and by both axes
+// when they have the same number of bins.
+template <typename BinT>
+void FillHistograms(const std::vector<vtkDataArray*>& arrays, const std::vector<double>& ranges,
+  const std::vector<std::pair<size_t, size_t>>& pairs, vtkIdType numRows, int numXBins,
+  int numYBins, std::vector<double>& counts)
+{
+  const size_t numColumns = arrays.size();
+  const bool shared = numXBins == numYBins;
+  std::vector<std::vector<BinT>> xBins(numColumns);
+  std::vector<std::vector<BinT>> yBinsStorage(shared ? 0 : numColumns);
+  std::vector<std::vector<BinT>>& yBins = shared ? xBins : yBinsStorage;
+  BinWorker<BinT> worker;
+  auto computeBins = [&](size_t cc, int numBins, std::vector<BinT>& bins) {
+    if (!vtkArrayDispatch::Dispatch::Execute(arrays[cc], worker, &ranges[2 * cc], numBins, bins))
+    {
+      worker(arrays[cc], &ranges[2 * cc], numBins, bins);
+    }
+  };
+  for (size_t cc = 0; cc < numColumns; ++cc)
+  {
+    if (!arrays[cc] || arrays[cc]->GetNumberOfTuples() != numRows)
+    {
+      continue;
+    }
+    // the first column is only used along x and the last one along y.
+    if (shared || cc + 1 < numColumns)
+    {
+      computeBins(cc, numXBins, xBins[cc]);
+    }
+    if (!shared && cc > 0)
+    {
+      computeBins(cc, numYBins, yBins[cc]);
+    }
+  }
+
+  const size_t numBinsPerPair = static_cast<size_t>(numXBins) * numYBins;
+  vtkSMPTools::For(0, static_cast<vtkIdType>(pairs.size()), [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType pair = begin; pair < end; ++pair)
+    {
+      const std::vector<BinT>& xs = xBins[pairs[pair].first];
+      const std::vector<BinT>& ys = yBins[pairs[pair].second];
+      if (xs.empty() || ys.empty())
+      {
+        continue;
+      }
+      double* histogram = &counts[pair * numBinsPerPair];
+      for (vtkIdType row = 0; row < numRows; ++row)
+      {
+        if (xs[row] != BinWorker<BinT>::Invalid && ys[row] != BinWorker<BinT>::Invalid)
+        {
+          histogram[static_cast<size_t>(ys[row]) * numXBins + xs[row]] += 1.0;
+        }
+      }
+    }
+  });
+}
+}
+
+class vtkPVPairwiseHistograms2D::vtkInternals
+{
+public:
+  std::vector<std::string> Columns;
+};
+
+vtkStandardNewMacro(vtkPVPairwiseHistograms2D);
+vtkCxxSetObjectMacro(vtkPVPairwiseHistograms2D, Controller, vtkMultiProcessController);
+//----------------------------------------------------------------------------
+vtkPVPairwiseHistograms2D::vtkPVPairwiseHistograms2D()
+  : Internals(new vtkPVPairwiseHistograms2D::vtkInternals())
+{
+}
+
+//----------------------------------------------------------------------------
+vtkPVPairwiseHistograms2D::~vtkPVPairwiseHistograms2D()
+{
+  this->SetController(nullptr);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVPairwiseHistograms2D::AddColumn(const char* name)
+{
+  if (name)
+  {
+    this->Internals->Columns.emplace_back(name);
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVPairwiseHistograms2D::ClearColumns()
+{
+  if (!this->Internals->Columns.empty())
+  {
+    this->Internals->Columns.clear();
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkPVPairwiseHistograms2D::FillInputPortInformation(int, vtkInformation* info)
+{
+  info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkTable");
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkPVPairwiseHistograms2D::RequestData(
+  vtkInformation*, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  vtkTable* input = vtkTable::GetData(inputVector[0], 0);
+  vtkMultiBlockDataSet* output = vtkMultiBlockDataSet::GetData(outputVector, 0);
+  if (!input || !output)
+  {
+    return 0;
+  }
+
+  const bool parallel = this->Controller && this->Controller->GetNumberOfProcesses() > 1;
+  std::vector<std::string> names = this->Internals->Columns;
+  if (names.empty())
+  {
+    for (vtkIdType cc = 0, max = input->GetNumberOfColumns(); cc < max; ++cc)
+    {
+      vtkDataArray* array = vtkDataArray::SafeDownCast(input->GetColumn(cc));
+      if (array && array->GetName() && array->GetNumberOfComponents() == 1)
+      {
+        names.emplace_back(array->GetName());
+      }
+    }
+
+    // Processes may have different or no columns, e.g. when their table is
+    // empty, so the reductions below would not match: all processes use the
+    // columns of the first one that has some.
+    if (parallel)
+    {
+      const int numProcs = this->Controller->GetNumberOfProcesses();
+      const int numNames = static_cast<int>(names.size());
+      std::vector<int> allNumNames(numProcs, 0);
+      this->Controller->AllGather(&numNames, allNumNames.data(), 1);
+      const auto source = std::find_if(
+        allNumNames.begin(), allNumNames.end(), [](int count) { return count > 0; });
+      if (source != allNumNames.end())
+      {
+        const int sourceId = static_cast<int>(source - allNumNames.begin());
+        vtkMultiProcessStream stream;
+        if (this->Controller->GetLocalProcessId() == sourceId)
+        {
+          stream << static_cast<int>(names.size());
+          for (const auto& name : names)
+          {
+            stream << name;
+          }
+        }
+        this->Controller->Broadcast(stream, sourceId);
+        int count;
+        stream >> count;
+        names.resize(count);
+        for (auto& name : names)
+        {
+          stream >> name;
+        }
+      }
+    }
+  }
+
+  const size_t numColumns = names.size();
+  std::vector<vtkDataArray*> arrays(numColumns, nullptr);
+  std::vector<double> ranges(2 * numColumns, VTK_DOUBLE_MAX);
+  for (size_t cc = 0; cc < numColumns; ++cc)
+  {
+    vtkDataArray* array = vtkDataArray::SafeDownCast(input->GetColumnByName(names[cc].c_str()));
+    if (array && array->GetNumberOfComponents() == 1 && array->GetNumberOfTuples() > 0)
+    {
+      double range[2];
+      array->GetFiniteRange(range, 0);
+      if (range[0] <= range[1])
+      {
+        arrays[cc] = array;
+        ranges[2 * cc] = range[0];
+        // negated so that the global range is reduced with a single MIN_OP.
+        ranges[2 * cc + 1] = -range[1];
+      }
+    }
+  }
+
+  if (parallel && numColumns > 0)
+  {
+    std::vector<double> localRanges(ranges);
+    this->Controller->AllReduce(localRanges.data(), ranges.data(),
+      static_cast<vtkIdType>(ranges.size()), vtkCommunicator::MIN_OP);
+  }
+  for (size_t cc = 0; cc < numColumns; ++cc)
+  {
+    ranges[2 * cc + 1] = -ranges[2 * cc + 1];
+    if (!(ranges[2 * cc] <= ranges[2 * cc + 1]))
+    {
+      // empty on all processes.
+      ranges[2 * cc] = 0.0;
+      ranges[2 * cc + 1] = 1.0;
+    }
+  }
+
+  std::vector<std::pair<size_t, size_t>> pairs;
+  for (size_t ii = 0; ii < numColumns; ++ii)
+  {
+    for (size_t jj = ii + 1; jj < numColumns; ++jj)
+    {
+      pairs.emplace_back(ii, jj);
+    }
+  }
+
+  // all histograms are stored contiguously so that they are summed with a
+  // single reduction.
+  const vtkIdType numRows = input->GetNumberOfRows();
+  const int numXBins = std::max(this->NumberOfBins[0], 1);
+  const int numYBins = std::max(this->NumberOfBins[1], 1);
+  const size_t numBinsPerPair = static_cast<size_t>(numXBins) * numYBins;
+  std::vector<double> counts(pairs.size() * numBinsPerPair, 0.0);
+  if (std::max(numXBins, numYBins) < BinWorker<vtkTypeUInt16>::Invalid)
+  {
+    FillHistograms<vtkTypeUInt16>(arrays, ranges, pairs, numRows, numXBins, numYBins, counts);
+  }
+  else
+  {
+    FillHistograms<vtkTypeInt32>(arrays, ranges, pairs, numRows, numXBins, numYBins, counts);
+  }
+
+  if (parallel && !counts.empty())
+  {
+    std::vector<double> localCounts(counts);
+    this->Controller->Reduce(localCounts.data(), counts.data(),
+      static_cast<vtkIdType>(counts.size()), vtkCommunicator::SUM_OP, 0);
+    if (this->Controller->GetLocalProcessId() != 0)
+    {
+      return 1;
+    }
+  }
+
+  output->SetNumberOfBlocks(static_cast<unsigned int>(pairs.size()));
+  for (size_t pair = 0; pair < pairs.size(); ++pair)
+  {
+    const size_t ii = pairs[pair].first;
+    const size_t jj = pairs[pair].second;
+    vtkNew<vtkImageData> image;
+    image->SetDimensions(numXBins, numYBins, 1);
+    image->SetOrigin(ranges[2 * ii], ranges[2 * jj], 0.0);
+    image->SetSpacing((ranges[2 * ii + 1] - ranges[2 * ii]) / numXBins,
+      (ranges[2 * jj + 1] - ranges[2 * jj]) / numYBins, 1.0);
+
+    vtkNew<vtkDoubleArray> values;
+    values->SetName("bin_values");
+    values->SetNumberOfTuples(static_cast<vtkIdType>(numBinsPerPair));
+    std::copy_n(counts.begin() + pair * numBinsPerPair, numBinsPerPair, values->GetPointer(0));
+    image->GetPointData()->SetScalars(values);
+
+    vtkNew<vtkStringArray> columnNames;
+    columnNames->SetName("column_names");
+    columnNames->InsertNextValue(names[ii]);
+    columnNames->InsertNextValue(names[jj]);
+    image->GetFieldData()->AddArray(columnNames);
+
+    output->SetBlock(static_cast<unsigned int>(pair), image);
+    output->GetMetaData(static_cast<unsigned int>(pair))
+      ->Set(vtkCompositeDataSet::NAME(), (names[ii] + " vs " + names[jj]).c_str());
+  }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVPairwiseHistograms2D::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfBins: " << this->NumberOfBins[0] << ", " << this->NumberOfBins[1]
+     << endl;
+  os << indent << "Columns:";
+  for (const auto& name : this->Internals->Columns)
+  {
+    os << " " << name;
+  }
+  os << endl;
+  os << indent << "Controller: " << this->Controller << endl;
+}
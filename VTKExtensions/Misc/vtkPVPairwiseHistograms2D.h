@@ -0,0 +1,90 @@
+// SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+// SPDX-License-Identifier: BSD-3-Clause
+/**
+ * @class vtkPVPairwiseHistograms2D
+ * @brief Extract the 2D histograms of all pairs of columns of a parallel table
+ *
+ * vtkPVPairwiseHistograms2D computes, in one pass over the rows of its input
+ * table, the 2D histogram of each pair of the columns added with AddColumn()
+ * (all single-component numeric columns if none was added), e.g. to draw a
+ * scatter plot matrix as density images. Like vtkPVExtractHistogram2D, the
+ * ranges are computed over all processes and the histograms are summed on the
+ * root node.
+ *
+ * The output is a vtkMultiBlockDataSet with one vtkImageData per pair (i, j),
+ * i < j, in the order (0, 1), (0, 2), ..., (1, 2), .... Each image has
+ * NumberOfBins[0] by NumberOfBins[1] points holding the number of rows in
+ * the bins, in a point data array named "bin_values", and spans the range of
+ * column i along X and of column j along Y. The names of the two columns
+ * are stored in a field data vtkStringArray named "column_names". On
+ * processes other than the root, the output is empty.
+ *
+ * Columns added with AddColumn() must be the same on all processes; missing
+ * columns are treated as empty on that process. Otherwise, the columns of
+ * the first process that has some are used on all processes.
+ */
+
+#ifndef vtkPVPairwiseHistograms2D_h
+#define vtkPVPairwiseHistograms2D_h
+
+#include "vtkMultiBlockDataSetAlgorithm.h"
+#include "vtkPVVTKExtensionsMiscModule.h" // needed for exports
+
+#include <memory> // for std::unique_ptr
+
+class vtkMultiProcessController;
+
+class VTKPVVTKEXTENSIONSMISC_EXPORT vtkPVPairwiseHistograms2D
+  : public vtkMultiBlockDataSetAlgorithm
+{
+public:
+  static vtkPVPairwiseHistograms2D* New();
+  vtkTypeMacro(vtkPVPairwiseHistograms2D, vtkMultiBlockDataSetAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /**
+   * Get/Set the multiprocess controller. If no controller is set,
+   * single process is assumed.
+   */
+  virtual void SetController(vtkMultiProcessController*);
+  vtkGetObjectMacro(Controller, vtkMultiProcessController);
+  ///@}
+
+  ///@{
+  /**
+   * Add/Clear the columns to compute the histograms of.
+   */
+  void AddColumn(const char* name);
+  void ClearColumns();
+  ///@}
+
+  ///@{
+  /**
+   * Set/get the number of bins to be used per dimension (x,y). Default is
+   * 64 by 64.
+   */
+  vtkSetVector2Macro(NumberOfBins, int);
+  vtkGetVector2Macro(NumberOfBins, int);
+  ///@}
+
+protected:
+  vtkPVPairwiseHistograms2D();
+  ~vtkPVPairwiseHistograms2D() override;
+
+  int FillInputPortInformation(int port, vtkInformation* info) override;
+  int RequestData(vtkInformation* request, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override;
+
+  int NumberOfBins[2] = { 64, 64 };
+  vtkMultiProcessController* Controller = nullptr;
+
+private:
+  vtkPVPairwiseHistograms2D(const vtkPVPairwiseHistograms2D&) = delete;
+  void operator=(const vtkPVPairwiseHistograms2D&) = delete;
+
+  class vtkInternals;
+  std::unique_ptr<vtkInternals> Internals;
+};
+
+#endif
@@ -3,6 +3,7 @@
 
 #include "vtkSelectionSerializer.h"
 
+#include "vtkBitArray.h"
 #include "vtkClientServerStreamInstantiator.h"
 #include "vtkDataArray.h"
 #include "vtkDataSetAttributes.h"
@@ -20,6 +21,10 @@
 #include "vtkSelectionNode.h"
 #include "vtkStringArray.h"
 
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
 //----------------------------------------------------------------------------
 
 vtkStandardNewMacro(vtkSelectionSerializer);
@@ -106,6 +111,62 @@ void vtkSelectionSerializerWriteSelectionList(
   os << endl;
 }
 
+//----------------------------------------------------------------------------
+// Bit arrays, used by bitmask selections, are written as the lengths of the
+// alternating runs of unset and set bits, starting with unset bits.
+static void vtkSelectionSerializerWriteBitRuns(ostream& os, vtkIndent indent, vtkBitArray* list)
+{
+  const vtkIdType numBits = list->GetNumberOfValues();
+  const unsigned char* bytes = list->GetPointer(0);
+  os << indent;
+  bool current = false;
+  vtkIdType runStart = 0;
+  for (vtkIdType idx = 0; idx < numBits;)
+  {
+    // skip whole bytes that continue the current run.
+    const unsigned char byte = bytes[idx >> 3];
+    if ((idx & 7) == 0 && idx + 8 <= numBits && byte == (current ? 0xff : 0x00))
+    {
+      idx += 8;
+      continue;
+    }
+    if (((byte >> (7 - (idx & 7))) & 1) != static_cast<int>(current))
+    {
+      os << (idx - runStart) << " ";
+      runStart = idx;
+      current = !current;
+    }
+    ++idx;
+  }
+  os << (numBits - runStart) << endl;
+}
+
+//----------------------------------------------------------------------------
+static void vtkSelectionSerializerParseBitRuns(const char* runs, vtkBitArray* list)
+{
+  const vtkIdType numBits = list->GetNumberOfValues();
+  if (numBits == 0)
+  {
+    return;
+  }
+  unsigned char* bytes = list->GetPointer(0);
+  memset(bytes, 0, static_cast<size_t>((numBits + 7) / 8));
+  std::istringstream str(runs ? runs : "");
+  bool current = false;
+  vtkIdType idx = 0;
+  vtkIdType length;
+  while (idx < numBits && str >> length)
+  {
+    const vtkIdType end = std::min(numBits, idx + length);
+    for (; current && idx < end; ++idx)
+    {
+      bytes[idx >> 3] |= static_cast<unsigned char>(0x80 >> (idx & 7));
+    }
+    idx = end;
+    current = !current;
+  }
+}
+
 //----------------------------------------------------------------------------
 // Serializes the selection list data array
 void vtkSelectionSerializer::WriteSelectionData(
@@ -114,7 +175,17 @@ void vtkSelectionSerializer::WriteSelectionData(
   vtkDataSetAttributes* data = selection->GetSelectionData();
   for (int i = 0; i < data->GetNumberOfArrays(); i++)
   {
-    if (vtkDataArray::SafeDownCast(data->GetAbstractArray(i)))
+    if (vtkBitArray* bitList = vtkBitArray::SafeDownCast(data->GetAbstractArray(i)))
+    {
+      os << indent << "<SelectionList"
+         << " classname=\"" << bitList->GetClassName() << "\" name=\""
+         << (bitList->GetName() ? bitList->GetName() : "") << "\" number_of_tuples=\""
+         << bitList->GetNumberOfTuples() << "\" number_of_components=\""
+         << bitList->GetNumberOfComponents() << "\" encoding=\"runs\">" << endl;
+      vtkSelectionSerializerWriteBitRuns(os, indent, bitList);
+      os << indent << "</SelectionList>" << endl;
+    }
+    else if (vtkDataArray::SafeDownCast(data->GetAbstractArray(i)))
     {
       vtkDataArray* list = vtkDataArray::SafeDownCast(data->GetAbstractArray(i));
       vtkIdType numTuples = list->GetNumberOfTuples();
@@ -331,10 +402,16 @@ void vtkSelectionSerializer::ParseNode(vtkPVXMLElement* nodeXML, vtkSelectionNod
     }
     else if (strcmp("SelectionList", name) == 0)
     {
+      const char* encoding = elem->GetAttribute("encoding");
+      const bool runs = encoding && strcmp(encoding, "runs") == 0;
       if (elem->GetAttribute("classname"))
       {
-        vtkAbstractArray* arr = vtkAbstractArray::SafeDownCast(
-          vtkClientServerStreamInstantiator::CreateInstance(elem->GetAttribute("classname")));
+        // run lengths are only written for bit arrays, which are created
+        // directly so that bitmasks parse without the client-server wrapping.
+        vtkAbstractArray* arr = runs
+          ? vtkBitArray::New()
+          : vtkAbstractArray::SafeDownCast(
+              vtkClientServerStreamInstantiator::CreateInstance(elem->GetAttribute("classname")));
         vtkDataArray* dataArray = vtkDataArray::SafeDownCast(arr);
         if (dataArray)
         {
@@ -346,19 +423,27 @@ void vtkSelectionSerializer::ParseNode(vtkPVXMLElement* nodeXML, vtkSelectionNod
           {
             dataArray->SetNumberOfComponents(numComps);
             dataArray->SetNumberOfTuples(numTuples);
-            vtkIdType numValues = numTuples * numComps;
-            double* data = new double[numValues];
-            if (elem->GetCharacterDataAsVector(numValues, data))
+            vtkBitArray* bitArray = vtkBitArray::SafeDownCast(dataArray);
+            if (bitArray && runs)
+            {
+              vtkSelectionSerializerParseBitRuns(elem->GetCharacterData(), bitArray);
+            }
+            else
             {
-              for (vtkIdType i2 = 0; i2 < numTuples; i2++)
+              vtkIdType numValues = numTuples * numComps;
+              double* data = new double[numValues];
+              if (elem->GetCharacterDataAsVector(numValues, data))
               {
-                for (int j = 0; j < numComps; j++)
+                for (vtkIdType i2 = 0; i2 < numTuples; i2++)
                 {
-                  dataArray->SetComponent(i2, j, data[i2 * numComps + j]);
+                  for (int j = 0; j < numComps; j++)
+                  {
+                    dataArray->SetComponent(i2, j, data[i2 * numComps + j]);
+                  }
                 }
               }
+              delete[] data;
             }
-            delete[] data;
           }
           node->GetSelectionData()->AddArray(dataArray);
           dataArray->Delete();
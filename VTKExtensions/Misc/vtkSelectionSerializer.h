@@ -8,6 +8,10 @@
  * serialize/deserialize vtkSelection to/from xml. Currently, it
  * supports only a subset of properties: CONTENT_TYPE, SOURCE_ID,
  * PROP_ID, PROCESS_ID, ORIGINAL_SOURCE_ID
+ *
+ * Selection lists stored in a vtkBitArray, as used by bitmask selections, are
+ * written as run lengths so that their size depends on the number of selected
+ * ranges rather than on the number of elements.
  * @sa
  * vtkSelection
  */
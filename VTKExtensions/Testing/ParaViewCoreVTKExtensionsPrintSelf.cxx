@@ -9,6 +9,7 @@
 #include "vtkAttributeDataReductionFilter.h"
 #include "vtkAttributeDataToTableFilter.h"
 #include "vtkBSPCutsGenerator.h"
+#include "vtkBalancedRedistributeDataSet.h"
 #include "vtkBlockDeliveryPreprocessor.h"
 #include "vtkCSVExporter.h"
 #include "vtkCSVWriter.h"
@@ -181,6 +182,7 @@ int ParaViewCoreVTKExtensionsPrintSelf(int, char*[])
   PRINT_SELF(vtkAppendRectilinearGrid);
   PRINT_SELF(vtkAttributeDataReductionFilter);
   PRINT_SELF(vtkAttributeDataToTableFilter);
+  PRINT_SELF(vtkBalancedRedistributeDataSet);
   PRINT_SELF(vtkBlockDeliveryPreprocessor);
   PRINT_SELF(vtkBSPCutsGenerator);
   PRINT_SELF(vtkCameraInterpolator2);
@@ -16,8 +16,11 @@ from vtkmodules.numpy_interface.algorithms import *
 from paraview.vtk import vtkDataObject, vtkDoubleArray, vtkSelectionNode, vtkSelection, vtkStreamingDemandDrivenPipeline
 from paraview.modules import vtkPVVTKExtensionsFiltersPython
 from paraview.vtk.util.numpy_support import get_numpy_array_type
+import ast
+import logging
 import sys
 import textwrap
+import tracemalloc
 
 if sys.version_info >= (3,):
     xrange = range
@@ -172,6 +175,171 @@ def compute(inputs, expression, ns=None, multiline=False):
         return finalRet
 
 
+# numpy functions that operate element by element. Expressions made of these
+# and of arithmetic can be evaluated on consecutive chunks of the arrays.
+_elementwise_functions = {
+    "abs", "absolute", "arccos", "arccosh", "arcsin", "arcsinh", "arctan", "arctan2",
+    "arctanh", "ceil", "clip", "cos", "cosh", "deg2rad", "degrees", "exp", "exp2", "expm1",
+    "fabs", "floor", "fmax", "fmin", "fmod", "hypot", "isfinite", "isinf", "isnan",
+    "log", "log10", "log1p", "log2", "logical_and", "logical_not", "logical_or",
+    "logical_xor", "maximum", "minimum", "mod", "negative", "power", "rad2deg", "radians",
+    "reciprocal", "rint", "sign", "sin", "sinh", "sqrt", "square", "tan", "tanh", "trunc",
+    "where"}
+
+# Functions numexpr understands under the same name.
+_numexpr_functions = {
+    "abs", "arccos", "arccosh", "arcsin", "arcsinh", "arctan", "arctan2", "arctanh", "ceil",
+    "cos", "cosh", "exp", "expm1", "floor", "log", "log10", "log1p", "sin", "sinh", "sqrt",
+    "tan", "tanh", "where"}
+
+_elementwise_nodes = (ast.Expression, ast.BinOp, ast.UnaryOp, ast.Compare, ast.Name,
+                      ast.Load, ast.operator, ast.unaryop, ast.cmpop)
+
+
+def _is_component_subscript(node):
+    """Returns True for `name[:, i]`, the extraction of a component."""
+    index = node.slice
+    if sys.version_info < (3, 9) and isinstance(index, ast.Index):
+        index = index.value
+    return isinstance(node.value, ast.Name) and isinstance(index, ast.Tuple) and \
+        len(index.elts) == 2 and isinstance(index.elts[0], ast.Slice) and \
+        index.elts[0].lower is None and index.elts[0].upper is None and \
+        index.elts[0].step is None and isinstance(index.elts[1], ast.Constant) and \
+        isinstance(index.elts[1].value, int)
+
+
+def _analyze_expression(expression):
+    """Returns the variable names used by `expression` and whether numexpr can
+    evaluate it, or `(None, False)` if it is not made of element-wise
+    operations only."""
+    try:
+        tree = ast.parse(expression.strip(), mode="eval")
+    except SyntaxError:
+        return None, False
+    names = set()
+    functions = set()
+    numexpr_compatible = True
+    for node in ast.walk(tree):
+        if isinstance(node, ast.Call):
+            func = node.func
+            if isinstance(func, ast.Attribute) and isinstance(func.value, ast.Name) and \
+                    func.value.id in ("np", "numpy"):
+                numexpr_compatible = False
+                name = func.attr
+            elif isinstance(func, ast.Name):
+                name = func.id
+                functions.add(name)
+            else:
+                return None, False
+            if name not in _elementwise_functions or node.keywords:
+                return None, False
+            numexpr_compatible = numexpr_compatible and name in _numexpr_functions
+        elif isinstance(node, ast.Attribute):
+            if not isinstance(node.value, ast.Name) or node.value.id not in ("np", "numpy"):
+                return None, False
+            # numexpr does not know about numpy attributes such as `numpy.pi`.
+            numexpr_compatible = False
+        elif isinstance(node, ast.Subscript):
+            if not _is_component_subscript(node):
+                return None, False
+            numexpr_compatible = False
+        elif isinstance(node, (ast.Tuple, ast.Slice)):
+            # only found inside component subscripts, checked above.
+            pass
+        elif isinstance(node, ast.Constant):
+            if not isinstance(node.value, (int, float)):
+                return None, False
+        elif isinstance(node, ast.Name):
+            names.add(node.id)
+        elif sys.version_info < (3, 9) and isinstance(node, ast.Index):
+            pass
+        elif not isinstance(node, _elementwise_nodes):
+            return None, False
+    return names - functions - {"np", "numpy"}, numexpr_compatible
+
+
+def compute_streaming(inputs, expression, ns=None, chunk_size=65536):
+    """Evaluates an element-wise `expression` without materializing full size
+    temporaries for its sub-expressions.
+
+    When numexpr is available and understands the expression, it evaluates
+    the whole arrays in cache-sized blocks on several threads without the GIL.
+    Otherwise, the expression is evaluated with numpy on chunks of
+    `chunk_size` tuples, numpy releasing the GIL in its loops, and the chunks
+    are written into the preallocated result.
+
+    Returns `NotImplemented` when the expression is not element-wise or does
+    not use arrays of the same number of tuples, in which case `compute` must
+    be used.
+    """
+    names, numexpr_compatible = _analyze_expression(expression)
+    if names is None:
+        return NotImplemented
+
+    mylocals = dict()
+    if ns:
+        mylocals.update(ns)
+    mylocals["inputs"] = inputs
+    try:
+        mylocals["points"] = inputs[0].Points
+    except AttributeError:
+        pass
+
+    arrays = dict()
+    for name in names:
+        value = mylocals.get(name)
+        if isinstance(value, dsa.VTKCompositeDataArray) or value is dsa.NoneArray:
+            return NotImplemented
+        if isinstance(value, np.ndarray) and value.ndim > 0:
+            arrays[name] = value
+        elif name in mylocals and not isinstance(value, (int, float, np.number)):
+            return NotImplemented
+    if not arrays:
+        return NotImplemented
+    num_tuples = {array.shape[0] for array in arrays.values()}
+    if len(num_tuples) != 1:
+        return NotImplemented
+    num_tuples = num_tuples.pop()
+    reference = next(iter(arrays.values()))
+
+    result = None
+    if numexpr_compatible:
+        try:
+            import numexpr
+        except ImportError:
+            numexpr = None
+        if numexpr is not None:
+            local_dict = {name: mylocals[name] for name in names if name in mylocals}
+            local_dict.update({name: np.asarray(array) for name, array in arrays.items()})
+            try:
+                result = numexpr.evaluate(expression.strip(), local_dict=local_dict)
+            except Exception as error:
+                # e.g. a type or a function signature numexpr does not support.
+                paraview.logger.debug("Python Calculator: numexpr cannot evaluate '%s' (%s), "
+                                      "using numpy." % (expression, error))
+                result = None
+
+    if result is None:
+        code = compile(expression.strip(), "<calculator>", "eval")
+        chunk_size = max(1, chunk_size)
+        for start in range(0, num_tuples, chunk_size):
+            stop = min(start + chunk_size, num_tuples)
+            for name, array in arrays.items():
+                mylocals[name] = np.asarray(array)[start:stop]
+            value = np.asarray(eval(code, globals(), mylocals))
+            if value.ndim == 0 or value.shape[0] != stop - start:
+                # not element-wise after all, e.g. broadcasting against a
+                # smaller array.
+                return NotImplemented
+            if result is None:
+                result = np.empty((num_tuples,) + value.shape[1:], dtype=value.dtype)
+            result[start:stop] = value
+
+    result = dsa.VTKArray(result, dataset=reference.DataSet)
+    result.Association = reference.Association
+    return result
+
+
 def get_data_time(self, do, ininfo):
     dinfo = do.GetInformation()
     if dinfo and dinfo.Has(do.DATA_TIME_STEP()):
@@ -231,7 +399,30 @@ def execute(self, expression, multiline=False):
                       "t_value": inputs[0].t_value,
                       "time_index": inputs[0].time_index,
                       "t_index": inputs[0].t_index})
-    retVal = compute(inputs, expression, ns=variables, multiline=multiline)
+
+    # tracemalloc slows down every allocation, only use it when debugging.
+    trace_memory = paraview.logger.isEnabledFor(logging.DEBUG) and not tracemalloc.is_tracing()
+    if trace_memory:
+        tracemalloc.start()
+
+    retVal = NotImplemented
+    streaming = self.GetUseStreamingEvaluation() and not multiline
+    if streaming:
+        retVal = compute_streaming(inputs, expression, ns=variables,
+                                   chunk_size=self.GetStreamingChunkSize())
+        if retVal is NotImplemented:
+            paraview.logger.info("Python Calculator: '%s' is not element-wise, "
+                                 "evaluating it on whole arrays." % expression)
+            streaming = False
+    if retVal is NotImplemented:
+        retVal = compute(inputs, expression, ns=variables, multiline=multiline)
+
+    if trace_memory:
+        peak = tracemalloc.get_traced_memory()[1]
+        tracemalloc.stop()
+        paraview.logger.debug("Python Calculator: peak memory allocated during %s evaluation: "
+                              "%.1f MiB" % ("streaming" if streaming else "whole array",
+                                            peak / (1024.0 * 1024.0)))
 
     if retVal is not None:
         vtkRet = retVal
@@ -0,0 +1,75 @@
+# SPDX-FileCopyrightText: Copyright (c) Kitware Inc.
+# SPDX-License-Identifier: BSD-3-Clause
+r"""
+This module is used by vtkPythonProgrammableFilter to run the RequestData
+script once per block of a composite dataset.
+"""
+from __future__ import absolute_import, print_function
+
+from concurrent.futures import ThreadPoolExecutor
+
+from vtkmodules.vtkCommonDataModel import vtkCompositeDataSet, vtkDataSet
+from vtkmodules.numpy_interface import dataset_adapter as dsa
+
+
+def _get_inputs(algorithm):
+    return [algorithm.GetInputDataObject(0, idx)
+            for idx in range(algorithm.GetNumberOfInputConnections(0))]
+
+
+def _copy_arrays(source, target):
+    if isinstance(source, vtkDataSet) and isinstance(target, vtkDataSet):
+        target.GetPointData().PassData(source.GetPointData())
+        target.GetCellData().PassData(source.GetCellData())
+    target.GetFieldData().PassData(source.GetFieldData())
+
+
+def execute_per_block(function, algorithm, request, number_of_threads=1):
+    """Calls `function(algorithm, inputs, output, request)` for each leaf of the
+    first input of `algorithm`. `inputs` holds the leaves of the inputs at the
+    same position, or the whole input when it is not composite, and `output`
+    the leaf of the output at that position, created with the type of the
+    leaf of the first input.
+
+    The calls run on `number_of_threads` threads. They only overlap while the
+    GIL is released, e.g. in numpy operations on large arrays.
+
+    Returns False without calling `function` if the first input or the output
+    of `algorithm` is not a composite dataset.
+    """
+    inputs = _get_inputs(algorithm)
+    output = algorithm.GetOutputDataObject(0)
+    if not inputs or not isinstance(inputs[0], vtkCompositeDataSet) or \
+            not isinstance(output, vtkCompositeDataSet):
+        return False
+
+    # Set up the output blocks first: the composite output must not be modified
+    # from several threads.
+    output.CopyStructure(inputs[0])
+    tasks = []
+    iterator = inputs[0].NewIterator()
+    iterator.InitTraversal()
+    while not iterator.IsDoneWithTraversal():
+        block = iterator.GetCurrentDataObject()
+        block_inputs = [inp.GetDataSet(iterator) if isinstance(inp, vtkCompositeDataSet)
+                        else inp for inp in inputs]
+        block_output = block.NewInstance()
+        if algorithm.GetCopyArrays():
+            _copy_arrays(block, block_output)
+        output.SetDataSet(iterator, block_output)
+        tasks.append(([dsa.WrapDataObject(inp) for inp in block_inputs],
+                      dsa.WrapDataObject(block_output)))
+        iterator.GoToNextItem()
+
+    def run(task):
+        function(algorithm, task[0], task[1], request)
+
+    if number_of_threads <= 1 or len(tasks) <= 1:
+        for task in tasks:
+            run(task)
+    else:
+        with ThreadPoolExecutor(max_workers=number_of_threads) as executor:
+            # consume the results so that exceptions are raised here.
+            for _ in executor.map(run, tasks):
+                pass
+    return True